@@ -10,11 +10,16 @@
 #include "../../source/Fill.hpp"
 #include "../../source/Store.hpp"
 #include "../../source/Attempt.hpp"
+#include "../../source/Float16.hpp"
+#include "../../source/Pack.hpp"
+#include "../../source/Aligned.hpp"
+#include "../../source/Masked.hpp"
 
 #include "../../source/unary/Abs.hpp"
 #include "../../source/unary/Floor.hpp"
 #include "../../source/unary/Ceil.hpp"
 #include "../../source/unary/Round.hpp"
+#include "../../source/unary/ByteSwap.hpp"
 
 #include "../../source/binary/Add.hpp"
 #include "../../source/binary/Divide.hpp"
@@ -31,4 +36,23 @@
 #include "../../source/binary/ShiftLeft.hpp"
 #include "../../source/binary/ShiftRight.hpp"
 #include "../../source/binary/Subtract.hpp"
-#include "../../source/binary/XOr.hpp"
\ No newline at end of file
+#include "../../source/binary/XOr.hpp"
+
+#include "../../source/bulk/Interleave.hpp"
+#include "../../source/bulk/ConvertHalf.hpp"
+#include "../../source/bulk/Batch.hpp"
+#include "../../source/bulk/Scan.hpp"
+#include "../../source/bulk/Endian.hpp"
+#include "../../source/bulk/Search.hpp"
+#include "../../source/bulk/Hash.hpp"
+#include "../../source/bulk/Sort.hpp"
+#include "../../source/bulk/Select.hpp"
+#include "../../source/bulk/Histogram.hpp"
+#include "../../source/bulk/Dot.hpp"
+#include "../../source/bulk/Quantize.hpp"
+#include "../../source/bulk/Compress.hpp"
+#include "../../source/bulk/Convert.hpp"
+#include "../../source/pixel/Pixel.hpp"
+#include "../../source/text/Unicode.hpp"
+
+#include "../../source/matrix/Matrix.hpp"
\ No newline at end of file
@@ -0,0 +1,110 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <bit>
+#include <limits>
+#include <new>
+#include <vector>
+
+
+///                                                                           
+///   Aligned storage                                                         
+///                                                                           
+/// Registers are loaded and stored fastest when they don't cross a cache     
+/// line, and only aligned memory guarantees that. AlignedAllocator gives     
+/// heap buffers (i.e. AlignedVector) that start on a boundary of the         
+/// widest register, and AlignedArray is a fixed-size vector with the same    
+/// alignment. Load and Store use aligned instructions whenever the type      
+/// of the array proves it's aligned - for AlignedArray, but never for        
+/// std::array or plain arrays of numbers                                     
+///                                                                           
+namespace Langulus::SIMD
+{
+
+   /// Standard allocator, that aligns all buffers to ALIGN bytes             
+   ///   @tparam T - the type of the allocated elements                       
+   ///   @tparam ALIGN - the alignment, the widest register by default        
+   template<class T, Count ALIGN = Alignment>
+   struct AlignedAllocator {
+      static_assert(::std::has_single_bit(ALIGN), "Alignment must be a power of two");
+      static_assert(ALIGN >= alignof(T), "Alignment can't be weaker than the type's");
+
+      using value_type = T;
+
+      template<class U>
+      struct rebind {
+         using other = AlignedAllocator<U, ALIGN>;
+      };
+
+      constexpr AlignedAllocator() noexcept = default;
+
+      template<class U>
+      constexpr AlignedAllocator(const AlignedAllocator<U, ALIGN>&) noexcept {}
+
+      /// Allocate an aligned buffer                                          
+      ///   @param count - number of elements                                 
+      ///   @return the buffer                                                
+      NOD() T* allocate(Count count) {
+         if (count > ::std::numeric_limits<Count>::max() / sizeof(T))
+            throw ::std::bad_array_new_length {};
+         return static_cast<T*>(::operator new(count * sizeof(T), ::std::align_val_t {ALIGN}));
+      }
+
+      /// Free a buffer that was allocated by allocate()                      
+      ///   @param buffer - the buffer                                        
+      void deallocate(T* buffer, Count) noexcept {
+         ::operator delete(buffer, ::std::align_val_t {ALIGN});
+      }
+
+      /// All aligned allocators can free each other's buffers                
+      template<class U> NOD() LANGULUS(INLINED)
+      constexpr bool operator == (const AlignedAllocator<U, ALIGN>&) const noexcept {
+         return true;
+      }
+   };
+
+   /// Dynamic array, aligned to the widest register                          
+   template<class T, Count ALIGN = Alignment>
+   using AlignedVector = ::std::vector<T, AlignedAllocator<T, ALIGN>>;
+
+   /// Fixed-size array, aligned to the widest register, or to the register   
+   /// the whole array fits in, if it's smaller                               
+   ///   @tparam T - the type of the elements                                 
+   ///   @tparam N - number of elements                                       
+   template<class T, Count N>
+   struct alignas(::std::bit_ceil(sizeof(T) * N) < Alignment
+      ? ::std::bit_ceil(sizeof(T) * N) : Alignment) AlignedArray {
+      LANGULUS(TYPED) T;
+      static constexpr Count MemberCount = N;
+
+      T mArray[N];
+
+      NOD() LANGULUS(INLINED)
+      constexpr T& operator [] (Offset i) noexcept {
+         return mArray[i];
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr const T& operator [] (Offset i) const noexcept {
+         return mArray[i];
+      }
+
+      NOD() LANGULUS(INLINED) constexpr T* data() noexcept { return mArray; }
+      NOD() LANGULUS(INLINED) constexpr const T* data() const noexcept { return mArray; }
+      NOD() LANGULUS(INLINED) constexpr T* begin() noexcept { return mArray; }
+      NOD() LANGULUS(INLINED) constexpr const T* begin() const noexcept { return mArray; }
+      NOD() LANGULUS(INLINED) constexpr T* end() noexcept { return mArray + N; }
+      NOD() LANGULUS(INLINED) constexpr const T* end() const noexcept { return mArray + N; }
+      NOD() LANGULUS(INLINED) static constexpr Count size() noexcept { return N; }
+
+      NOD() LANGULUS(INLINED)
+      constexpr bool operator == (const AlignedArray&) const noexcept = default;
+   };
+
+} // namespace Langulus::SIMD
@@ -94,7 +94,9 @@ namespace Langulus::SIMD::Inner
          LOSSLESS, SIMD::LosslessArray<FORCE_OUT>>;
       using E = TypeOf<OUT>;
       using R = decltype(Load<DEF>(Fake<const LOSSLESS&>()));
-      constexpr bool supported = CT::SIMD<InvocableResult2<decltype(opSIMD), R>>;
+      using RESULT = InvocableResult2<decltype(opSIMD), R>;
+      // 512bit comparisons give bitmasks instead of registers          
+      constexpr bool supported = CT::SIMD<RESULT> or CT::Bitmask<RESULT>;
 
       if constexpr (not supported) {
          // Operating on scalars, or SIMD not supported, just fallback  
@@ -22,6 +22,8 @@
 #if LANGULUS_ALIGNMENT >= 32
    #include <simde/x86/avx2.h>
    #include <simde/x86/avx.h>
+   #include <simde/x86/fma.h>
+   #include <simde/x86/f16c.h>
 #endif
 
 #if LANGULUS_ALIGNMENT >= 16
@@ -66,9 +68,12 @@ LANGULUS_EXCEPTION(DivisionByZero);
 #define LANGULUS_SIMD_AVX512DQ() 0
 #define LANGULUS_SIMD_AVX512F() 0
 #define LANGULUS_SIMD_AVX512VL() 0
+#define LANGULUS_SIMD_AVX512VNNI() 0
 #define LANGULUS_SIMD_AVX512() 0
 #define LANGULUS_SIMD_AVX2() 0
 #define LANGULUS_SIMD_AVX() 0
+#define LANGULUS_SIMD_FMA() 0
+#define LANGULUS_SIMD_F16C() 0
 #define LANGULUS_SIMD_SSE4_2() 0
 #define LANGULUS_SIMD_SSE4_1() 0
 #define LANGULUS_SIMD_SSSE3() 0
@@ -126,6 +131,11 @@ LANGULUS_EXCEPTION(DivisionByZero);
    #define LANGULUS_SIMD_128BIT() 1
 #endif
 
+#if defined(SIMDE_ARCH_X86_AVX512VNNI) and LANGULUS_ALIGNMENT >= 64
+   #undef LANGULUS_SIMD_AVX512VNNI
+   #define LANGULUS_SIMD_AVX512VNNI() 1
+#endif
+
 #if LANGULUS_SIMD(AVX512BW) and LANGULUS_SIMD(AVX512CD) \
                             and LANGULUS_SIMD(AVX512DQ) \
                             and LANGULUS_SIMD(AVX512F)  \
@@ -159,6 +169,16 @@ LANGULUS_EXCEPTION(DivisionByZero);
    #define LANGULUS_SIMD_128BIT() 1
 #endif
 
+#if defined(SIMDE_ARCH_X86_FMA) and LANGULUS_ALIGNMENT >= 32
+   #undef LANGULUS_SIMD_FMA
+   #define LANGULUS_SIMD_FMA() 1
+#endif
+
+#if defined(SIMDE_ARCH_X86_F16C) and LANGULUS_ALIGNMENT >= 32
+   #undef LANGULUS_SIMD_F16C
+   #define LANGULUS_SIMD_F16C() 1
+#endif
+
 #if defined(SIMDE_ARCH_X86_SSE4_2) and LANGULUS_ALIGNMENT >= 16
    #undef LANGULUS_SIMD_SSE4_2
    #define LANGULUS_SIMD_SSE4_2() 1
@@ -201,6 +221,27 @@ LANGULUS_EXCEPTION(DivisionByZero);
    #define LANGULUS_SIMD_128BIT() 1
 #endif
 
+/// Registers wider than LANGULUS_SIMD_PREFER_WIDTH bits are never used, even 
+/// if the CPU has them. Short bursts of 512bit instructions lower the clock  
+/// of the whole core on some CPUs, which slows down everything else that     
+/// runs on it. The instruction sets stay enabled, so AVX-512VL masks,        
+/// compression and conversions are still used on the narrower registers.     
+/// Code vectorized by the compiler is limited separately, by flags such as   
+/// -mprefer-vector-width=256                                                 
+#ifndef LANGULUS_SIMD_PREFER_WIDTH
+   #define LANGULUS_SIMD_PREFER_WIDTH 512
+#endif
+
+#if LANGULUS_SIMD_PREFER_WIDTH < 512
+   #undef LANGULUS_SIMD_512BIT
+   #define LANGULUS_SIMD_512BIT() 0
+#endif
+
+#if LANGULUS_SIMD_PREFER_WIDTH < 256
+   #undef LANGULUS_SIMD_256BIT
+   #define LANGULUS_SIMD_256BIT() 0
+#endif
+
 #if LANGULUS_SIMD(128BIT) or LANGULUS_SIMD(256BIT) or LANGULUS_SIMD(512BIT)
    #undef LANGULUS_SIMD_ENABLED
    #define LANGULUS_SIMD_ENABLED()  1
@@ -227,6 +268,13 @@ namespace Langulus::SIMD
 
    using ::Langulus::Inner::Unsupported;
 
+   /// Size of the widest register in bytes - it can be narrower than the     
+   /// Alignment, if LANGULUS_SIMD_PREFER_WIDTH restricts it                  
+   constexpr Count WidestRegisterSize = LANGULUS_SIMD(512BIT) ? 64
+                                      : LANGULUS_SIMD(256BIT) ? 32
+                                      : LANGULUS_SIMD(128BIT) ? 16
+                                      : Alignment;
+
    /// Single real element inside a register                                  
    template<class...T>
    concept RealElement = ((CT::ExactAsOneOf<T,
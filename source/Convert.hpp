@@ -8,6 +8,7 @@
 #pragma once
 #include "Load.hpp"
 #include "Store.hpp"
+#include "converters/Policy.hpp"
 
 #if LANGULUS_SIMD(128BIT)
    #include "converters/From128f.hpp"
@@ -28,20 +29,23 @@
 
 namespace Langulus::SIMD
 {
+
    namespace Inner
    {
 
       /// Used to detect missing SIMD routine                                 
-      template<Element> NOD() LANGULUS(INLINED)
+      template<Element, ConvertPolicy = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
       constexpr Unsupported ConvertSIMD(CT::NotSIMD auto) noexcept {
          return {};
       }
 
       /// Convert from one register to another                                
       ///   @tparam TO - type of element to convert to                        
+      ///   @tparam P - how to treat numbers that don't fit, and how to round 
+      ///      reals to integers (see ConvertPolicy)                          
       ///   @param in - register to convert from                              
       ///   @return the resulting register, or Unsupported if not possible    
-      template<Element TO> NOD() LANGULUS(INLINED)
+      template<Element TO, ConvertPolicy P = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
       auto ConvertSIMD(CT::SIMD auto in) noexcept {
          using R = decltype(in);
          using T = TypeOf<R>;
@@ -51,28 +55,29 @@ namespace Langulus::SIMD
             return in;
          }
          else if constexpr (CT::SIMD128<R>) {
-            if      constexpr (CT::Float<T>)    return ConvertFrom128f<TO>(in);
-            else if constexpr (CT::Double<T>)   return ConvertFrom128d<TO>(in);
-            else if constexpr (CT::Integer<T>)  return ConvertFrom128i<TO>(in);
+            if      constexpr (CT::Float<T>)    return ConvertFrom128f<TO, P>(in);
+            else if constexpr (CT::Double<T>)   return ConvertFrom128d<TO, P>(in);
+            else if constexpr (CT::Integer<T>)  return ConvertFrom128i<TO, P>(in);
          }
          else if constexpr (CT::SIMD256<R>) {
-            if      constexpr (CT::Float<T>)    return ConvertFrom256f<TO>(in);
-            else if constexpr (CT::Double<T>)   return ConvertFrom256d<TO>(in);
-            else if constexpr (CT::Integer<T>)  return ConvertFrom256i<TO>(in);
+            if      constexpr (CT::Float<T>)    return ConvertFrom256f<TO, P>(in);
+            else if constexpr (CT::Double<T>)   return ConvertFrom256d<TO, P>(in);
+            else if constexpr (CT::Integer<T>)  return ConvertFrom256i<TO, P>(in);
          }
          else if constexpr (CT::SIMD512<R>) {
-            if      constexpr (CT::Float<T>)    return ConvertFrom512f<TO>(in);
-            else if constexpr (CT::Double<T>)   return ConvertFrom512d<TO>(in);
-            else if constexpr (CT::Integer<T>)  return ConvertFrom512i<TO>(in);
+            if      constexpr (CT::Float<T>)    return ConvertFrom512f<TO, P>(in);
+            else if constexpr (CT::Double<T>)   return ConvertFrom512d<TO, P>(in);
+            else if constexpr (CT::Integer<T>)  return ConvertFrom512i<TO, P>(in);
          }
          else static_assert(false, "Can't convert from unsupported");
       }
 
       /// Convert scalars/arrays at compile-time, if possible                 
       ///   @tparam TO - the desired element type                             
+      ///   @tparam P - the policy                                            
       ///   @param in - scalar/vector to convert from                         
       ///   @return std::array or scalar, depending on the input              
-      template<Element TO> NOD() LANGULUS(INLINED)
+      template<Element TO, ConvertPolicy P = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
       constexpr auto ConvertConstexpr(const CT::NotSIMD auto& in) noexcept {
          using FROM = Deref<decltype(in)>;
 
@@ -80,12 +85,12 @@ namespace Langulus::SIMD
             // Convert from vectors                                     
             ::std::array<TO, CountOf<FROM>> result;
             for (Count i = 0; i < CountOf<FROM>; ++i)
-               result[i] = static_cast<TO>(in[i]);
+               result[i] = ConvertScalar<P, TO>(in[i]);
             return result;
          }
          else {
             // Convert from scalar                                      
-            return static_cast<TO>(in);
+            return ConvertScalar<P, TO>(in);
          }
       }
 
@@ -93,15 +98,16 @@ namespace Langulus::SIMD
       ///   @tparam DEF - default value for setting elements outside array,   
       ///      used only if input array is smaller than chosen register       
       ///   @tparam TO - the desired element type                             
+      ///   @tparam P - the policy                                            
       ///   @param in - scalar/vector/register to convert from                
       ///   @return scalar/vector/register/unsupported                        
-      template<auto DEF, Element TO> NOD() LANGULUS(INLINED)
+      template<auto DEF, Element TO, ConvertPolicy P = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
       auto Convert(const auto& in) noexcept {
          using FROM = Deref<decltype(in)>;
 
          if constexpr (CT::SIMD<FROM>) {
             // Input is already a register, skip loading                
-            return ConvertSIMD<TO>(in);
+            return ConvertSIMD<TO, P>(in);
          }
          else if constexpr (CT::Vector<FROM>) {
             // Convert from vectors                                     
@@ -110,15 +116,15 @@ namespace Langulus::SIMD
 
             if constexpr (CT::Unsupported<decltype(v)>) {
                // Load to register fails, fallback                      
-               return ConvertConstexpr<TO>(in);
+               return ConvertConstexpr<TO, P>(in);
             }
             else {
                // Load was a success, now test if SIMD conversion is    
                // supported                                             
-               const auto converted = ConvertSIMD<TO>(v);
+               const auto converted = ConvertSIMD<TO, P>(v);
                if constexpr (CT::Unsupported<decltype(converted)>) {
                   // SIMD conversion fails, fallback                    
-                  return ConvertConstexpr<TO>(in);
+                  return ConvertConstexpr<TO, P>(in);
                }
                else {
                   static_assert(CT::SIMD<decltype(converted)>,
@@ -130,47 +136,65 @@ namespace Langulus::SIMD
          }
          else {
             // Convert from scalar                                      
-            return static_cast<TO>(in);
+            return ConvertScalar<P, TO>(in);
          }
       }
 
    } // namespace Langulus::SIMD::Inner
 
-   /// Convert numbers, and force output to desired place                     
+   /// Convert numbers, and force output to desired place - as if by          
+   /// static_cast, unless a policy says otherwise                            
    ///   @tparam DEF - default value for setting elements outside array,      
    ///      used only if input array is smaller than chosen register          
+   ///   @tparam P - how to treat numbers that don't fit, and how to round    
+   ///      reals to integers (see ConvertPolicy)                             
    ///   @tparam OUT - the desired scalar/array/register location (deducible) 
    ///   @attention will generate additional store (and convert) instructions 
    ///      in order to fit the result in 'out'. Use Inner::Convert if you    
    ///      don't want this.                                                  
-   template<auto DEF, CT::NoIntent OUT> LANGULUS(INLINED)
-   constexpr void Convert(const auto& val, OUT& out) noexcept {
+   template<auto DEF, ConvertPolicy P = ConvertPolicy::Wrap, CT::NoIntent OUT>
+   requires (not CT::Exact<decltype(DEF), ConvertPolicy>)
+   LANGULUS(INLINED) constexpr void Convert(const auto& val, OUT& out) noexcept {
       using TO = TypeOf<OUT>;
 
-      IF_CONSTEXPR() {
-         // Converting in a contexpr context                            
-         Store(Inner::ConvertConstexpr<TO>(DeintCast(val)), out);
-      }
-      else {
-         // Converting using SIMD, hopefully                            
-         if constexpr (CT::SIMD<OUT>)
-            out = Inner::Convert<DEF, TO>(DeintCast(val));
-         else
-            Store(Inner::Convert<DEF, TO>(DeintCast(val)), out);
+      if constexpr (CT::NotSIMD<Deref<decltype(val)>, OUT>) {
+         IF_CONSTEXPR() {
+            // Converting in a contexpr context                         
+            Store(Inner::ConvertConstexpr<TO, P>(DeintCast(val)), out);
+            return;
+         }
       }
+
+      // Converting using SIMD, hopefully                               
+      if constexpr (CT::SIMD<OUT>)
+         out = Inner::Convert<DEF, TO, P>(DeintCast(val));
+      else
+         Store(Inner::Convert<DEF, TO, P>(DeintCast(val)), out);
+   }
+
+   /// Convert numbers by policy, and force output to desired place, padding  
+   /// registers with zeroes - see Convert<DEF, P> for other padding. Spans   
+   /// of numbers are converted by the overload in bulk/Convert.hpp instead   
+   ///   @tparam P - how to treat numbers that don't fit, and how to round    
+   ///      reals to integers (see ConvertPolicy)                             
+   ///   @tparam OUT - the desired scalar/array/register location (deducible) 
+   template<ConvertPolicy P = ConvertPolicy::Wrap, class VAL, CT::NoIntent OUT>
+   LANGULUS(INLINED) constexpr void Convert(const VAL& val, OUT&& out) noexcept {
+      Convert<0, P>(val, out);
    }
 
    /// Convert numbers                                                        
+   ///   @tparam P - the policy (see ConvertPolicy)                           
    ///   @tparam VAL - array, scalar, or register (deducible)                 
    ///   @tparam OUT - the desired output type (lossless array by default)    
    ///   @attention will generate additional store (and convert) instructions 
    ///      in order to fit the result in an instance of 'OUT'. Use           
    ///      Inner::Convert if you don't want this.                            
-   template<class VAL, CT::NoIntent OUT = LosslessArray<VAL, VAL>>
+   template<ConvertPolicy P = ConvertPolicy::Wrap, class VAL, CT::NoIntent OUT = LosslessArray<VAL, VAL>>
    NOD() LANGULUS(INLINED)
    constexpr OUT Convert(const VAL& val) noexcept {
       OUT out;
-      Convert(DeintCast(val), out);
+      Convert<P>(DeintCast(val), out);
       return out;
    }
 
@@ -0,0 +1,170 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Common.hpp"
+#include <bit>
+
+
+///                                                                           
+///   Half-precision storage types                                            
+///                                                                           
+/// Float16 (IEEE 754 binary16) and BFloat16 (the upper half of a float)      
+/// are storage-only element types. They are never kept in registers as       
+/// they are - they are widened to float on load, all arithmetic happens      
+/// in float, and the results are narrowed back with round-to-nearest-even    
+/// on store. Both implicitly convert to float, so scalar arithmetic on       
+/// them naturally produces floats                                            
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Narrow a float to binary16 bits, rounding to nearest even           
+      ///   @param value - the float to narrow                                
+      ///   @return the half-precision bits                                   
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint16_t FloatToHalfBits(float value) noexcept {
+         auto x = ::std::bit_cast<::std::uint32_t>(value);
+         const auto sign = static_cast<::std::uint16_t>((x >> 16) & 0x8000u);
+         x &= 0x7FFFFFFFu;
+
+         if (x >= 0x7F800000u) {
+            // Infinity stays infinity, NaN becomes a quiet NaN         
+            return static_cast<::std::uint16_t>(sign | (x > 0x7F800000u ? 0x7E00u : 0x7C00u));
+         }
+
+         if (x >= 0x477FF000u) {
+            // Too big, rounds up to infinity                           
+            return static_cast<::std::uint16_t>(sign | 0x7C00u);
+         }
+
+         if (x < 0x38800000u) {
+            // Becomes a subnormal, or zero                             
+            if (x < 0x33000000u)
+               return sign;
+
+            const ::std::uint32_t e = x >> 23;
+            const ::std::uint32_t m = (x & 0x7FFFFFu) | 0x800000u;
+            const ::std::uint32_t shift = 126 - e;
+            const ::std::uint32_t rem = m & ((1u << shift) - 1);
+            const ::std::uint32_t half = 1u << (shift - 1);
+            ::std::uint32_t r = m >> shift;
+            if (rem > half or (rem == half and (r & 1)))
+               ++r;
+            return static_cast<::std::uint16_t>(sign | r);
+         }
+
+         // Normal number - rebias the exponent, and round the mantissa 
+         x -= 0x38000000u;
+         x += 0xFFFu + ((x >> 13) & 1);
+         return static_cast<::std::uint16_t>(sign | (x >> 13));
+      }
+
+      /// Widen binary16 bits to a float - this is always exact               
+      ///   @param bits - the half-precision bits                             
+      ///   @return the float                                                 
+      NOD() LANGULUS(INLINED)
+      constexpr float HalfBitsToFloat(::std::uint16_t bits) noexcept {
+         const ::std::uint32_t sign = ::std::uint32_t(bits & 0x8000u) << 16;
+         const ::std::uint32_t e = (bits >> 10) & 0x1Fu;
+         const ::std::uint32_t m = bits & 0x3FFu;
+
+         if (e == 0) {
+            // Zero or subnormal                                        
+            const float magnitude = static_cast<float>(m) * 5.9604644775390625e-8f;
+            return ::std::bit_cast<float>(sign | ::std::bit_cast<::std::uint32_t>(magnitude));
+         }
+
+         if (e == 31) {
+            // Infinity or NaN                                          
+            return ::std::bit_cast<float>(sign | 0x7F800000u | (m << 13));
+         }
+
+         return ::std::bit_cast<float>(sign | ((e + 112) << 23) | (m << 13));
+      }
+
+      /// Narrow a float to bfloat16 bits, rounding to nearest even           
+      ///   @param value - the float to narrow                                
+      ///   @return the bfloat16 bits                                         
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint16_t FloatToBFloatBits(float value) noexcept {
+         const auto x = ::std::bit_cast<::std::uint32_t>(value);
+         if ((x & 0x7FFFFFFFu) > 0x7F800000u) {
+            // Keep NaNs quiet, rounding could turn them into infinity  
+            return static_cast<::std::uint16_t>((x >> 16) | 0x40u);
+         }
+         return static_cast<::std::uint16_t>((x + 0x7FFFu + ((x >> 16) & 1)) >> 16);
+      }
+
+      /// Widen bfloat16 bits to a float - this is always exact               
+      ///   @param bits - the bfloat16 bits                                   
+      ///   @return the float                                                 
+      NOD() LANGULUS(INLINED)
+      constexpr float BFloatBitsToFloat(::std::uint16_t bits) noexcept {
+         return ::std::bit_cast<float>(::std::uint32_t(bits) << 16);
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// IEEE 754 half-precision storage element                                
+   struct Float16 {
+      ::std::uint16_t mBits = 0;
+
+      constexpr Float16() noexcept = default;
+      constexpr explicit Float16(float value) noexcept
+         : mBits {Inner::FloatToHalfBits(value)} {}
+
+      NOD() LANGULUS(INLINED)
+      static constexpr Float16 FromBits(::std::uint16_t bits) noexcept {
+         Float16 result;
+         result.mBits = bits;
+         return result;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr operator float() const noexcept {
+         return Inner::HalfBitsToFloat(mBits);
+      }
+   };
+
+   /// Brain floating point storage element - a float with a 7bit mantissa    
+   struct BFloat16 {
+      ::std::uint16_t mBits = 0;
+
+      constexpr BFloat16() noexcept = default;
+      constexpr explicit BFloat16(float value) noexcept
+         : mBits {Inner::FloatToBFloatBits(value)} {}
+
+      NOD() LANGULUS(INLINED)
+      static constexpr BFloat16 FromBits(::std::uint16_t bits) noexcept {
+         BFloat16 result;
+         result.mBits = bits;
+         return result;
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr operator float() const noexcept {
+         return Inner::BFloatBitsToFloat(mBits);
+      }
+   };
+
+   static_assert(sizeof(Float16) == 2 and sizeof(BFloat16) == 2,
+      "Half-precision elements must be tightly packed");
+
+} // namespace Langulus::SIMD
+
+namespace Langulus::CT
+{
+
+   /// Half-precision storage element, that is widened to float for math      
+   template<class...T>
+   concept Half = ((CT::Exact<T, SIMD::Float16>
+                 or CT::Exact<T, SIMD::BFloat16>) and ...);
+
+} // namespace Langulus::CT
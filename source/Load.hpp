@@ -73,17 +73,24 @@ namespace Langulus::SIMD
       else {
          // Load a vector either partially, filling the blanks using    
          // DEF value, or directly if vector is of the proper size      
-         // Should perform faster if 'v' is aligned properly            
+         // Aligned instructions are used if the type of 'v' is aligned 
          constexpr auto S  = Inner::DecideCount<R, FORCE_OUT>();
          UNUSED() constexpr auto RS = sizeof(T) * S;
 
          #if LANGULUS_SIMD(128BIT)
             if constexpr (RS <= 16) {
                LANGULUS_SIMD_VERBOSE(
-                  "Loading 128bit register from ", S, " unaligned elements");
+                  "Loading 128bit register from ", S, " elements");
 
                // Load as a single 128bit register                      
-               if constexpr (sizeof(R) >= 16) {
+               if constexpr (sizeof(R) >= 16 and alignof(R) % 16 == 0) {
+                  // The type of the array guarantees it's aligned      
+                  if      constexpr (CT::Float<T>)    return V128<T> {simde_mm_load_ps   (&GetFirst(v))};
+                  else if constexpr (CT::Double<T>)   return V128<T> {simde_mm_load_pd   (&GetFirst(v))};
+                  else if constexpr (CT::Integer<T>)  return V128<T> {simde_mm_load_si128(reinterpret_cast<const simde__m128i*>(&GetFirst(v)))};
+                  else static_assert(false, "Unsupported element");
+               }
+               else if constexpr (sizeof(R) >= 16) {
                   if      constexpr (CT::Float<T>)    return V128<T> {simde_mm_loadu_ps   (&GetFirst(v))};
                   else if constexpr (CT::Double<T>)   return V128<T> {simde_mm_loadu_pd   (&GetFirst(v))};
                   else if constexpr (CT::Integer<T>)  return V128<T> {simde_mm_loadu_si128(&GetFirst(v))};
@@ -97,10 +104,17 @@ namespace Langulus::SIMD
          #if LANGULUS_SIMD(256BIT)
             if constexpr (RS <= 32) {
                LANGULUS_SIMD_VERBOSE(
-                  "Loading 256bit register from ", S, " unaligned elements");
+                  "Loading 256bit register from ", S, " elements");
 
                // Load as a single 256bit register                      
-               if constexpr (sizeof(R) >= 32) {
+               if constexpr (sizeof(R) >= 32 and alignof(R) % 32 == 0) {
+                  // The type of the array guarantees it's aligned      
+                  if      constexpr (CT::Float<T>)    return V256<T> {simde_mm256_load_ps   (&GetFirst(v))};
+                  else if constexpr (CT::Double<T>)   return V256<T> {simde_mm256_load_pd   (&GetFirst(v))};
+                  else if constexpr (CT::Integer<T>)  return V256<T> {simde_mm256_load_si256(reinterpret_cast<const simde__m256i*>(&GetFirst(v)))};
+                  else static_assert(false, "Unsupported element");
+               }
+               else if constexpr (sizeof(R) >= 32) {
                   if      constexpr (CT::Float<T>)    return V256<T> {simde_mm256_loadu_ps   (&GetFirst(v))};
                   else if constexpr (CT::Double<T>)   return V256<T> {simde_mm256_loadu_pd   (&GetFirst(v))};
                   else if constexpr (CT::Integer<T>)  return V256<T> {simde_mm256_loadu_si256(&GetFirst(v))};
@@ -114,10 +128,17 @@ namespace Langulus::SIMD
          #if LANGULUS_SIMD(512BIT)
             if constexpr (RS <= 64) {
                LANGULUS_SIMD_VERBOSE(
-                  "Loading 512bit register from ", S, " unaligned elements");
+                  "Loading 512bit register from ", S, " elements");
 
                // Load as a single 512bit register                      
-               if constexpr (sizeof(R) >= 64) {
+               if constexpr (sizeof(R) >= 64 and alignof(R) % 64 == 0) {
+                  // The type of the array guarantees it's aligned      
+                  if      constexpr (CT::Float<T>)    return V512<T> {simde_mm512_load_ps   (&GetFirst(v))};
+                  else if constexpr (CT::Double<T>)   return V512<T> {simde_mm512_load_pd   (&GetFirst(v))};
+                  else if constexpr (CT::Integer<T>)  return V512<T> {simde_mm512_load_si512(reinterpret_cast<const simde__m512i*>(&GetFirst(v)))};
+                  else static_assert(false, "Unsupported element");
+               }
+               else if constexpr (sizeof(R) >= 64) {
                   if      constexpr (CT::Float<T>)    return V512<T> {simde_mm512_loadu_ps   (&GetFirst(v))};
                   else if constexpr (CT::Double<T>)   return V512<T> {simde_mm512_loadu_pd   (&GetFirst(v))};
                   else if constexpr (CT::Integer<T>)  return V512<T> {simde_mm512_loadu_si512(&GetFirst(v))};
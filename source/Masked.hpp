@@ -0,0 +1,513 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Fill.hpp"
+#include "Load.hpp"
+#include "Store.hpp"
+
+
+///                                                                           
+///   Masked operations                                                       
+///                                                                           
+/// AVX-512 has dedicated mask registers - comparisons of 512bit registers    
+/// write a bit per lane in them, and nearly every instruction can take one,  
+/// writing only the selected lanes, and either keeping (merge-masking) or    
+/// zeroing (zero-masking) the rest. Here 512bit comparisons return these     
+/// masks directly as a Bitmask, and masked operations are a kernel followed  
+/// by MergeSIMD or ZeroSIMD, which compilers fuse into a single masked       
+/// instruction. Narrower registers compare into registers of lane masks, so  
+/// there the bitmask is expanded to such a register, and lanes are blended.  
+/// With AVX-512VL they can still be loaded and stored by a native mask       
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Native AVX-512 mask of C lanes, i.e. __mmask16 for 16 lanes         
+      template<Count C>
+      using NativeMask = Conditional<(C <= 8),  ::std::uint8_t,
+                         Conditional<(C <= 16), ::std::uint16_t,
+                         Conditional<(C <= 32), ::std::uint32_t,
+                                                ::std::uint64_t>>>;
+
+      /// How lanes of a register are selected - a native mask for 512bit     
+      /// registers, and a register with all bits of the selected lanes set,  
+      /// for the narrower ones                                               
+      template<CT::SIMD R>
+      using MaskOf = Conditional<CT::SIMD512<R>, NativeMask<CountOf<R>>, R>;
+
+      /// What comparing two registers gives - a bitmask for 512bit           
+      /// registers, and a register of lane masks for the narrower ones       
+      template<CT::SIMD R>
+      using CompareOf = Conditional<CT::SIMD512<R>, Bitmask<CountOf<R>>, R>;
+
+      /// Wrap a native mask of a register in a bitmask                       
+      ///   @param mask - the native mask                                     
+      ///   @return the bitmask                                               
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      constexpr Bitmask<CountOf<R>> AsBitmask(::std::uint64_t mask) noexcept {
+         using B = Bitmask<CountOf<R>>;
+         return B {static_cast<typename B::Type>(mask)};
+      }
+
+      /// Select lanes of a register by a bitmask                             
+      ///   @param mask - a bit for each lane                                 
+      ///   @return the native mask, or a register of lane masks              
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      MaskOf<R> MaskSIMD(const Bitmask<CountOf<R>>& mask) noexcept {
+         using T = TypeOf<R>;
+         constexpr Count S = sizeof(T);
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               // Give each lane its own bit of the mask, and check it  
+               simde__m128i lanes;
+               if constexpr (S == 1) {
+                  const auto bytes = simde_mm_shuffle_epi8(
+                     simde_mm_set1_epi16(static_cast<::std::int16_t>(mask.mValue)),
+                     simde_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+                  const auto bits = simde_mm_setr_epi8(
+                     1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+                  lanes = simde_mm_cmpeq_epi8(simde_mm_and_si128(bytes, bits), bits);
+               }
+               else if constexpr (S == 2) {
+                  const auto bits = simde_mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+                  lanes = simde_mm_cmpeq_epi16(simde_mm_and_si128(
+                     simde_mm_set1_epi16(static_cast<::std::int16_t>(mask.mValue)), bits), bits);
+               }
+               else if constexpr (S == 4) {
+                  const auto bits = simde_mm_setr_epi32(1, 2, 4, 8);
+                  lanes = simde_mm_cmpeq_epi32(simde_mm_and_si128(
+                     simde_mm_set1_epi32(static_cast<::std::int32_t>(mask.mValue)), bits), bits);
+               }
+               else {
+                  const auto bits = simde_mm_set_epi64x(2, 1);
+                  lanes = simde_mm_cmpeq_epi64(simde_mm_and_si128(
+                     simde_mm_set1_epi64x(mask.mValue), bits), bits);
+               }
+
+               if      constexpr (CT::Float<T>)  return R {simde_mm_castsi128_ps(lanes)};
+               else if constexpr (CT::Double<T>) return R {simde_mm_castsi128_pd(lanes)};
+               else                              return R {lanes};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               // Give each lane its own bit of the mask, and check it  
+               simde__m256i lanes;
+               if constexpr (S == 1) {
+                  const auto bytes = simde_mm256_shuffle_epi8(
+                     simde_mm256_set1_epi32(static_cast<::std::int32_t>(mask.mValue)),
+                     simde_mm256_setr_epi8(
+                        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                        2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+                  const auto bits = simde_mm256_setr_epi8(
+                     1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                     1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+                  lanes = simde_mm256_cmpeq_epi8(simde_mm256_and_si256(bytes, bits), bits);
+               }
+               else if constexpr (S == 2) {
+                  const auto bits = simde_mm256_setr_epi16(
+                     1, 2, 4, 8, 16, 32, 64, 128,
+                     256, 512, 1024, 2048, 4096, 8192, 16384, -32768);
+                  lanes = simde_mm256_cmpeq_epi16(simde_mm256_and_si256(
+                     simde_mm256_set1_epi16(static_cast<::std::int16_t>(mask.mValue)), bits), bits);
+               }
+               else if constexpr (S == 4) {
+                  const auto bits = simde_mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+                  lanes = simde_mm256_cmpeq_epi32(simde_mm256_and_si256(
+                     simde_mm256_set1_epi32(static_cast<::std::int32_t>(mask.mValue)), bits), bits);
+               }
+               else {
+                  const auto bits = simde_mm256_set_epi64x(8, 4, 2, 1);
+                  lanes = simde_mm256_cmpeq_epi64(simde_mm256_and_si256(
+                     simde_mm256_set1_epi64x(mask.mValue), bits), bits);
+               }
+
+               if      constexpr (CT::Float<T>)  return R {simde_mm256_castsi256_ps(lanes)};
+               else if constexpr (CT::Double<T>) return R {simde_mm256_castsi256_pd(lanes)};
+               else                              return R {lanes};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>)
+               return static_cast<MaskOf<R>>(mask.mValue);
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Select the first lanes of a register, for masked loads and stores   
+      ///   @param count - number of lanes to select                          
+      ///   @return the native mask                                           
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      constexpr NativeMask<CountOf<R>> FirstLanes(Count count) noexcept {
+         using B = Bitmask<CountOf<R>>;
+         using BT = typename B::Type;
+         return static_cast<NativeMask<CountOf<R>>>(count >= CountOf<R> ? B::Mask
+            : static_cast<BT>((BT {1} << count) - BT {1}));
+      }
+
+      /// Check if lanes of a register can be loaded and stored by a native   
+      /// mask - 512bit registers always can, narrower ones need AVX-512VL,   
+      /// and AVX-512BW for 8bit and 16bit lanes                              
+      template<CT::SIMD R>
+      constexpr bool MaskedMemory = CT::SIMD512<R>
+         or (LANGULUS_SIMD(AVX512VL) and (sizeof(TypeOf<R>) >= 4 or LANGULUS_SIMD(AVX512BW)));
+
+      /// Pick lanes from a value where a mask is set, and from src elsewhere 
+      /// On AVX-512 this is a masked move, that compilers fuse with the      
+      /// instruction that computed the value                                 
+      ///   @param mask - the selected lanes                                  
+      ///   @param src - where the unselected lanes come from                 
+      ///   @param value - where the selected lanes come from                 
+      ///   @return the merged register                                       
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R MergeSIMD(const MaskOf<R>& mask, const R& src, const R& value) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               using T = TypeOf<R>;
+               if      constexpr (CT::Float<T>)  return R {simde_mm_blendv_ps(src, value, mask)};
+               else if constexpr (CT::Double<T>) return R {simde_mm_blendv_pd(src, value, mask)};
+               else                              return R {simde_mm_blendv_epi8(src, value, mask)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               using T = TypeOf<R>;
+               if      constexpr (CT::Float<T>)  return R {simde_mm256_blendv_ps(src, value, mask)};
+               else if constexpr (CT::Double<T>) return R {simde_mm256_blendv_pd(src, value, mask)};
+               else                              return R {simde_mm256_blendv_epi8(src, value, mask)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using T = TypeOf<R>;
+               constexpr Count S = sizeof(T);
+               if      constexpr (CT::Float<T>)  return R {simde_mm512_mask_mov_ps(src, mask, value)};
+               else if constexpr (CT::Double<T>) return R {simde_mm512_mask_mov_pd(src, mask, value)};
+               else if constexpr (S == 1)        return R {simde_mm512_mask_mov_epi8(src, mask, value)};
+               else if constexpr (S == 2)        return R {simde_mm512_mask_mov_epi16(src, mask, value)};
+               else if constexpr (S == 4)        return R {simde_mm512_mask_mov_epi32(src, mask, value)};
+               else                              return R {simde_mm512_mask_mov_epi64(src, mask, value)};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Keep the lanes of a value where a mask is set, and zero the rest    
+      ///   @param mask - the selected lanes                                  
+      ///   @param value - the register                                       
+      ///   @return the register with unselected lanes zeroed                 
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R ZeroSIMD(const MaskOf<R>& mask, const R& value) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               using T = TypeOf<R>;
+               if      constexpr (CT::Float<T>)  return R {simde_mm_and_ps(mask, value)};
+               else if constexpr (CT::Double<T>) return R {simde_mm_and_pd(mask, value)};
+               else                              return R {simde_mm_and_si128(mask, value)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               using T = TypeOf<R>;
+               if      constexpr (CT::Float<T>)  return R {simde_mm256_and_ps(mask, value)};
+               else if constexpr (CT::Double<T>) return R {simde_mm256_and_pd(mask, value)};
+               else                              return R {simde_mm256_and_si256(mask, value)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using T = TypeOf<R>;
+               constexpr Count S = sizeof(T);
+               if      constexpr (CT::Float<T>)  return R {simde_mm512_maskz_mov_ps(mask, value)};
+               else if constexpr (CT::Double<T>) return R {simde_mm512_maskz_mov_pd(mask, value)};
+               else if constexpr (S == 1)        return R {simde_mm512_maskz_mov_epi8(mask, value)};
+               else if constexpr (S == 2)        return R {simde_mm512_maskz_mov_epi16(mask, value)};
+               else if constexpr (S == 4)        return R {simde_mm512_maskz_mov_epi32(mask, value)};
+               else                              return R {simde_mm512_maskz_mov_epi64(mask, value)};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Reinterpret the bits of a register as another element of the same   
+      /// size, i.e. to select integer lanes by a float comparison            
+      ///   @param x - the register                                           
+      ///   @return the register, with elements of type TO                    
+      template<class TO, CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto ReinterpretSIMD(const R& x) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               using FROM = TypeOf<R>;
+               simde__m128i i;
+               if      constexpr (CT::Float<FROM>)  i = simde_mm_castps_si128(x);
+               else if constexpr (CT::Double<FROM>) i = simde_mm_castpd_si128(x);
+               else                                 i = x;
+
+               if      constexpr (CT::Float<TO>)    return V128<TO> {simde_mm_castsi128_ps(i)};
+               else if constexpr (CT::Double<TO>)   return V128<TO> {simde_mm_castsi128_pd(i)};
+               else                                 return V128<TO> {i};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               using FROM = TypeOf<R>;
+               simde__m256i i;
+               if      constexpr (CT::Float<FROM>)  i = simde_mm256_castps_si256(x);
+               else if constexpr (CT::Double<FROM>) i = simde_mm256_castpd_si256(x);
+               else                                 i = x;
+
+               if      constexpr (CT::Float<TO>)    return V256<TO> {simde_mm256_castsi256_ps(i)};
+               else if constexpr (CT::Double<TO>)   return V256<TO> {simde_mm256_castsi256_pd(i)};
+               else                                 return V256<TO> {i};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using FROM = TypeOf<R>;
+               simde__m512i i;
+               if      constexpr (CT::Float<FROM>)  i = simde_mm512_castps_si512(x);
+               else if constexpr (CT::Double<FROM>) i = simde_mm512_castpd_si512(x);
+               else                                 i = x;
+
+               if      constexpr (CT::Float<TO>)    return V512<TO> {simde_mm512_castsi512_ps(i)};
+               else if constexpr (CT::Double<TO>)   return V512<TO> {simde_mm512_castsi512_pd(i)};
+               else                                 return V512<TO> {i};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Select lanes of a register by what a comparison gave                
+      ///   @param compared - a register of lane masks, with elements of the  
+      ///      same size as R's, a bitmask, or a native mask                  
+      ///   @return the mask for R                                            
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      MaskOf<R> MaskFrom(const auto& compared) noexcept {
+         using C = Deref<decltype(compared)>;
+         if constexpr (CT::SIMD<C>) {
+            static_assert(sizeof(C) == sizeof(R) and CountOf<C> == CountOf<R>,
+               "Comparison must have the same lanes as the register");
+            return ReinterpretSIMD<TypeOf<R>>(compared);
+         }
+         else if constexpr (CT::Bitmask<C>)
+            return MaskSIMD<R>(compared);
+         else
+            return static_cast<MaskOf<R>>(compared);
+      }
+
+      /// Pick lanes from b where a comparison holds, and from a elsewhere,   
+      /// i.e. SelectSIMD(LesserSIMD(x, y), x, y) is the bigger of the two    
+      ///   @param compared - what LesserSIMD, GreaterSIMD, etc. gave, see    
+      ///      MaskFrom                                                       
+      ///   @param a - where lanes come from, if the comparison fails         
+      ///   @param b - where lanes come from, if the comparison holds         
+      ///   @return the selected lanes                                        
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SelectSIMD(const auto& compared, const R& a, const R& b) noexcept {
+         return MergeSIMD<R>(MaskFrom<R>(compared), a, b);
+      }
+
+      /// Load only the selected lanes of a register, without touching the    
+      /// memory of the others, so it's safe to read past the end of arrays   
+      /// Only AVX-512 has masked loads, see MaskedMemory                     
+      ///   @param from - where to load from                                  
+      ///   @param mask - the selected lanes                                  
+      ///   @param fill - where the unselected lanes come from                
+      ///   @return the loaded register                                       
+      template<CT::SIMD R, class T> NOD() LANGULUS(INLINED)
+      R LoadMasked(const T* from, NativeMask<CountOf<R>> mask, const R& fill) noexcept {
+         static_assert(MaskedMemory<R>, "Masked loads need AVX-512");
+         #if LANGULUS_SIMD(AVX512VL)
+            if constexpr (CT::SIMD128<R>) {
+               if      constexpr (CT::Float<T>)   return R {simde_mm_mask_loadu_ps(fill, mask, from)};
+               else if constexpr (CT::Double<T>)  return R {simde_mm_mask_loadu_pd(fill, mask, from)};
+               else if constexpr (sizeof(T) == 1) return R {simde_mm_mask_loadu_epi8(fill, mask, from)};
+               else if constexpr (sizeof(T) == 2) return R {simde_mm_mask_loadu_epi16(fill, mask, from)};
+               else if constexpr (sizeof(T) == 4) return R {simde_mm_mask_loadu_epi32(fill, mask, from)};
+               else                               return R {simde_mm_mask_loadu_epi64(fill, mask, from)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(AVX512VL) and LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if      constexpr (CT::Float<T>)   return R {simde_mm256_mask_loadu_ps(fill, mask, from)};
+               else if constexpr (CT::Double<T>)  return R {simde_mm256_mask_loadu_pd(fill, mask, from)};
+               else if constexpr (sizeof(T) == 1) return R {simde_mm256_mask_loadu_epi8(fill, mask, from)};
+               else if constexpr (sizeof(T) == 2) return R {simde_mm256_mask_loadu_epi16(fill, mask, from)};
+               else if constexpr (sizeof(T) == 4) return R {simde_mm256_mask_loadu_epi32(fill, mask, from)};
+               else                               return R {simde_mm256_mask_loadu_epi64(fill, mask, from)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if      constexpr (CT::Float<T>)   return R {simde_mm512_mask_loadu_ps(fill, mask, from)};
+               else if constexpr (CT::Double<T>)  return R {simde_mm512_mask_loadu_pd(fill, mask, from)};
+               else if constexpr (sizeof(T) == 1) return R {simde_mm512_mask_loadu_epi8(fill, mask, from)};
+               else if constexpr (sizeof(T) == 2) return R {simde_mm512_mask_loadu_epi16(fill, mask, from)};
+               else if constexpr (sizeof(T) == 4) return R {simde_mm512_mask_loadu_epi32(fill, mask, from)};
+               else                               return R {simde_mm512_mask_loadu_epi64(fill, mask, from)};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Store only the selected lanes of a register, without touching the   
+      /// memory of the others. Only AVX-512 has masked stores, see           
+      /// MaskedMemory                                                        
+      ///   @param to - where to store                                        
+      ///   @param mask - the selected lanes                                  
+      ///   @param from - the register to store                               
+      template<class T, CT::SIMD R> LANGULUS(INLINED)
+      void StoreMasked(T* to, NativeMask<CountOf<R>> mask, const R& from) noexcept {
+         static_assert(MaskedMemory<R>, "Masked stores need AVX-512");
+         #if LANGULUS_SIMD(AVX512VL)
+            if constexpr (CT::SIMD128<R>) {
+               if      constexpr (CT::Float<T>)   simde_mm_mask_storeu_ps(to, mask, from);
+               else if constexpr (CT::Double<T>)  simde_mm_mask_storeu_pd(to, mask, from);
+               else if constexpr (sizeof(T) == 1) simde_mm_mask_storeu_epi8(to, mask, from);
+               else if constexpr (sizeof(T) == 2) simde_mm_mask_storeu_epi16(to, mask, from);
+               else if constexpr (sizeof(T) == 4) simde_mm_mask_storeu_epi32(to, mask, from);
+               else                               simde_mm_mask_storeu_epi64(to, mask, from);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(AVX512VL) and LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if      constexpr (CT::Float<T>)   simde_mm256_mask_storeu_ps(to, mask, from);
+               else if constexpr (CT::Double<T>)  simde_mm256_mask_storeu_pd(to, mask, from);
+               else if constexpr (sizeof(T) == 1) simde_mm256_mask_storeu_epi8(to, mask, from);
+               else if constexpr (sizeof(T) == 2) simde_mm256_mask_storeu_epi16(to, mask, from);
+               else if constexpr (sizeof(T) == 4) simde_mm256_mask_storeu_epi32(to, mask, from);
+               else                               simde_mm256_mask_storeu_epi64(to, mask, from);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if      constexpr (CT::Float<T>)   simde_mm512_mask_storeu_ps(to, mask, from);
+               else if constexpr (CT::Double<T>)  simde_mm512_mask_storeu_pd(to, mask, from);
+               else if constexpr (sizeof(T) == 1) simde_mm512_mask_storeu_epi8(to, mask, from);
+               else if constexpr (sizeof(T) == 2) simde_mm512_mask_storeu_epi16(to, mask, from);
+               else if constexpr (sizeof(T) == 4) simde_mm512_mask_storeu_epi32(to, mask, from);
+               else                               simde_mm512_mask_storeu_epi64(to, mask, from);
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Apply an arithmetic kernel only to the elements selected by a mask  
+      ///   @tparam ZERO - whether to zero the unselected elements of 'out',  
+      ///      instead of keeping them                                        
+      ///   @tparam SAFE - whether to replace unselected elements of 'rhs'    
+      ///      with ones, so that they can't cause a division by zero         
+      ///   @param mask - a bit for each element                              
+      ///   @param lhs - left vector                                          
+      ///   @param rhs - right vector, of the same type                       
+      ///   @param out - output vector, of the same type                      
+      ///   @param opSIMD - the register kernel                               
+      ///   @param opFALL - routine for whole vectors, if no register is      
+      ///      supported                                                      
+      template<bool ZERO, bool SAFE, class LHS, class RHS, class OUT>
+      void MaskedArithmetic(
+         const CT::Bitmask auto& mask, const LHS& lhs, const RHS& rhs, OUT& out,
+         const auto& opSIMD, const auto& opFALL
+      ) {
+         using T = TypeOf<OUT>;
+         constexpr Count N = CountOf<OUT>;
+         static_assert(CT::Vector<OUT> and CT::Similar<LHS, OUT> and CT::Similar<RHS, OUT>,
+            "Masked operations work on vectors of the same type");
+         static_assert(CountOf<decltype(mask)> == N,
+            "Mask must have a bit for each element");
+
+         using R = decltype(Load<0>(lhs));
+         if constexpr (CT::SIMD<R> and CT::SIMD<InvocableResult2<decltype(opSIMD), R>>) {
+            using B = Bitmask<CountOf<R>>;
+            const auto m = MaskSIMD<R>(B {static_cast<typename B::Type>(mask.mValue)});
+            R r = Load<0>(rhs);
+            if constexpr (SAFE)
+               r = MergeSIMD(m, R {Fill<sizeof(R)>(T {1})}, r);
+
+            const R result = opSIMD(R {Load<0>(lhs)}, r);
+            if constexpr (ZERO)
+               Store(ZeroSIMD(m, result), out);
+            else
+               Store(MergeSIMD(m, R {Load<0>(out)}, result), out);
+         }
+         else {
+            // Compute all elements, and pick the selected ones         
+            RHS safe = rhs;
+            if constexpr (SAFE) {
+               for (Offset i = 0; i < N; ++i) {
+                  if (not mask[i])
+                     safe[i] = T {1};
+               }
+            }
+
+            const auto all = opFALL(lhs, safe);
+            for (Offset i = 0; i < N; ++i) {
+               if (mask[i])
+                  out[i] = static_cast<T>(all[i]);
+               else if constexpr (ZERO)
+                  out[i] = T {0};
+            }
+         }
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+} // namespace Langulus::SIMD
+
+/// Generate masked forms of an arithmetic routine in SIMD::Masked, that      
+/// use the Inner::OP##SIMD kernel, and SIMD::OP as a fallback. SAFE keeps    
+/// unselected elements of 'rhs' from causing a division by zero              
+///   Masked::OP(mask, lhs, rhs, out) updates only selected elements of out   
+///   Masked::OP(mask, lhs, rhs) returns zeroes in the unselected elements    
+#define LANGULUS_SIMD_MASKED_API(OP, SAFE) \
+   namespace Langulus::SIMD::Masked { \
+      template<class LHS, class RHS, class OUT> LANGULUS(INLINED) \
+      void OP(const CT::Bitmask auto& mask, const LHS& lhs, const RHS& rhs, OUT& out) { \
+         Inner::MaskedArithmetic<false, SAFE>(mask, lhs, rhs, out, \
+            []<class R>(const R& l, const R& r) { \
+               return Inner::OP##SIMD(l, r); \
+            }, \
+            []<class V>(const V& l, const V& r) { \
+               return SIMD::OP(l, r); \
+            } \
+         ); \
+      } \
+      template<class LHS, class RHS> NOD() LANGULUS(INLINED) \
+      LHS OP(const CT::Bitmask auto& mask, const LHS& lhs, const RHS& rhs) { \
+         LHS out; \
+         Inner::MaskedArithmetic<true, SAFE>(mask, lhs, rhs, out, \
+            []<class R>(const R& l, const R& r) { \
+               return Inner::OP##SIMD(l, r); \
+            }, \
+            []<class V>(const V& l, const V& r) { \
+               return SIMD::OP(l, r); \
+            } \
+         ); \
+         return out; \
+      } \
+   }
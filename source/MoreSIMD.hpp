@@ -36,7 +36,7 @@ namespace Langulus::SIMD
 
    /// Reverse order of bytes in each 32-bit word                             
    inline simde__m128i _mm_bswap_epi32(simde__m128i x) {
-#ifdef __SSSE3__
+#if LANGULUS_SIMD(SSSE3)
       return simde_mm_shuffle_epi8(x, simde_mm_set_epi8(
          12, 13, 14, 15,
          8, 9, 10, 11,
@@ -48,15 +48,15 @@ namespace Langulus::SIMD
       simde__m128i a = simde_mm_or_si128(simde_mm_slli_epi16(x, 8), simde_mm_srli_epi16(x, 8));
 
       // Then swap all 16-bit words                                     
-      a = simde_mm_shufflelo_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
-      a = simde_mm_shufflehi_epi16(a, _MM_SHUFFLE(2, 3, 0, 1));
+      a = simde_mm_shufflelo_epi16(a, SIMDE_MM_SHUFFLE(2, 3, 0, 1));
+      a = simde_mm_shufflehi_epi16(a, SIMDE_MM_SHUFFLE(2, 3, 0, 1));
       return a;
 #endif
    }
 
    /// Reverse order of bytes in each 64-bit word                             
    inline simde__m128i _mm_bswap_epi64(simde__m128i x) {
-#ifdef __SSSE3__
+#if LANGULUS_SIMD(SSSE3)
       return simde_mm_shuffle_epi8(x, simde_mm_set_epi8(
          8, 9, 10, 11,
          12, 13, 14, 15,
@@ -68,15 +68,15 @@ namespace Langulus::SIMD
       simde__m128i a = simde_mm_or_si128(simde_mm_slli_epi16(x, 8), simde_mm_srli_epi16(x, 8));
 
       // Reverse all 16-bit words in 64-bit halves                      
-      a = simde_mm_shufflelo_epi16(a, _MM_SHUFFLE(0, 1, 2, 3));
-      a = simde_mm_shufflehi_epi16(a, _MM_SHUFFLE(0, 1, 2, 3));
+      a = simde_mm_shufflelo_epi16(a, SIMDE_MM_SHUFFLE(0, 1, 2, 3));
+      a = simde_mm_shufflehi_epi16(a, SIMDE_MM_SHUFFLE(0, 1, 2, 3));
       return a;
 #endif
    }
 
    /// Reverse order of all bytes in the 128-bit word                         
    inline simde__m128i _mm_bswap_si128(simde__m128i x) {
-#ifdef __SSSE3__
+#if LANGULUS_SIMD(SSSE3)
       return simde_mm_shuffle_epi8(x, simde_mm_set_epi8(
          0, 1, 2, 3,
          4, 5, 6, 7,
@@ -88,11 +88,11 @@ namespace Langulus::SIMD
       simde__m128i a = simde_mm_or_si128(simde_mm_slli_epi16(x, 8), simde_mm_srli_epi16(x, 8));
 
       // Reverse all 16-bit words in 64-bit halves                      
-      a = simde_mm_shufflelo_epi16(a, _MM_SHUFFLE(0, 1, 2, 3));
-      a = simde_mm_shufflehi_epi16(a, _MM_SHUFFLE(0, 1, 2, 3));
+      a = simde_mm_shufflelo_epi16(a, SIMDE_MM_SHUFFLE(0, 1, 2, 3));
+      a = simde_mm_shufflehi_epi16(a, SIMDE_MM_SHUFFLE(0, 1, 2, 3));
 
       // Reverse 64-bit halves                                          
-      return simde_mm_shuffle_epi32(a, _MM_SHUFFLE(1, 0, 3, 2));
+      return simde_mm_shuffle_epi32(a, SIMDE_MM_SHUFFLE(1, 0, 3, 2));
 #endif
    }
 
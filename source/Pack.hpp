@@ -0,0 +1,370 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Masked.hpp"
+#include "converters/Policy.hpp"
+#include <limits>
+#include <utility>
+
+
+///                                                                           
+///   Narrowing registers                                                     
+///                                                                           
+/// Two registers of integers are packed into a single register of the same   
+/// width, with integers half the size - the first register goes into the     
+/// lower half, the second one into the upper half, in order. Doubles are     
+/// packed to floats the same way. The pack instructions of AVX/AVX2 work     
+/// inside 128bit lanes, so their results are permuted back in order, and     
+/// AVX-512 uses its own narrowing instructions instead.                      
+///                                                                           
+/// Integers that don't fit are truncated by default (ConvertPolicy::Wrap),   
+/// or clamped to the range of the smaller integer (ConvertPolicy::Saturate)  
+/// - signed integers to a signed range, unsigned ones to an unsigned range.  
+/// PackN packs 2, 4 or 8 registers in a tree of Pack calls, i.e. four        
+/// registers of 32bit integers into one register of 8bit integers            
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Element of half the size, with the same signedness                  
+      template<class T>
+      using PackedOf = Conditional<CT::Real<T>, simde_float32,
+         Conditional<CT::Signed<T>,
+            Conditional<sizeof(T) == 2, ::std::int8_t,
+            Conditional<sizeof(T) == 4, ::std::int16_t, ::std::int32_t>>,
+            Conditional<sizeof(T) == 2, ::std::uint8_t,
+            Conditional<sizeof(T) == 4, ::std::uint16_t, ::std::uint32_t>>
+         >
+      >;
+
+      /// Check if a register of T can be packed                              
+      template<class T>
+      constexpr bool Packable = CT::Double<T> or (CT::Integer<T>
+         and (sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8));
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Clamp 128bit registers of integers to the range of the smaller   
+         /// integer, so that they can be packed with truncation              
+         template<class T> NOD() LANGULUS(INLINED)
+         simde__m128i PackClamp(const simde__m128i& x) noexcept {
+            if constexpr (sizeof(T) == 2)
+               return simde_mm_min_epu16(x, simde_mm_set1_epi16(0xFF));
+            else if constexpr (sizeof(T) == 4)
+               return simde_mm_min_epu32(x, simde_mm_set1_epi32(0xFFFF));
+            else if constexpr (CT::Signed<T>) {
+               const auto lo = simde_mm_set1_epi64x(::std::numeric_limits<::std::int32_t>::min());
+               const auto hi = simde_mm_set1_epi64x(::std::numeric_limits<::std::int32_t>::max());
+               const auto y = simde_mm_blendv_epi8(x, hi, simde_mm_cmpgt_epi64(x, hi));
+               return simde_mm_blendv_epi8(y, lo, simde_mm_cmpgt_epi64(lo, y));
+            }
+            else {
+               // Anything with bits in the upper half saturates        
+               const auto fits = simde_mm_cmpeq_epi64(
+                  simde_mm_srli_epi64(x, 32), simde_mm_setzero_si128());
+               return simde_mm_or_si128(x, simde_mm_andnot_si128(fits,
+                  simde_mm_set1_epi64x(0xFFFFFFFF)));
+            }
+         }
+      #endif
+
+      #if LANGULUS_SIMD(256BIT)
+         /// Clamp 256bit registers of integers to the range of the smaller   
+         /// integer, so that they can be packed with truncation              
+         template<class T> NOD() LANGULUS(INLINED)
+         simde__m256i PackClamp(const simde__m256i& x) noexcept {
+            if constexpr (sizeof(T) == 2)
+               return simde_mm256_min_epu16(x, simde_mm256_set1_epi16(0xFF));
+            else if constexpr (sizeof(T) == 4)
+               return simde_mm256_min_epu32(x, simde_mm256_set1_epi32(0xFFFF));
+            else if constexpr (CT::Signed<T>) {
+               const auto lo = simde_mm256_set1_epi64x(::std::numeric_limits<::std::int32_t>::min());
+               const auto hi = simde_mm256_set1_epi64x(::std::numeric_limits<::std::int32_t>::max());
+               const auto y = simde_mm256_blendv_epi8(x, hi, simde_mm256_cmpgt_epi64(x, hi));
+               return simde_mm256_blendv_epi8(y, lo, simde_mm256_cmpgt_epi64(lo, y));
+            }
+            else {
+               // Anything with bits in the upper half saturates        
+               const auto fits = simde_mm256_cmpeq_epi64(
+                  simde_mm256_srli_epi64(x, 32), simde_mm256_setzero_si256());
+               return simde_mm256_or_si256(x, simde_mm256_andnot_si256(fits,
+                  simde_mm256_set1_epi64x(0xFFFFFFFF)));
+            }
+         }
+      #endif
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Pack two registers into one register of the same width, with           
+   /// elements half the size                                                 
+   ///   @tparam P - ConvertPolicy::Wrap to truncate integers that don't fit, 
+   ///      or ConvertPolicy::Saturate to clamp them (ignored for doubles)    
+   ///   @param lo - the register that goes into the lower half               
+   ///   @param hi - the register that goes into the upper half               
+   ///   @return the packed register                                          
+   template<ConvertPolicy P = ConvertPolicy::Wrap, CT::SIMD R>
+   requires Inner::Packable<TypeOf<R>> NOD() LANGULUS(INLINED)
+   auto Pack(const R& lo, const R& hi) noexcept {
+      using T = TypeOf<R>;
+      constexpr Count S = sizeof(T);
+      constexpr bool SATURATE = (static_cast<unsigned>(P) & 1) != 0;
+      constexpr bool UNSIGNED = CT::Integer<T> and not CT::Signed<T>;
+
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::SIMD128<R>) {
+            using TO = Inner::PackedOf<T>;
+            if constexpr (CT::Double<T>) {
+               return V128<TO> {simde_mm_movelh_ps(
+                  simde_mm_cvtpd_ps(lo), simde_mm_cvtpd_ps(hi))};
+            }
+            else if constexpr (S == 8) {
+               // Pick the lower halves of all 64bit integers           
+               const auto a = SATURATE ? Inner::PackClamp<T>(lo.m) : lo.m;
+               const auto b = SATURATE ? Inner::PackClamp<T>(hi.m) : hi.m;
+               return V128<TO> {simde_mm_castps_si128(simde_mm_shuffle_ps(
+                  simde_mm_castsi128_ps(a), simde_mm_castsi128_ps(b),
+                  SIMDE_MM_SHUFFLE(2, 0, 2, 0)))};
+            }
+            else if constexpr (SATURATE and not UNSIGNED) {
+               if constexpr (S == 2)
+                  return V128<TO> {simde_mm_packs_epi16(lo, hi)};
+               else
+                  return V128<TO> {simde_mm_packs_epi32(lo, hi)};
+            }
+            else {
+               // Bring all integers in the unsigned range first, so    
+               // that the unsigned saturation of packus doesn't kick in
+               const auto mask = S == 2
+                  ? simde_mm_set1_epi16(0xFF) : simde_mm_set1_epi32(0xFFFF);
+               const auto a = SATURATE ? Inner::PackClamp<T>(lo.m) : simde_mm_and_si128(lo, mask);
+               const auto b = SATURATE ? Inner::PackClamp<T>(hi.m) : simde_mm_and_si128(hi, mask);
+               if constexpr (S == 2)
+                  return V128<TO> {simde_mm_packus_epi16(a, b)};
+               else
+                  return V128<TO> {simde_mm_packus_epi32(a, b)};
+            }
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         if constexpr (CT::SIMD256<R>) {
+            using TO = Inner::PackedOf<T>;
+            if constexpr (CT::Double<T>) {
+               return V256<TO> {simde_mm256_insertf128_ps(
+                  simde_mm256_castps128_ps256(simde_mm256_cvtpd_ps(lo)),
+                  simde_mm256_cvtpd_ps(hi), 1)};
+            }
+            else {
+               simde__m256i r;
+               if constexpr (S == 8) {
+                  // Pick the lower halves of all 64bit integers        
+                  const auto a = SATURATE ? Inner::PackClamp<T>(lo.m) : lo.m;
+                  const auto b = SATURATE ? Inner::PackClamp<T>(hi.m) : hi.m;
+                  r = simde_mm256_castps_si256(simde_mm256_shuffle_ps(
+                     simde_mm256_castsi256_ps(a), simde_mm256_castsi256_ps(b),
+                     SIMDE_MM_SHUFFLE(2, 0, 2, 0)));
+               }
+               else if constexpr (SATURATE and not UNSIGNED) {
+                  if constexpr (S == 2)
+                     r = simde_mm256_packs_epi16(lo, hi);
+                  else
+                     r = simde_mm256_packs_epi32(lo, hi);
+               }
+               else {
+                  // Bring all integers in the unsigned range first, so 
+                  // that the unsigned saturation of packus doesn't     
+                  // kick in                                            
+                  const auto mask = S == 2
+                     ? simde_mm256_set1_epi16(0xFF) : simde_mm256_set1_epi32(0xFFFF);
+                  const auto a = SATURATE ? Inner::PackClamp<T>(lo.m) : simde_mm256_and_si256(lo, mask);
+                  const auto b = SATURATE ? Inner::PackClamp<T>(hi.m) : simde_mm256_and_si256(hi, mask);
+                  if constexpr (S == 2)
+                     r = simde_mm256_packus_epi16(a, b);
+                  else
+                     r = simde_mm256_packus_epi32(a, b);
+               }
+
+               // Packing works inside 128bit lanes, so the result is   
+               // {lo0, hi0, lo1, hi1} in 64bit parts - put them in order
+               return V256<TO> {simde_mm256_permute4x64_epi64(r, SIMDE_MM_SHUFFLE(3, 1, 2, 0))};
+            }
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(512BIT)
+         if constexpr (CT::SIMD512<R>) {
+            using TO = Inner::PackedOf<T>;
+            if constexpr (CT::Double<T>) {
+               return V512<TO> {simde_mm512_castpd_ps(simde_mm512_insertf64x4(
+                  simde_mm512_castpd256_pd512(simde_mm256_castps_pd(simde_mm512_cvtpd_ps(lo))),
+                  simde_mm256_castps_pd(simde_mm512_cvtpd_ps(hi)), 1))};
+            }
+            else {
+               // AVX-512 narrows a whole register to half a register   
+               const auto narrow = [](const simde__m512i& x) {
+                  if constexpr (S == 2) {
+                     if constexpr (not SATURATE) return simde_mm512_cvtepi16_epi8(x);
+                     else if constexpr (UNSIGNED) return simde_mm512_cvtusepi16_epi8(x);
+                     else                         return simde_mm512_cvtsepi16_epi8(x);
+                  }
+                  else if constexpr (S == 4) {
+                     if constexpr (not SATURATE) return simde_mm512_cvtepi32_epi16(x);
+                     else if constexpr (UNSIGNED) return simde_mm512_cvtusepi32_epi16(x);
+                     else                         return simde_mm512_cvtsepi32_epi16(x);
+                  }
+                  else {
+                     if constexpr (not SATURATE) return simde_mm512_cvtepi64_epi32(x);
+                     else if constexpr (UNSIGNED) return simde_mm512_cvtusepi64_epi32(x);
+                     else                         return simde_mm512_cvtsepi64_epi32(x);
+                  }
+               };
+
+               return V512<TO> {simde_mm512_inserti64x4(
+                  simde_mm512_castsi256_si512(narrow(lo)), narrow(hi), 1)};
+            }
+         }
+         else
+      #endif
+      static_assert(false, "Unsupported register");
+   }
+
+   /// Pack 2, 4 or 8 registers into one register of the same width, with     
+   /// elements that many times smaller, i.e. four registers of 32bit         
+   /// integers into one register of 8bit integers                            
+   ///   @tparam P - ConvertPolicy::Wrap to truncate integers that don't fit, 
+   ///      or ConvertPolicy::Saturate to clamp them                          
+   ///   @param r0 - the register that goes first                             
+   ///   @param rn - the rest of the registers, in order                      
+   ///   @return the packed register                                          
+   template<ConvertPolicy P = ConvertPolicy::Wrap, CT::SIMD R, CT::SIMD...RN>
+   requires (sizeof...(RN) == 1 or sizeof...(RN) == 3 or sizeof...(RN) == 7)
+        and (CT::Exact<R, RN> and ...)
+   NOD() LANGULUS(INLINED)
+   auto PackN(const R& r0, const RN&...rn) noexcept {
+      if constexpr (sizeof...(RN) == 1)
+         return Pack<P>(r0, rn...);
+      else {
+         // Pack each half, and then pack the halves together           
+         constexpr Count N = (sizeof...(RN) + 1) / 2;
+         const R all[] {r0, rn...};
+         return [&]<Offset...I>(::std::index_sequence<I...>) {
+            return Pack<P>(PackN<P>(all[I]...), PackN<P>(all[I + N]...));
+         }(::std::make_index_sequence<N> {});
+      }
+   }
+
+   namespace Inner
+   {
+
+      /// Clamp integers to the range they share with integers of the other   
+      /// signedness - signed ones from zero up, unsigned ones up to the      
+      /// biggest signed one - so that they can be reinterpreted as such      
+      ///   @param x - register of integers                                   
+      ///   @return the clamped register                                      
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R PackSign(const R& x) noexcept {
+         using T = TypeOf<R>;
+         constexpr Count S = sizeof(T);
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               const auto zero = simde_mm_setzero_si128();
+               if constexpr (CT::Signed<T>) {
+                  if      constexpr (S == 1) return R {simde_mm_max_epi8 (x, zero)};
+                  else if constexpr (S == 2) return R {simde_mm_max_epi16(x, zero)};
+                  else if constexpr (S == 4) return R {simde_mm_max_epi32(x, zero)};
+                  else return R {simde_mm_andnot_si128(simde_mm_cmpgt_epi64(zero, x), x)};
+               }
+               else {
+                  if      constexpr (S == 1) return R {simde_mm_min_epu8 (x, simde_mm_set1_epi8 (0x7F))};
+                  else if constexpr (S == 2) return R {simde_mm_min_epu16(x, simde_mm_set1_epi16(0x7FFF))};
+                  else if constexpr (S == 4) return R {simde_mm_min_epu32(x, simde_mm_set1_epi32(0x7FFFFFFF))};
+                  else {
+                     // The top bit is spread over the integer, and then
+                     // shifted out of the biggest signed integer       
+                     const auto top = simde_mm_cmpgt_epi64(zero, x);
+                     return R {simde_mm_or_si128(simde_mm_andnot_si128(top, x), simde_mm_srli_epi64(top, 1))};
+                  }
+               }
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               const auto zero = simde_mm256_setzero_si256();
+               if constexpr (CT::Signed<T>) {
+                  if      constexpr (S == 1) return R {simde_mm256_max_epi8 (x, zero)};
+                  else if constexpr (S == 2) return R {simde_mm256_max_epi16(x, zero)};
+                  else if constexpr (S == 4) return R {simde_mm256_max_epi32(x, zero)};
+                  else return R {simde_mm256_andnot_si256(simde_mm256_cmpgt_epi64(zero, x), x)};
+               }
+               else {
+                  if      constexpr (S == 1) return R {simde_mm256_min_epu8 (x, simde_mm256_set1_epi8 (0x7F))};
+                  else if constexpr (S == 2) return R {simde_mm256_min_epu16(x, simde_mm256_set1_epi16(0x7FFF))};
+                  else if constexpr (S == 4) return R {simde_mm256_min_epu32(x, simde_mm256_set1_epi32(0x7FFFFFFF))};
+                  else {
+                     const auto top = simde_mm256_cmpgt_epi64(zero, x);
+                     return R {simde_mm256_or_si256(simde_mm256_andnot_si256(top, x), simde_mm256_srli_epi64(top, 1))};
+                  }
+               }
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               const auto zero = simde_mm512_setzero_si512();
+               if constexpr (CT::Signed<T>) {
+                  if      constexpr (S == 1) return R {simde_mm512_max_epi8 (x, zero)};
+                  else if constexpr (S == 2) return R {simde_mm512_max_epi16(x, zero)};
+                  else if constexpr (S == 4) return R {simde_mm512_max_epi32(x, zero)};
+                  else                       return R {simde_mm512_max_epi64(x, zero)};
+               }
+               else {
+                  if      constexpr (S == 1) return R {simde_mm512_min_epu8 (x, simde_mm512_set1_epi8 (0x7F))};
+                  else if constexpr (S == 2) return R {simde_mm512_min_epu16(x, simde_mm512_set1_epi16(0x7FFF))};
+                  else if constexpr (S == 4) return R {simde_mm512_min_epu32(x, simde_mm512_set1_epi32(0x7FFFFFFF))};
+                  else return R {simde_mm512_min_epu64(x, simde_mm512_set1_epi64(::std::numeric_limits<::std::int64_t>::max()))};
+               }
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Narrow a register of integers to integers of TO, by packing it      
+      /// with zeroes as many times as it takes - the integers end up in the  
+      /// lower part of a register of the same width. Integers of the same    
+      /// size are only reinterpreted                                         
+      ///   @tparam TO - the integer to narrow to                             
+      ///   @tparam P - ConvertPolicy::Wrap to truncate integers that don't   
+      ///      fit, or ConvertPolicy::Saturate to clamp them to the range of  
+      ///      TO, even if it is of the other signedness                      
+      ///   @param x - register of integers                                   
+      ///   @return the narrowed register                                     
+      template<class TO, ConvertPolicy P, CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto PackTo(const R& x) noexcept {
+         using T = TypeOf<R>;
+         static_assert(sizeof(TO) <= sizeof(T), "Can't pack to a bigger integer");
+
+         if constexpr (ConvertSaturates<P> and CT::Signed<T> != CT::Signed<TO>) {
+            // Pack<P> keeps the signedness, so it is changed on the    
+            // side of the unsigned integers                            
+            if constexpr (CT::Signed<T>)
+               return PackTo<TO, P>(ReinterpretSIMD<::std::make_unsigned_t<T>>(PackSign(x)));
+            else
+               return ReinterpretSIMD<TO>(PackSign(PackTo<::std::make_unsigned_t<TO>, P>(x)));
+         }
+         else if constexpr (sizeof(T) == sizeof(TO))
+            return ReinterpretSIMD<TO>(x);
+         else
+            return PackTo<TO, P>(SIMD::Pack<P>(x, R::Zero()));
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+} // namespace Langulus::SIMD
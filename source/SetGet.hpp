@@ -142,7 +142,7 @@ namespace Langulus::SIMD
    ///   @tparam FROM - the scalar/array/vector to use for setting            
    ///   @param values - the array to wrap                                    
    ///   @return the register                                                 
-   template<auto DEF = 0, Offset CHUNK = Alignment, CT::Vector FROM>
+   template<auto DEF = 0, Offset CHUNK = WidestRegisterSize, CT::Vector FROM>
    LANGULUS(INLINED)
    auto Set(const FROM& values) noexcept {
       using T = TypeOf<FROM>;
@@ -46,16 +46,13 @@ namespace Langulus::SIMD
             else static_assert(false, "Unsupported type");
          }
          else if constexpr (CT::SIMD512<R>) {
-            if      constexpr (CT::Integer8<T>)    to = simde_mm512_movemask_epi8(from);
-            else if constexpr (CT::Integer16<T>) {
-               const auto lo_lane = simde_mm512_castsi512_si256(from);
-               const auto hi_lane = simde_mm512_extracti256_si512(from, 1);
-               StoreSIMD(simde_mm256_packs_epi16(lo_lane, hi_lane), to);
-            }
-            else if constexpr (CT::Integer32<T>)   to = simde_mm512_movemask_ps  (simde_mm512_castsi256_ps(from));
-            else if constexpr (CT::Integer64<T>)   to = simde_mm512_movemask_pd  (simde_mm512_castsi256_pd(from));
-            else if constexpr (CT::Float<T>)       to = simde_mm512_movemask_ps  (from);
-            else if constexpr (CT::Double<T>)      to = simde_mm512_movemask_pd  (from);
+            using TYPE = typename Deref<decltype(to)>::Type;
+            if      constexpr (CT::Integer8<T>)    to = static_cast<TYPE>(simde_mm512_movepi8_mask (from));
+            else if constexpr (CT::Integer16<T>)   to = static_cast<TYPE>(simde_mm512_movepi16_mask(from));
+            else if constexpr (CT::Integer32<T>)   to = static_cast<TYPE>(simde_mm512_movepi32_mask(from));
+            else if constexpr (CT::Integer64<T>)   to = static_cast<TYPE>(simde_mm512_movepi64_mask(from));
+            else if constexpr (CT::Float<T>)       to = static_cast<TYPE>(simde_mm512_movepi32_mask(simde_mm512_castps_si512(from)));
+            else if constexpr (CT::Double<T>)      to = static_cast<TYPE>(simde_mm512_movepi64_mask(simde_mm512_castpd_si512(from)));
             else static_assert(false, "Unsupported type");
          }
          else static_assert(false, "Unsupported register");
@@ -277,8 +274,9 @@ namespace Langulus::SIMD
          if constexpr (CT::Bitmask<FROM>) {
             // Extract from bitmask                                     
             if constexpr (CT::Bitmask<TO>) {
-               // Store in another bitmask                              
-               to = from;
+               // Store in another bitmask, that might be shorter, i.e. 
+               // when a 512bit comparison had unused lanes             
+               to = static_cast<typename TO::Type>(from.mValue);
             }
             else if constexpr (CT::Vector<TO>) {
                // Store each bit into an array of different type        
@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -101,3 +102,5 @@ namespace Langulus::SIMD
    LANGULUS_SIMD_ARITHMETHIC_API(Add)
 
 } // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(Add, false)
@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 #include "../Convert.hpp"
 #include "Equals.hpp"
 
@@ -92,16 +93,28 @@ namespace Langulus::SIMD
          }
          else if constexpr (CT::SIMD512<R>) {
             // Check if anything in 'rhs' is zero                       
-            if constexpr (CT::Integer<T>) {
-               if (EqualsSIMD(rhs, rhs.Zero()))
+            if constexpr (CT::Integer8<T>) {
+               if (simde_mm512_cmpeq_epi8_mask(rhs, rhs.Zero()))
+                  LANGULUS_THROW(DivisionByZero, "Division by zero");
+            }
+            else if constexpr (CT::Integer16<T>) {
+               if (simde_mm512_cmpeq_epi16_mask(rhs, rhs.Zero()))
+                  LANGULUS_THROW(DivisionByZero, "Division by zero");
+            }
+            else if constexpr (CT::Integer32<T>) {
+               if (simde_mm512_cmpeq_epi32_mask(rhs, rhs.Zero()))
+                  LANGULUS_THROW(DivisionByZero, "Division by zero");
+            }
+            else if constexpr (CT::Integer64<T>) {
+               if (simde_mm512_cmpeq_epi64_mask(rhs, rhs.Zero()))
                   LANGULUS_THROW(DivisionByZero, "Division by zero");
             }
             else if constexpr (CT::Float<T>) {
-               if (EqualsSIMD(rhs, rhs.Zero()))
+               if (simde_mm512_cmp_ps_mask(rhs, rhs.Zero(), SIMDE_CMP_EQ_OQ))
                   LANGULUS_THROW(DivisionByZero, "Division by zero");
             }
             else if constexpr (CT::Double<T>) {
-               if (EqualsSIMD(rhs, rhs.Zero()))
+               if (simde_mm512_cmp_pd_mask(rhs, rhs.Zero(), SIMDE_CMP_EQ_OQ))
                   LANGULUS_THROW(DivisionByZero, "Division by zero");
             }
             else static_assert(false, "Unsupported T");
@@ -208,3 +221,5 @@ namespace Langulus::SIMD
    }
 
 } // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(Divide, true)
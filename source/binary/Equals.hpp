@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -23,9 +24,9 @@ namespace Langulus::SIMD
       /// Compare two registers                                               
       ///   @param lhs - left register                                        
       ///   @param rhs - right register                                       
-      ///   @return the resulting register                                    
+      ///   @return the resulting register, or a bitmask for 512bit registers 
       template<CT::SIMD R> NOD() LANGULUS(INLINED)
-      R EqualsSIMD(R lhs, R rhs) noexcept {
+      CompareOf<R> EqualsSIMD(R lhs, R rhs) noexcept {
          using T = TypeOf<R>;
          (void)lhs; (void)rhs;
 
@@ -48,12 +49,12 @@ namespace Langulus::SIMD
             else static_assert(false, "Unsupported type");
          }
          else if constexpr (CT::SIMD512<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm512_cmpeq_epi8 (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm512_cmpeq_epi16(lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm512_cmpeq_epi32(lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm512_cmpeq_epi64(lhs, rhs);
-            else if constexpr (CT::Float<T>)       return simde_mm512_cmp_ps_mask(lhs, rhs, SIMDE_CMP_EQ_OQ);
-            else if constexpr (CT::Double<T>)      return simde_mm512_cmp_pd_mask(lhs, rhs, SIMDE_CMP_EQ_OQ);
+            if      constexpr (CT::Integer8<T>)  return AsBitmask<R>(simde_mm512_cmpeq_epi8_mask (lhs, rhs));
+            else if constexpr (CT::Integer16<T>) return AsBitmask<R>(simde_mm512_cmpeq_epi16_mask(lhs, rhs));
+            else if constexpr (CT::Integer32<T>) return AsBitmask<R>(simde_mm512_cmpeq_epi32_mask(lhs, rhs));
+            else if constexpr (CT::Integer64<T>) return AsBitmask<R>(simde_mm512_cmpeq_epi64_mask(lhs, rhs));
+            else if constexpr (CT::Float<T>)     return AsBitmask<R>(simde_mm512_cmp_ps_mask    (lhs, rhs, SIMDE_CMP_EQ_OQ));
+            else if constexpr (CT::Double<T>)    return AsBitmask<R>(simde_mm512_cmp_pd_mask    (lhs, rhs, SIMDE_CMP_EQ_OQ));
             else static_assert(false, "Unsupported type");
          }
          else static_assert(false, "Unsupported register");
@@ -7,6 +7,8 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
+#include "XOr.hpp"
 
 
 namespace Langulus::SIMD
@@ -20,40 +22,59 @@ namespace Langulus::SIMD
          return {};
       }
       
+      /// Flip the sign bit of unsigned integers, because SSE and AVX only    
+      /// compare signed ones, and the flip keeps their order                 
+      ///   @param x - the register                                           
+      ///   @return the register, that compares as signed                     
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SignedOrderSIMD(const R& x) noexcept {
+         using T = TypeOf<R>;
+         if constexpr (CT::Integer<T> and not CT::Signed<T>)
+            return XOrSIMD(x, R {Fill<sizeof(R)>(static_cast<T>(T {1} << (sizeof(T) * 8 - 1)))});
+         else
+            return x;
+      }
+
       /// Compare two registers                                               
       ///   @param lhs - left register                                        
       ///   @param rhs - right register                                       
-      ///   @return the resulting register                                    
+      ///   @return the resulting register, or a bitmask for 512bit registers 
+      ///   @attention SSE and AVX compare integers only as signed, so        
+      ///      128 and 256bit unsigned integers get their sign bit flipped    
       template<CT::SIMD R> NOD() LANGULUS(INLINED)
-      R GreaterSIMD(R lhs, R rhs) noexcept {
+      CompareOf<R> GreaterSIMD(R lhs, R rhs) noexcept {
          using T = TypeOf<R>;
          (void)lhs; (void)rhs;
          
          if constexpr (CT::SIMD128<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm_cmpgt_epi8    (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm_cmpgt_epi16   (lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm_cmpgt_epi32   (lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm_cmpgt_epi64   (lhs, rhs);
+            if      constexpr (CT::Integer8<T>)    return simde_mm_cmpgt_epi8    (SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Integer16<T>)   return simde_mm_cmpgt_epi16   (SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Integer32<T>)   return simde_mm_cmpgt_epi32   (SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Integer64<T>)   return simde_mm_cmpgt_epi64   (SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
             else if constexpr (CT::Float<T>)       return simde_mm_cmpgt_ps      (lhs, rhs);
             else if constexpr (CT::Double<T>)      return simde_mm_cmpgt_pd      (lhs, rhs);
             else static_assert(false, "Unsupported type for 16-byte package");
          }
          else if constexpr (CT::SIMD256<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm256_cmpgt_epi8 (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm256_cmpgt_epi16(lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm256_cmpgt_epi32(lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm256_cmpgt_epi64(lhs, rhs);
-            else if constexpr (CT::Float<T>)       return simde_mm256_cmpgt_ps   (lhs, rhs);
-            else if constexpr (CT::Double<T>)      return simde_mm256_cmpgt_pd   (lhs, rhs);
+            if      constexpr (CT::Integer8<T>)    return simde_mm256_cmpgt_epi8 (SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Integer16<T>)   return simde_mm256_cmpgt_epi16(SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Integer32<T>)   return simde_mm256_cmpgt_epi32(SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Integer64<T>)   return simde_mm256_cmpgt_epi64(SignedOrderSIMD(lhs), SignedOrderSIMD(rhs));
+            else if constexpr (CT::Float<T>)       return simde_mm256_cmp_ps     (lhs, rhs, SIMDE_CMP_GT_OQ);
+            else if constexpr (CT::Double<T>)      return simde_mm256_cmp_pd     (lhs, rhs, SIMDE_CMP_GT_OQ);
             else static_assert(false, "Unsupported type for 32-byte package");
          }
          else if constexpr (CT::SIMD512<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm512_cmpgt_epi8 (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm512_cmpgt_epi16(lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm512_cmpgt_epi32(lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm512_cmpgt_epi64(lhs, rhs);
-            else if constexpr (CT::Float<T>)       return simde_mm512_cmpgt_ps   (lhs, rhs);
-            else if constexpr (CT::Double<T>)      return simde_mm512_cmpgt_pd   (lhs, rhs);
+            if      constexpr (CT::SignedInteger8<T>)    return AsBitmask<R>(simde_mm512_cmpgt_epi8_mask (lhs, rhs));
+            else if constexpr (CT::UnsignedInteger8<T>)  return AsBitmask<R>(simde_mm512_cmpgt_epu8_mask (lhs, rhs));
+            else if constexpr (CT::SignedInteger16<T>)   return AsBitmask<R>(simde_mm512_cmpgt_epi16_mask(lhs, rhs));
+            else if constexpr (CT::UnsignedInteger16<T>) return AsBitmask<R>(simde_mm512_cmpgt_epu16_mask(lhs, rhs));
+            else if constexpr (CT::SignedInteger32<T>)   return AsBitmask<R>(simde_mm512_cmpgt_epi32_mask(lhs, rhs));
+            else if constexpr (CT::UnsignedInteger32<T>) return AsBitmask<R>(simde_mm512_cmpgt_epu32_mask(lhs, rhs));
+            else if constexpr (CT::SignedInteger64<T>)   return AsBitmask<R>(simde_mm512_cmpgt_epi64_mask(lhs, rhs));
+            else if constexpr (CT::UnsignedInteger64<T>) return AsBitmask<R>(simde_mm512_cmpgt_epu64_mask(lhs, rhs));
+            else if constexpr (CT::Float<T>)             return AsBitmask<R>(simde_mm512_cmp_ps_mask    (lhs, rhs, SIMDE_CMP_GT_OQ));
+            else if constexpr (CT::Double<T>)            return AsBitmask<R>(simde_mm512_cmp_pd_mask    (lhs, rhs, SIMDE_CMP_GT_OQ));
             else static_assert(false, "Unsupported type for 64-byte package");
          }
          else static_assert(false, "Unsupported type");
@@ -7,6 +7,8 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
+#include "Greater.hpp"
 
 
 namespace Langulus::SIMD
@@ -23,37 +25,37 @@ namespace Langulus::SIMD
       /// Compare two registers                                               
       ///   @param lhs - left register                                        
       ///   @param rhs - right register                                       
-      ///   @return the resulting register                                    
+      ///   @return the resulting register, or a bitmask for 512bit registers 
+      ///   @attention SSE and AVX compare integers only for greater, so      
+      ///      128 and 256bit integers are compared with swapped arguments    
       template<CT::SIMD R> NOD() LANGULUS(INLINED)
-      R LesserSIMD(R lhs, R rhs) noexcept {
+      CompareOf<R> LesserSIMD(R lhs, R rhs) noexcept {
          using T = TypeOf<R>;
          (void)lhs; (void)rhs;
          
          if constexpr (CT::SIMD128<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm_cmplt_epi8    (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm_cmplt_epi16   (lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm_cmplt_epi32   (lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm_cmplt_epi64   (lhs, rhs);
+            if      constexpr (CT::Integer<T>)     return GreaterSIMD           (rhs, lhs);
             else if constexpr (CT::Float<T>)       return simde_mm_cmplt_ps      (lhs, rhs);
             else if constexpr (CT::Double<T>)      return simde_mm_cmplt_pd      (lhs, rhs);
             else static_assert(false, "Unsupported type for 16-byte package");
          }
          else if constexpr (CT::SIMD256<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm256_cmplt_epi8 (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm256_cmplt_epi16(lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm256_cmplt_epi32(lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm256_cmplt_epi64(lhs, rhs);
-            else if constexpr (CT::Float<T>)       return simde_mm256_cmplt_ps   (lhs, rhs);
-            else if constexpr (CT::Double<T>)      return simde_mm256_cmplt_pd   (lhs, rhs);
+            if      constexpr (CT::Integer<T>)     return GreaterSIMD           (rhs, lhs);
+            else if constexpr (CT::Float<T>)       return simde_mm256_cmp_ps     (lhs, rhs, SIMDE_CMP_LT_OQ);
+            else if constexpr (CT::Double<T>)      return simde_mm256_cmp_pd     (lhs, rhs, SIMDE_CMP_LT_OQ);
             else static_assert(false, "Unsupported type for 32-byte package");
          }
          else if constexpr (CT::SIMD512<R>) {
-            if      constexpr (CT::Integer8<T>)    return simde_mm512_cmplt_epi8 (lhs, rhs);
-            else if constexpr (CT::Integer16<T>)   return simde_mm512_cmplt_epi16(lhs, rhs);
-            else if constexpr (CT::Integer32<T>)   return simde_mm512_cmplt_epi32(lhs, rhs);
-            else if constexpr (CT::Integer64<T>)   return simde_mm512_cmplt_epi64(lhs, rhs);
-            else if constexpr (CT::Float<T>)       return simde_mm512_cmplt_ps   (lhs, rhs);
-            else if constexpr (CT::Double<T>)      return simde_mm512_cmplt_pd   (lhs, rhs);
+            if      constexpr (CT::SignedInteger8<T>)    return AsBitmask<R>(simde_mm512_cmplt_epi8_mask (lhs, rhs));
+            else if constexpr (CT::UnsignedInteger8<T>)  return AsBitmask<R>(simde_mm512_cmplt_epu8_mask (lhs, rhs));
+            else if constexpr (CT::SignedInteger16<T>)   return AsBitmask<R>(simde_mm512_cmplt_epi16_mask(lhs, rhs));
+            else if constexpr (CT::UnsignedInteger16<T>) return AsBitmask<R>(simde_mm512_cmplt_epu16_mask(lhs, rhs));
+            else if constexpr (CT::SignedInteger32<T>)   return AsBitmask<R>(simde_mm512_cmplt_epi32_mask(lhs, rhs));
+            else if constexpr (CT::UnsignedInteger32<T>) return AsBitmask<R>(simde_mm512_cmplt_epu32_mask(lhs, rhs));
+            else if constexpr (CT::SignedInteger64<T>)   return AsBitmask<R>(simde_mm512_cmplt_epi64_mask(lhs, rhs));
+            else if constexpr (CT::UnsignedInteger64<T>) return AsBitmask<R>(simde_mm512_cmplt_epu64_mask(lhs, rhs));
+            else if constexpr (CT::Float<T>)             return AsBitmask<R>(simde_mm512_cmp_ps_mask    (lhs, rhs, SIMDE_CMP_LT_OQ));
+            else if constexpr (CT::Double<T>)            return AsBitmask<R>(simde_mm512_cmp_pd_mask    (lhs, rhs, SIMDE_CMP_LT_OQ));
             else static_assert(false, "Unsupported type for 64-byte package");
          }
          else static_assert(false, "Unsupported type");
@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -38,7 +39,7 @@ namespace Langulus::SIMD
             else if constexpr (CT::UnsignedInteger32<T>) return R {simde_mm_min_epu32   (lhs, rhs)};
             else if constexpr (CT::SignedInteger64<T>) {
                #if LANGULUS_SIMD(AVX512)
-                  return R {_mm_min_epi64(lhs, rhs)};
+                  return R {simde_mm_min_epi64(lhs, rhs)};
                #else
                   return Unsupported{};
                #endif
@@ -63,14 +64,14 @@ namespace Langulus::SIMD
             else if constexpr (CT::UnsignedInteger32<T>) return R {simde_mm256_min_epu32(lhs, rhs)};
             else if constexpr (CT::SignedInteger64<T>) {
                #if LANGULUS_SIMD(AVX512)
-                  return R {_mm_min_epi64(lhs, rhs)};
+                  return R {simde_mm256_min_epi64(lhs, rhs)};
                #else
                   return Unsupported{};
                #endif
             }
             else if constexpr (CT::UnsignedInteger64<T>) {
                #if LANGULUS_SIMD(AVX512)
-                  return R {_mm_min_epu64(lhs, rhs)};
+                  return R {simde_mm256_min_epu64(lhs, rhs)};
                #else
                   return Unsupported{};
                #endif
@@ -131,3 +132,5 @@ namespace Langulus::SIMD
    LANGULUS_SIMD_ARITHMETHIC_API(Min)
 
 } // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(Min, false)
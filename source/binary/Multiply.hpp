@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -167,3 +168,5 @@ namespace Langulus::SIMD
    LANGULUS_SIMD_ARITHMETHIC_API(Multiply)
 
 } // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(Multiply, false)
@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -188,4 +189,6 @@ namespace Langulus::SIMD
 
    LANGULUS_SIMD_ARITHMETHIC_API(Power)
 
-} // namespace Langulus::SIMD
\ No newline at end of file
+} // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(Power, false)
@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -107,6 +108,35 @@ namespace Langulus::SIMD
          else static_assert(false, "Unsupported type for SIMD::ShiftRightInner");
       }
       
+      /// Shift right by an immediate - unlike ShiftRightSIMD, this needs no more
+      /// than SSE2 for integers of 16 bits and more                          
+      ///   @tparam N - the number of bits to shift by                        
+      ///   @param lhs - the register                                         
+      ///   @return the shifted register                                      
+      template<int N, CT::SIMD R> NOD() LANGULUS(INLINED)
+      R ShiftRightBySIMD(const R& lhs) noexcept {
+         using T = TypeOf<R>;
+         static_assert(CT::IntegerX<T> and sizeof(T) > 1,
+            "Can only shift 16, 32 or 64bit integers by an immediate");
+
+         if constexpr (CT::SIMD128<R>) {
+            if      constexpr (CT::Integer16<T>)         return R {simde_mm_srli_epi16(lhs, N)};
+            else if constexpr (CT::Integer32<T>)         return R {simde_mm_srli_epi32(lhs, N)};
+            else                                         return R {simde_mm_srli_epi64(lhs, N)};
+         }
+         else if constexpr (CT::SIMD256<R>) {
+            if      constexpr (CT::Integer16<T>)         return R {simde_mm256_srli_epi16(lhs, N)};
+            else if constexpr (CT::Integer32<T>)         return R {simde_mm256_srli_epi32(lhs, N)};
+            else                                         return R {simde_mm256_srli_epi64(lhs, N)};
+         }
+         else if constexpr (CT::SIMD512<R>) {
+            if      constexpr (CT::Integer16<T>)         return R {simde_mm512_srli_epi16(lhs, N)};
+            else if constexpr (CT::Integer32<T>)         return R {simde_mm512_srli_epi32(lhs, N)};
+            else                                         return R {simde_mm512_srli_epi64(lhs, N)};
+         }
+         else static_assert(false, "Unsupported type for SIMD::ShiftRightBySIMD");
+      }
+      
       /// Bitwise right shift values as constexpr, if possible                
       ///   @attention this differs from C++'s undefined behavior when        
       ///      shifting by less than zero, or by a number larger than the     
@@ -162,4 +192,6 @@ namespace Langulus::SIMD
 
    LANGULUS_SIMD_ARITHMETHIC_API(ShiftRight)
 
-} // namespace Langulus::SIMD
\ No newline at end of file
+} // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(ShiftRight, false)
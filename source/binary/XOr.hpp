@@ -7,6 +7,7 @@
 ///                                                                           
 #pragma once
 #include "../Attempt.hpp"
+#include "../Masked.hpp"
 
 
 namespace Langulus::SIMD
@@ -85,4 +86,6 @@ namespace Langulus::SIMD
 
    LANGULUS_SIMD_ARITHMETHIC_API(XOr)
 
-} // namespace Langulus::SIMD
\ No newline at end of file
+} // namespace Langulus::SIMD
+
+LANGULUS_SIMD_MASKED_API(XOr, false)
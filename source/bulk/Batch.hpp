@@ -0,0 +1,611 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "ConvertHalf.hpp"
+#include "../binary/Add.hpp"
+#include "../binary/Subtract.hpp"
+#include "../binary/Multiply.hpp"
+#include "../binary/Divide.hpp"
+#include "../binary/Min.hpp"
+#include "../binary/Max.hpp"
+#include "../binary/Equals.hpp"
+#include "../binary/Lesser.hpp"
+#include "../binary/Greater.hpp"
+#include "../binary/EqualsOrLesser.hpp"
+#include "../binary/EqualsOrGreater.hpp"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+
+///                                                                           
+///   Batched operations on many small vectors                                
+///                                                                           
+/// Calling SIMD::Add on two Vector<float, 4> loads them in a single 128bit   
+/// register, even if 512bit registers are available. The batch routines      
+/// instead treat a span of tightly packed vectors as one flat array of       
+/// elements, and pack as many vectors as possible in the widest register,    
+/// i.e. four Vector<float, 4> per V512. The same register kernels are used   
+/// (AddSIMD, LesserSIMD, etc.), so results match the per-vector routines     
+/// On AVX-512 the remainder goes through masked loads and stores, instead    
+/// of being copied into a padded register. PreferredWidth narrows the        
+/// registers at runtime, i.e. to avoid 512bit instructions                   
+/// Inputs are prefetched by BulkPrefetch, or by a policy given to each       
+/// routine. TunePrefetch picks the fastest BulkPrefetch for the machine,     
+/// when it's called explicitly, i.e. from a benchmark                        
+/// Outputs of at least StreamThreshold bytes are written around the caches   
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Get the element type of a span of scalars or packed vectors         
+      template<class V>
+      consteval auto BatchElement() {
+         if constexpr (CT::Vector<V>) {
+            static_assert(sizeof(V) == sizeof(TypeOf<V>) * CountOf<V>,
+               "Vectors must be tightly packed");
+            return (TypeOf<V>*) nullptr;
+         }
+         else return (V*) nullptr;
+      }
+
+      /// Check if a register kernel has an implementation for register R     
+      /// 512bit comparisons give bitmasks instead of registers               
+      template<class R, class F>
+      constexpr bool BatchSupports = CT::SIMD<InvocableResult2<F, R>>
+                                  or CT::Bitmask<InvocableResult2<F, R>>;
+
+      /// Run a kernel on less than a register worth of elements, by padding  
+      /// the register with DEF, the same way Load does it                    
+      ///   @tparam DEF - value to fill the unused lanes with                 
+      ///   @tparam R - the register to use                                   
+      template<auto DEF, CT::SIMD R, class T, class F> LANGULUS(INLINED)
+      void BatchPadded(
+         const T* lhs, const T* rhs, T* out, Count count, F& op
+      ) {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         if (not count)
+            return;
+
+         T l[L], r[L], o[L];
+         ::std::fill_n(l, L, static_cast<T>(DEF));
+         ::std::fill_n(r, L, static_cast<T>(DEF));
+         ::std::copy_n(lhs, count, l);
+         ::std::copy_n(rhs, count, r);
+         StoreUnaligned(o, op(LoadUnaligned<R>(l), LoadUnaligned<R>(r)));
+         ::std::copy_n(o, count, out);
+      }
+
+      /// Run a kernel on less than a register worth of elements, with        
+      /// masked loads and stores - unused lanes are filled with DEF, and     
+      /// never read from or written to memory                                
+      ///   @tparam DEF - value to fill the unused lanes with                 
+      ///   @tparam R - the register to use, must support MaskedMemory        
+      template<auto DEF, CT::SIMD R, class T, class F> LANGULUS(INLINED)
+      void BatchMasked(
+         const T* lhs, const T* rhs, T* out, Count count, F& op
+      ) {
+         if (not count)
+            return;
+
+         const auto mask = FirstLanes<R>(count);
+         const R fill = Fill<sizeof(R)>(static_cast<T>(DEF));
+         StoreMasked(out, mask, R {op(
+            LoadMasked<R>(lhs, mask, fill),
+            LoadMasked<R>(rhs, mask, fill)
+         )});
+      }
+
+      /// Run a kernel on as many full registers as possible. Outputs of at   
+      /// least StreamThreshold bytes are written around the caches, after    
+      /// padding a few elements to align the output                          
+      ///   @tparam DEF - value to fill the unused lanes with                 
+      ///   @tparam R - the register to use                                   
+      ///   @param lhs - left elements                                        
+      ///   @param rhs - right elements                                       
+      ///   @param out - output elements                                      
+      ///   @param i - the first element to process                           
+      ///   @param count - number of elements in total                        
+      ///   @param op - the register kernel                                   
+      ///   @param prefetch - how to prefetch the inputs                      
+      ///   @return the first element that wasn't processed                   
+      template<auto DEF, CT::SIMD R, class T, class F> LANGULUS(INLINED)
+      Offset BatchStream(
+         const T* lhs, const T* rhs, T* out, Offset i, Count count, F& op,
+         const PrefetchPolicy& prefetch
+      ) {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         const Count misaligned = reinterpret_cast<::std::uintptr_t>(out + i) % sizeof(R);
+         if (count * sizeof(T) >= StreamThreshold and misaligned % sizeof(T) == 0) {
+            // Pad the elements until the output is aligned, and then   
+            // stream the rest around the caches                        
+            const Count head = misaligned
+               ? ::std::min((sizeof(R) - misaligned) / sizeof(T), count - i) : 0;
+            BatchPadded<DEF, R>(lhs + i, rhs + i, out + i, head, op);
+            i = BulkWalk<L>({lhs, rhs}, i + head, count, prefetch, [&](Offset at) {
+               StoreBulk<true>(out + at, R {op(
+                  LoadUnaligned<R>(lhs + at),
+                  LoadUnaligned<R>(rhs + at)
+               )});
+            });
+            StreamFence();
+            return i;
+         }
+
+         return BulkWalk<L>({lhs, rhs}, i, count, prefetch, [&](Offset at) {
+            StoreUnaligned(out + at, op(
+               LoadUnaligned<R>(lhs + at),
+               LoadUnaligned<R>(rhs + at)
+            ));
+         });
+      }
+
+      /// Stream flat elements through the widest supported registers, that   
+      /// aren't wider than PreferredWidth, unless nothing narrower supports  
+      /// the kernel. The remainder goes through masked loads and stores if   
+      /// AVX-512 allows it, or through the narrowest supported register      
+      ///   @tparam DEF - value to fill the unused lanes with                 
+      ///   @param lhs - left elements                                        
+      ///   @param rhs - right elements                                       
+      ///   @param out - output elements                                      
+      ///   @param count - number of elements                                 
+      ///   @param op - the register kernel                                   
+      ///   @param prefetch - how to prefetch the inputs                      
+      ///   @return false if no register supports the kernel for T            
+      template<auto DEF, class T, class F>
+      bool BatchArithmetic(
+         const T* lhs, const T* rhs, T* out, Count count, F&& op,
+         const PrefetchPolicy& prefetch
+      ) {
+         (void) lhs; (void) rhs; (void) out; (void) count; (void) op; (void) prefetch;
+         Offset i = 0;
+         (void) i;
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (BatchSupports<V512<T>, F>) {
+               if (PreferredWidth >= 512 or not BatchSupports<V256<T>, F>) {
+                  i = BatchStream<DEF, V512<T>>(lhs, rhs, out, i, count, op, prefetch);
+                  BatchMasked<DEF, V512<T>>(lhs + i, rhs + i, out + i, count - i, op);
+                  return true;
+               }
+            }
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (BatchSupports<V256<T>, F>) {
+               if (PreferredWidth >= 256 or not BatchSupports<V128<T>, F>) {
+                  i = BatchStream<DEF, V256<T>>(lhs, rhs, out, i, count, op, prefetch);
+                  if constexpr (MaskedMemory<V256<T>>) {
+                     BatchMasked<DEF, V256<T>>(lhs + i, rhs + i, out + i, count - i, op);
+                     return true;
+                  }
+               }
+            }
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (BatchSupports<V128<T>, F>) {
+               i = BatchStream<DEF, V128<T>>(lhs, rhs, out, i, count, op, prefetch);
+               if constexpr (MaskedMemory<V128<T>>)
+                  BatchMasked<DEF, V128<T>>(lhs + i, rhs + i, out + i, count - i, op);
+               else
+                  BatchPadded<DEF, V128<T>>(lhs + i, rhs + i, out + i, count - i, op);
+               return true;
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (BatchSupports<V256<T>, F>) {
+               BatchPadded<DEF, V256<T>>(lhs + i, rhs + i, out + i, count - i, op);
+               return true;
+            }
+            else
+         #endif
+         return false;
+      }
+
+      /// Run an arithmetic kernel on half-precision elements, by widening    
+      /// them to floats in small chunks, and narrowing the results back      
+      /// The chunks are small enough to stay in cache, so they're never      
+      /// prefetched                                                          
+      ///   @tparam DEF - value to fill the unused lanes with                 
+      ///   @param lhs - left elements                                        
+      ///   @param rhs - right elements                                       
+      ///   @param out - output elements                                      
+      ///   @param count - number of elements                                 
+      ///   @param op - the register kernel                                   
+      ///   @param fallback - scalar routine, if no register is supported     
+      template<auto DEF, CT::Half H, class F, class FALL>
+      void BatchHalf(
+         const H* lhs, const H* rhs, H* out, Count count, F&& op, FALL&& fallback
+      ) {
+         constexpr Count CHUNK = 256;
+         float l[CHUNK], r[CHUNK], o[CHUNK];
+         for (Offset i = 0; i < count; i += CHUNK) {
+            const Count n = ::std::min(CHUNK, count - i);
+            WidenHalves(lhs + i, l, n);
+            WidenHalves(rhs + i, r, n);
+            if (not BatchArithmetic<DEF>(l, r, o, n, op, PrefetchPolicy {})) {
+               for (Offset j = 0; j < n; ++j)
+                  o[j] = fallback(l[j], r[j]);
+            }
+            NarrowHalves(o, out + i, n);
+         }
+      }
+
+      ///                                                                     
+      ///   Packs a stream of register comparison masks into bitmasks         
+      /// Each output bitmask gets N consecutive bits, regardless of how      
+      /// vectors are split between registers                                 
+      ///                                                                     
+      template<Count N>
+      struct BatchMaskWriter {
+         static_assert(N <= 32, "Vector too large to batch");
+
+         Bitmask<N>* mTo;
+         ::std::uint64_t mBits = 0;
+         Count mFill = 0;
+
+         /// Append the lowest 'count' bits of 'bits'                         
+         LANGULUS(INLINED)
+         void Push(::std::uint64_t bits, Count count) noexcept {
+            mBits |= (bits & ((::std::uint64_t {1} << count) - 1)) << mFill;
+            mFill += count;
+            while (mFill >= N) {
+               *mTo++ = Bitmask<N> {static_cast<typename Bitmask<N>::Type>(
+                  mBits & ((::std::uint64_t {1} << N) - 1))};
+               mBits >>= N;
+               mFill -= N;
+            }
+         }
+
+         /// Append the comparison mask of a register                         
+         template<Count L>
+         LANGULUS(INLINED)
+         void Push(const CT::SIMD auto& reg, Count count = L) noexcept {
+            Bitmask<L> mask;
+            StoreSIMD(reg, mask);
+            Push<L>(mask, count);
+         }
+
+         /// Append a comparison bitmask, i.e. of a 512bit register           
+         template<Count L>
+         LANGULUS(INLINED)
+         void Push(const Bitmask<L>& mask, Count count = L) noexcept {
+            using TYPE = typename Bitmask<L>::Type;
+            const auto bits = static_cast<::std::make_unsigned_t<TYPE>>(mask.mValue);
+            if constexpr (L > 32) {
+               // Push in halves, so that pending bits don't overflow   
+               Push(bits, ::std::min<Count>(count, 32));
+               if (count > 32)
+                  Push(bits >> 32, count - 32);
+            }
+            else Push(bits, count);
+         }
+      };
+
+      /// Compare as many full registers as possible                          
+      ///   @tparam R - the register to use                                   
+      ///   @return the first element that wasn't processed                   
+      template<CT::SIMD R, class T, Count N, class F> LANGULUS(INLINED)
+      Offset BatchCompareStream(
+         const T* lhs, const T* rhs, BatchMaskWriter<N>& out,
+         Offset i, Count count, F& op, const PrefetchPolicy& prefetch
+      ) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         return BulkWalk<L>({lhs, rhs}, i, count, prefetch, [&](Offset at) {
+            out.template Push<L>(op(
+               LoadUnaligned<R>(lhs + at),
+               LoadUnaligned<R>(rhs + at)
+            ));
+         });
+      }
+
+      /// Compare less than a register worth of elements                      
+      ///   @tparam R - the register to use                                   
+      template<CT::SIMD R, class T, Count N, class F> LANGULUS(INLINED)
+      void BatchComparePadded(
+         const T* lhs, const T* rhs, BatchMaskWriter<N>& out,
+         Count count, F& op
+      ) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         if (not count)
+            return;
+
+         T l[L] {}, r[L] {};
+         ::std::copy_n(lhs, count, l);
+         ::std::copy_n(rhs, count, r);
+         out.template Push<L>(op(LoadUnaligned<R>(l), LoadUnaligned<R>(r)), count);
+      }
+
+      /// Compare less than a register worth of elements, with masked loads   
+      ///   @tparam R - the register to use, must support MaskedMemory        
+      template<CT::SIMD R, class T, Count N, class F> LANGULUS(INLINED)
+      void BatchCompareMasked(
+         const T* lhs, const T* rhs, BatchMaskWriter<N>& out,
+         Count count, F& op
+      ) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         if (not count)
+            return;
+
+         const auto mask = FirstLanes<R>(count);
+         const R zero = R::Zero();
+         out.template Push<L>(op(
+            LoadMasked<R>(lhs, mask, zero),
+            LoadMasked<R>(rhs, mask, zero)
+         ), count);
+      }
+
+      /// Compare flat elements through the widest supported registers, that  
+      /// aren't wider than PreferredWidth, unless nothing narrower supports  
+      /// the kernel. 512bit comparisons give bitmasks directly. The          
+      /// remainder goes through masked loads if AVX-512 allows it            
+      ///   @tparam N - number of elements per output bitmask                 
+      ///   @param lhs - left elements                                        
+      ///   @param rhs - right elements                                       
+      ///   @param out - output bitmasks, one per N elements                  
+      ///   @param count - number of elements                                 
+      ///   @param op - the register kernel                                   
+      ///   @param prefetch - how to prefetch the inputs                      
+      ///   @return false if no register supports the kernel for T            
+      template<Count N, class T, class F>
+      bool BatchCompare(
+         const T* lhs, const T* rhs, Bitmask<N>* out, Count count, F&& op,
+         const PrefetchPolicy& prefetch
+      ) noexcept {
+         (void) lhs; (void) rhs; (void) count; (void) op; (void) prefetch;
+         BatchMaskWriter<N> writer {out};
+         Offset i = 0;
+         (void) writer; (void) i;
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (BatchSupports<V512<T>, F>) {
+               if (PreferredWidth >= 512 or not BatchSupports<V256<T>, F>) {
+                  i = BatchCompareStream<V512<T>>(lhs, rhs, writer, i, count, op, prefetch);
+                  BatchCompareMasked<V512<T>>(lhs + i, rhs + i, writer, count - i, op);
+                  return true;
+               }
+            }
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (BatchSupports<V256<T>, F>) {
+               if (PreferredWidth >= 256 or not BatchSupports<V128<T>, F>) {
+                  i = BatchCompareStream<V256<T>>(lhs, rhs, writer, i, count, op, prefetch);
+                  if constexpr (MaskedMemory<V256<T>>) {
+                     BatchCompareMasked<V256<T>>(lhs + i, rhs + i, writer, count - i, op);
+                     return true;
+                  }
+               }
+            }
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (BatchSupports<V128<T>, F>) {
+               i = BatchCompareStream<V128<T>>(lhs, rhs, writer, i, count, op, prefetch);
+               if constexpr (MaskedMemory<V128<T>>)
+                  BatchCompareMasked<V128<T>>(lhs + i, rhs + i, writer, count - i, op);
+               else
+                  BatchComparePadded<V128<T>>(lhs + i, rhs + i, writer, count - i, op);
+               return true;
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (BatchSupports<V256<T>, F>) {
+               BatchComparePadded<V256<T>>(lhs + i, rhs + i, writer, count - i, op);
+               return true;
+            }
+            else
+         #endif
+         return false;
+      }
+
+      /// Validate batch arguments and get their flat element pointers        
+      ///   @param lhs - left span                                            
+      ///   @param rhs - right span                                           
+      ///   @param out - output span                                          
+      ///   @return the number of vectors in the batch                        
+      LANGULUS(INLINED)
+      Count BatchCount(const auto& lhs, const auto& rhs, const auto& out) {
+         LANGULUS_ASSUME(UserAssumes, lhs.size() == rhs.size(),
+            "Batch size mismatch");
+         LANGULUS_ASSUME(UserAssumes, out.size() >= lhs.size(),
+            "Batch output is too short");
+         (void) rhs; (void) out;
+         return lhs.size();
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   namespace Batch
+   {
+
+      /// Apply an arithmetic kernel to a batch of vectors                    
+      ///   @tparam DEF - value to fill the unused lanes with                 
+      ///   @param lhs - left vectors or scalars                              
+      ///   @param rhs - right vectors or scalars, same type and count        
+      ///   @param out - output span, at least as long as 'lhs'               
+      ///   @param opSIMD - the register kernel                               
+      ///   @param opFALL - per vector routine, if no register is supported   
+      ///   @param prefetch - how to prefetch the inputs                      
+      template<auto DEF, class LHS, class RHS, class OUT>
+      void Arithmetic(
+         const LHS& lhs, const RHS& rhs, OUT&& out,
+         const auto& opSIMD, const auto& opFALL,
+         const PrefetchPolicy& prefetch = BulkPrefetch
+      ) {
+         const ::std::span l {lhs};
+         const ::std::span r {rhs};
+         const ::std::span o {out};
+         using V = Decvq<typename decltype(l)::element_type>;
+         using T = Deptr<decltype(Inner::BatchElement<V>())>;
+         static_assert(CT::Similar<V, typename decltype(r)::element_type>
+                   and CT::Exact<V, typename decltype(o)::element_type>,
+            "Batch spans must be of the same type, and output must be mutable");
+
+         const Count count = Inner::BatchCount(l, r, o);
+         constexpr Count N = sizeof(V) / sizeof(T);
+         if constexpr (CT::Half<T>) {
+            // Half-precision math is done in floats                    
+            Inner::BatchHalf<DEF>(
+               reinterpret_cast<const T*>(l.data()),
+               reinterpret_cast<const T*>(r.data()),
+               reinterpret_cast<T*>(o.data()),
+               count * N, opSIMD, opFALL
+            );
+         }
+         else {
+            if (Inner::BatchArithmetic<DEF>(
+               reinterpret_cast<const T*>(l.data()),
+               reinterpret_cast<const T*>(r.data()),
+               reinterpret_cast<T*>(o.data()),
+               count * N, opSIMD, prefetch
+            )) return;
+
+            for (Offset i = 0; i < count; ++i)
+               o[i] = opFALL(l[i], r[i]);
+         }
+      }
+
+      /// Apply a comparison kernel to a batch of vectors                     
+      ///   @param lhs - left vectors or scalars                              
+      ///   @param rhs - right vectors or scalars, same type and count        
+      ///   @param out - span of Bitmask<N>, one for each vector              
+      ///   @param opSIMD - the register kernel                               
+      ///   @param opFALL - per vector routine, if no register is supported   
+      ///   @param prefetch - how to prefetch the inputs                      
+      template<class LHS, class RHS, class OUT>
+      void Compare(
+         const LHS& lhs, const RHS& rhs, OUT&& out,
+         const auto& opSIMD, const auto& opFALL,
+         const PrefetchPolicy& prefetch = BulkPrefetch
+      ) {
+         const ::std::span l {lhs};
+         const ::std::span r {rhs};
+         const ::std::span o {out};
+         using V = Decvq<typename decltype(l)::element_type>;
+         using T = Deptr<decltype(Inner::BatchElement<V>())>;
+         constexpr Count N = sizeof(V) / sizeof(T);
+         static_assert(CT::Similar<V, typename decltype(r)::element_type>,
+            "Batch spans must be of the same type");
+         static_assert(CT::Exact<Bitmask<N>, typename decltype(o)::element_type>,
+            "Batch comparisons output one Bitmask<N> per vector");
+
+         static_assert(not CT::Half<T>,
+            "Widen half-precision batches to float, before comparing them");
+
+         const Count count = Inner::BatchCount(l, r, o);
+         if (Inner::BatchCompare<N>(
+            reinterpret_cast<const T*>(l.data()),
+            reinterpret_cast<const T*>(r.data()),
+            o.data(), count * N, opSIMD, prefetch
+         )) return;
+
+         for (Offset i = 0; i < count; ++i)
+            o[i] = opFALL(l[i], r[i]);
+      }
+
+   } // namespace Langulus::SIMD::Batch
+
+} // namespace Langulus::SIMD
+
+/// Generate a batched arithmetic routine in SIMD::Batch, that uses the       
+/// Inner::OP##SIMD kernel, and SIMD::OP as a fallback. Inputs are            
+/// prefetched by BulkPrefetch, unless another policy is given                
+#define LANGULUS_SIMD_BATCH_ARITHMETIC_API(OP, DEF) \
+   namespace Langulus::SIMD::Batch { \
+      template<class LHS, class RHS, class OUT> LANGULUS(INLINED) \
+      void OP(const LHS& lhs, const RHS& rhs, OUT&& out, \
+         const PrefetchPolicy& prefetch = BulkPrefetch \
+      ) { \
+         Arithmetic<DEF>(lhs, rhs, out, \
+            []<class R>(const R& l, const R& r) { \
+               return Inner::OP##SIMD(l, r); \
+            }, \
+            []<class V>(const V& l, const V& r) { \
+               return SIMD::OP(l, r); \
+            }, prefetch \
+         ); \
+      } \
+   }
+
+/// Generate a batched comparison routine in SIMD::Batch, that uses the       
+/// Inner::OP##SIMD kernel, and SIMD::OP as a fallback. Inputs are            
+/// prefetched by BulkPrefetch, unless another policy is given                
+#define LANGULUS_SIMD_BATCH_COMPARE_API(OP) \
+   namespace Langulus::SIMD::Batch { \
+      template<class LHS, class RHS, class OUT> LANGULUS(INLINED) \
+      void OP(const LHS& lhs, const RHS& rhs, OUT&& out, \
+         const PrefetchPolicy& prefetch = BulkPrefetch \
+      ) { \
+         Compare(lhs, rhs, out, \
+            []<class R>(const R& l, const R& r) noexcept { \
+               return Inner::OP##SIMD(l, r); \
+            }, \
+            []<class V>(const V& l, const V& r) { \
+               return SIMD::OP(l, r); \
+            }, prefetch \
+         ); \
+      } \
+   }
+
+LANGULUS_SIMD_BATCH_ARITHMETIC_API(Add, 0)
+LANGULUS_SIMD_BATCH_ARITHMETIC_API(Subtract, 0)
+LANGULUS_SIMD_BATCH_ARITHMETIC_API(Multiply, 1)
+LANGULUS_SIMD_BATCH_ARITHMETIC_API(Divide, 1)
+LANGULUS_SIMD_BATCH_ARITHMETIC_API(Min, 0)
+LANGULUS_SIMD_BATCH_ARITHMETIC_API(Max, 0)
+LANGULUS_SIMD_BATCH_COMPARE_API(Equals)
+LANGULUS_SIMD_BATCH_COMPARE_API(Lesser)
+LANGULUS_SIMD_BATCH_COMPARE_API(Greater)
+LANGULUS_SIMD_BATCH_COMPARE_API(EqualsOrLesser)
+LANGULUS_SIMD_BATCH_COMPARE_API(EqualsOrGreater)
+
+namespace Langulus::SIMD
+{
+
+   /// Pick the fastest prefetch policy for this machine, by timing batched   
+   /// additions over inputs much bigger than the caches, and make it the     
+   /// default BulkPrefetch. Meant to be run once, i.e. by a benchmark, and   
+   /// not while other threads run bulk routines - batches never run it by    
+   /// themselves                                                             
+   ///   @param count - number of floats in each input, 64MB by default       
+   ///   @return the chosen policy                                            
+   inline PrefetchPolicy TunePrefetch(Count count = 16 * 1024 * 1024) {
+      using Clock = ::std::chrono::steady_clock;
+      const ::std::vector<float> lhs(count, 1.0f), rhs(count, 2.0f);
+      ::std::vector<float> out(count);
+
+      PrefetchPolicy best {};
+      auto bestTime = Clock::duration::max();
+      for (bool nonTemporal : {false, true}) {
+         for (Count distance : {0, 2, 4, 8, 16, 32}) {
+            if (nonTemporal and not distance)
+               continue;
+
+            // The fastest of a few runs, after a warm-up one           
+            const PrefetchPolicy policy {distance, nonTemporal};
+            Batch::Add(lhs, rhs, out, policy);
+            auto time = Clock::duration::max();
+            for (int run = 0; run < 3; ++run) {
+               const auto start = Clock::now();
+               Batch::Add(lhs, rhs, out, policy);
+               time = ::std::min(time, Clock::now() - start);
+            }
+
+            if (time < bestTime) {
+               bestTime = time;
+               best = policy;
+            }
+         }
+      }
+
+      BulkPrefetch = best;
+      return best;
+   }
+
+} // namespace Langulus::SIMD
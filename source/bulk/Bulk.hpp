@@ -0,0 +1,298 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "../Common.hpp"
+#include <cstdint>
+#include <initializer_list>
+#include <span>
+
+
+///                                                                           
+///   Common tools for the bulk routines                                      
+///                                                                           
+/// Bulk routines operate on whole spans of elements, instead of a single     
+/// scalar/vector. They stream the data through the widest available          
+/// register, up to LANGULUS_SIMD_PREFER_WIDTH bits, and handle the remaining 
+/// elements conventionally. Outputs bigger than StreamThreshold are written  
+/// with non-temporal stores, that go around the caches, and inputs can be    
+/// prefetched by a PrefetchPolicy                                            
+///                                                                           
+namespace Langulus::SIMD
+{
+
+   /// How bulk routines prefetch their inputs, ahead of the hardware         
+   /// prefetcher. The hardware keeps up with plain sequential reads on most  
+   /// machines, so prefetching is off by default - see TunePrefetch for      
+   /// picking a policy on the target machine                                 
+   struct PrefetchPolicy {
+      // How many cache lines ahead to prefetch, zero disables it       
+      Count mDistance = 0;
+      // Prefetch with a non-temporal hint, for inputs that are read    
+      // only once, so that they don't evict other data from the caches 
+      bool mNonTemporal = true;
+   };
+
+   /// The policy used by bulk routines, unless they're given another one     
+   inline PrefetchPolicy BulkPrefetch {};
+
+   /// Bulk routines switch to non-temporal stores for outputs of at least    
+   /// this many bytes. Such outputs don't fit in the last level cache, so    
+   /// caching them would only evict data that is still needed, and would     
+   /// read each line from memory just to overwrite it. Set it to a good      
+   /// part of the last level cache of the target machine                     
+   inline Count StreamThreshold = 16 * 1024 * 1024;
+
+   /// The widest register batched routines use, in bits. It can only narrow  
+   /// LANGULUS_SIMD_PREFER_WIDTH at runtime - the wider registers are never  
+   /// compiled in. Lower it to 256 on CPUs that drop their clock when        
+   /// running 512bit instructions, if the workload is latency-sensitive.     
+   /// The narrower registers still use AVX-512VL masked loads and stores     
+   inline Count PreferredWidth = LANGULUS_SIMD_PREFER_WIDTH;
+
+} // namespace Langulus::SIMD
+
+namespace Langulus::SIMD::Inner
+{
+
+   /// Load a full register from unaligned memory                             
+   ///   @tparam R - the register to load                                     
+   ///   @param from - the memory to load from                                
+   ///   @return the loaded register                                          
+   template<CT::SIMD R> NOD() LANGULUS(INLINED)
+   R LoadUnaligned(const void* from) noexcept {
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::SIMD128<R>) {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Float<T>)   return R {simde_mm_loadu_ps(static_cast<const simde_float32*>(from))};
+            else if constexpr (CT::Double<T>)  return R {simde_mm_loadu_pd(static_cast<const simde_float64*>(from))};
+            else if constexpr (CT::Integer<T>) return R {simde_mm_loadu_si128(from)};
+            else static_assert(false, "Unsupported element");
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         if constexpr (CT::SIMD256<R>) {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Float<T>)   return R {simde_mm256_loadu_ps(static_cast<const simde_float32*>(from))};
+            else if constexpr (CT::Double<T>)  return R {simde_mm256_loadu_pd(static_cast<const simde_float64*>(from))};
+            else if constexpr (CT::Integer<T>) return R {simde_mm256_loadu_si256(from)};
+            else static_assert(false, "Unsupported element");
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(512BIT)
+         if constexpr (CT::SIMD512<R>) {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Float<T>)   return R {simde_mm512_loadu_ps(from)};
+            else if constexpr (CT::Double<T>)  return R {simde_mm512_loadu_pd(from)};
+            else if constexpr (CT::Integer<T>) return R {simde_mm512_loadu_si512(from)};
+            else static_assert(false, "Unsupported element");
+         }
+         else
+      #endif
+      static_assert(false, "Unsupported register");
+   }
+
+   /// Store a full register to unaligned memory                              
+   ///   @param to - the memory to store to                                   
+   ///   @param from - the register to store                                  
+   template<CT::SIMD R> LANGULUS(INLINED)
+   void StoreUnaligned(void* to, const R& from) noexcept {
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::SIMD128<R>) {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Float<T>)   simde_mm_storeu_ps(static_cast<simde_float32*>(to), from);
+            else if constexpr (CT::Double<T>)  simde_mm_storeu_pd(static_cast<simde_float64*>(to), from);
+            else if constexpr (CT::Integer<T>) simde_mm_storeu_si128(to, from);
+            else static_assert(false, "Unsupported element");
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         if constexpr (CT::SIMD256<R>) {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Float<T>)   simde_mm256_storeu_ps(static_cast<simde_float32*>(to), from);
+            else if constexpr (CT::Double<T>)  simde_mm256_storeu_pd(static_cast<simde_float64*>(to), from);
+            else if constexpr (CT::Integer<T>) simde_mm256_storeu_si256(to, from);
+            else static_assert(false, "Unsupported element");
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(512BIT)
+         if constexpr (CT::SIMD512<R>) {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Float<T>)   simde_mm512_storeu_ps(to, from);
+            else if constexpr (CT::Double<T>)  simde_mm512_storeu_pd(to, from);
+            else if constexpr (CT::Integer<T>) simde_mm512_storeu_si512(to, from);
+            else static_assert(false, "Unsupported element");
+         }
+         else
+      #endif
+      static_assert(false, "Unsupported register");
+   }
+
+   /// Size of a cache line, the unit of prefetching                          
+   constexpr Count CacheLine = 64;
+
+   /// Hint that the cache line at an address will be read soon               
+   ///   @tparam NONTEMPORAL - whether the line will be read only once        
+   ///   @param at - the address, that is never dereferenced                  
+   template<bool NONTEMPORAL> LANGULUS(INLINED)
+   void PrefetchLine(const void* at) noexcept {
+      #if LANGULUS_SIMD(128BIT)
+         simde_mm_prefetch(static_cast<const char*>(at),
+            NONTEMPORAL ? SIMDE_MM_HINT_NTA : SIMDE_MM_HINT_T0);
+      #else
+         (void) at;
+      #endif
+   }
+
+   /// Walk over the inputs L elements at a time, prefetching each of them    
+   /// by policy, while there's something ahead to prefetch                   
+   ///   @tparam L - number of elements processed by each step                
+   ///   @tparam NONTEMPORAL - whether to use a non-temporal hint             
+   ///   @param inputs - the inputs, all walked at the same offsets           
+   ///   @param i - the first element to process                              
+   ///   @param count - number of elements in total                           
+   ///   @param distance - how many cache lines ahead to prefetch             
+   ///   @param step - invoked with the first element of each step            
+   ///   @return the first element that wasn't processed                      
+   template<Count L, bool NONTEMPORAL, class T> LANGULUS(INLINED)
+   Offset PrefetchWalk(
+      ::std::initializer_list<const T*> inputs, Offset i, Count count,
+      Count distance, auto&& step
+   ) {
+      // Each cache line is prefetched once, and then processed         
+      constexpr Count LINE = CacheLine / sizeof(T) > L ? CacheLine / sizeof(T) : L;
+      const Count ahead = distance * LINE;
+      for (; i + ahead + LINE <= count; i += LINE) {
+         for (auto input : inputs)
+            PrefetchLine<NONTEMPORAL>(input + i + ahead);
+         for (Offset j = 0; j < LINE; j += L)
+            step(i + j);
+      }
+      return i;
+   }
+
+   /// Walk over the inputs L elements at a time, as long as there are at     
+   /// least L elements left, prefetching by policy                           
+   ///   @tparam L - number of elements processed by each step                
+   ///   @param inputs - the inputs, all walked at the same offsets           
+   ///   @param i - the first element to process                              
+   ///   @param count - number of elements in total                           
+   ///   @param prefetch - the prefetch policy                                
+   ///   @param step - invoked with the first element of each step            
+   ///   @return the first element that wasn't processed                      
+   template<Count L, class T> LANGULUS(INLINED)
+   Offset BulkWalk(
+      ::std::initializer_list<const T*> inputs, Offset i, Count count,
+      const PrefetchPolicy& prefetch, auto&& step
+   ) {
+      if (prefetch.mDistance) {
+         i = prefetch.mNonTemporal
+            ? PrefetchWalk<L, true>(inputs, i, count, prefetch.mDistance, step)
+            : PrefetchWalk<L, false>(inputs, i, count, prefetch.mDistance, step);
+      }
+
+      for (; i + L <= count; i += L)
+         step(i);
+      return i;
+   }
+
+   /// Store a full register to memory, around the caches if STREAM is set    
+   ///   @tparam STREAM - whether to use a non-temporal store, in which case  
+   ///      'to' must be aligned to the size of the register                  
+   ///   @param to - the memory to store to                                   
+   ///   @param from - the register to store                                  
+   template<bool STREAM, CT::SIMD R> LANGULUS(INLINED)
+   void StoreBulk(void* to, const R& from) noexcept {
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::SIMD128<R>) {
+            using T = TypeOf<R>;
+            if constexpr (CT::Float<T>) {
+               if constexpr (STREAM) simde_mm_stream_ps(static_cast<simde_float32*>(to), from);
+               else                  simde_mm_storeu_ps(static_cast<simde_float32*>(to), from);
+            }
+            else if constexpr (CT::Double<T>) {
+               if constexpr (STREAM) simde_mm_stream_pd(static_cast<simde_float64*>(to), from);
+               else                  simde_mm_storeu_pd(static_cast<simde_float64*>(to), from);
+            }
+            else {
+               if constexpr (STREAM) simde_mm_stream_si128(static_cast<simde__m128i*>(to), from);
+               else                  simde_mm_storeu_si128(to, from);
+            }
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         if constexpr (CT::SIMD256<R>) {
+            using T = TypeOf<R>;
+            if constexpr (CT::Float<T>) {
+               if constexpr (STREAM) simde_mm256_stream_ps(static_cast<simde_float32*>(to), from);
+               else                  simde_mm256_storeu_ps(static_cast<simde_float32*>(to), from);
+            }
+            else if constexpr (CT::Double<T>) {
+               if constexpr (STREAM) simde_mm256_stream_pd(static_cast<simde_float64*>(to), from);
+               else                  simde_mm256_storeu_pd(static_cast<simde_float64*>(to), from);
+            }
+            else {
+               if constexpr (STREAM) simde_mm256_stream_si256(static_cast<simde__m256i*>(to), from);
+               else                  simde_mm256_storeu_si256(to, from);
+            }
+         }
+         else
+      #endif
+      #if LANGULUS_SIMD(512BIT)
+         if constexpr (CT::SIMD512<R>) {
+            using T = TypeOf<R>;
+            if constexpr (CT::Float<T>) {
+               if constexpr (STREAM) simde_mm512_stream_ps(static_cast<simde_float32*>(to), from);
+               else                  simde_mm512_storeu_ps(to, from);
+            }
+            else if constexpr (CT::Double<T>) {
+               if constexpr (STREAM) simde_mm512_stream_pd(static_cast<simde_float64*>(to), from);
+               else                  simde_mm512_storeu_pd(to, from);
+            }
+            else {
+               if constexpr (STREAM) simde_mm512_stream_si512(static_cast<simde__m512i*>(to), from);
+               else                  simde_mm512_storeu_si512(to, from);
+            }
+         }
+         else
+      #endif
+      static_assert(false, "Unsupported register");
+   }
+
+} // namespace Langulus::SIMD::Inner
+
+namespace Langulus::SIMD
+{
+
+   /// Store a register to memory with a non-temporal store, that goes        
+   /// around the caches - for outputs that won't be read again soon          
+   ///   @attention call StreamFence() after the last of them, before the     
+   ///      stored data is read by other threads                              
+   ///   @param from - the register to store                                  
+   ///   @param to - the memory to store to, aligned to the register's size   
+   LANGULUS(INLINED)
+   void StreamStore(const CT::SIMD auto& from, void* to) {
+      LANGULUS_ASSUME(UserAssumes,
+         reinterpret_cast<::std::uintptr_t>(to) % sizeof(from) == 0,
+         "Streamed memory must be aligned to the register's size");
+      Inner::StoreBulk<true>(to, from);
+   }
+
+   /// Order all non-temporal stores before any stores that follow            
+   LANGULUS(INLINED)
+   void StreamFence() noexcept {
+      #if LANGULUS_SIMD(128BIT)
+         simde_mm_sfence();
+      #endif
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,432 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Bitmask.hpp"
+#include "../Masked.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+
+
+///                                                                           
+///   Stream compaction                                                       
+///                                                                           
+/// Compress packs the elements selected by a mask at the start of the        
+/// output, and Expand does the opposite - it scatters consecutive inputs     
+/// to the selected places of the output, leaving the rest untouched.         
+///                                                                           
+/// Masks are consumed 64 elements at a time, as a 64bit word, and each       
+/// word is split into groups of lanes. AVX-512 compresses/expands 32bit      
+/// and 64bit lanes natively, in 256bit registers too if 512bit ones aren't   
+/// preferred. Otherwise a group is permuted through a lookup table indexed   
+/// by its bits - byte shuffles for 128bit registers, and 32bit permutations  
+/// for 256bit ones. 8bit and 16bit elements always go in groups of eight,    
+/// so that their tables stay small.                                          
+///                                                                           
+/// Whole groups are written (and read) even if only a part of them is        
+/// needed, as long as they fit in the spans - the rest is done one element   
+/// at a time                                                                 
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Number of lanes handled at once for elements of size S              
+      template<Count S>
+      constexpr Count CompressGroup =
+         #if LANGULUS_SIMD(512BIT)
+            S >= 4 ? 64 / S : 8;
+         #elif LANGULUS_SIMD(256BIT)
+            S >= 4 ? 32 / S : 8;
+         #else
+            S >= 4 ? 16 / S : 8;
+         #endif
+
+      /// Byte shuffles for every mask of G lanes, B bytes each               
+      /// Compression moves the selected lanes to the bottom, expansion moves 
+      /// the bottom lanes to the selected places                             
+      template<Count G, Count B, bool EXPAND>
+      consteval auto CompressBytes() {
+         ::std::array<::std::array<::std::uint8_t, 16>, (1 << G)> result {};
+         for (Offset mask = 0; mask < (1 << G); ++mask) {
+            Offset w = 0;
+            for (Offset i = 0; i < G; ++i) {
+               if (not ((mask >> i) & 1))
+                  continue;
+               for (Offset b = 0; b < B; ++b) {
+                  if constexpr (EXPAND)
+                     result[mask][i * B + b] = static_cast<::std::uint8_t>(w * B + b);
+                  else
+                     result[mask][w * B + b] = static_cast<::std::uint8_t>(i * B + b);
+               }
+               ++w;
+            }
+         }
+         return result;
+      }
+
+      /// 32bit permutations for every mask of G lanes, packed in nibbles     
+      template<Count G, bool EXPAND>
+      consteval auto CompressDwords() {
+         ::std::array<::std::uint32_t, (1 << G)> result {};
+         constexpr Count D = 8 / G;
+         for (Offset mask = 0; mask < (1 << G); ++mask) {
+            Offset w = 0;
+            for (Offset i = 0; i < G; ++i) {
+               if (not ((mask >> i) & 1))
+                  continue;
+               for (Offset d = 0; d < D; ++d) {
+                  if constexpr (EXPAND)
+                     result[mask] |= static_cast<::std::uint32_t>(w * D + d) << (4 * (i * D + d));
+                  else
+                     result[mask] |= static_cast<::std::uint32_t>(i * D + d) << (4 * (w * D + d));
+               }
+               ++w;
+            }
+         }
+         return result;
+      }
+
+      template<Count G, Count B, bool EXPAND>
+      constexpr auto CompressBytesTable = CompressBytes<G, B, EXPAND>();
+      template<Count G, bool EXPAND>
+      constexpr auto CompressDwordsTable = CompressDwords<G, EXPAND>();
+
+      /// Unsigned integer of S bytes, to handle elements as register lanes   
+      template<Count S>
+      using CompressLane = Conditional<S == 1, ::std::uint8_t,
+                           Conditional<S == 2, ::std::uint16_t,
+                           Conditional<S == 4, ::std::uint32_t,
+                                               ::std::uint64_t>>>;
+
+      /// Write the elements of a group, selected by the mask, to the start   
+      /// of the output. The whole group is written                           
+      ///   @tparam S - size of an element in bytes                           
+      ///   @param in - the group                                             
+      ///   @param mask - a bit for each element of the group                 
+      ///   @param out - where to write, room for the whole group             
+      template<Count S> LANGULUS(INLINED)
+      void CompressStep(const void* in, unsigned mask, void* out) noexcept {
+         constexpr Count G = CompressGroup<S>;
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (S >= 4) {
+               const auto x = simde_mm512_loadu_si512(in);
+               if constexpr (S == 4)
+                  simde_mm512_mask_compressstoreu_epi32(out, static_cast<simde__mmask16>(mask), x);
+               else
+                  simde_mm512_mask_compressstoreu_epi64(out, static_cast<simde__mmask8>(mask), x);
+            }
+            else
+         #elif LANGULUS_SIMD(256BIT) and LANGULUS_SIMD(AVX512VL)
+            if constexpr (S >= 4) {
+               const auto x = simde_mm256_loadu_si256(in);
+               if constexpr (S == 4)
+                  simde_mm256_mask_compressstoreu_epi32(out, static_cast<simde__mmask8>(mask), x);
+               else
+                  simde_mm256_mask_compressstoreu_epi64(out, static_cast<simde__mmask8>(mask), x);
+            }
+            else
+         #elif LANGULUS_SIMD(256BIT)
+            if constexpr (S >= 4) {
+               const auto nibbles = simde_mm256_srlv_epi32(
+                  simde_mm256_set1_epi32(static_cast<int>(CompressDwordsTable<G, false>[mask])),
+                  simde_mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28)
+               );
+               simde_mm256_storeu_si256(out, simde_mm256_permutevar8x32_epi32(
+                  simde_mm256_loadu_si256(in), nibbles));
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+         {
+            const auto shuffle = simde_mm_loadu_si128(CompressBytesTable<G, S, false>[mask].data());
+            if constexpr (S == 1) {
+               simde_mm_storel_epi64(static_cast<simde__m128i*>(out), simde_mm_shuffle_epi8(
+                  simde_mm_loadl_epi64(static_cast<const simde__m128i*>(in)), shuffle));
+            }
+            else {
+               simde_mm_storeu_si128(out, simde_mm_shuffle_epi8(
+                  simde_mm_loadu_si128(in), shuffle));
+            }
+         }
+         #else
+            static_assert(false, "Unsupported register");
+         #endif
+      }
+
+      /// Write the first elements of a group to the places of another group, 
+      /// selected by the mask. The other places keep their elements          
+      ///   @tparam S - size of an element in bytes                           
+      ///   @param in - the group to read, whole                              
+      ///   @param mask - a bit for each element of the output group          
+      ///   @param out - the output group                                     
+      template<Count S> LANGULUS(INLINED)
+      void ExpandStep(const void* in, unsigned mask, void* out) noexcept {
+         constexpr Count G = CompressGroup<S>;
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (S >= 4) {
+               const auto x = simde_mm512_loadu_si512(in);
+               const auto old = simde_mm512_loadu_si512(out);
+               if constexpr (S == 4)
+                  simde_mm512_storeu_si512(out, simde_mm512_mask_expand_epi32(old, static_cast<simde__mmask16>(mask), x));
+               else
+                  simde_mm512_storeu_si512(out, simde_mm512_mask_expand_epi64(old, static_cast<simde__mmask8>(mask), x));
+            }
+            else
+         #elif LANGULUS_SIMD(256BIT) and LANGULUS_SIMD(AVX512VL)
+            if constexpr (S >= 4) {
+               const auto x = simde_mm256_loadu_si256(in);
+               const auto old = simde_mm256_loadu_si256(out);
+               if constexpr (S == 4)
+                  simde_mm256_storeu_si256(out, simde_mm256_mask_expand_epi32(old, static_cast<simde__mmask8>(mask), x));
+               else
+                  simde_mm256_storeu_si256(out, simde_mm256_mask_expand_epi64(old, static_cast<simde__mmask8>(mask), x));
+            }
+            else
+         #elif LANGULUS_SIMD(256BIT)
+            if constexpr (S >= 4) {
+               const auto nibbles = simde_mm256_srlv_epi32(
+                  simde_mm256_set1_epi32(static_cast<int>(CompressDwordsTable<G, true>[mask])),
+                  simde_mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28)
+               );
+               using R = V256<CompressLane<S>>;
+               simde_mm256_storeu_si256(out, MergeSIMD<R>(
+                  MaskSIMD<R>(AsBitmask<R>(mask)),
+                  R {simde_mm256_loadu_si256(out)},
+                  R {simde_mm256_permutevar8x32_epi32(simde_mm256_loadu_si256(in), nibbles)}
+               ));
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+         {
+            using R = V128<CompressLane<S>>;
+            const auto shuffle = simde_mm_loadu_si128(CompressBytesTable<G, S, true>[mask].data());
+            const auto lanes = MaskSIMD<R>(AsBitmask<R>(mask));
+            if constexpr (S == 1) {
+               const auto x = simde_mm_loadl_epi64(static_cast<const simde__m128i*>(in));
+               const auto old = simde_mm_loadl_epi64(static_cast<const simde__m128i*>(out));
+               simde_mm_storel_epi64(static_cast<simde__m128i*>(out), MergeSIMD<R>(
+                  lanes, R {old}, R {simde_mm_shuffle_epi8(x, shuffle)}));
+            }
+            else {
+               simde_mm_storeu_si128(out, MergeSIMD<R>(lanes,
+                  R {simde_mm_loadu_si128(out)},
+                  R {simde_mm_shuffle_epi8(simde_mm_loadu_si128(in), shuffle)}));
+            }
+         }
+         #else
+            static_assert(false, "Unsupported register");
+         #endif
+      }
+
+      /// Mask of the first n bits of a word                                  
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint64_t CompressFirst(Count n) noexcept {
+         return n >= 64 ? ~::std::uint64_t {0} : (::std::uint64_t {1} << n) - 1;
+      }
+
+      /// Get a bit for each non-zero byte                                    
+      ///   @param mask - the bytes, i.e. bools                               
+      ///   @param n - number of bytes, up to 64                              
+      NOD() LANGULUS(INLINED)
+      ::std::uint64_t CompressByteBits(const ::std::uint8_t* mask, Count n) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if (n == 64) {
+               ::std::uint64_t zeroes = 0;
+               for (Offset i = 0; i < 64; i += 16) {
+                  const auto zero = simde_mm_cmpeq_epi8(simde_mm_loadu_si128(mask + i), simde_mm_setzero_si128());
+                  zeroes |= static_cast<::std::uint64_t>(static_cast<::std::uint16_t>(simde_mm_movemask_epi8(zero))) << i;
+               }
+               return ~zeroes;
+            }
+         #endif
+
+         ::std::uint64_t bits = 0;
+         for (Offset i = 0; i < n; ++i)
+            bits |= static_cast<::std::uint64_t>(mask[i] != 0) << i;
+         return bits;
+      }
+
+      /// Turn any supported mask into a function, that returns the bits for  
+      /// 64 elements at a time                                               
+      ///   @param data - the elements the mask is for                        
+      ///   @param mask - a Bitmask, a span of bools/bytes, a span of packed  
+      ///                 std::uint64_t bits, or a predicate for elements     
+      ///   @return a function of the first element and number of elements    
+      template<class S, class M> NOD() LANGULUS(INLINED)
+      auto CompressBits(const S& data, const M& mask) {
+         using E = Decvq<typename S::element_type>;
+         if constexpr (CT::Bitmask<M>) {
+            LANGULUS_ASSUME(UserAssumes, data.size() == Deref<M>::MemberCount,
+               "Bitmask size doesn't match the elements");
+            const auto bits = static_cast<::std::uint64_t>(mask.mValue);
+            return [bits](Offset, Count n) noexcept {
+               return bits & CompressFirst(n);
+            };
+         }
+         else if constexpr (::std::predicate<const M&, const E&>) {
+            return [&mask, ptr = data.data()](Offset at, Count n) {
+               ::std::uint64_t bits = 0;
+               for (Offset i = 0; i < n; ++i)
+                  bits |= static_cast<::std::uint64_t>(static_cast<bool>(mask(ptr[at + i]))) << i;
+               return bits;
+            };
+         }
+         else {
+            const ::std::span m {mask};
+            using B = Decvq<typename decltype(m)::element_type>;
+            if constexpr (CT::Exact<B, ::std::uint64_t>) {
+               LANGULUS_ASSUME(UserAssumes, m.size() >= (data.size() + 63) / 64,
+                  "Not enough mask words for the elements");
+               return [ptr = m.data()](Offset at, Count n) noexcept {
+                  return ptr[at / 64] & CompressFirst(n);
+               };
+            }
+            else {
+               static_assert(sizeof(B) == 1 and (CT::Bool<B> or CT::Integer<B>),
+                  "Mask must be a Bitmask, a span of bools, a span of std::uint64_t, or a predicate");
+               LANGULUS_ASSUME(UserAssumes, m.size() >= data.size(),
+                  "Not enough mask bytes for the elements");
+               return [ptr = reinterpret_cast<const ::std::uint8_t*>(m.data())](Offset at, Count n) noexcept {
+                  return CompressByteBits(ptr + at, n);
+               };
+            }
+         }
+      }
+
+      /// Compress elements by mask                                           
+      ///   @param in - the elements                                          
+      ///   @param n - number of elements                                     
+      ///   @param bits - function that returns the mask of 64 elements       
+      ///   @param out - where to write the selected elements                 
+      ///   @param room - number of elements that fit in the output           
+      ///   @return the number of selected elements                           
+      template<class T, class F>
+      Count CompressBulk(const T* in, Count n, F&& bits, T* out, Count room) {
+         Offset w = 0;
+         for (Offset i = 0; i < n; i += 64) {
+            const Count block = ::std::min(n - i, Count {64});
+            const ::std::uint64_t word = bits(i, block);
+            if (not word)
+               continue;
+
+            Offset j = 0;
+            #if LANGULUS_SIMD(128BIT)
+               constexpr Count G = CompressGroup<sizeof(T)>;
+               for (; j + G <= block and w + G <= room; j += G) {
+                  const auto mask = static_cast<unsigned>((word >> j) & CompressFirst(G));
+                  CompressStep<sizeof(T)>(in + i + j, mask, out + w);
+                  w += ::std::popcount(mask);
+               }
+            #endif
+
+            for (; j < block; ++j) {
+               if ((word >> j) & 1) {
+                  if (w < room)
+                     out[w] = in[i + j];
+                  ++w;
+               }
+            }
+         }
+
+         LANGULUS_ASSUME(UserAssumes, w <= room, "Output span is too short");
+         return w;
+      }
+
+      /// Expand elements by mask                                             
+      ///   @param in - the elements                                          
+      ///   @param n - number of elements                                     
+      ///   @param bits - function that returns the mask of 64 outputs        
+      ///   @param out - where to scatter the elements                        
+      ///   @param size - number of outputs                                   
+      ///   @return the number of elements that were read                     
+      template<class T, class F>
+      Count ExpandBulk(const T* in, Count n, F&& bits, T* out, Count size) {
+         Offset r = 0;
+         for (Offset i = 0; i < size; i += 64) {
+            const Count block = ::std::min(size - i, Count {64});
+            const ::std::uint64_t word = bits(i, block);
+            if (not word)
+               continue;
+
+            Offset j = 0;
+            #if LANGULUS_SIMD(128BIT)
+               constexpr Count G = CompressGroup<sizeof(T)>;
+               for (; j + G <= block and r + G <= n; j += G) {
+                  const auto mask = static_cast<unsigned>((word >> j) & CompressFirst(G));
+                  ExpandStep<sizeof(T)>(in + r, mask, out + i + j);
+                  r += ::std::popcount(mask);
+               }
+            #endif
+
+            for (; j < block; ++j) {
+               if ((word >> j) & 1) {
+                  if (r < n)
+                     out[i + j] = in[r];
+                  ++r;
+               }
+            }
+         }
+
+         LANGULUS_ASSUME(UserAssumes, r <= n, "Input span is too short");
+         return r;
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Copy the elements selected by a mask to the start of the output,       
+   /// preserving their order                                                 
+   ///   @param in - span of elements, up to 8 bytes each                     
+   ///   @param mask - a Bitmask as big as 'in', a span of bools or bytes     
+   ///                 (non-zero selects), a span of std::uint64_t with a     
+   ///                 bit for each element, or a predicate for elements      
+   ///   @param out - [out] span, with room for all selected elements         
+   ///   @return the number of selected elements                              
+   template<class IN, class M, class OUT>
+   Count Compress(const IN& in, const M& mask, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using T = typename decltype(to)::element_type;
+      static_assert(CT::Exact<T, Decvq<typename decltype(from)::element_type>>,
+         "Output must be a mutable span of the same elements");
+      static_assert(::std::is_trivially_copyable_v<T> and sizeof(T) <= 8 and ::std::has_single_bit(sizeof(T)),
+         "Unsupported element");
+
+      return Inner::CompressBulk(static_cast<const T*>(from.data()), from.size(),
+         Inner::CompressBits(from, mask), to.data(), to.size());
+   }
+
+   /// Copy consecutive elements to the places of the output, selected by a   
+   /// mask - the inverse of Compress. Other places are left untouched        
+   ///   @param in - span of elements, up to 8 bytes each, at least as many   
+   ///               as the selected places                                   
+   ///   @param mask - a Bitmask as big as 'out', a span of bools or bytes    
+   ///                 (non-zero selects), a span of std::uint64_t with a     
+   ///                 bit for each place, or a predicate, that's given the   
+   ///                 current element at each place                          
+   ///   @param out - [out] span of places                                    
+   ///   @return the number of elements read from 'in'                        
+   template<class IN, class M, class OUT>
+   Count Expand(const IN& in, const M& mask, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using T = typename decltype(to)::element_type;
+      static_assert(CT::Exact<T, Decvq<typename decltype(from)::element_type>>,
+         "Output must be a mutable span of the same elements");
+      static_assert(::std::is_trivially_copyable_v<T> and sizeof(T) <= 8 and ::std::has_single_bit(sizeof(T)),
+         "Unsupported element");
+
+      return Inner::ExpandBulk(static_cast<const T*>(from.data()), from.size(),
+         Inner::CompressBits(to, mask), to.data(), to.size());
+   }
+
+} // namespace Langulus::SIMD
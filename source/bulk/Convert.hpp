@@ -0,0 +1,619 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Convert.hpp"
+#include "../Pack.hpp"
+#include <limits>
+
+
+///                                                                           
+///   Conversion of whole arrays                                              
+///                                                                           
+/// Elements are converted a block at a time, as many as fit in the widest    
+/// register of 32bit lanes. Each block is loaded from however many bytes     
+/// it takes (i.e. a quarter register of 8bit elements, or two registers of   
+/// 64bit ones), brought to 32bit lanes, and stored as however many output    
+/// registers it takes - one input register is widened into several output    
+/// registers, or several inputs are narrowed into one.                       
+///                                                                           
+/// By default results are the same as with static_cast - narrowing           
+/// integers wraps around, reals are truncated towards zero when converted    
+/// to integers, and integers are rounded to nearest when converted to        
+/// reals. A ConvertPolicy can instead saturate numbers that don't fit, and   
+/// round reals in other ways - rounding is fused with the conversion where   
+/// there's an instruction for it, and saturation happens in the same pass.   
+///                                                                           
+/// Outputs of at least StreamThreshold bytes are written around the caches,  
+/// after converting a few elements one by one to align the output.           
+///                                                                           
+/// Pairs without a fitting instruction (64bit integers to reals, reals to    
+/// unsigned 32bit and 64bit integers, saturated 64bit integers) are          
+/// converted one by one                                                      
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Elements that can be converted in bulk                              
+      template<class T>
+      constexpr bool ConvertArithmetic = CT::Float<T> or CT::Double<T> or (CT::Integer<T>
+         and (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8));
+
+      /// Check if converting FROM to TO has a SIMD routine                   
+      template<ConvertPolicy P, class FROM, class TO>
+      constexpr bool ConvertBulkSIMD = ConvertArithmetic<FROM> and ConvertArithmetic<TO>
+         and not (sizeof(FROM) == sizeof(TO) and CT::Integer<FROM> == CT::Integer<TO>)
+         and not (CT::Integer<FROM> and sizeof(FROM) == 8 and (ConvertSaturates<P> or not CT::Integer<TO>))
+         and not (CT::Integer<TO> and not CT::Integer<FROM>
+              and (sizeof(TO) == 8 or (sizeof(TO) == 4 and not CT::Signed<TO>)));
+
+      #if LANGULUS_SIMD(512BIT)
+         using ConvertHub = simde__m512i;
+      #elif LANGULUS_SIMD(256BIT)
+         using ConvertHub = simde__m256i;
+      #elif LANGULUS_SIMD(128BIT)
+         using ConvertHub = simde__m128i;
+      #endif
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Number of elements converted at once                             
+         constexpr Count ConvertLanes = sizeof(ConvertHub) / 4;
+
+         /// Number of blocks packed together into one register of 8bit or    
+         /// 16bit integers, so that whole registers are stored. AVX-512 has  
+         /// instructions that narrow a whole block, so there blocks are      
+         /// stored one by one                                                
+         template<class TO>
+         constexpr Count ConvertPacked = LANGULUS_SIMD(512BIT)
+            or not CT::Integer<TO> or sizeof(TO) >= 4 ? 1 : 4 / sizeof(TO);
+
+         /// Load a block of integers as 32bit integers - smaller integers    
+         /// are extended, bigger ones are truncated                          
+         template<class FROM> NOD() LANGULUS(INLINED)
+         ConvertHub ConvertLoadIntegers(const FROM* p) noexcept {
+            constexpr Count S = sizeof(FROM);
+            constexpr bool SIGNED = CT::Signed<FROM>;
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (S == 1) {
+                  const auto x = simde_mm_loadu_si128(p);
+                  if constexpr (SIGNED) return simde_mm512_cvtepi8_epi32(x);
+                  else                  return simde_mm512_cvtepu8_epi32(x);
+               }
+               else if constexpr (S == 2) {
+                  const auto x = simde_mm256_loadu_si256(p);
+                  if constexpr (SIGNED) return simde_mm512_cvtepi16_epi32(x);
+                  else                  return simde_mm512_cvtepu16_epi32(x);
+               }
+               else if constexpr (S == 4)
+                  return simde_mm512_loadu_si512(p);
+               else {
+                  return simde_mm512_inserti64x4(
+                     simde_mm512_castsi256_si512(simde_mm512_cvtepi64_epi32(simde_mm512_loadu_si512(p))),
+                     simde_mm512_cvtepi64_epi32(simde_mm512_loadu_si512(p + 8)), 1);
+               }
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (S == 1) {
+                  const auto x = simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(p));
+                  if constexpr (SIGNED) return simde_mm256_cvtepi8_epi32(x);
+                  else                  return simde_mm256_cvtepu8_epi32(x);
+               }
+               else if constexpr (S == 2) {
+                  const auto x = simde_mm_loadu_si128(p);
+                  if constexpr (SIGNED) return simde_mm256_cvtepi16_epi32(x);
+                  else                  return simde_mm256_cvtepu16_epi32(x);
+               }
+               else if constexpr (S == 4)
+                  return simde_mm256_loadu_si256(p);
+               else {
+                  // Pick the low halves, then fix the order of the lanes
+                  const auto x = simde_mm256_shuffle_ps(
+                     simde_mm256_castsi256_ps(simde_mm256_loadu_si256(p)),
+                     simde_mm256_castsi256_ps(simde_mm256_loadu_si256(p + 4)),
+                     SIMDE_MM_SHUFFLE(2, 0, 2, 0));
+                  return simde_mm256_permute4x64_epi64(simde_mm256_castps_si256(x), 0xD8);
+               }
+            #else
+               if constexpr (S == 1) {
+                  const auto x = simde_mm_loadu_si32(p);
+                  if constexpr (SIGNED) return simde_mm_cvtepi8_epi32(x);
+                  else                  return simde_mm_cvtepu8_epi32(x);
+               }
+               else if constexpr (S == 2) {
+                  const auto x = simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(p));
+                  if constexpr (SIGNED) return simde_mm_cvtepi16_epi32(x);
+                  else                  return simde_mm_cvtepu16_epi32(x);
+               }
+               else if constexpr (S == 4)
+                  return simde_mm_loadu_si128(p);
+               else {
+                  return simde_mm_castps_si128(simde_mm_shuffle_ps(
+                     simde_mm_castsi128_ps(simde_mm_loadu_si128(p)),
+                     simde_mm_castsi128_ps(simde_mm_loadu_si128(p + 2)),
+                     SIMDE_MM_SHUFFLE(2, 0, 2, 0)));
+               }
+            #endif
+         }
+
+         /// Clamp 32bit integers to the range of TO, if narrower than FROM   
+         template<class FROM, class TO> NOD() LANGULUS(INLINED)
+         ConvertHub ConvertSaturateIntegers(const ConvertHub& x) noexcept {
+            constexpr ::std::int64_t FROM_LO = ::std::numeric_limits<FROM>::lowest();
+            constexpr ::std::int64_t FROM_HI = ::std::numeric_limits<FROM>::max();
+            constexpr ::std::int64_t TO_LO = ::std::numeric_limits<TO>::lowest();
+            constexpr ::std::int64_t TO_HI = sizeof(TO) == 8
+               ? ::std::numeric_limits<::std::int64_t>::max()
+               : static_cast<::std::int64_t>(::std::numeric_limits<TO>::max());
+            // Only 32bit unsigned integers don't fit in signed lanes   
+            constexpr bool UNSIGNED = not CT::Signed<FROM> and sizeof(FROM) == 4;
+            constexpr auto lo = static_cast<int>(TO_LO);
+            constexpr auto hi = static_cast<int>(TO_HI);
+
+            auto y = x;
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (TO_LO > FROM_LO)
+                  y = simde_mm512_max_epi32(y, simde_mm512_set1_epi32(lo));
+               if constexpr (TO_HI < FROM_HI and UNSIGNED)
+                  y = simde_mm512_min_epu32(y, simde_mm512_set1_epi32(hi));
+               else if constexpr (TO_HI < FROM_HI)
+                  y = simde_mm512_min_epi32(y, simde_mm512_set1_epi32(hi));
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (TO_LO > FROM_LO)
+                  y = simde_mm256_max_epi32(y, simde_mm256_set1_epi32(lo));
+               if constexpr (TO_HI < FROM_HI and UNSIGNED)
+                  y = simde_mm256_min_epu32(y, simde_mm256_set1_epi32(hi));
+               else if constexpr (TO_HI < FROM_HI)
+                  y = simde_mm256_min_epi32(y, simde_mm256_set1_epi32(hi));
+            #else
+               if constexpr (TO_LO > FROM_LO)
+                  y = simde_mm_max_epi32(y, simde_mm_set1_epi32(lo));
+               if constexpr (TO_HI < FROM_HI and UNSIGNED)
+                  y = simde_mm_min_epu32(y, simde_mm_set1_epi32(hi));
+               else if constexpr (TO_HI < FROM_HI)
+                  y = simde_mm_min_epi32(y, simde_mm_set1_epi32(hi));
+            #endif
+            return y;
+         }
+
+         /// Clamp reals to the range of TO, and replace NaNs with zeroes     
+         /// Floats aren't clamped from above for 32bit integers, because the 
+         /// biggest one isn't a float - ConvertRealsToIntegers fixes those   
+         ///   @tparam F - float or double                                    
+         ///   @param x - register of F                                       
+         template<class F, class TO, class R> NOD() LANGULUS(INLINED)
+         R ConvertSaturateReals(const R& x) noexcept {
+            constexpr auto lo = static_cast<F>(::std::numeric_limits<TO>::lowest());
+            constexpr auto hi = static_cast<F>(::std::numeric_limits<TO>::max());
+            constexpr bool UPPER = not (CT::Float<F> and sizeof(TO) == 4);
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (CT::Float<F>) {
+                  auto y = simde_mm512_maskz_mov_ps(simde_mm512_cmp_ps_mask(x, x, SIMDE_CMP_ORD_Q), x);
+                  y = simde_mm512_max_ps(y, simde_mm512_set1_ps(lo));
+                  if constexpr (UPPER)
+                     y = simde_mm512_min_ps(y, simde_mm512_set1_ps(hi));
+                  return y;
+               }
+               else {
+                  auto y = simde_mm512_maskz_mov_pd(simde_mm512_cmp_pd_mask(x, x, SIMDE_CMP_ORD_Q), x);
+                  y = simde_mm512_max_pd(y, simde_mm512_set1_pd(lo));
+                  return simde_mm512_min_pd(y, simde_mm512_set1_pd(hi));
+               }
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (CT::Float<F>) {
+                  auto y = simde_mm256_and_ps(x, simde_mm256_cmp_ps(x, x, SIMDE_CMP_ORD_Q));
+                  y = simde_mm256_max_ps(y, simde_mm256_set1_ps(lo));
+                  if constexpr (UPPER)
+                     y = simde_mm256_min_ps(y, simde_mm256_set1_ps(hi));
+                  return y;
+               }
+               else {
+                  auto y = simde_mm256_and_pd(x, simde_mm256_cmp_pd(x, x, SIMDE_CMP_ORD_Q));
+                  y = simde_mm256_max_pd(y, simde_mm256_set1_pd(lo));
+                  return simde_mm256_min_pd(y, simde_mm256_set1_pd(hi));
+               }
+            #else
+               if constexpr (CT::Float<F>) {
+                  auto y = simde_mm_and_ps(x, simde_mm_cmpord_ps(x, x));
+                  y = simde_mm_max_ps(y, simde_mm_set1_ps(lo));
+                  if constexpr (UPPER)
+                     y = simde_mm_min_ps(y, simde_mm_set1_ps(hi));
+                  return y;
+               }
+               else {
+                  auto y = simde_mm_and_pd(x, simde_mm_cmpord_pd(x, x));
+                  y = simde_mm_max_pd(y, simde_mm_set1_pd(lo));
+                  return simde_mm_min_pd(y, simde_mm_set1_pd(hi));
+               }
+            #endif
+         }
+
+         /// Round reals and convert them to 32bit integers in one go, where  
+         /// there's an instruction for it                                    
+         ///   @tparam ROUND - the rounding part of a policy                  
+         ///   @tparam F - float or double                                    
+         ///   @param x - register of F                                       
+         ///   @return the integers, in a register half as big for doubles    
+         template<ConvertPolicy ROUND, class F, class R> NOD() LANGULUS(INLINED)
+         auto ConvertRound(const R& x) noexcept {
+            constexpr int MODE = ROUND == ConvertPolicy::Floor ? SIMDE_MM_FROUND_TO_NEG_INF
+                               : ROUND == ConvertPolicy::Ceil  ? SIMDE_MM_FROUND_TO_POS_INF
+                                                               : SIMDE_MM_FROUND_TO_NEAREST_INT;
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (CT::Float<F>) {
+                  if constexpr (ROUND == ConvertPolicy::TowardZero)
+                     return simde_mm512_cvttps_epi32(x);
+                  else
+                     return simde_mm512_cvt_roundps_epi32(x, MODE | SIMDE_MM_FROUND_NO_EXC);
+               }
+               else {
+                  if constexpr (ROUND == ConvertPolicy::TowardZero)
+                     return simde_mm512_cvttpd_epi32(x);
+                  else
+                     return simde_mm512_cvt_roundpd_epi32(x, MODE | SIMDE_MM_FROUND_NO_EXC);
+               }
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (CT::Float<F>) {
+                  if constexpr (ROUND == ConvertPolicy::TowardZero)
+                     return simde_mm256_cvttps_epi32(x);
+                  else if constexpr (ROUND == ConvertPolicy::RoundNearest)
+                     return simde_mm256_cvtps_epi32(x);
+                  else
+                     return simde_mm256_cvttps_epi32(simde_mm256_round_ps(x, MODE | SIMDE_MM_FROUND_NO_EXC));
+               }
+               else {
+                  if constexpr (ROUND == ConvertPolicy::TowardZero)
+                     return simde_mm256_cvttpd_epi32(x);
+                  else if constexpr (ROUND == ConvertPolicy::RoundNearest)
+                     return simde_mm256_cvtpd_epi32(x);
+                  else
+                     return simde_mm256_cvttpd_epi32(simde_mm256_round_pd(x, MODE | SIMDE_MM_FROUND_NO_EXC));
+               }
+            #else
+               if constexpr (CT::Float<F>) {
+                  if constexpr (ROUND == ConvertPolicy::TowardZero)
+                     return simde_mm_cvttps_epi32(x);
+                  else if constexpr (ROUND == ConvertPolicy::RoundNearest)
+                     return simde_mm_cvtps_epi32(x);
+                  else
+                     return simde_mm_cvttps_epi32(simde_mm_round_ps(x, MODE | SIMDE_MM_FROUND_NO_EXC));
+               }
+               else {
+                  if constexpr (ROUND == ConvertPolicy::TowardZero)
+                     return simde_mm_cvttpd_epi32(x);
+                  else if constexpr (ROUND == ConvertPolicy::RoundNearest)
+                     return simde_mm_cvtpd_epi32(x);
+                  else
+                     return simde_mm_cvttpd_epi32(simde_mm_round_pd(x, MODE | SIMDE_MM_FROUND_NO_EXC));
+               }
+            #endif
+         }
+
+         /// Convert a register of reals to 32bit integers, by policy         
+         ///   @tparam F - float or double                                    
+         ///   @param x - register of F                                       
+         template<ConvertPolicy P, class TO, class F, class R> NOD() LANGULUS(INLINED)
+         auto ConvertRealsToIntegers(const R& x) noexcept {
+            constexpr auto ROUND = ConvertRounding<P>;
+            if constexpr (not ConvertSaturates<P>)
+               return ConvertRound<ROUND, F>(x);
+            else {
+               const auto y = ConvertSaturateReals<F, TO>(x);
+               const auto i = ConvertRound<ROUND, F>(y);
+               if constexpr (CT::Float<F> and sizeof(TO) == 4) {
+                  // Floats from 2^31 up convert to 0x80000000, which is
+                  // flipped to 0x7FFFFFFF by a mask of those floats    
+                  #if LANGULUS_SIMD(512BIT)
+                     return simde_mm512_mask_mov_epi32(i,
+                        simde_mm512_cmp_ps_mask(y, simde_mm512_set1_ps(2147483648.0f), SIMDE_CMP_GE_OQ),
+                        simde_mm512_set1_epi32(::std::numeric_limits<::std::int32_t>::max()));
+                  #elif LANGULUS_SIMD(256BIT)
+                     return simde_mm256_xor_si256(i, simde_mm256_castps_si256(
+                        simde_mm256_cmp_ps(y, simde_mm256_set1_ps(2147483648.0f), SIMDE_CMP_GE_OQ)));
+                  #else
+                     return simde_mm_xor_si128(i, simde_mm_castps_si128(
+                        simde_mm_cmpge_ps(y, simde_mm_set1_ps(2147483648.0f))));
+                  #endif
+               }
+               else return i;
+            }
+         }
+
+         /// Load a block of elements as 32bit integers, by policy            
+         template<ConvertPolicy P, class TO, class FROM> NOD() LANGULUS(INLINED)
+         ConvertHub ConvertLoad(const FROM* p) noexcept {
+            if constexpr (CT::Integer<FROM>) {
+               if constexpr (ConvertSaturates<P> and CT::Integer<TO>)
+                  return ConvertSaturateIntegers<FROM, TO>(ConvertLoadIntegers(p));
+               else
+                  return ConvertLoadIntegers(p);
+            }
+            else {
+               #if LANGULUS_SIMD(512BIT)
+                  if constexpr (CT::Float<FROM>)
+                     return ConvertRealsToIntegers<P, TO, FROM>(simde_mm512_loadu_ps(p));
+                  else {
+                     return simde_mm512_inserti64x4(simde_mm512_castsi256_si512(
+                        ConvertRealsToIntegers<P, TO, FROM>(simde_mm512_loadu_pd(p))),
+                        ConvertRealsToIntegers<P, TO, FROM>(simde_mm512_loadu_pd(p + 8)), 1);
+                  }
+               #elif LANGULUS_SIMD(256BIT)
+                  if constexpr (CT::Float<FROM>)
+                     return ConvertRealsToIntegers<P, TO, FROM>(simde_mm256_loadu_ps(p));
+                  else {
+                     return simde_mm256_set_m128i(
+                        ConvertRealsToIntegers<P, TO, FROM>(simde_mm256_loadu_pd(p + 4)),
+                        ConvertRealsToIntegers<P, TO, FROM>(simde_mm256_loadu_pd(p)));
+                  }
+               #else
+                  if constexpr (CT::Float<FROM>)
+                     return ConvertRealsToIntegers<P, TO, FROM>(simde_mm_loadu_ps(p));
+                  else {
+                     return simde_mm_unpacklo_epi64(
+                        ConvertRealsToIntegers<P, TO, FROM>(simde_mm_loadu_pd(p)),
+                        ConvertRealsToIntegers<P, TO, FROM>(simde_mm_loadu_pd(p + 2)));
+                  }
+               #endif
+            }
+         }
+
+         /// Store a block of 32bit integers as floats                        
+         ///   @tparam UNSIGNED - whether the integers are unsigned           
+         ///   @tparam STREAM - whether to bypass the caches                  
+         template<bool UNSIGNED, bool STREAM> LANGULUS(INLINED)
+         void ConvertStoreFloats(float* p, const ConvertHub& x) noexcept {
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (UNSIGNED)
+                  StoreBulk<STREAM>(p, V512<float> {simde_mm512_cvtepu32_ps(x)});
+               else
+                  StoreBulk<STREAM>(p, V512<float> {simde_mm512_cvtepi32_ps(x)});
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (UNSIGNED) {
+                  // Both halves convert exactly, so the sum is rounded once
+                  const auto hi = simde_mm256_cvtepi32_ps(simde_mm256_srli_epi32(x, 16));
+                  const auto lo = simde_mm256_cvtepi32_ps(simde_mm256_and_si256(x, simde_mm256_set1_epi32(0xFFFF)));
+                  StoreBulk<STREAM>(p, V256<float> {simde_mm256_add_ps(simde_mm256_mul_ps(hi, simde_mm256_set1_ps(65536.0f)), lo)});
+               }
+               else StoreBulk<STREAM>(p, V256<float> {simde_mm256_cvtepi32_ps(x)});
+            #else
+               if constexpr (UNSIGNED) {
+                  // Both halves convert exactly, so the sum is rounded once
+                  const auto hi = simde_mm_cvtepi32_ps(simde_mm_srli_epi32(x, 16));
+                  const auto lo = simde_mm_cvtepi32_ps(simde_mm_and_si128(x, simde_mm_set1_epi32(0xFFFF)));
+                  StoreBulk<STREAM>(p, V128<float> {simde_mm_add_ps(simde_mm_mul_ps(hi, simde_mm_set1_ps(65536.0f)), lo)});
+               }
+               else StoreBulk<STREAM>(p, V128<float> {simde_mm_cvtepi32_ps(x)});
+            #endif
+         }
+
+         /// Store a block of 32bit integers as doubles, in two registers     
+         ///   @tparam UNSIGNED - whether the integers are unsigned           
+         ///   @tparam STREAM - whether to bypass the caches                  
+         template<bool UNSIGNED, bool STREAM> LANGULUS(INLINED)
+         void ConvertStoreDoubles(double* p, const ConvertHub& x) noexcept {
+            #if LANGULUS_SIMD(512BIT)
+               const auto lo = simde_mm512_castsi512_si256(x);
+               const auto hi = simde_mm512_extracti64x4_epi64(x, 1);
+               if constexpr (UNSIGNED) {
+                  StoreBulk<STREAM>(p,     V512<double> {simde_mm512_cvtepu32_pd(lo)});
+                  StoreBulk<STREAM>(p + 8, V512<double> {simde_mm512_cvtepu32_pd(hi)});
+               }
+               else {
+                  StoreBulk<STREAM>(p,     V512<double> {simde_mm512_cvtepi32_pd(lo)});
+                  StoreBulk<STREAM>(p + 8, V512<double> {simde_mm512_cvtepi32_pd(hi)});
+               }
+            #elif LANGULUS_SIMD(256BIT)
+               // Unsigned integers are converted as signed ones, that are
+               // 2^31 smaller, which is exact for doubles              
+               const auto s = UNSIGNED ? simde_mm256_xor_si256(x, simde_mm256_set1_epi32(::std::numeric_limits<::std::int32_t>::min())) : x;
+               auto lo = simde_mm256_cvtepi32_pd(simde_mm256_castsi256_si128(s));
+               auto hi = simde_mm256_cvtepi32_pd(simde_mm256_extracti128_si256(s, 1));
+               if constexpr (UNSIGNED) {
+                  lo = simde_mm256_add_pd(lo, simde_mm256_set1_pd(2147483648.0));
+                  hi = simde_mm256_add_pd(hi, simde_mm256_set1_pd(2147483648.0));
+               }
+               StoreBulk<STREAM>(p,     V256<double> {lo});
+               StoreBulk<STREAM>(p + 4, V256<double> {hi});
+            #else
+               const auto s = UNSIGNED ? simde_mm_xor_si128(x, simde_mm_set1_epi32(::std::numeric_limits<::std::int32_t>::min())) : x;
+               auto lo = simde_mm_cvtepi32_pd(s);
+               auto hi = simde_mm_cvtepi32_pd(simde_mm_srli_si128(s, 8));
+               if constexpr (UNSIGNED) {
+                  lo = simde_mm_add_pd(lo, simde_mm_set1_pd(2147483648.0));
+                  hi = simde_mm_add_pd(hi, simde_mm_set1_pd(2147483648.0));
+               }
+               StoreBulk<STREAM>(p,     V128<double> {lo});
+               StoreBulk<STREAM>(p + 2, V128<double> {hi});
+            #endif
+         }
+
+         /// Store a block of 32bit integers as 32bit or wider integers on    
+         /// SSE/AVX2 - narrower ones are packed from several blocks - and as 
+         /// any integers on AVX-512                                          
+         ///   @tparam UNSIGNED - whether the integers are unsigned           
+         ///   @tparam STREAM - whether to bypass the caches                  
+         template<bool UNSIGNED, bool STREAM, CT::Integer TO> LANGULUS(INLINED)
+         void ConvertStoreIntegers(TO* p, const ConvertHub& x) noexcept {
+            constexpr Count S = sizeof(TO);
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (S == 1)
+                  StoreBulk<STREAM>(p, V128<TO> {simde_mm512_cvtepi32_epi8(x)});
+               else if constexpr (S == 2)
+                  StoreBulk<STREAM>(p, V256<TO> {simde_mm512_cvtepi32_epi16(x)});
+               else if constexpr (S == 4)
+                  StoreBulk<STREAM>(p, V512<TO> {x});
+               else {
+                  const auto lo = simde_mm512_castsi512_si256(x);
+                  const auto hi = simde_mm512_extracti64x4_epi64(x, 1);
+                  if constexpr (UNSIGNED) {
+                     StoreBulk<STREAM>(p,     V512<TO> {simde_mm512_cvtepu32_epi64(lo)});
+                     StoreBulk<STREAM>(p + 8, V512<TO> {simde_mm512_cvtepu32_epi64(hi)});
+                  }
+                  else {
+                     StoreBulk<STREAM>(p,     V512<TO> {simde_mm512_cvtepi32_epi64(lo)});
+                     StoreBulk<STREAM>(p + 8, V512<TO> {simde_mm512_cvtepi32_epi64(hi)});
+                  }
+               }
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (S == 4)
+                  StoreBulk<STREAM>(p, V256<TO> {x});
+               else {
+                  const auto lo = simde_mm256_castsi256_si128(x);
+                  const auto hi = simde_mm256_extracti128_si256(x, 1);
+                  if constexpr (UNSIGNED) {
+                     StoreBulk<STREAM>(p,     V256<TO> {simde_mm256_cvtepu32_epi64(lo)});
+                     StoreBulk<STREAM>(p + 4, V256<TO> {simde_mm256_cvtepu32_epi64(hi)});
+                  }
+                  else {
+                     StoreBulk<STREAM>(p,     V256<TO> {simde_mm256_cvtepi32_epi64(lo)});
+                     StoreBulk<STREAM>(p + 4, V256<TO> {simde_mm256_cvtepi32_epi64(hi)});
+                  }
+               }
+            #else
+               if constexpr (S == 4)
+                  StoreBulk<STREAM>(p, V128<TO> {x});
+               else {
+                  const auto hi = simde_mm_srli_si128(x, 8);
+                  if constexpr (UNSIGNED) {
+                     StoreBulk<STREAM>(p,     V128<TO> {simde_mm_cvtepu32_epi64(x)});
+                     StoreBulk<STREAM>(p + 2, V128<TO> {simde_mm_cvtepu32_epi64(hi)});
+                  }
+                  else {
+                     StoreBulk<STREAM>(p,     V128<TO> {simde_mm_cvtepi32_epi64(x)});
+                     StoreBulk<STREAM>(p + 2, V128<TO> {simde_mm_cvtepi32_epi64(hi)});
+                  }
+               }
+            #endif
+         }
+
+         /// Convert a block of floats to doubles, or the other way around    
+         ///   @tparam STREAM - whether to bypass the caches                  
+         template<bool STREAM, class FROM, class TO> LANGULUS(INLINED)
+         void ConvertReals(const FROM* in, TO* out) noexcept {
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (CT::Double<TO>) {
+                  StoreBulk<STREAM>(out,     V512<TO> {simde_mm512_cvtps_pd(simde_mm256_loadu_ps(in))});
+                  StoreBulk<STREAM>(out + 8, V512<TO> {simde_mm512_cvtps_pd(simde_mm256_loadu_ps(in + 8))});
+               }
+               else {
+                  StoreBulk<STREAM>(out,     V256<TO> {simde_mm512_cvtpd_ps(simde_mm512_loadu_pd(in))});
+                  StoreBulk<STREAM>(out + 8, V256<TO> {simde_mm512_cvtpd_ps(simde_mm512_loadu_pd(in + 8))});
+               }
+            #elif LANGULUS_SIMD(256BIT)
+               if constexpr (CT::Double<TO>) {
+                  StoreBulk<STREAM>(out,     V256<TO> {simde_mm256_cvtps_pd(simde_mm_loadu_ps(in))});
+                  StoreBulk<STREAM>(out + 4, V256<TO> {simde_mm256_cvtps_pd(simde_mm_loadu_ps(in + 4))});
+               }
+               else {
+                  StoreBulk<STREAM>(out,     V128<TO> {simde_mm256_cvtpd_ps(simde_mm256_loadu_pd(in))});
+                  StoreBulk<STREAM>(out + 4, V128<TO> {simde_mm256_cvtpd_ps(simde_mm256_loadu_pd(in + 4))});
+               }
+            #else
+               if constexpr (CT::Double<TO>) {
+                  const auto f = simde_mm_loadu_ps(in);
+                  StoreBulk<STREAM>(out,     V128<TO> {simde_mm_cvtps_pd(f)});
+                  StoreBulk<STREAM>(out + 2, V128<TO> {simde_mm_cvtps_pd(simde_mm_movehl_ps(f, f))});
+               }
+               else {
+                  StoreBulk<STREAM>(out, V128<TO> {simde_mm_movelh_ps(
+                     simde_mm_cvtpd_ps(simde_mm_loadu_pd(in)),
+                     simde_mm_cvtpd_ps(simde_mm_loadu_pd(in + 2)))});
+               }
+            #endif
+         }
+
+         /// Convert a block of elements, by policy                           
+         ///   @tparam STREAM - whether to bypass the caches, in which case   
+         ///      'out' must be aligned to the widest register                
+         template<ConvertPolicy P, bool STREAM, class FROM, class TO> LANGULUS(INLINED)
+         void ConvertBlock(const FROM* in, TO* out) noexcept {
+            // Only 32bit unsigned integers don't fit in signed lanes   
+            constexpr bool UNSIGNED = CT::Integer<FROM>
+               and not CT::Signed<FROM> and sizeof(FROM) == 4;
+
+            if constexpr (not CT::Integer<FROM> and not CT::Integer<TO>)
+               ConvertReals<STREAM>(in, out);
+            else if constexpr (CT::Float<TO>)
+               ConvertStoreFloats<UNSIGNED, STREAM>(out, ConvertLoad<P, TO>(in));
+            else if constexpr (CT::Double<TO>)
+               ConvertStoreDoubles<UNSIGNED, STREAM>(out, ConvertLoad<P, TO>(in));
+         #if not LANGULUS_SIMD(512BIT)
+            else if constexpr (ConvertPacked<TO> > 1) {
+               // Integers are already in the range of TO, if saturated,
+               // so packing them only has to truncate                  
+               const auto packed = [&]<Offset...I>(::std::index_sequence<I...>) {
+                  #if LANGULUS_SIMD(256BIT)
+                     return PackN(V256<::std::int32_t> {ConvertLoad<P, TO>(in + I * ConvertLanes)}...);
+                  #else
+                     return PackN(V128<::std::int32_t> {ConvertLoad<P, TO>(in + I * ConvertLanes)}...);
+                  #endif
+               }(::std::make_index_sequence<ConvertPacked<TO>> {});
+
+               StoreBulk<STREAM>(out, packed);
+            }
+         #endif
+            else
+               ConvertStoreIntegers<UNSIGNED, STREAM>(out, ConvertLoad<P, TO>(in));
+         }
+      #endif
+
+      /// Convert elements                                                    
+      ///   @tparam P - the policy                                            
+      ///   @param in - the elements to convert                               
+      ///   @param out - the converted elements                               
+      ///   @param count - number of elements                                 
+      template<ConvertPolicy P, class FROM, class TO>
+      void ConvertBulk(const FROM* in, TO* out, const Count count) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (ConvertBulkSIMD<P, FROM, TO>) {
+               constexpr Count STEP = ConvertLanes * ConvertPacked<TO>;
+               if (count * sizeof(TO) >= StreamThreshold) {
+                  // Convert one by one until the output is aligned,    
+                  // and then stream the rest around the caches         
+                  for (; i < count and reinterpret_cast<::std::uintptr_t>(out + i) % sizeof(ConvertHub); ++i)
+                     out[i] = ConvertScalar<P, TO>(in[i]);
+                  for (; i + STEP <= count; i += STEP)
+                     ConvertBlock<P, true>(in + i, out + i);
+                  StreamFence();
+               }
+               else {
+                  for (; i + STEP <= count; i += STEP)
+                     ConvertBlock<P, false>(in + i, out + i);
+               }
+            }
+         #endif
+
+         // Remaining elements                                          
+         for (; i < count; ++i)
+            out[i] = ConvertScalar<P, TO>(in[i]);
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Convert a span of numbers to another type - as if by static_cast,      
+   /// unless a policy says otherwise                                         
+   ///   @tparam P - how to treat numbers that don't fit, and how to round    
+   ///      reals to integers (see ConvertPolicy)                             
+   ///   @param in - the numbers                                              
+   ///   @param out - [out] the converted numbers, at least as many as 'in'   
+   template<ConvertPolicy P = ConvertPolicy::Wrap, class IN, CT::NoIntent OUT>
+   requires requires (const IN& i, OUT& o) { ::std::span {i}; ::std::span {o}; }
+   void Convert(const IN& in, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using FROM = Decvq<typename decltype(from)::element_type>;
+      using TO = typename decltype(to)::element_type;
+      static_assert(not ::std::is_const_v<TO>, "Output must be a mutable span");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+         "Output span is too short");
+
+      Inner::ConvertBulk<P>(static_cast<const FROM*>(from.data()), to.data(), from.size());
+   }
+
+} // namespace Langulus::SIMD
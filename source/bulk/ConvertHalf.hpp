@@ -0,0 +1,145 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Float16.hpp"
+
+
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Narrow four floats to bfloat16 bits, rounding to nearest even    
+         /// Works the same way as FloatToBFloatBits, but on a register       
+         ///   @param f - the floats                                          
+         ///   @return the bfloat16 bits, in the low half of each 32bit lane  
+         NOD() LANGULUS(INLINED)
+         simde__m128i NarrowToBFloat(const simde__m128& f) noexcept {
+            const auto x = simde_mm_castps_si128(f);
+            const auto lsb = simde_mm_and_si128(simde_mm_srli_epi32(x, 16), simde_mm_set1_epi32(1));
+            const auto rounded = simde_mm_add_epi32(x, simde_mm_add_epi32(lsb, simde_mm_set1_epi32(0x7FFF)));
+            const auto quiet = simde_mm_or_si128(x, simde_mm_set1_epi32(0x400000));
+            const auto nan = simde_mm_castps_si128(simde_mm_cmpunord_ps(f, f));
+            const auto result = simde_mm_or_si128(
+               simde_mm_and_si128(nan, quiet),
+               simde_mm_andnot_si128(nan, rounded)
+            );
+            return simde_mm_srli_epi32(result, 16);
+         }
+      #endif
+
+      /// Widen half-precision elements to floats                             
+      ///   @param in - the Float16 or BFloat16 elements                      
+      ///   @param out - the floats                                           
+      ///   @param count - number of elements                                 
+      template<CT::Half H>
+      void WidenHalves(const H* in, float* out, const Count count) noexcept {
+         Offset i = 0;
+         if constexpr (CT::Exact<H, Float16>) {
+            #if LANGULUS_SIMD(F16C)
+               for (; i + 8 <= count; i += 8)
+                  simde_mm256_storeu_ps(out + i, simde_mm256_cvtph_ps(simde_mm_loadu_si128(in + i)));
+               for (; i + 4 <= count; i += 4) {
+                  simde_mm_storeu_ps(out + i, simde_mm_cvtph_ps(
+                     simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(in + i))));
+               }
+            #endif
+         }
+         else {
+            #if LANGULUS_SIMD(128BIT)
+               // A bfloat16 is just the upper half of a float          
+               const auto zero = simde_mm_setzero_si128();
+               for (; i + 8 <= count; i += 8) {
+                  const auto h = simde_mm_loadu_si128(in + i);
+                  simde_mm_storeu_ps(out + i,     simde_mm_castsi128_ps(simde_mm_unpacklo_epi16(zero, h)));
+                  simde_mm_storeu_ps(out + i + 4, simde_mm_castsi128_ps(simde_mm_unpackhi_epi16(zero, h)));
+               }
+            #endif
+         }
+
+         // Remaining elements                                          
+         for (; i < count; ++i)
+            out[i] = static_cast<float>(in[i]);
+      }
+
+      /// Narrow floats to half-precision elements, rounding to nearest even  
+      ///   @param in - the floats                                            
+      ///   @param out - the Float16 or BFloat16 elements                     
+      ///   @param count - number of elements                                 
+      template<CT::Half H>
+      void NarrowHalves(const float* in, H* out, const Count count) noexcept {
+         Offset i = 0;
+         if constexpr (CT::Exact<H, Float16>) {
+            #if LANGULUS_SIMD(F16C)
+               for (; i + 8 <= count; i += 8) {
+                  simde_mm_storeu_si128(out + i, simde_mm256_cvtps_ph(
+                     simde_mm256_loadu_ps(in + i), SIMDE_MM_FROUND_TO_NEAREST_INT));
+               }
+               for (; i + 4 <= count; i += 4) {
+                  simde_mm_storel_epi64(reinterpret_cast<simde__m128i*>(out + i), simde_mm_cvtps_ph(
+                     simde_mm_loadu_ps(in + i), SIMDE_MM_FROUND_TO_NEAREST_INT));
+               }
+            #endif
+         }
+         else {
+            #if LANGULUS_SIMD(128BIT)
+               for (; i + 8 <= count; i += 8) {
+                  simde_mm_storeu_si128(out + i, simde_mm_packus_epi32(
+                     NarrowToBFloat(simde_mm_loadu_ps(in + i)),
+                     NarrowToBFloat(simde_mm_loadu_ps(in + i + 4))
+                  ));
+               }
+            #endif
+         }
+
+         // Remaining elements                                          
+         for (; i < count; ++i)
+            out[i] = H {in[i]};
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Widen a span of Float16 or BFloat16 elements to floats                 
+   /// Float16 uses F16C when available, BFloat16 only needs 128bit registers 
+   ///   @param in - the half-precision elements                              
+   ///   @param out - the floats, at least as long as 'in'                    
+   template<class IN, class OUT> LANGULUS(INLINED)
+   void HalfToFloat(const IN& in, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using H = Decvq<typename decltype(from)::element_type>;
+      static_assert(CT::Half<H>, "Input must be Float16 or BFloat16");
+      static_assert(CT::Exact<float, typename decltype(to)::element_type>,
+         "Output must be a mutable span of floats");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+         "Output span is too short");
+
+      Inner::WidenHalves(from.data(), to.data(), from.size());
+   }
+
+   /// Narrow a span of floats to Float16 or BFloat16 elements, rounding to   
+   /// nearest even. Overflowing values become infinity, NaNs stay NaNs       
+   ///   @param in - the floats                                               
+   ///   @param out - the half-precision elements, at least as long as 'in'   
+   template<class IN, class OUT> LANGULUS(INLINED)
+   void FloatToHalf(const IN& in, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using H = typename decltype(to)::element_type;
+      static_assert(CT::Half<H>, "Output must be a mutable Float16 or BFloat16 span");
+      static_assert(CT::Exact<float, Decvq<typename decltype(from)::element_type>>,
+         "Input must be a span of floats");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+         "Output span is too short");
+
+      Inner::NarrowHalves(from.data(), to.data(), from.size());
+   }
+
+} // namespace Langulus::SIMD
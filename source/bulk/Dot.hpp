@@ -0,0 +1,270 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Fill.hpp"
+#include "../binary/Add.hpp"
+#include <array>
+
+
+///                                                                           
+///   Quantized dot products                                                  
+///                                                                           
+/// Pairs of narrow integers are multiplied and summed into 32bit lanes,      
+/// with vpdpbusd/vpdpwssd where AVX512-VNNI is available. Elsewhere, 8bit    
+/// elements are widened to 16bit and summed with pmaddwd instead - the       
+/// shorter pmaddubsw saturates to 16bit, so it isn't exact for our inputs.   
+///                                                                           
+/// All sums are computed in 32bit, and wrap around on overflow, the same     
+/// way the instructions do it                                                
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Number of 8bit pairs consumed by one DotU8I8SIMD into R             
+      template<CT::SIMD R>
+      constexpr Count DotU8I8Step = (CT::SIMD512<R> and LANGULUS_SIMD(AVX512VNNI))
+         ? sizeof(R) : sizeof(R) / 2;
+
+      /// Number of 16bit pairs consumed by one DotI16SIMD into R             
+      template<CT::SIMD R>
+      constexpr Count DotI16Step = sizeof(R) / 2;
+
+      /// Multiply unsigned and signed bytes, and add each four adjacent      
+      /// products to the 32bit lanes of an accumulator                       
+      ///   @param acc - the accumulator                                      
+      ///   @param a - unsigned bytes, DotU8I8Step<R> of them are read        
+      ///   @param b - signed bytes, DotU8I8Step<R> of them are read          
+      ///   @return the new accumulator                                       
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R DotU8I8SIMD(const R& acc, const ::std::uint8_t* a, const ::std::int8_t* b) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               const auto wa = simde_mm_cvtepu8_epi16(simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(a)));
+               const auto wb = simde_mm_cvtepi8_epi16(simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(b)));
+               return R {simde_mm_add_epi32(acc, simde_mm_madd_epi16(wa, wb))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               const auto wa = simde_mm256_cvtepu8_epi16(simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(a)));
+               const auto wb = simde_mm256_cvtepi8_epi16(simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(b)));
+               return R {simde_mm256_add_epi32(acc, simde_mm256_madd_epi16(wa, wb))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               #if LANGULUS_SIMD(AVX512VNNI)
+                  return R {simde_mm512_dpbusd_epi32(acc, simde_mm512_loadu_si512(a), simde_mm512_loadu_si512(b))};
+               #else
+                  const auto wa = simde_mm512_cvtepu8_epi16(simde_mm256_loadu_si256(reinterpret_cast<const simde__m256i*>(a)));
+                  const auto wb = simde_mm512_cvtepi8_epi16(simde_mm256_loadu_si256(reinterpret_cast<const simde__m256i*>(b)));
+                  return R {simde_mm512_add_epi32(acc, simde_mm512_madd_epi16(wa, wb))};
+               #endif
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Multiply signed 16bit integers, and add each two adjacent products  
+      /// to the 32bit lanes of an accumulator                                
+      ///   @param acc - the accumulator                                      
+      ///   @param a - DotI16Step<R> integers are read                        
+      ///   @param b - DotI16Step<R> integers are read                        
+      ///   @return the new accumulator                                       
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R DotI16SIMD(const R& acc, const ::std::int16_t* a, const ::std::int16_t* b) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               using W = V128<::std::int16_t>;
+               const auto products = simde_mm_madd_epi16(LoadUnaligned<W>(a), LoadUnaligned<W>(b));
+               return R {simde_mm_add_epi32(acc, products)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               using W = V256<::std::int16_t>;
+               const auto products = simde_mm256_madd_epi16(LoadUnaligned<W>(a), LoadUnaligned<W>(b));
+               return R {simde_mm256_add_epi32(acc, products)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using W = V512<::std::int16_t>;
+               #if LANGULUS_SIMD(AVX512VNNI)
+                  return R {simde_mm512_dpwssd_epi32(acc, LoadUnaligned<W>(a), LoadUnaligned<W>(b))};
+               #else
+                  const auto products = simde_mm512_madd_epi16(LoadUnaligned<W>(a), LoadUnaligned<W>(b));
+                  return R {simde_mm512_add_epi32(acc, products)};
+               #endif
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Sum the lanes of an accumulator, wrapping around on overflow        
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      ::std::uint32_t DotSum(const R& acc) noexcept {
+         ::std::int32_t lanes[CountOf<R>];
+         StoreUnaligned(lanes, acc);
+         ::std::uint32_t sum = 0;
+         for (auto lane : lanes)
+            sum += static_cast<::std::uint32_t>(lane);
+         return sum;
+      }
+
+      /// The widest accumulator available                                    
+      #if LANGULUS_SIMD(512BIT)
+         using DotRegister = V512<::std::int32_t>;
+      #elif LANGULUS_SIMD(256BIT)
+         using DotRegister = V256<::std::int32_t>;
+      #elif LANGULUS_SIMD(128BIT)
+         using DotRegister = V128<::std::int32_t>;
+      #endif
+
+      /// Dot products of one vector with several others at once, so that     
+      /// the shared vector is loaded only once for all of them               
+      ///   @tparam ROWS - number of other vectors                            
+      ///   @tparam I16 - whether elements are 16bit integers, instead of     
+      ///                 unsigned and signed bytes                           
+      ///   @param a - the shared vector                                      
+      ///   @param b - the other vectors, each n elements apart               
+      ///   @param n - number of elements in each vector                      
+      ///   @param out - [out] the ROWS dot products                          
+      template<Count ROWS, bool I16, class A, class B>
+      void DotRows(const A* a, const B* b, Count n, ::std::uint32_t* out) noexcept {
+         Offset i = 0;
+         for (Offset r = 0; r < ROWS; ++r)
+            out[r] = 0;
+
+         #if LANGULUS_SIMD(128BIT)
+            using R = DotRegister;
+            constexpr Count S = I16 ? DotI16Step<R> : DotU8I8Step<R>;
+            const auto step = [&](const R& acc, Offset r, Offset at) {
+               if constexpr (I16) return DotI16SIMD(acc, a + at, b + r * n + at);
+               else               return DotU8I8SIMD(acc, a + at, b + r * n + at);
+            };
+
+            if (n >= S) {
+               // A single row gets two accumulators, to hide the latency
+               constexpr Count ACCS = ROWS == 1 ? 2 : ROWS;
+               auto acc = [&]<Offset...K>(::std::index_sequence<K...>) {
+                  return ::std::array<R, ACCS> {((void) K, R::Zero())...};
+               }(::std::make_index_sequence<ACCS> {});
+
+               if constexpr (ROWS == 1) {
+                  for (; i + S * 2 <= n; i += S * 2) {
+                     acc[0] = step(acc[0], 0, i);
+                     acc[1] = step(acc[1], 0, i + S);
+                  }
+                  acc[0] = AddSIMD(acc[0], acc[1]);
+               }
+               for (; i + S <= n; i += S) {
+                  for (Offset r = 0; r < ROWS; ++r)
+                     acc[r] = step(acc[r], r, i);
+               }
+
+               for (Offset r = 0; r < ROWS; ++r)
+                  out[r] = DotSum(acc[r]);
+            }
+         #endif
+
+         for (; i < n; ++i) {
+            for (Offset r = 0; r < ROWS; ++r) {
+               out[r] += static_cast<::std::uint32_t>(
+                  static_cast<::std::int32_t>(a[i]) * static_cast<::std::int32_t>(b[r * n + i]));
+            }
+         }
+      }
+
+      /// Get the elements of a span, checking their type                     
+      template<class T, class DATA> NOD() LANGULUS(INLINED)
+      auto DotElements(const DATA& data) noexcept {
+         const ::std::span span {data};
+         static_assert(CT::Exact<T, Decvq<typename decltype(span)::element_type>>,
+            "Unexpected element type");
+         return ::std::pair {static_cast<const T*>(span.data()), span.size()};
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Dot product of unsigned and signed bytes, i.e. quantized activations   
+   /// and weights                                                            
+   ///   @param a - span of std::uint8_t                                      
+   ///   @param b - span of std::int8_t, of the same size                     
+   ///   @return the sum of all products, wrapped around in 32bit             
+   template<class A, class B> NOD()
+   ::std::int32_t DotU8I8(const A& a, const B& b) {
+      const auto [pa, na] = Inner::DotElements<::std::uint8_t>(a);
+      const auto [pb, nb] = Inner::DotElements<::std::int8_t>(b);
+      LANGULUS_ASSUME(UserAssumes, na == nb, "Spans must be of the same size");
+
+      ::std::uint32_t result;
+      Inner::DotRows<1, false>(pa, pb, na, &result);
+      return static_cast<::std::int32_t>(result);
+   }
+
+   /// Dot product of signed 16bit integers                                   
+   ///   @param a - span of std::int16_t                                      
+   ///   @param b - span of std::int16_t, of the same size                    
+   ///   @return the sum of all products, wrapped around in 32bit             
+   template<class A, class B> NOD()
+   ::std::int32_t DotI16(const A& a, const B& b) {
+      const auto [pa, na] = Inner::DotElements<::std::int16_t>(a);
+      const auto [pb, nb] = Inner::DotElements<::std::int16_t>(b);
+      LANGULUS_ASSUME(UserAssumes, na == nb, "Spans must be of the same size");
+
+      ::std::uint32_t result;
+      Inner::DotRows<1, true>(pa, pb, na, &result);
+      return static_cast<::std::int32_t>(result);
+   }
+
+   /// Multiply a matrix of signed bytes by a vector of unsigned bytes, and   
+   /// scale each row of the result, i.e. out[r] = scales[r] * dot(row r, x)  
+   /// Four rows are multiplied at once, so that x is loaded once for all     
+   ///   @param matrix - span of std::int8_t, with out.size() rows of         
+   ///                   x.size() columns each                                
+   ///   @param x - span of std::uint8_t                                      
+   ///   @param scales - span of floats, one for each row                     
+   ///   @param out - [out] span of floats, one for each row                  
+   template<class M, class X, class S, class OUT>
+   void GemvU8I8(const M& matrix, const X& x, const S& scales, OUT&& out) {
+      const auto [pm, nm] = Inner::DotElements<::std::int8_t>(matrix);
+      const auto [px, cols] = Inner::DotElements<::std::uint8_t>(x);
+      const auto [ps, ns] = Inner::DotElements<float>(scales);
+      const ::std::span y {out};
+      static_assert(CT::Exact<float, typename decltype(y)::element_type>,
+         "Output must be a mutable span of floats");
+
+      const Count rows = y.size();
+      LANGULUS_ASSUME(UserAssumes, nm == rows * cols, "Matrix size mismatch");
+      LANGULUS_ASSUME(UserAssumes, ns == rows, "There must be a scale for each row");
+
+      constexpr Count BLOCK = 4;
+      ::std::uint32_t sums[BLOCK];
+      Offset r = 0;
+      for (; r + BLOCK <= rows; r += BLOCK) {
+         Inner::DotRows<BLOCK, false>(px, pm + r * cols, cols, sums);
+         for (Offset k = 0; k < BLOCK; ++k)
+            y[r + k] = ps[r + k] * static_cast<float>(static_cast<::std::int32_t>(sums[k]));
+      }
+      for (; r < rows; ++r) {
+         Inner::DotRows<1, false>(px, pm + r * cols, cols, sums);
+         y[r] = ps[r] * static_cast<float>(static_cast<::std::int32_t>(sums[0]));
+      }
+   }
+
+} // namespace Langulus::SIMD
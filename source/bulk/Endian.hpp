@@ -0,0 +1,136 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Batch.hpp"
+#include "../unary/ByteSwap.hpp"
+#include <bit>
+
+
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Swap the bytes of as many full registers as possible                
+      ///   @tparam R - the register to use                                   
+      ///   @param in - the elements to swap                                  
+      ///   @param out - the swapped elements, can be the same as 'in'        
+      ///   @param i - the first element to process                           
+      ///   @param count - number of elements in total                        
+      ///   @param prefetch - how to prefetch the input                       
+      ///   @return the first element that wasn't processed                   
+      template<CT::SIMD R, class T> LANGULUS(INLINED)
+      Offset ByteSwapStream(
+         const T* in, T* out, Offset i, const Count count,
+         const PrefetchPolicy& prefetch
+      ) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         return BulkWalk<L>({in}, i, count, prefetch, [&](Offset at) {
+            StoreUnaligned(out + at, ByteSwapSIMD(LoadUnaligned<R>(in + at)));
+         });
+      }
+
+      /// Swap the bytes of each element, through the widest register         
+      ///   @param in - the elements to swap                                  
+      ///   @param out - the swapped elements, can be the same as 'in'        
+      ///   @param count - number of elements                                 
+      ///   @param prefetch - how to prefetch the input                       
+      template<class T>
+      void ByteSwapBulk(
+         const T* in, T* out, const Count count,
+         const PrefetchPolicy& prefetch
+      ) noexcept {
+         (void) prefetch;
+         if constexpr (sizeof(T) == 1) {
+            if (in != out)
+               ::std::copy_n(in, count, out);
+            return;
+         }
+         else {
+            Offset i = 0;
+            if constexpr (Element<T>) {
+               #if LANGULUS_SIMD(512BIT)
+                  i = ByteSwapStream<V512<T>>(in, out, i, count, prefetch);
+               #endif
+               #if LANGULUS_SIMD(256BIT)
+                  i = ByteSwapStream<V256<T>>(in, out, i, count, prefetch);
+               #endif
+               #if LANGULUS_SIMD(128BIT)
+                  i = ByteSwapStream<V128<T>>(in, out, i, count, prefetch);
+               #endif
+            }
+
+            // Remaining elements                                       
+            for (; i < count; ++i)
+               out[i] = ByteSwapScalar(in[i]);
+         }
+      }
+
+      /// Swap the bytes of a span in place, if the host isn't big-endian     
+      template<class DATA> LANGULUS(INLINED)
+      void SwapIfLittleEndian(DATA& data) {
+         if constexpr (::std::endian::native == ::std::endian::little) {
+            const ::std::span span {data};
+            using V = typename decltype(span)::element_type;
+            using T = Deptr<decltype(BatchElement<V>())>;
+            static_assert(not ::std::is_const_v<V>, "Data must be mutable");
+            const auto flat = reinterpret_cast<T*>(span.data());
+            ByteSwapBulk(flat, flat, span.size() * (sizeof(V) / sizeof(T)), BulkPrefetch);
+         }
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   namespace Batch
+   {
+
+      /// Reverse the bytes of each element in a batch of scalars/vectors     
+      ///   @param in - the elements to swap                                  
+      ///   @param out - the output span, at least as long as 'in', can be    
+      ///                the same as 'in'                                     
+      ///   @param prefetch - how to prefetch the input                       
+      template<class IN, class OUT> LANGULUS(INLINED)
+      void ByteSwap(
+         const IN& in, OUT&& out,
+         const PrefetchPolicy& prefetch = BulkPrefetch
+      ) {
+         const ::std::span from {in};
+         const ::std::span to {out};
+         using V = Decvq<typename decltype(from)::element_type>;
+         using T = Deptr<decltype(Inner::BatchElement<V>())>;
+         static_assert(CT::Exact<V, typename decltype(to)::element_type>,
+            "Batch spans must be of the same type, and output must be mutable");
+         LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+            "Output span is too short");
+
+         Inner::ByteSwapBulk(
+            reinterpret_cast<const T*>(from.data()),
+            reinterpret_cast<T*>(to.data()),
+            from.size() * (sizeof(V) / sizeof(T)), prefetch
+         );
+      }
+
+   } // namespace Langulus::SIMD::Batch
+
+   /// Convert a buffer from the host byte order to big-endian, in place      
+   /// Does nothing on big-endian hosts                                       
+   ///   @param data - span of scalars or vectors to convert                  
+   template<class DATA> LANGULUS(INLINED)
+   void ToBigEndian(DATA&& data) {
+      Inner::SwapIfLittleEndian(data);
+   }
+
+   /// Convert a big-endian buffer (i.e. network order) to the host byte      
+   /// order, in place. Does nothing on big-endian hosts                      
+   ///   @param data - span of scalars or vectors to convert                  
+   template<class DATA> LANGULUS(INLINED)
+   void FromBigEndian(DATA&& data) {
+      Inner::SwapIfLittleEndian(data);
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,434 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../binary/Add.hpp"
+#include "../binary/Multiply.hpp"
+#include "../binary/XOr.hpp"
+#include "../binary/ShiftLeft.hpp"
+#include "../binary/ShiftRight.hpp"
+#include <cstring>
+
+
+///                                                                           
+///   Hashing kernels                                                         
+///                                                                           
+/// Crc32c is the Castagnoli CRC, as used by iSCSI, ext4 and many storage     
+/// formats. Hash64 is a multi-lane streaming hash in the spirit of XXH3 -    
+/// eight 64bit accumulators consume 64-byte stripes, each lane doing a       
+/// 32x32->64bit multiply of the input mixed with a secret, and all lanes     
+/// are scrambled every 1024 bytes. Its results are the same for any          
+/// register width, but it is not compatible with XXH3 itself.                
+/// HashIntegers hashes each integer on its own, with the finalizer of        
+/// MurmurHash3, which is a bijection - distinct keys never collide           
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Generate the lookup table of the reflected Castagnoli polynomial    
+      consteval auto Crc32cTable() {
+         ::std::array<::std::uint32_t, 256> result {};
+         for (::std::uint32_t i = 0; i < 256; ++i) {
+            ::std::uint32_t crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+               crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+            result[i] = crc;
+         }
+         return result;
+      }
+
+      constexpr auto Crc32cLookup = Crc32cTable();
+
+      /// Continue a CRC32C over some bytes                                   
+      ///   @param crc - the inverted CRC so far                              
+      ///   @param p - the bytes                                              
+      ///   @param count - number of bytes                                    
+      ///   @return the updated (still inverted) CRC                          
+      NOD() inline ::std::uint32_t Crc32cBytes(::std::uint32_t crc, const ::std::uint8_t* p, const Count count) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(SSE4_2)
+            for (; i + 8 <= count; i += 8) {
+               ::std::uint64_t word;
+               ::std::memcpy(&word, p + i, 8);
+               crc = static_cast<::std::uint32_t>(simde_mm_crc32_u64(crc, word));
+            }
+            for (; i < count; ++i)
+               crc = simde_mm_crc32_u8(crc, p[i]);
+         #else
+            for (; i < count; ++i)
+               crc = Crc32cLookup[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+         #endif
+         return crc;
+      }
+
+      constexpr ::std::uint64_t HashPrime64[5] {
+         0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+         0x85EBCA77C2B2AE63ull, 0x27D4EB2F165667C5ull
+      };
+      constexpr ::std::uint32_t HashPrime32[3] {
+         0x9E3779B1u, 0x85EBCA77u, 0xC2B2AE3Du
+      };
+
+      /// Accumulator lanes, and bytes consumed by all of them at once        
+      constexpr Count HashLanes = 8;
+      constexpr Count HashStripe = HashLanes * sizeof(::std::uint64_t);
+      /// Stripes between two scrambles                                       
+      constexpr Count HashBlockStripes = 16;
+      /// Each stripe in a block uses the secret shifted by one word, and     
+      /// scrambling uses the words after that                                
+      constexpr Count HashSecretWords = HashLanes + HashBlockStripes;
+
+      /// Generate the default secret with splitmix64                         
+      consteval auto HashSecret() {
+         ::std::array<::std::uint64_t, HashSecretWords> result {};
+         ::std::uint64_t state = 0x4C616E67756C7573ull;
+         for (auto& word : result) {
+            state += 0x9E3779B97F4A7C15ull;
+            auto z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            word = z ^ (z >> 31);
+         }
+         return result;
+      }
+
+      constexpr auto DefaultHashSecret = HashSecret();
+
+      /// Multiply the low 32 bits of each 64bit element, into 64bits         
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R MultiplyLow32(const R& a, const R& b) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {simde_mm_mul_epu32(a, b)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_mul_epu32(a, b)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) return R {simde_mm512_mul_epu32(a, b)};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Swap each pair of neighbouring 64bit elements                       
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SwapPairs64(const R& x) noexcept {
+         constexpr int imm8 = Shuffle(1, 0, 3, 2);
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {simde_mm_shuffle_epi32(x, imm8)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_shuffle_epi32(x, imm8)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>)
+               return R {simde_mm512_shuffle_epi32(x, static_cast<SIMDE_MM_PERM_ENUM>(imm8))};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Multiply 64bit elements, keeping the low 64 bits                    
+      /// Made of three 32x32->64bit multiplications, unless AVX-512DQ        
+      /// has the real thing                                                  
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R MultiplyLow64(const R& a, const R& b) noexcept {
+         #if LANGULUS_SIMD(AVX512DQ)
+            if constexpr (CT::SIMD512<R>)
+               return R {simde_mm512_mullo_epi64(a, b)};
+            else
+         #endif
+         {
+            const R cross = AddSIMD(
+               MultiplyLow32(ShiftRightBySIMD<32>(a), b),
+               MultiplyLow32(a, ShiftRightBySIMD<32>(b))
+            );
+            return AddSIMD(MultiplyLow32(a, b), ShiftLeftBySIMD<32>(cross));
+         }
+      }
+
+      /// Multiply two 64bit numbers into 128 bits, and fold the halves       
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint64_t MultiplyFold64(::std::uint64_t a, ::std::uint64_t b) noexcept {
+         const ::std::uint64_t aLo = a & 0xFFFFFFFFu, aHi = a >> 32;
+         const ::std::uint64_t bLo = b & 0xFFFFFFFFu, bHi = b >> 32;
+         const ::std::uint64_t ll = aLo * bLo;
+         const ::std::uint64_t lh = aLo * bHi;
+         const ::std::uint64_t hl = aHi * bLo;
+         const ::std::uint64_t hh = aHi * bHi;
+         const ::std::uint64_t mid = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+         const ::std::uint64_t lo = (ll & 0xFFFFFFFFu) | (mid << 32);
+         const ::std::uint64_t hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+         return lo ^ hi;
+      }
+
+      /// One stripe of a single lane - the reference for the registers       
+      ///   @param acc - the accumulators                                     
+      ///   @param data - the stripe's words                                  
+      ///   @param key - the secret words for this stripe                     
+      LANGULUS(INLINED)
+      constexpr void HashStripeScalar(::std::uint64_t* acc, const ::std::uint64_t* data, const ::std::uint64_t* key) noexcept {
+         for (Offset i = 0; i < HashLanes; ++i) {
+            const auto k = data[i] ^ key[i];
+            acc[i ^ 1] += data[i];
+            acc[i] += (k & 0xFFFFFFFFu) * (k >> 32);
+         }
+      }
+
+      /// Scramble the accumulators, so that their bits spread                
+      LANGULUS(INLINED)
+      constexpr void HashScrambleScalar(::std::uint64_t* acc, const ::std::uint64_t* key) noexcept {
+         for (Offset i = 0; i < HashLanes; ++i) {
+            auto a = acc[i];
+            a ^= a >> 47;
+            a ^= key[i];
+            acc[i] = a * HashPrime32[0];
+         }
+      }
+
+      /// Consume a number of stripes (up to a block), and scramble the       
+      /// accumulators, if the block was completed                            
+      ///   @tparam R - the register to use, void for scalar                  
+      ///   @param acc - the accumulators                                     
+      ///   @param p - the stripes                                            
+      ///   @param first - index of the first stripe in the block             
+      ///   @param stripes - number of stripes to consume                     
+      ///   @param secret - the secret                                        
+      template<class R>
+      void HashBlock(
+         ::std::uint64_t* acc, const ::std::uint8_t* p, const Offset first,
+         const Count stripes, const ::std::uint64_t* secret
+      ) noexcept {
+         if constexpr (CT::Void<R>) {
+            ::std::uint64_t data[HashLanes];
+            for (Offset s = 0; s < stripes; ++s) {
+               ::std::memcpy(data, p + s * HashStripe, HashStripe);
+               HashStripeScalar(acc, data, secret + first + s);
+            }
+            if (first + stripes == HashBlockStripes)
+               HashScrambleScalar(acc, secret + HashBlockStripes);
+         }
+         else {
+            // Keep all accumulators in registers, while in the block   
+            constexpr Count L = sizeof(R) / sizeof(::std::uint64_t);
+            constexpr Count N = HashLanes / L;
+            auto a = [acc]<Offset...K>(::std::index_sequence<K...>) {
+               return ::std::array<R, N> {LoadUnaligned<R>(acc + K * L)...};
+            }(::std::make_index_sequence<N> {});
+
+            for (Offset s = 0; s < stripes; ++s) {
+               for (Offset k = 0; k < N; ++k) {
+                  const auto data = LoadUnaligned<R>(p + s * HashStripe + k * sizeof(R));
+                  const auto key = XOrSIMD(data, LoadUnaligned<R>(secret + first + s + k * L));
+                  const R product = MultiplyLow32(key, ShiftRightBySIMD<32>(key));
+                  a[k] = AddSIMD(a[k], R {AddSIMD(product, SwapPairs64(data))});
+               }
+            }
+
+            if (first + stripes == HashBlockStripes) {
+               const R prime = Fill<sizeof(R)>(::std::uint64_t {HashPrime32[0]});
+               for (Offset k = 0; k < N; ++k) {
+                  R x = XOrSIMD(a[k], ShiftRightBySIMD<47>(a[k]));
+                  x = XOrSIMD(x, LoadUnaligned<R>(secret + HashBlockStripes + k * L));
+                  a[k] = AddSIMD(
+                     MultiplyLow32(x, prime),
+                     ShiftLeftBySIMD<32>(MultiplyLow32(ShiftRightBySIMD<32>(x), prime))
+                  );
+               }
+            }
+
+            for (Offset k = 0; k < N; ++k)
+               StoreUnaligned(acc + k * L, a[k]);
+         }
+      }
+
+      /// Hash bytes into 64 bits                                             
+      ///   @param p - the bytes                                              
+      ///   @param count - number of bytes                                    
+      ///   @param seed - the seed                                            
+      ///   @return the hash                                                  
+      NOD() inline ::std::uint64_t HashBytes(const ::std::uint8_t* p, const Count count, const ::std::uint64_t seed) noexcept {
+         #if LANGULUS_SIMD(512BIT)
+            using R = V512<::std::uint64_t>;
+         #elif LANGULUS_SIMD(256BIT)
+            using R = V256<::std::uint64_t>;
+         #elif LANGULUS_SIMD(128BIT)
+            using R = V128<::std::uint64_t>;
+         #else
+            using R = void;
+         #endif
+
+         // Derive the secret from the seed                             
+         ::std::uint64_t secret[HashSecretWords];
+         for (Offset i = 0; i < HashSecretWords; ++i)
+            secret[i] = DefaultHashSecret[i] + (i % 2 ? 0 - seed : seed);
+
+         ::std::uint64_t acc[HashLanes] {
+            HashPrime32[2], HashPrime64[0], HashPrime64[1], HashPrime64[2],
+            HashPrime64[3], HashPrime32[1], HashPrime64[4], HashPrime32[0]
+         };
+
+         // Consume full stripes, block by block                        
+         const Count stripes = count / HashStripe;
+         Offset s = 0;
+         while (s < stripes) {
+            const Offset first = s % HashBlockStripes;
+            const Count n = ::std::min(HashBlockStripes - first, stripes - s);
+            HashBlock<R>(acc, p + s * HashStripe, first, n, secret);
+            s += n;
+         }
+
+         // Consume the rest as a zero-padded stripe                    
+         if (const Count rest = count % HashStripe) {
+            alignas(64) ::std::uint8_t last[HashStripe] {};
+            ::std::memcpy(last, p + stripes * HashStripe, rest);
+            HashBlock<R>(acc, last, stripes % HashBlockStripes, 1, secret);
+         }
+
+         // Merge the lanes, and avalanche the result                   
+         ::std::uint64_t result = count * HashPrime64[0] ^ seed;
+         for (Offset i = 0; i < HashLanes; i += 2) {
+            result += MultiplyFold64(
+               acc[i]     ^ DefaultHashSecret[HashLanes + i],
+               acc[i + 1] ^ DefaultHashSecret[HashLanes + i + 1]
+            );
+         }
+         result ^= result >> 37;
+         result *= 0x165667919E3779F9ull;
+         return result ^ (result >> 32);
+      }
+
+      /// The MurmurHash3 finalizers, as scalars                              
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint32_t HashInteger(::std::uint32_t h) noexcept {
+         h ^= h >> 16;
+         h *= 0x85EBCA6Bu;
+         h ^= h >> 13;
+         h *= 0xC2B2AE35u;
+         return h ^ (h >> 16);
+      }
+
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint64_t HashInteger(::std::uint64_t h) noexcept {
+         h ^= h >> 33;
+         h *= 0xFF51AFD7ED558CCDull;
+         h ^= h >> 33;
+         h *= 0xC4CEB9FE1A85EC53ull;
+         return h ^ (h >> 33);
+      }
+
+      /// The MurmurHash3 finalizers, as registers                            
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R HashIntegerSIMD(R h) noexcept {
+         using T = TypeOf<R>;
+         if constexpr (sizeof(T) == 4) {
+            h = XOrSIMD(h, ShiftRightBySIMD<16>(h));
+            h = MultiplySIMD(h, R {Fill<sizeof(R)>(T {0x85EBCA6Bu})});
+            h = XOrSIMD(h, ShiftRightBySIMD<13>(h));
+            h = MultiplySIMD(h, R {Fill<sizeof(R)>(T {0xC2B2AE35u})});
+            return XOrSIMD(h, ShiftRightBySIMD<16>(h));
+         }
+         else {
+            h = XOrSIMD(h, ShiftRightBySIMD<33>(h));
+            h = MultiplyLow64(h, R {Fill<sizeof(R)>(T {0xFF51AFD7ED558CCDull})});
+            h = XOrSIMD(h, ShiftRightBySIMD<33>(h));
+            h = MultiplyLow64(h, R {Fill<sizeof(R)>(T {0xC4CEB9FE1A85EC53ull})});
+            return XOrSIMD(h, ShiftRightBySIMD<33>(h));
+         }
+      }
+
+      /// Hash as many integers as possible, through one register width       
+      ///   @return the first integer that wasn't hashed                      
+      template<CT::SIMD R, class T> LANGULUS(INLINED)
+      Offset HashIntegerStream(const T* in, T* out, Offset i, const Count count, const T seed) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         const R s = Fill<sizeof(R)>(seed);
+         for (; i + L <= count; i += L) {
+            StoreUnaligned(out + i, HashIntegerSIMD(
+               R {XOrSIMD(LoadUnaligned<R>(in + i), s)}));
+         }
+         return i;
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Compute the CRC32C (Castagnoli) checksum of some bytes                 
+   /// Uses the crc32 instruction when SSE4.2 is available                    
+   ///   @param data - span of bytes, or anything tightly packed              
+   ///   @param crc - a previous result, to continue a checksum in parts      
+   ///   @return the checksum                                                 
+   template<class DATA> NOD() LANGULUS(INLINED)
+   ::std::uint32_t Crc32c(const DATA& data, ::std::uint32_t crc = 0) noexcept {
+      const ::std::span span {data};
+      static_assert(::std::is_trivially_copyable_v<typename decltype(span)::element_type>,
+         "Data must be trivially copyable");
+      return ~Inner::Crc32cBytes(~crc,
+         reinterpret_cast<const ::std::uint8_t*>(span.data()), span.size_bytes());
+   }
+
+   /// Hash some bytes into 64 bits, with a multi-lane streaming hash         
+   ///   @param data - span of bytes, or anything tightly packed              
+   ///   @param seed - the seed                                               
+   ///   @return the hash                                                     
+   template<class DATA> NOD() LANGULUS(INLINED)
+   ::std::uint64_t Hash64(const DATA& data, ::std::uint64_t seed = 0) noexcept {
+      const ::std::span span {data};
+      static_assert(::std::is_trivially_copyable_v<typename decltype(span)::element_type>,
+         "Data must be trivially copyable");
+      return Inner::HashBytes(
+         reinterpret_cast<const ::std::uint8_t*>(span.data()), span.size_bytes(), seed);
+   }
+
+   /// Hash each 32bit or 64bit integer on its own, i.e. to hash join keys    
+   /// out[i] is the MurmurHash3 finalizer of (in[i] ^ seed)                  
+   ///   @param in - span of 32bit or 64bit integers                          
+   ///   @param out - span of integers of the same size, at least as long as  
+   ///                'in', can be the same as 'in'                           
+   ///   @param seed - the seed                                               
+   template<class IN, class OUT> LANGULUS(INLINED)
+   void HashIntegers(const IN& in, OUT&& out, ::std::uint64_t seed = 0) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using V = Decvq<typename decltype(from)::element_type>;
+      using W = typename decltype(to)::element_type;
+      static_assert(CT::Integer<V> and (sizeof(V) == 4 or sizeof(V) == 8),
+         "Can only hash 32bit or 64bit integers");
+      static_assert(CT::Integer<W> and sizeof(W) == sizeof(V) and not ::std::is_const_v<W>,
+         "Output must be a mutable span of integers of the same size");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+         "Output span is too short");
+
+      using T = Conditional<sizeof(V) == 4, ::std::uint32_t, ::std::uint64_t>;
+      const auto p = reinterpret_cast<const T*>(from.data());
+      const auto o = reinterpret_cast<T*>(to.data());
+      const auto s = static_cast<T>(seed);
+      const Count count = from.size();
+
+      Offset i = 0;
+      #if LANGULUS_SIMD(512BIT)
+         i = Inner::HashIntegerStream<V512<T>>(p, o, i, count, s);
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         i = Inner::HashIntegerStream<V256<T>>(p, o, i, count, s);
+      #endif
+      #if LANGULUS_SIMD(128BIT)
+         i = Inner::HashIntegerStream<V128<T>>(p, o, i, count, s);
+      #endif
+
+      // Remaining integers                                             
+      for (; i < count; ++i)
+         o[i] = Inner::HashInteger(static_cast<T>(p[i] ^ s));
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,380 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Select.hpp"
+#include "../binary/Lesser.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <thread>
+#include <vector>
+
+
+///                                                                           
+///   Histograms                                                              
+///                                                                           
+/// Incrementing the same bin for consecutive elements makes every load       
+/// wait for the previous store, so elements are counted in a few copies of   
+/// the histogram, in rotation, which are summed at the end.                  
+///                                                                           
+/// Bins of 32bit and 64bit elements are computed a register at a time: by    
+/// comparing against every edge, when there are few of them, or by a         
+/// branchless binary search, that gathers the probed edge of each lane       
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Below this many elements per thread, counting isn't split           
+      constexpr Count HistogramParallelThreshold = 65536;
+
+      /// Number of interleaved copies of a histogram                         
+      constexpr Count HistogramCopies = 4;
+
+      /// Counters are 32bit, so they're flushed after this many elements     
+      constexpr Count HistogramFlush = Count {1} << 30;
+
+      /// Up to this many edges are compared one by one, instead of searched  
+      constexpr Count HistogramLinearEdges = 8;
+
+      /// Interleaved copies of a histogram, with 32bit counters              
+      /// Each copy has an additional bin at the end, that collects the       
+      /// elements that are ignored                                           
+      struct HistogramCounters {
+         ::std::vector<::std::uint32_t> mCounts;
+         Count mStride;
+
+         explicit HistogramCounters(Count bins)
+            : mCounts((bins + 1) * HistogramCopies)
+            , mStride {bins + 1} {}
+
+         LANGULUS(INLINED)
+         void Add(Offset copy, Offset bin) noexcept {
+            ++mCounts[copy * mStride + bin];
+         }
+
+         /// Add the sum of all copies to the bins, and reset the counters    
+         template<class C>
+         void Flush(C* bins) noexcept {
+            for (Offset b = 0; b + 1 < mStride; ++b) {
+               Count total = 0;
+               for (Offset c = 0; c < HistogramCopies; ++c)
+                  total += mCounts[c * mStride + b];
+               bins[b] += static_cast<C>(total);
+            }
+            ::std::fill(mCounts.begin(), mCounts.end(), 0);
+         }
+      };
+
+      /// Load the element at a given index for each lane of a register       
+      ///   @param base - the elements                                        
+      ///   @param index - the index register, with lanes as wide as T        
+      ///   @return the gathered elements                                     
+      template<CT::SIMD R, class T = TypeOf<R>> NOD() LANGULUS(INLINED)
+      R HistogramGather(const T* base, const auto& index) noexcept {
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if constexpr (sizeof(T) == 4) {
+                  const auto g = simde_mm256_i32gather_ps(
+                     reinterpret_cast<const simde_float32*>(base), index, 4);
+                  if constexpr (CT::Float<T>) return R {g};
+                  else return R {simde_mm256_castps_si256(g)};
+               }
+               else {
+                  const auto g = simde_mm256_i64gather_pd(
+                     reinterpret_cast<const simde_float64*>(base), index, 8);
+                  if constexpr (CT::Double<T>) return R {g};
+                  else return R {simde_mm256_castpd_si256(g)};
+               }
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if constexpr (sizeof(T) == 4) {
+                  const auto g = simde_mm512_i32gather_ps(index, base, 4);
+                  if constexpr (CT::Float<T>) return R {g};
+                  else return R {simde_mm512_castps_si512(g)};
+               }
+               else {
+                  const auto g = simde_mm512_i64gather_pd(index, base, 8);
+                  if constexpr (CT::Double<T>) return R {g};
+                  else return R {simde_mm512_castpd_si512(g)};
+               }
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Count 8bit or 16bit values                                          
+      ///   @param data - the elements                                        
+      ///   @param n - number of elements                                     
+      ///   @param bins - [in/out] the counts to add to                       
+      ///   @param binCount - number of bins, values without one are ignored  
+      template<class T, class C>
+      void HistogramValues(const T* data, Count n, C* bins, Count binCount) {
+         constexpr Count range = Count {1} << (sizeof(T) * 8);
+         const Count used = ::std::min(binCount, range);
+         HistogramCounters counters {used};
+
+         for (Offset start = 0; start < n; start += HistogramFlush) {
+            const T* p = data + start;
+            const Count size = ::std::min(HistogramFlush, n - start);
+            Offset i = 0;
+
+            if (used < range) {
+               // Values without a bin are clamped to the ignored one   
+               #if LANGULUS_SIMD(512BIT)
+                  using R = V512<T>;
+               #elif LANGULUS_SIMD(256BIT)
+                  using R = V256<T>;
+               #elif LANGULUS_SIMD(128BIT)
+                  using R = V128<T>;
+               #endif
+
+               #if LANGULUS_SIMD(128BIT)
+                  constexpr Count L = CountOf<R>;
+                  const R limit = Fill<sizeof(R)>(static_cast<T>(used));
+                  T lanes[L];
+                  for (; i + L <= size; i += L) {
+                     StoreUnaligned(lanes, MinSIMD(LoadUnaligned<R>(p + i), limit));
+                     for (Offset l = 0; l < L; l += HistogramCopies) {
+                        for (Offset c = 0; c < HistogramCopies; ++c)
+                           counters.Add(c, lanes[l + c]);
+                     }
+                  }
+               #endif
+
+               for (; i < size; ++i)
+                  counters.Add(i % HistogramCopies, ::std::min<Count>(p[i], used));
+            }
+            else {
+               ::std::uint32_t* copy[HistogramCopies];
+               for (Offset c = 0; c < HistogramCopies; ++c)
+                  copy[c] = counters.mCounts.data() + c * counters.mStride;
+
+               for (; i + HistogramCopies <= size; i += HistogramCopies) {
+                  for (Offset c = 0; c < HistogramCopies; ++c)
+                     ++copy[c][p[i + c]];
+               }
+               for (; i < size; ++i)
+                  counters.Add(i % HistogramCopies, p[i]);
+            }
+
+            counters.Flush(bins);
+         }
+      }
+
+      /// Count elements between edges                                        
+      ///   @param data - the elements                                        
+      ///   @param n - number of elements                                     
+      ///   @param edges - the sorted edges                                   
+      ///   @param e - number of edges                                        
+      ///   @param bins - [in/out] the e + 1 counts to add to                 
+      template<class T, class C>
+      void HistogramEdges(const T* data, Count n, const T* edges, Count e, C* bins) {
+         // Bin e + 1 is the ignored one, where NaNs go                 
+         HistogramCounters counters {e + 1};
+         const auto scalar = [&](const T& x) -> Offset {
+            if constexpr (CT::Real<T>) {
+               if (x != x)
+                  return e + 1;
+            }
+            return ::std::upper_bound(edges, edges + e, x) - edges;
+         };
+
+         #if LANGULUS_SIMD(512BIT)
+            using R = V512<T>;
+         #elif LANGULUS_SIMD(256BIT)
+            using R = V256<T>;
+         #elif LANGULUS_SIMD(128BIT)
+            using R = V128<T>;
+         #endif
+
+         #if LANGULUS_SIMD(256BIT)
+            // The binary search probes are padded up to a power of two,
+            // with the biggest value, so that every probe is in range  
+            const Count probes = ::std::bit_ceil(e + 1);
+            ::std::vector<T> padded;
+            if constexpr (sizeof(T) >= 4) {
+               if (e > HistogramLinearEdges) {
+                  padded.assign(probes - 1, CT::Real<T>
+                     ? ::std::numeric_limits<T>::infinity()
+                     : ::std::numeric_limits<T>::max());
+                  ::std::copy(edges, edges + e, padded.begin());
+               }
+            }
+         #endif
+
+         for (Offset start = 0; start < n; start += HistogramFlush) {
+            const T* p = data + start;
+            const Count size = ::std::min(HistogramFlush, n - start);
+            Offset i = 0;
+
+            #if LANGULUS_SIMD(128BIT)
+               if constexpr (sizeof(T) >= 4) {
+                  using I = Conditional<sizeof(T) == 4, ::std::int32_t, ::std::int64_t>;
+                  using IR = Deref<decltype(Fill<sizeof(R)>(I {}))>;
+                  constexpr Count L = CountOf<R>;
+                  const IR zero = IR::Zero();
+
+                  // Count the bins, computed a register at a time      
+                  const auto stream = [&](auto&& binOf) {
+                     I lanes[L];
+                     for (; i + L <= size; i += L) {
+                        StoreUnaligned(lanes, binOf(LoadUnaligned<R>(p + i)));
+                        for (Offset l = 0; l < L; ++l) {
+                           Offset bin = ::std::min(static_cast<Offset>(lanes[l]), e);
+                           if constexpr (CT::Real<T>) {
+                              if (p[i + l] != p[i + l])
+                                 bin = e + 1;
+                           }
+                           counters.Add(l % HistogramCopies, bin);
+                        }
+                     }
+                  };
+
+                  if (e <= HistogramLinearEdges) {
+                     // The bin is the number of edges not above x      
+                     const IR one = Fill<sizeof(R)>(I {1});
+                     stream([&](const R& x) {
+                        IR bin = zero;
+                        for (Offset k = 0; k < e; ++k) {
+                           const R edge = Fill<sizeof(R)>(edges[k]);
+                           bin = AddSIMD(bin, SelectSIMD(LesserSIMD(x, edge), one, zero));
+                        }
+                        return bin;
+                     });
+                  }
+                  #if LANGULUS_SIMD(256BIT)
+                     else {
+                        // Branchless binary search - every lane moves  
+                        // past the probed edge, if it isn't above x    
+                        stream([&](const R& x) {
+                           IR bin = zero;
+                           for (Count step = probes / 2; step; step /= 2) {
+                              const IR probe = AddSIMD(bin, IR {Fill<sizeof(R)>(static_cast<I>(step - 1))});
+                              const R edge = HistogramGather<R>(padded.data(), probe);
+                              bin = AddSIMD(bin, SelectSIMD(LesserSIMD(x, edge),
+                                 IR {Fill<sizeof(R)>(static_cast<I>(step))}, zero));
+                           }
+                           return bin;
+                        });
+                     }
+                  #endif
+               }
+            #endif
+
+            for (; i < size; ++i)
+               counters.Add(i % HistogramCopies, scalar(p[i]));
+            counters.Flush(bins);
+         }
+      }
+
+      /// Count elements, optionally splitting the work between threads       
+      /// Every thread but the calling one counts in its own bins, which      
+      /// are added up at the end                                             
+      ///   @param threads - number of threads, zero to use all hardware ones 
+      ///   @param kernel - counts a part of the elements into some bins      
+      template<class T, class C, class F>
+      void HistogramSplit(const T* data, Count n, C* bins, Count binCount, Count threads, F&& kernel) {
+         if (threads == 0)
+            threads = ::std::max(::std::thread::hardware_concurrency(), 1u);
+         threads = ::std::min(threads, n / HistogramParallelThreshold);
+
+         if (threads <= 1) {
+            kernel(data, n, bins);
+            return;
+         }
+
+         const Count chunk = (n + threads - 1) / threads;
+         const auto begin = [&](Offset c) { return ::std::min(c * chunk, n); };
+         const auto size  = [&](Offset c) { return begin(c + 1) - begin(c); };
+         ::std::vector<::std::vector<C>> partial(threads - 1, ::std::vector<C>(binCount));
+         {
+            ::std::vector<::std::jthread> workers;
+            workers.reserve(threads - 1);
+            for (Offset c = 1; c < threads; ++c) {
+               workers.emplace_back([&, c] {
+                  kernel(data + begin(c), size(c), partial[c - 1].data());
+               });
+            }
+            kernel(data, size(0), bins);
+         }
+
+         for (auto& counts : partial) {
+            for (Offset b = 0; b < binCount; ++b)
+               bins[b] += counts[b];
+         }
+      }
+
+      /// Get the mutable integers of a span of bins                          
+      template<class BINS> NOD() LANGULUS(INLINED)
+      auto HistogramBins(BINS&& bins) noexcept {
+         const ::std::span span {bins};
+         using C = typename decltype(span)::element_type;
+         static_assert(CT::Integer<C> and not ::std::is_const_v<C>,
+            "Bins must be a mutable span of integers");
+         return span;
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Count how many times each value occurs                                 
+   ///   @param data - span of 8bit or 16bit unsigned integers                
+   ///   @param bins - [in/out] span of integers, bins[v] is incremented for  
+   ///                 every element v - values without a bin are ignored     
+   ///   @param threads - split very large arrays between that many threads,  
+   ///                    zero uses all hardware threads                      
+   template<class DATA, class BINS> requires requires (BINS& b) { ::std::span {b}; }
+   void Histogram(const DATA& data, BINS&& bins, Count threads = 1) {
+      const ::std::span in {data};
+      const auto out = Inner::HistogramBins(bins);
+      using T = Decvq<typename decltype(in)::element_type>;
+      static_assert(CT::Exact<T, ::std::uint8_t> or CT::Exact<T, ::std::uint16_t>,
+         "Values can be counted only for 8bit or 16bit unsigned integers");
+
+      Inner::HistogramSplit(in.data(), in.size(), out.data(), out.size(), threads,
+         [&](const T* p, Count n, auto* b) {
+            Inner::HistogramValues(p, n, b, out.size());
+         });
+   }
+
+   /// Count how many elements fall between each pair of edges                
+   ///   @param data - span of numbers                                        
+   ///   @param edges - sorted span of numbers of the same type               
+   ///   @param bins - [in/out] span of edges.size() + 1 integers, where      
+   ///                 bins[0] counts elements below edges[0], bins[i] counts 
+   ///                 elements in [edges[i - 1], edges[i]), and the last one 
+   ///                 counts elements not below the last edge - NaNs are     
+   ///                 ignored                                                
+   ///   @param threads - split very large arrays between that many threads,  
+   ///                    zero uses all hardware threads                      
+   template<class DATA, class EDGES, class BINS> requires requires (BINS& b) { ::std::span {b}; }
+   void Histogram(const DATA& data, const EDGES& edges, BINS&& bins, Count threads = 1) {
+      const ::std::span in {data};
+      const ::std::span by {edges};
+      const auto out = Inner::HistogramBins(bins);
+      using T = Decvq<typename decltype(in)::element_type>;
+      static_assert(CT::Exact<T, Decvq<typename decltype(by)::element_type>>,
+         "Edges must be of the same type as the elements");
+      static_assert(CT::Integer<T> or CT::Real<T>, "Can only count numbers");
+      LANGULUS_ASSUME(UserAssumes, out.size() == by.size() + 1,
+         "There must be one more bin than there are edges");
+      LANGULUS_ASSUME(UserAssumes, ::std::is_sorted(by.begin(), by.end()),
+         "Edges must be sorted");
+
+      Inner::HistogramSplit(in.data(), in.size(), out.data(), out.size(), threads,
+         [&](const T* p, Count n, auto* b) {
+            Inner::HistogramEdges(p, n, by.data(), by.size(), b);
+         });
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,525 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+
+
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Elements that can be moved around as raw bytes by the kernels       
+      template<class T>
+      concept InterleavableElement = CT::Dense<T>
+          and ::std::is_trivially_copyable_v<T>
+          and (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4 or sizeof(T) == 8);
+
+      /// Number of interleaved streams, that the routines are made for       
+      template<Count N>
+      constexpr bool InterleavableStreams = N == 2 or N == 3 or N == 4 or N == 8;
+
+      /// A 16-byte shuffle control for simde_mm_shuffle_epi8                 
+      using LaneControl = ::std::array<::std::int8_t, 16>;
+
+      /// Generate the shuffle controls for deinterleaving a block of N       
+      /// 128bit lanes, containing S-byte elements of N interleaved streams   
+      /// Control [c][r] gathers the bytes of stream 'c' from lane 'r' and    
+      /// zeroes the rest, so that the partial results can be OR-ed           
+      template<Count N, Count S>
+      consteval auto DeinterleaveControls() {
+         ::std::array<::std::array<LaneControl, N>, N> result {};
+         for (Offset c = 0; c < N; ++c) {
+            for (Offset r = 0; r < N; ++r) {
+               for (Offset j = 0; j < 16; ++j) {
+                  const Offset at = ((j / S) * N + c) * S + j % S;
+                  result[c][r][j] = at / 16 == r
+                     ? static_cast<::std::int8_t>(at % 16) : -1;
+               }
+            }
+         }
+         return result;
+      }
+
+      /// Generate the shuffle controls for interleaving N streams of         
+      /// S-byte elements into a block of N 128bit lanes                      
+      /// Control [r][c] gathers the bytes that go to lane 'r' from stream    
+      /// 'c' and zeroes the rest, so that the partial results can be OR-ed   
+      template<Count N, Count S>
+      consteval auto InterleaveControls() {
+         ::std::array<::std::array<LaneControl, N>, N> result {};
+         for (Offset r = 0; r < N; ++r) {
+            for (Offset c = 0; c < N; ++c) {
+               for (Offset j = 0; j < 16; ++j) {
+                  const Offset at = r * 16 + j;
+                  const Offset e  = at / S;
+                  result[r][c][j] = e % N == c
+                     ? static_cast<::std::int8_t>((e / N) * S + at % S) : -1;
+               }
+            }
+         }
+         return result;
+      }
+
+      template<Count N, Count S>
+      constexpr auto DeinterleaveControlTable = DeinterleaveControls<N, S>();
+
+      template<Count N, Count S>
+      constexpr auto InterleaveControlTable = InterleaveControls<N, S>();
+
+      /// Check if a shuffle control picks any byte at all                    
+      consteval bool Picks(const LaneControl& control) {
+         for (auto i : control)
+            if (i >= 0)
+               return true;
+         return false;
+      }
+
+      /// Broadcast a 16-byte shuffle control to all 128bit lanes of R        
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R BroadcastLane(const LaneControl& control) noexcept {
+         const auto lane = simde_mm_loadu_si128(control.data());
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {lane};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_broadcastsi128_si256(lane)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) return R {simde_mm512_broadcast_i32x4(lane)};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Load 128bit lane 'k' of R from 'from + k * stride'                  
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R LoadLanes(const ::std::byte* from, const Offset stride) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               (void) stride;
+               return R {simde_mm_loadu_si128(from)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               return R {simde_mm256_set_m128i(
+                  simde_mm_loadu_si128(from + stride),
+                  simde_mm_loadu_si128(from)
+               )};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               auto r = simde_mm512_castsi128_si512(simde_mm_loadu_si128(from));
+               r = simde_mm512_inserti32x4(r, simde_mm_loadu_si128(from + stride),     1);
+               r = simde_mm512_inserti32x4(r, simde_mm_loadu_si128(from + stride * 2), 2);
+               r = simde_mm512_inserti32x4(r, simde_mm_loadu_si128(from + stride * 3), 3);
+               return R {r};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Store 128bit lane 'k' of R to 'to + k * stride'                     
+      template<CT::SIMD R> LANGULUS(INLINED)
+      void StoreLanes(::std::byte* to, const Offset stride, const R& from) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               (void) stride;
+               simde_mm_storeu_si128(to, from);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               simde_mm_storeu_si128(to,          simde_mm256_castsi256_si128(from));
+               simde_mm_storeu_si128(to + stride, simde_mm256_extracti128_si256(from, 1));
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               simde_mm_storeu_si128(to,              simde_mm512_castsi512_si128(from));
+               simde_mm_storeu_si128(to + stride,     simde_mm512_extracti32x4_epi32(from, 1));
+               simde_mm_storeu_si128(to + stride * 2, simde_mm512_extracti32x4_epi32(from, 2));
+               simde_mm_storeu_si128(to + stride * 3, simde_mm512_extracti32x4_epi32(from, 3));
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Gather the bytes, picked by the shuffle controls, from all lanes    
+      ///   @tparam TABLE - the table of shuffle controls                     
+      ///   @tparam ROW - the row in the table, that contains one shuffle     
+      ///      control for each lane in 'from'                                
+      ///   @param from - the lanes to gather from                            
+      ///   @return the gathered bytes                                        
+      template<const auto& TABLE, Offset ROW, CT::SIMD R, Count N>
+      NOD() LANGULUS(INLINED)
+      R Gather(const ::std::array<R, N>& from) noexcept {
+         R result = R::Zero();
+         const auto pick = [&]<Offset I>() {
+            if constexpr (Picks(TABLE[ROW][I])) {
+               const auto control = BroadcastLane<R>(TABLE[ROW][I]);
+               #if LANGULUS_SIMD(128BIT)
+                  if constexpr (CT::SIMD128<R>)
+                     result = simde_mm_or_si128(result, simde_mm_shuffle_epi8(from[I], control));
+                  else
+               #endif
+               #if LANGULUS_SIMD(256BIT)
+                  if constexpr (CT::SIMD256<R>)
+                     result = simde_mm256_or_si256(result, simde_mm256_shuffle_epi8(from[I], control));
+                  else
+               #endif
+               #if LANGULUS_SIMD(512BIT)
+                  if constexpr (CT::SIMD512<R>)
+                     result = simde_mm512_or_si512(result, simde_mm512_shuffle_epi8(from[I], control));
+                  else
+               #endif
+               static_assert(false, "Unsupported register");
+            }
+         };
+
+         [&]<Offset...I>(ExpandedSequence<I...>) {
+            (pick.template operator() <I> (), ...);
+         }(Sequence<N>::Expand);
+         return result;
+      }
+
+      /// Unpack low/high 32bit or 64bit elements inside each 128bit lane     
+      template<Count S, bool HIGH, CT::SIMD R> NOD() LANGULUS(INLINED)
+      R Unpack(const R& a, const R& b) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               if      constexpr (S == 4 and not HIGH) return R {simde_mm_unpacklo_epi32(a, b)};
+               else if constexpr (S == 4)              return R {simde_mm_unpackhi_epi32(a, b)};
+               else if constexpr (S == 8 and not HIGH) return R {simde_mm_unpacklo_epi64(a, b)};
+               else if constexpr (S == 8)              return R {simde_mm_unpackhi_epi64(a, b)};
+               else static_assert(false, "Unsupported element size");
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if      constexpr (S == 4 and not HIGH) return R {simde_mm256_unpacklo_epi32(a, b)};
+               else if constexpr (S == 4)              return R {simde_mm256_unpackhi_epi32(a, b)};
+               else if constexpr (S == 8 and not HIGH) return R {simde_mm256_unpacklo_epi64(a, b)};
+               else if constexpr (S == 8)              return R {simde_mm256_unpackhi_epi64(a, b)};
+               else static_assert(false, "Unsupported element size");
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if      constexpr (S == 4 and not HIGH) return R {simde_mm512_unpacklo_epi32(a, b)};
+               else if constexpr (S == 4)              return R {simde_mm512_unpackhi_epi32(a, b)};
+               else if constexpr (S == 8 and not HIGH) return R {simde_mm512_unpacklo_epi64(a, b)};
+               else if constexpr (S == 8)              return R {simde_mm512_unpackhi_epi64(a, b)};
+               else static_assert(false, "Unsupported element size");
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Pick the even (or odd) 32bit elements of 'a' and 'b' inside each    
+      /// 128bit lane, i.e. {a0, a2, b0, b2} (or {a1, a3, b1, b3})            
+      template<bool ODD, CT::SIMD R> NOD() LANGULUS(INLINED)
+      R PickEven32(const R& a, const R& b) noexcept {
+         constexpr int imm8 = ODD ? Shuffle(3, 1, 3, 1) : Shuffle(2, 0, 2, 0);
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               return R {simde_mm_castps_si128(simde_mm_shuffle_ps(
+                  simde_mm_castsi128_ps(a), simde_mm_castsi128_ps(b), imm8))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               return R {simde_mm256_castps_si256(simde_mm256_shuffle_ps(
+                  simde_mm256_castsi256_ps(a), simde_mm256_castsi256_ps(b), imm8))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               return R {simde_mm512_castps_si512(simde_mm512_shuffle_ps(
+                  simde_mm512_castsi512_ps(a), simde_mm512_castsi512_ps(b), imm8))};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Transpose 4x4 32bit elements inside each 128bit lane                
+      /// This is its own inverse, so it both interleaves and deinterleaves   
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto Transpose4x4(const ::std::array<R, 4>& in) noexcept {
+         const auto t0 = Unpack<4, false>(in[0], in[1]);
+         const auto t1 = Unpack<4, false>(in[2], in[3]);
+         const auto t2 = Unpack<4, true> (in[0], in[1]);
+         const auto t3 = Unpack<4, true> (in[2], in[3]);
+         return ::std::array<R, 4> {
+            Unpack<8, false>(t0, t1),
+            Unpack<8, true> (t0, t1),
+            Unpack<8, false>(t2, t3),
+            Unpack<8, true> (t2, t3)
+         };
+      }
+
+      /// Deinterleave N lanes of S-byte elements into N streams              
+      ///   @param in - lane 'r' contains AoS bytes [r * 16, r * 16 + 16)     
+      ///   @return register 'c' contains the elements of stream 'c'          
+      template<Count N, Count S, CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto DeinterleaveLanes(const ::std::array<R, N>& in) noexcept {
+         if constexpr (S == 4 and N == 4)
+            return Transpose4x4(in);
+         else if constexpr (S == 4 and N == 2) {
+            return ::std::array<R, 2> {
+               PickEven32<false>(in[0], in[1]),
+               PickEven32<true> (in[0], in[1])
+            };
+         }
+         else if constexpr (S == 8 and N % 2 == 0) {
+            // Each lane holds two 64bit elements, stream 'c' is in the 
+            // lanes c/2 and N/2 + c/2, at the same half                
+            return [&]<Offset...C>(ExpandedSequence<C...>) {
+               return ::std::array<R, N> {
+                  Unpack<8, C % 2 == 1>(in[C / 2], in[N / 2 + C / 2])...
+               };
+            }(Sequence<N>::Expand);
+         }
+         else {
+            // Generic byte gather for any other combination            
+            return [&]<Offset...C>(ExpandedSequence<C...>) {
+               return ::std::array<R, N> {
+                  Gather<DeinterleaveControlTable<N, S>, C>(in)...
+               };
+            }(Sequence<N>::Expand);
+         }
+      }
+
+      /// Interleave N streams of S-byte elements into N lanes                
+      /// The exact inverse of DeinterleaveLanes                              
+      template<Count N, Count S, CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto InterleaveLanes(const ::std::array<R, N>& in) noexcept {
+         if constexpr (S == 4 and N == 4)
+            return Transpose4x4(in);
+         else if constexpr (S == 4 and N == 2) {
+            return ::std::array<R, 2> {
+               Unpack<4, false>(in[0], in[1]),
+               Unpack<4, true> (in[0], in[1])
+            };
+         }
+         else if constexpr (S == 8 and N % 2 == 0) {
+            // Lane 'r' is made of the same half of streams 2r and 2r+1,
+            // low halves going to the first N/2 lanes                  
+            return [&]<Offset...L>(ExpandedSequence<L...>) {
+               return ::std::array<R, N> {
+                  Unpack<8, (L >= N / 2)>(in[(L % (N / 2)) * 2], in[(L % (N / 2)) * 2 + 1])...
+               };
+            }(Sequence<N>::Expand);
+         }
+         else {
+            // Generic byte gather for any other combination            
+            return [&]<Offset...L>(ExpandedSequence<L...>) {
+               return ::std::array<R, N> {
+                  Gather<InterleaveControlTable<N, S>, L>(in)...
+               };
+            }(Sequence<N>::Expand);
+         }
+      }
+
+      /// Deinterleave as many structures as possible, using register R       
+      ///   @param aos - the interleaved source                               
+      ///   @param soa - the N stream destinations                            
+      ///   @param i - the structure to start from                            
+      ///   @param count - the number of structures                           
+      ///   @return the first structure that wasn't deinterleaved             
+      template<Count N, CT::SIMD R, class T> LANGULUS(INLINED)
+      Offset DeinterleaveWith(
+         const T* aos, const ::std::array<T*, N>& soa, Offset i, const Count count
+      ) noexcept {
+         // Each 128bit lane of R processes a separate block of N lanes 
+         constexpr Count K = sizeof(R) / sizeof(T);
+         constexpr Offset STRIDE = N * 16;
+
+         for (; i + K <= count; i += K) {
+            const auto from = reinterpret_cast<const ::std::byte*>(aos + i * N);
+            const auto in = [&]<Offset...L>(ExpandedSequence<L...>) {
+               return ::std::array<R, N> {LoadLanes<R>(from + L * 16, STRIDE)...};
+            }(Sequence<N>::Expand);
+
+            const auto out = DeinterleaveLanes<N, sizeof(T)>(in);
+            for (Offset c = 0; c < N; ++c)
+               StoreUnaligned(soa[c] + i, out[c]);
+         }
+         return i;
+      }
+
+      /// Interleave as many structures as possible, using register R         
+      ///   @param soa - the N stream sources                                 
+      ///   @param aos - the interleaved destination                          
+      ///   @param i - the structure to start from                            
+      ///   @param count - the number of structures                           
+      ///   @return the first structure that wasn't interleaved               
+      template<Count N, CT::SIMD R, class T> LANGULUS(INLINED)
+      Offset InterleaveWith(
+         const ::std::array<const T*, N>& soa, T* aos, Offset i, const Count count
+      ) noexcept {
+         constexpr Count K = sizeof(R) / sizeof(T);
+         constexpr Offset STRIDE = N * 16;
+
+         for (; i + K <= count; i += K) {
+            const auto in = [&]<Offset...C>(ExpandedSequence<C...>) {
+               return ::std::array<R, N> {LoadUnaligned<R>(soa[C] + i)...};
+            }(Sequence<N>::Expand);
+
+            const auto out = InterleaveLanes<N, sizeof(T)>(in);
+            const auto to = reinterpret_cast<::std::byte*>(aos + i * N);
+            for (Offset l = 0; l < N; ++l)
+               StoreLanes(to + l * 16, STRIDE, out[l]);
+         }
+         return i;
+      }
+
+      /// Deinterleave 'count' structures of N elements into N streams        
+      template<Count N, class T>
+      void Deinterleave(
+         const T* aos, const ::std::array<T*, N>& soa, const Count count
+      ) noexcept {
+         Offset i = 0;
+         if constexpr (InterleavableElement<T>) {
+            #if LANGULUS_SIMD(512BIT)
+               i = DeinterleaveWith<N, V512u8>(aos, soa, i, count);
+            #endif
+            #if LANGULUS_SIMD(256BIT)
+               i = DeinterleaveWith<N, V256u8>(aos, soa, i, count);
+            #endif
+            #if LANGULUS_SIMD(128BIT)
+               i = DeinterleaveWith<N, V128u8>(aos, soa, i, count);
+            #endif
+         }
+
+         // Remaining structures                                        
+         for (; i < count; ++i) {
+            for (Offset c = 0; c < N; ++c)
+               soa[c][i] = aos[i * N + c];
+         }
+      }
+
+      /// Interleave N streams into 'count' structures of N elements          
+      template<Count N, class T>
+      void Interleave(
+         const ::std::array<const T*, N>& soa, T* aos, const Count count
+      ) noexcept {
+         Offset i = 0;
+         if constexpr (InterleavableElement<T>) {
+            #if LANGULUS_SIMD(512BIT)
+               i = InterleaveWith<N, V512u8>(soa, aos, i, count);
+            #endif
+            #if LANGULUS_SIMD(256BIT)
+               i = InterleaveWith<N, V256u8>(soa, aos, i, count);
+            #endif
+            #if LANGULUS_SIMD(128BIT)
+               i = InterleaveWith<N, V128u8>(soa, aos, i, count);
+            #endif
+         }
+
+         // Remaining structures                                        
+         for (; i < count; ++i) {
+            for (Offset c = 0; c < N; ++c)
+               aos[i * N + c] = soa[c][i];
+         }
+      }
+
+      /// Get the element type and element count of an interleaved span       
+      /// Spans of packed vectors (like Vector<float, 3>) are flattened       
+      template<Count N, class T>
+      consteval auto AoSElement() {
+         if constexpr (CT::Vector<T>) {
+            static_assert(CountOf<T> == N,
+               "Vector size must match the number of streams");
+            static_assert(sizeof(T) == sizeof(TypeOf<T>) * N,
+               "Vectors must be tightly packed");
+            return (TypeOf<T>*) nullptr;
+         }
+         else return (T*) nullptr;
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Split an array of structures into N separate streams (AoS -> SoA)      
+   /// For example, {x0,y0,z0, x1,y1,z1, ...} -> {x0,x1,...}, {y0,y1,...}...  
+   ///   @tparam N - number of interleaved streams, i.e. 2, 3, 4 or 8         
+   ///   @param aos - the interleaved elements, or packed vectors of size N   
+   ///   @param soa - N destination streams, each at least aos/N long         
+   template<Count N, class AOS, class...SOA>
+   void Deinterleave(const AOS& aos, SOA&&...soa) {
+      static_assert(Inner::InterleavableStreams<N>,
+         "Unsupported number of streams - use 2, 3, 4 or 8");
+      static_assert(sizeof...(SOA) == N, "Provide exactly N streams");
+
+      const ::std::span from {aos};
+      using V = Decvq<typename decltype(from)::element_type>;
+      using T = Deptr<decltype(Inner::AoSElement<N, V>())>;
+      const Count count = CT::Vector<V>
+         ? from.size() : from.size() / N;
+      LANGULUS_ASSUME(UserAssumes, CT::Vector<V> or from.size() % N == 0,
+         "Interleaved span must contain whole structures");
+
+      const ::std::array<::std::span<T>, N> streams {::std::span<T> {soa}...};
+      ::std::array<T*, N> to;
+      for (Offset c = 0; c < N; ++c) {
+         LANGULUS_ASSUME(UserAssumes, streams[c].size() >= count,
+            "Stream is too short");
+         to[c] = streams[c].data();
+      }
+
+      Inner::Deinterleave<N>(reinterpret_cast<const T*>(from.data()), to, count);
+   }
+
+   /// Merge N separate streams into an array of structures (SoA -> AoS)      
+   /// For example, {x0,x1,...}, {y0,y1,...}... -> {x0,y0,z0, x1,y1,z1, ...}  
+   ///   @tparam N - number of interleaved streams, i.e. 2, 3, 4 or 8         
+   ///   @param aos - the interleaved destination, or packed vectors of N     
+   ///   @param soa - N source streams, each at least aos/N long              
+   template<Count N, class AOS, class...SOA>
+   void Interleave(AOS&& aos, const SOA&...soa) {
+      static_assert(Inner::InterleavableStreams<N>,
+         "Unsupported number of streams - use 2, 3, 4 or 8");
+      static_assert(sizeof...(SOA) == N, "Provide exactly N streams");
+
+      const ::std::span to {aos};
+      using V = typename decltype(to)::element_type;
+      static_assert(not ::std::is_const_v<V>, "Destination must be mutable");
+      using T = Deptr<decltype(Inner::AoSElement<N, V>())>;
+      const Count count = CT::Vector<V>
+         ? to.size() : to.size() / N;
+      LANGULUS_ASSUME(UserAssumes, CT::Vector<V> or to.size() % N == 0,
+         "Interleaved span must contain whole structures");
+
+      const ::std::array<::std::span<const T>, N> streams {::std::span<const T> {soa}...};
+      ::std::array<const T*, N> from;
+      for (Offset c = 0; c < N; ++c) {
+         LANGULUS_ASSUME(UserAssumes, streams[c].size() >= count,
+            "Stream is too short");
+         from[c] = streams[c].data();
+      }
+
+      Inner::Interleave<N>(from, reinterpret_cast<T*>(to.data()), count);
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,357 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Fill.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+
+///                                                                           
+///   Affine quantization                                                     
+///                                                                           
+/// Floats are multiplied by the reciprocal of the scale, rounded to the      
+/// nearest integer (ties to even), offset by the zero point, and packed to   
+/// the narrow type with saturation. Rounding happens before the zero point   
+/// is added, and the zero point is subtracted before scaling back, so that   
+/// every step but the multiplication is exact, and results are identical     
+/// with and without SIMD.                                                    
+///                                                                           
+/// Per-channel quantization splits the elements into as many equal rows as   
+/// there are scales, i.e. the rows of a matrix, each with its own scale      
+///                                                                           
+namespace Langulus::CT
+{
+
+   /// Integers that floats can be quantized to                               
+   template<class...T>
+   concept Quantized = ((CT::Exact<T, ::std::int8_t>
+                      or CT::Exact<T, ::std::uint8_t>
+                      or CT::Exact<T, ::std::int16_t>) and ...);
+
+} // namespace Langulus::CT
+
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Scaled values are clamped to this magnitude before they are         
+      /// converted, so that they stay in 32bit after adding the zero point   
+      constexpr float QuantizeLimit = 1073741824.0f;
+
+      /// Quantize a single float                                             
+      ///   @param x - the float                                              
+      ///   @param inv - reciprocal of the scale                              
+      ///   @param zp - the zero point                                        
+      ///   @return the quantized integer, NaN is treated as zero             
+      template<CT::Quantized T> NOD() LANGULUS(INLINED)
+      T QuantizeScalar(float x, float inv, ::std::int32_t zp) noexcept {
+         float p = x * inv;
+         if (p != p)
+            p = 0;
+         p = ::std::clamp(p, -QuantizeLimit, QuantizeLimit);
+         const auto q = static_cast<::std::int32_t>(::std::nearbyint(p)) + zp;
+         return static_cast<T>(::std::clamp<::std::int32_t>(q,
+            ::std::numeric_limits<T>::min(), ::std::numeric_limits<T>::max()));
+      }
+
+      /// Scale a register of floats, round them, and add the zero point      
+      ///   @param x - the floats                                             
+      ///   @param inv - reciprocal of the scale, in all lanes                
+      ///   @param zp - the zero point, in all 32bit lanes                    
+      ///   @return the integers, not yet saturated                           
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto QuantizeRound(const R& x, const R& inv, const auto& zp) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               auto p = simde_mm_mul_ps(x, inv);
+               p = simde_mm_and_ps(p, simde_mm_cmpeq_ps(p, p));
+               p = simde_mm_min_ps(simde_mm_max_ps(p, simde_mm_set1_ps(-QuantizeLimit)), simde_mm_set1_ps(QuantizeLimit));
+               return simde_mm_add_epi32(simde_mm_cvtps_epi32(p), zp);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               auto p = simde_mm256_mul_ps(x, inv);
+               p = simde_mm256_and_ps(p, simde_mm256_cmp_ps(p, p, SIMDE_CMP_EQ_OQ));
+               p = simde_mm256_min_ps(simde_mm256_max_ps(p, simde_mm256_set1_ps(-QuantizeLimit)), simde_mm256_set1_ps(QuantizeLimit));
+               return simde_mm256_add_epi32(simde_mm256_cvtps_epi32(p), zp);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               auto p = simde_mm512_mul_ps(x, inv);
+               p = simde_mm512_maskz_mov_ps(simde_mm512_cmp_ps_mask(p, p, SIMDE_CMP_EQ_OQ), p);
+               p = simde_mm512_min_ps(simde_mm512_max_ps(p, simde_mm512_set1_ps(-QuantizeLimit)), simde_mm512_set1_ps(QuantizeLimit));
+               return simde_mm512_add_epi32(simde_mm512_cvtps_epi32(p), zp);
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Number of float registers that are packed into a single store       
+      template<CT::SIMD R, CT::Quantized T>
+      constexpr Count QuantizePack = CT::SIMD512<R> ? 1 : 4 / sizeof(T);
+
+      /// Saturate and store integers, rounded by QuantizeRound               
+      ///   @param out - [out] where to store CountOf<R> * QuantizePack<R, T> 
+      ///                elements                                             
+      ///   @param q - the integers                                           
+      template<CT::SIMD R, CT::Quantized T, class Q> LANGULUS(INLINED)
+      void QuantizeStore(T* out, const Q& q) noexcept {
+         constexpr bool BYTES = sizeof(T) == 1;
+         constexpr bool SIGNED = CT::Signed<T>;
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               const auto lo = simde_mm_packs_epi32(q[0], q[1]);
+               if constexpr (BYTES) {
+                  const auto hi = simde_mm_packs_epi32(q[2], q[3]);
+                  const auto v = SIGNED ? simde_mm_packs_epi16(lo, hi) : simde_mm_packus_epi16(lo, hi);
+                  simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(out), v);
+               }
+               else simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(out), lo);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               // Packing works inside 128bit lanes, so elements are    
+               // put back in order afterwards                          
+               const auto lo = simde_mm256_packs_epi32(q[0], q[1]);
+               if constexpr (BYTES) {
+                  const auto hi = simde_mm256_packs_epi32(q[2], q[3]);
+                  const auto v = SIGNED ? simde_mm256_packs_epi16(lo, hi) : simde_mm256_packus_epi16(lo, hi);
+                  simde_mm256_storeu_si256(reinterpret_cast<simde__m256i*>(out),
+                     simde_mm256_permutevar8x32_epi32(v, simde_mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+               }
+               else {
+                  simde_mm256_storeu_si256(reinterpret_cast<simde__m256i*>(out),
+                     simde_mm256_permute4x64_epi64(lo, 0xD8));
+               }
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if constexpr (not BYTES)
+                  simde_mm256_storeu_si256(reinterpret_cast<simde__m256i*>(out), simde_mm512_cvtsepi32_epi16(q[0]));
+               else if constexpr (SIGNED)
+                  simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(out), simde_mm512_cvtsepi32_epi8(q[0]));
+               else {
+                  const auto positive = simde_mm512_max_epi32(q[0], simde_mm512_setzero_si512());
+                  simde_mm_storeu_si128(reinterpret_cast<simde__m128i*>(out), simde_mm512_cvtusepi32_epi8(positive));
+               }
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Load narrow integers, widen them to 32bit, and subtract the zero    
+      /// point                                                               
+      ///   @param in - CountOf<R> integers are read                          
+      ///   @param zp - the zero point, in all 32bit lanes                    
+      ///   @return the 32bit integers                                        
+      template<CT::SIMD R, CT::Quantized T> NOD() LANGULUS(INLINED)
+      auto DequantizeLoad(const T* in, const auto& zp) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               simde__m128i q;
+               if constexpr (CT::Exact<T, ::std::int8_t>)
+                  q = simde_mm_cvtepi8_epi32(simde_mm_loadu_si32(in));
+               else if constexpr (CT::Exact<T, ::std::uint8_t>)
+                  q = simde_mm_cvtepu8_epi32(simde_mm_loadu_si32(in));
+               else
+                  q = simde_mm_cvtepi16_epi32(simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(in)));
+               return simde_mm_sub_epi32(q, zp);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               simde__m256i q;
+               if constexpr (CT::Exact<T, ::std::int8_t>)
+                  q = simde_mm256_cvtepi8_epi32(simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(in)));
+               else if constexpr (CT::Exact<T, ::std::uint8_t>)
+                  q = simde_mm256_cvtepu8_epi32(simde_mm_loadl_epi64(reinterpret_cast<const simde__m128i*>(in)));
+               else
+                  q = simde_mm256_cvtepi16_epi32(simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(in)));
+               return simde_mm256_sub_epi32(q, zp);
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               simde__m512i q;
+               if constexpr (CT::Exact<T, ::std::int8_t>)
+                  q = simde_mm512_cvtepi8_epi32(simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(in)));
+               else if constexpr (CT::Exact<T, ::std::uint8_t>)
+                  q = simde_mm512_cvtepu8_epi32(simde_mm_loadu_si128(reinterpret_cast<const simde__m128i*>(in)));
+               else
+                  q = simde_mm512_cvtepi16_epi32(simde_mm256_loadu_si256(reinterpret_cast<const simde__m256i*>(in)));
+               return simde_mm512_sub_epi32(q, zp);
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// The widest register of floats available                             
+      #if LANGULUS_SIMD(512BIT)
+         using QuantizeRegister = V512<float>;
+      #elif LANGULUS_SIMD(256BIT)
+         using QuantizeRegister = V256<float>;
+      #elif LANGULUS_SIMD(128BIT)
+         using QuantizeRegister = V128<float>;
+      #endif
+
+      /// Quantize floats with a single scale and zero point                  
+      template<CT::Quantized T>
+      void QuantizeBulk(const float* in, Count n, float scale, ::std::int32_t zp, T* out) noexcept {
+         const float inv = 1.0f / scale;
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            using R = QuantizeRegister;
+            constexpr Count L = CountOf<R>;
+            constexpr Count K = QuantizePack<R, T>;
+            const R invs = Fill<sizeof(R)>(inv);
+            const auto zps = Fill<sizeof(R)>(zp);
+            for (; i + L * K <= n; i += L * K) {
+               const auto q = [&]<Offset...J>(::std::index_sequence<J...>) {
+                  return ::std::array {QuantizeRound(LoadUnaligned<R>(in + i + J * L), invs, zps)...};
+               }(::std::make_index_sequence<K> {});
+               QuantizeStore<R>(out + i, q);
+            }
+         #endif
+
+         for (; i < n; ++i)
+            out[i] = QuantizeScalar<T>(in[i], inv, zp);
+      }
+
+      /// Dequantize integers with a single scale and zero point              
+      template<CT::Quantized T>
+      void DequantizeBulk(const T* in, Count n, float scale, ::std::int32_t zp, float* out) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            using R = QuantizeRegister;
+            constexpr Count L = CountOf<R>;
+            const R scales = Fill<sizeof(R)>(scale);
+            const auto zps = Fill<sizeof(R)>(zp);
+            for (; i + L <= n; i += L) {
+               const auto q = DequantizeLoad<R>(in + i, zps);
+               #if LANGULUS_SIMD(512BIT)
+                  StoreUnaligned(out + i, R {simde_mm512_mul_ps(simde_mm512_cvtepi32_ps(q), scales)});
+               #elif LANGULUS_SIMD(256BIT)
+                  StoreUnaligned(out + i, R {simde_mm256_mul_ps(simde_mm256_cvtepi32_ps(q), scales)});
+               #else
+                  StoreUnaligned(out + i, R {simde_mm_mul_ps(simde_mm_cvtepi32_ps(q), scales)});
+               #endif
+            }
+         #endif
+
+         for (; i < n; ++i)
+            out[i] = static_cast<float>(static_cast<::std::int32_t>(in[i]) - zp) * scale;
+      }
+
+      /// Call f for each channel, i.e. each row of elements                  
+      ///   @param n - number of elements, a multiple of the channel count    
+      ///   @param channels - number of channels                              
+      ///   @param f - called with the offset and size of each row            
+      template<class F> LANGULUS(INLINED)
+      void QuantizeChannels(Count n, Count channels, F&& f) {
+         LANGULUS_ASSUME(UserAssumes, channels > 0 and n % channels == 0,
+            "Elements must split evenly between the channels");
+         const Count row = n / channels;
+         for (Offset c = 0; c < channels; ++c)
+            f(c, c * row, row);
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Quantize floats, i.e. out[i] = saturate(round(in[i] / scale) + zp)     
+   /// Rounding is to the nearest integer, ties to even, NaN becomes zp       
+   ///   @param in - span of floats                                           
+   ///   @param scale - the quantization step                                 
+   ///   @param zeroPoint - the integer that represents zero                  
+   ///   @param out - [out] span of std::int8_t, std::uint8_t or              
+   ///                std::int16_t, at least as long as 'in'                  
+   template<class IN, class OUT>
+   void Quantize(const IN& in, float scale, ::std::int32_t zeroPoint, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using T = typename decltype(to)::element_type;
+      static_assert(CT::Exact<float, Decvq<typename decltype(from)::element_type>>,
+         "Only floats can be quantized");
+      static_assert(CT::Quantized<T>, "Unsupported quantized type");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(), "Output span is too short");
+
+      Inner::QuantizeBulk(from.data(), from.size(), scale, zeroPoint, to.data());
+   }
+
+   /// Quantize floats with a scale and zero point for each channel           
+   ///   @param in - span of floats, split evenly between the channels        
+   ///   @param scales - span of floats, one for each channel                 
+   ///   @param zeroPoints - span of std::int32_t, one for each channel       
+   ///   @param out - [out] span of std::int8_t, std::uint8_t or              
+   ///                std::int16_t, at least as long as 'in'                  
+   template<class IN, class S, class Z, class OUT> requires requires (const S& s) { ::std::span {s}; }
+   void Quantize(const IN& in, const S& scales, const Z& zeroPoints, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      const ::std::span s {scales};
+      const ::std::span z {zeroPoints};
+      LANGULUS_ASSUME(UserAssumes, s.size() == z.size(),
+         "There must be a zero point for each scale");
+      Inner::QuantizeChannels(from.size(), s.size(), [&](Offset c, Offset at, Count row) {
+         Quantize(from.subspan(at, row), s[c], z[c], to.subspan(at, row));
+      });
+   }
+
+   /// Dequantize integers, i.e. out[i] = (in[i] - zp) * scale                
+   ///   @param in - span of std::int8_t, std::uint8_t or std::int16_t        
+   ///   @param scale - the quantization step                                 
+   ///   @param zeroPoint - the integer that represents zero                  
+   ///   @param out - [out] span of floats, at least as long as 'in'          
+   template<class IN, class OUT>
+   void Dequantize(const IN& in, float scale, ::std::int32_t zeroPoint, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      using T = Decvq<typename decltype(from)::element_type>;
+      static_assert(CT::Exact<float, typename decltype(to)::element_type>,
+         "Output must be a mutable span of floats");
+      static_assert(CT::Quantized<T>, "Unsupported quantized type");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(), "Output span is too short");
+
+      Inner::DequantizeBulk(static_cast<const T*>(from.data()), from.size(), scale, zeroPoint, to.data());
+   }
+
+   /// Dequantize integers with a scale and zero point for each channel       
+   ///   @param in - span of integers, split evenly between the channels      
+   ///   @param scales - span of floats, one for each channel                 
+   ///   @param zeroPoints - span of std::int32_t, one for each channel       
+   ///   @param out - [out] span of floats, at least as long as 'in'          
+   template<class IN, class S, class Z, class OUT> requires requires (const S& s) { ::std::span {s}; }
+   void Dequantize(const IN& in, const S& scales, const Z& zeroPoints, OUT&& out) {
+      const ::std::span from {in};
+      const ::std::span to {out};
+      const ::std::span s {scales};
+      const ::std::span z {zeroPoints};
+      LANGULUS_ASSUME(UserAssumes, s.size() == z.size(),
+         "There must be a zero point for each scale");
+      Inner::QuantizeChannels(from.size(), s.size(), [&](Offset c, Offset at, Count row) {
+         Dequantize(from.subspan(at, row), s[c], z[c], to.subspan(at, row));
+      });
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,363 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Fill.hpp"
+#include "../binary/Add.hpp"
+#include "../binary/Min.hpp"
+#include "../binary/Max.hpp"
+#include "../binary/XOr.hpp"
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <thread>
+#include <vector>
+
+
+///                                                                           
+///   Prefix scans                                                            
+///                                                                           
+/// Every 128bit register is scanned in log2(lanes) steps, by combining it    
+/// with a copy of itself, shifted up by 1, 2, 4... elements. The running     
+/// total of all previous registers is then combined with the result, and     
+/// the last element is broadcasted as the total for the next register.       
+/// Wider registers aren't used, because shifting elements across their       
+/// 128bit lanes costs as much as it saves                                    
+///                                                                           
+namespace Langulus::SIMD
+{
+
+   /// The operators available for scanning                                   
+   /// Each provides an identity element, a 128bit register kernel (which     
+   /// returns Unsupported if there's no instruction for T), and a scalar     
+   /// routine, that is used for the remainder                                
+   namespace ScanOp
+   {
+
+      /// Running sum - integers wrap around on overflow, the same way        
+      /// std::inclusive_scan does it                                         
+      struct Add {
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Identity() noexcept {
+            return T {};
+         }
+
+         template<CT::SIMD128 R> NOD() LANGULUS(INLINED)
+         static auto Register(const R& lhs, const R& rhs) noexcept {
+            using T = TypeOf<R>;
+            if      constexpr (CT::Integer8<T>)  return R {simde_mm_add_epi8 (lhs, rhs)};
+            else if constexpr (CT::Integer16<T>) return R {simde_mm_add_epi16(lhs, rhs)};
+            else return Inner::AddSIMD(lhs, rhs);
+         }
+
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Scalar(const T& lhs, const T& rhs) noexcept {
+            return static_cast<T>(lhs + rhs);
+         }
+      };
+
+      /// Running maximum                                                     
+      struct Max {
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Identity() noexcept {
+            if constexpr (::std::numeric_limits<T>::has_infinity)
+               return -::std::numeric_limits<T>::infinity();
+            else
+               return ::std::numeric_limits<T>::lowest();
+         }
+
+         template<CT::SIMD128 R> NOD() LANGULUS(INLINED)
+         static auto Register(const R& lhs, const R& rhs) noexcept {
+            return Inner::MaxSIMD(lhs, rhs);
+         }
+
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Scalar(const T& lhs, const T& rhs) noexcept {
+            return lhs < rhs ? rhs : lhs;
+         }
+      };
+
+      /// Running minimum                                                     
+      struct Min {
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Identity() noexcept {
+            if constexpr (::std::numeric_limits<T>::has_infinity)
+               return ::std::numeric_limits<T>::infinity();
+            else
+               return ::std::numeric_limits<T>::max();
+         }
+
+         template<CT::SIMD128 R> NOD() LANGULUS(INLINED)
+         static auto Register(const R& lhs, const R& rhs) noexcept {
+            return Inner::MinSIMD(lhs, rhs);
+         }
+
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Scalar(const T& lhs, const T& rhs) noexcept {
+            return rhs < lhs ? rhs : lhs;
+         }
+      };
+
+      /// Running exclusive-or, available only for integers                   
+      struct XOr {
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Identity() noexcept {
+            static_assert(CT::Integer<T>, "XOr scan works only for integers");
+            return T {};
+         }
+
+         template<CT::SIMD128 R> NOD() LANGULUS(INLINED)
+         static auto Register(const R& lhs, const R& rhs) noexcept {
+            return Inner::XOrSIMD(lhs, rhs);
+         }
+
+         template<class T> NOD() LANGULUS(INLINED)
+         static constexpr T Scalar(const T& lhs, const T& rhs) noexcept {
+            return static_cast<T>(lhs ^ rhs);
+         }
+      };
+
+   } // namespace Langulus::SIMD::ScanOp
+
+   namespace Inner
+   {
+
+      /// Below this many elements per thread, scanning isn't split           
+      constexpr Count ScanParallelThreshold = 65536;
+
+      /// Check if a scan operator has a register kernel for R                
+      template<class OP, class R>
+      concept ScanSupports = requires (const R& r) {
+         {OP::Register(r, r)} -> CT::SIMD;
+      };
+
+      /// Shift the elements of a register up by B bytes, filling the         
+      /// vacated elements with the top elements of 'fill'                    
+      ///   @param x - the register to shift                                  
+      ///   @param fill - the register to shift in from below                 
+      ///   @return the shifted register                                      
+      template<Count B, CT::SIMD128 R> NOD() LANGULUS(INLINED)
+      R ShiftElementsUp(const R& x, const R& fill) noexcept {
+         using T = TypeOf<R>;
+         if constexpr (CT::Float<T>) {
+            return R {simde_mm_castsi128_ps(simde_mm_alignr_epi8(
+               simde_mm_castps_si128(x), simde_mm_castps_si128(fill), 16 - B))};
+         }
+         else if constexpr (CT::Double<T>) {
+            return R {simde_mm_castsi128_pd(simde_mm_alignr_epi8(
+               simde_mm_castpd_si128(x), simde_mm_castpd_si128(fill), 16 - B))};
+         }
+         else return R {simde_mm_alignr_epi8(x, fill, 16 - B)};
+      }
+
+      /// Broadcast the last element of a register to all of its elements     
+      template<CT::SIMD128 R> NOD() LANGULUS(INLINED)
+      R BroadcastLast(const R& x) noexcept {
+         using T = TypeOf<R>;
+         if constexpr (CT::Float<T>)
+            return R {simde_mm_shuffle_ps(x, x, Shuffle(3, 3, 3, 3))};
+         else if constexpr (CT::Double<T>)
+            return R {simde_mm_unpackhi_pd(x, x)};
+         else if constexpr (sizeof(T) == 4)
+            return R {simde_mm_shuffle_epi32(x, Shuffle(3, 3, 3, 3))};
+         else if constexpr (sizeof(T) == 8)
+            return R {simde_mm_unpackhi_epi64(x, x)};
+         else {
+            constexpr auto control = [] {
+               ::std::array<::std::int8_t, 16> result {};
+               for (Offset j = 0; j < 16; ++j)
+                  result[j] = static_cast<::std::int8_t>(16 - sizeof(T) + j % sizeof(T));
+               return result;
+            }();
+            return R {simde_mm_shuffle_epi8(x, simde_mm_loadu_si128(control.data()))};
+         }
+      }
+
+      /// Inclusive scan of the elements inside a single register             
+      ///   @param x - the register to scan                                   
+      ///   @param identity - register filled with the identity of OP         
+      ///   @return the scanned register                                      
+      template<class OP, CT::SIMD128 R> NOD() LANGULUS(INLINED)
+      R ScanRegister(R x, const R& identity) noexcept {
+         using T = TypeOf<R>;
+         constexpr Count STEPS = ::std::bit_width(16 / sizeof(T)) - 1;
+         [&]<Offset...K>(ExpandedSequence<K...>) {
+            ((x = R {OP::Register(x,
+               ShiftElementsUp<(Count {1} << K) * sizeof(T)>(x, identity))}), ...);
+         }(Sequence<STEPS>::Expand);
+         return x;
+      }
+
+      /// Scan a contiguous chunk of elements                                 
+      ///   @tparam INCLUSIVE - whether out[i] includes in[i]                 
+      ///   @param in - the elements to scan                                  
+      ///   @param out - the output, can be the same as 'in'                  
+      ///   @param count - number of elements                                 
+      ///   @param carry - the total of everything before 'in'                
+      ///   @return the total, including the whole chunk                      
+      template<class OP, bool INCLUSIVE, class T>
+      T ScanChunk(const T* in, T* out, const Count count, T carry) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (ScanSupports<OP, V128<T>>) {
+               using R = V128<T>;
+               constexpr Count L = sizeof(R) / sizeof(T);
+               const T id = OP::template Identity<T>();
+               const R identity = Fill<16>(id);
+               R total = Fill<16>(carry);
+
+               for (; i + L <= count; i += L) {
+                  const R x = OP::Register(
+                     ScanRegister<OP>(LoadUnaligned<R>(in + i), identity), total);
+                  if constexpr (INCLUSIVE)
+                     StoreUnaligned(out + i, x);
+                  else
+                     StoreUnaligned(out + i, ShiftElementsUp<sizeof(T)>(x, total));
+                  total = BroadcastLast(x);
+               }
+
+               if (i) {
+                  T lanes[L];
+                  StoreUnaligned(lanes, total);
+                  carry = lanes[0];
+               }
+            }
+         #endif
+
+         // Remaining elements                                          
+         for (; i < count; ++i) {
+            const T next = OP::Scalar(carry, in[i]);
+            out[i] = INCLUSIVE ? next : carry;
+            carry = next;
+         }
+         return carry;
+      }
+
+      /// Combine all elements of a chunk, without writing anything           
+      ///   @param in - the elements to combine                               
+      ///   @param count - number of elements                                 
+      ///   @return the total                                                 
+      template<class OP, class T>
+      T ScanReduce(const T* in, const Count count) noexcept {
+         T total = OP::template Identity<T>();
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (ScanSupports<OP, V128<T>>) {
+               using R = V128<T>;
+               constexpr Count L = sizeof(R) / sizeof(T);
+               if (count >= L) {
+                  R accum = Fill<16>(total);
+                  for (; i + L <= count; i += L)
+                     accum = R {OP::Register(accum, LoadUnaligned<R>(in + i))};
+
+                  T lanes[L];
+                  StoreUnaligned(lanes, accum);
+                  for (auto lane : lanes)
+                     total = OP::Scalar(total, lane);
+               }
+            }
+         #endif
+
+         for (; i < count; ++i)
+            total = OP::Scalar(total, in[i]);
+         return total;
+      }
+
+      /// Scan elements, optionally splitting the work between threads        
+      /// The first pass combines each chunk (the first one is directly       
+      /// scanned instead), then the chunk totals are scanned serially, and   
+      /// the second pass scans all other chunks, starting from their totals  
+      ///   @param threads - number of threads, zero to use all hardware ones 
+      template<class OP, bool INCLUSIVE, class T>
+      void Scan(const T* in, T* out, const Count count, Count threads) {
+         if (threads == 0)
+            threads = ::std::max(::std::thread::hardware_concurrency(), 1u);
+         threads = ::std::min(threads, count / ScanParallelThreshold);
+
+         const T identity = OP::template Identity<T>();
+         if (threads <= 1) {
+            ScanChunk<OP, INCLUSIVE>(in, out, count, identity);
+            return;
+         }
+
+         const Count chunk = (count + threads - 1) / threads;
+         const auto begin = [&](Offset c) { return ::std::min(c * chunk, count); };
+         const auto size  = [&](Offset c) { return begin(c + 1) - begin(c); };
+         ::std::vector<T> totals(threads, identity);
+
+         // First pass - the calling thread scans the first chunk       
+         {
+            ::std::vector<::std::jthread> workers;
+            workers.reserve(threads - 2);
+            for (Offset c = 1; c < threads - 1; ++c) {
+               workers.emplace_back([&, c] {
+                  totals[c] = ScanReduce<OP>(in + begin(c), size(c));
+               });
+            }
+            totals[0] = ScanChunk<OP, INCLUSIVE>(in, out, size(0), identity);
+         }
+
+         // Carry the totals                                            
+         for (Offset c = 1; c < threads; ++c)
+            totals[c] = OP::Scalar(totals[c - 1], totals[c]);
+
+         // Second pass                                                 
+         ::std::vector<::std::jthread> workers;
+         workers.reserve(threads - 2);
+         for (Offset c = 1; c < threads - 1; ++c) {
+            workers.emplace_back([&, c] {
+               ScanChunk<OP, INCLUSIVE>(in + begin(c), out + begin(c), size(c), totals[c - 1]);
+            });
+         }
+
+         const Offset last = threads - 1;
+         ScanChunk<OP, INCLUSIVE>(in + begin(last), out + begin(last), size(last), totals[last - 1]);
+      }
+
+      /// Validate the spans, and scan                                        
+      template<class OP, bool INCLUSIVE, class IN, class OUT>
+      void Scan(const IN& in, OUT&& out, const Count threads) {
+         const ::std::span from {in};
+         const ::std::span to {out};
+         using T = Decvq<typename decltype(from)::element_type>;
+         static_assert(CT::Exact<T, typename decltype(to)::element_type>,
+            "Scan spans must be of the same type, and output must be mutable");
+         static_assert(CT::Integer<T> or CT::Real<T>,
+            "Only numbers can be scanned");
+         LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+            "Output span is too short");
+
+         Scan<OP, INCLUSIVE>(from.data(), to.data(), from.size(), threads);
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Inclusive prefix scan, i.e. out[i] = in[0] op in[1] op ... op in[i]    
+   ///   @tparam OP - the operator, i.e. ScanOp::Add/Max/Min/XOr              
+   ///   @param in - the elements to scan                                     
+   ///   @param out - the output, at least as long as 'in', can be the same   
+   ///   @param threads - split very large arrays between that many threads,  
+   ///                    zero uses all hardware threads                      
+   template<class OP = ScanOp::Add, class IN, class OUT> LANGULUS(INLINED)
+   void InclusiveScan(const IN& in, OUT&& out, Count threads = 1) {
+      Inner::Scan<OP, true>(in, out, threads);
+   }
+
+   /// Exclusive prefix scan, i.e. out[i] = in[0] op in[1] op ... op in[i-1]  
+   /// out[0] is the identity of the operator, i.e. zero for ScanOp::Add      
+   ///   @tparam OP - the operator, i.e. ScanOp::Add/Max/Min/XOr              
+   ///   @param in - the elements to scan                                     
+   ///   @param out - the output, at least as long as 'in', can be the same   
+   ///   @param threads - split very large arrays between that many threads,  
+   ///                    zero uses all hardware threads                      
+   template<class OP = ScanOp::Add, class IN, class OUT> LANGULUS(INLINED)
+   void ExclusiveScan(const IN& in, OUT&& out, Count threads = 1) {
+      Inner::Scan<OP, false>(in, out, threads);
+   }
+
+} // namespace Langulus::SIMD
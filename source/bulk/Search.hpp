@@ -0,0 +1,353 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../Fill.hpp"
+#include "../binary/Equals.hpp"
+#include <bit>
+
+
+///                                                                           
+///   Vectorized search over buffers of characters                            
+///                                                                           
+/// Each register is compared against the needle, and the comparison is       
+/// turned into a bitmask, so positions are extracted with a single           
+/// tzcnt and counts with a single popcnt. Bounded scans read the last        
+/// partial register in one go if it doesn't cross a page, and NUL-           
+/// terminated scans only ever do aligned loads - neither can fault, since    
+/// memory protection works with whole pages                                  
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Size of the smallest page on any supported platform                 
+      constexpr Count SearchPageSize = 4096;
+
+      /// The unsigned integer used to compare characters of type T           
+      template<class T>
+      using SearchElement = Conditional<sizeof(T) == 1, ::std::uint8_t,
+                            Conditional<sizeof(T) == 2, ::std::uint16_t,
+                                                        ::std::uint32_t>>;
+
+      /// How many mask bits correspond to one element of the register        
+      /// movemask_epi8 gives a bit per byte, AVX-512 gives a bit per element 
+      template<CT::SIMD R>
+      constexpr Count MatchStride = CT::SIMD512<R> ? 1 : sizeof(TypeOf<R>);
+
+      /// Compare all elements with the needle, and get a bitmask of matches  
+      ///   @param data - the register to search in                           
+      ///   @param needle - a register filled with the searched element       
+      ///   @return a bit (or MatchStride<R> bits) for each match             
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto MatchMask(const R& data, const R& needle) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               return ::std::uint64_t {static_cast<::std::uint16_t>(
+                  simde_mm_movemask_epi8(EqualsSIMD(data, needle)))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               return ::std::uint64_t {static_cast<::std::uint32_t>(
+                  simde_mm256_movemask_epi8(EqualsSIMD(data, needle)))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using T = TypeOf<R>;
+               if      constexpr (sizeof(T) == 1) return ::std::uint64_t {simde_mm512_cmpeq_epi8_mask (data, needle)};
+               else if constexpr (sizeof(T) == 2) return ::std::uint64_t {simde_mm512_cmpeq_epi16_mask(data, needle)};
+               else if constexpr (sizeof(T) == 4) return ::std::uint64_t {simde_mm512_cmpeq_epi32_mask(data, needle)};
+               else static_assert(false, "Unsupported element size");
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Get a mask with the bits of the first n elements set                
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      constexpr ::std::uint64_t FirstElements(Count n) noexcept {
+         const Count bits = n * MatchStride<R>;
+         return bits >= 64 ? ~::std::uint64_t {0} : (::std::uint64_t {1} << bits) - 1;
+      }
+
+      /// Check if a full register can be read at an address, without         
+      /// touching the next page                                              
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      bool FitsInPage(const void* at) noexcept {
+         return reinterpret_cast<::std::uintptr_t>(at) % SearchPageSize
+             <= SearchPageSize - sizeof(R);
+      }
+
+      /// Matches a single element                                            
+      template<class T>
+      struct MatchOne {
+         T mValue;
+
+         /// Get the matcher for a register - the needle is filled once       
+         template<CT::SIMD R> NOD() LANGULUS(INLINED)
+         auto Register() const noexcept {
+            const R needle = Fill<sizeof(R)>(mValue);
+            return [needle](const R& data) noexcept {
+               return MatchMask(data, needle);
+            };
+         }
+
+         NOD() LANGULUS(INLINED)
+         bool operator () (const T& e) const noexcept {
+            return e == mValue;
+         }
+      };
+
+      /// Matches any element of a set, one compare per element in the set    
+      template<class T>
+      struct MatchAny {
+         const T* mSet;
+         Count mCount;
+
+         template<CT::SIMD R> NOD() LANGULUS(INLINED)
+         auto Register() const noexcept {
+            return [this](const R& data) noexcept {
+               ::std::uint64_t mask = 0;
+               for (Offset i = 0; i < mCount; ++i)
+                  mask |= MatchMask(data, R {Fill<sizeof(R)>(mSet[i])});
+               return mask;
+            };
+         }
+
+         NOD() LANGULUS(INLINED)
+         bool operator () (const T& e) const noexcept {
+            for (Offset i = 0; i < mCount; ++i) {
+               if (e == mSet[i])
+                  return true;
+            }
+            return false;
+         }
+      };
+
+      /// Find the first matching element, through one register width         
+      ///   @param data - the elements to search                              
+      ///   @param count - number of elements                                 
+      ///   @param matcher - a MatchOne/MatchAny instance                     
+      ///   @param i - [in/out] the first element to search, updated to the   
+      ///              first element that wasn't searched                     
+      ///   @return true if a match was found, 'i' is its index then          
+      template<CT::SIMD R, class T, class M> LANGULUS(INLINED)
+      bool FindStream(const T* data, const Count count, const M& matcher, Offset& i) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         const auto match = matcher.template Register<R>();
+         for (; i + L <= count; i += L) {
+            if (const auto mask = match(LoadUnaligned<R>(data + i))) {
+               i += ::std::countr_zero(mask) / MatchStride<R>;
+               return true;
+            }
+         }
+
+         if (i < count and FitsInPage<R>(data + i)) {
+            // Read the rest in one go, ignoring whatever comes after   
+            const auto mask = match(LoadUnaligned<R>(data + i))
+                            & FirstElements<R>(count - i);
+            i = mask ? i + ::std::countr_zero(mask) / MatchStride<R> : count;
+            return mask != 0;
+         }
+         return false;
+      }
+
+      /// Find the first matching element, through the widest register        
+      ///   @return the index of the element, or 'count' if not found         
+      template<class T, class M>
+      Offset FindBulk(const T* data, const Count count, const M& matcher) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(512BIT)
+            if (FindStream<V512<T>>(data, count, matcher, i))
+               return i;
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if (FindStream<V256<T>>(data, count, matcher, i))
+               return i;
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+            if (FindStream<V128<T>>(data, count, matcher, i))
+               return i;
+         #endif
+
+         // Remaining elements                                          
+         for (; i < count; ++i) {
+            if (matcher(data[i]))
+               return i;
+         }
+         return count;
+      }
+
+      /// Count the matching elements, through one register width             
+      ///   @param i - [in/out] the first element to count, updated to the    
+      ///              first element that wasn't counted                      
+      ///   @return the number of matches                                     
+      template<CT::SIMD R, class T, class M> LANGULUS(INLINED)
+      Count CountStream(const T* data, const Count count, const M& matcher, Offset& i) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         const auto match = matcher.template Register<R>();
+         Count bits = 0;
+         for (; i + L <= count; i += L)
+            bits += ::std::popcount(match(LoadUnaligned<R>(data + i)));
+
+         if (i < count and FitsInPage<R>(data + i)) {
+            bits += ::std::popcount(match(LoadUnaligned<R>(data + i))
+                                  & FirstElements<R>(count - i));
+            i = count;
+         }
+         return bits / MatchStride<R>;
+      }
+
+      /// Count the matching elements, through the widest register            
+      template<class T, class M>
+      Count CountBulk(const T* data, const Count count, const M& matcher) noexcept {
+         Offset i = 0;
+         Count result = 0;
+         #if LANGULUS_SIMD(512BIT)
+            result += CountStream<V512<T>>(data, count, matcher, i);
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            result += CountStream<V256<T>>(data, count, matcher, i);
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+            result += CountStream<V128<T>>(data, count, matcher, i);
+         #endif
+
+         // Remaining elements                                          
+         for (; i < count; ++i)
+            result += matcher(data[i]);
+         return result;
+      }
+
+      /// Find the terminating zero, with aligned loads only                  
+      /// The first load may start before 'str', but never leaves the page    
+      /// that contains it, and matches before 'str' are discarded            
+      ///   @param str - the zero-terminated string                           
+      ///   @return the number of elements before the zero                    
+      template<class T>
+      Count LengthBulk(const T* str) noexcept {
+         #if LANGULUS_SIMD(512BIT)
+            using R = V512<T>;
+         #elif LANGULUS_SIMD(256BIT)
+            using R = V256<T>;
+         #elif LANGULUS_SIMD(128BIT)
+            using R = V128<T>;
+         #endif
+
+         #if LANGULUS_SIMD(128BIT)
+            const auto start = reinterpret_cast<::std::uintptr_t>(str);
+            auto block = start & ~::std::uintptr_t {sizeof(R) - 1};
+            const auto match = MatchOne<T> {0}.template Register<R>();
+            auto mask = match(LoadUnaligned<R>(reinterpret_cast<const void*>(block)))
+                     & ~FirstElements<R>((start - block) / sizeof(T));
+
+            while (not mask) {
+               block += sizeof(R);
+               mask = match(LoadUnaligned<R>(reinterpret_cast<const void*>(block)));
+            }
+
+            const auto at = block + ::std::countr_zero(mask) / MatchStride<R> * sizeof(T);
+            return (at - start) / sizeof(T);
+         #else
+            Count result = 0;
+            while (str[result])
+               ++result;
+            return result;
+         #endif
+      }
+
+      /// Get a span of characters as unsigned elements of the same size      
+      ///   @param data - span of characters, or any 1, 2 or 4 byte integers  
+      ///   @return the element pointer and number of elements                
+      template<class DATA> NOD() LANGULUS(INLINED)
+      auto SearchElements(const DATA& data) noexcept {
+         const ::std::span span {data};
+         using V = Decvq<typename decltype(span)::element_type>;
+         static_assert(::std::is_trivially_copyable_v<V>
+            and (sizeof(V) == 1 or sizeof(V) == 2 or sizeof(V) == 4),
+            "Can only search in 1, 2 or 4-byte characters");
+         using E = SearchElement<V>;
+         return ::std::pair {reinterpret_cast<const E*>(span.data()), span.size()};
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Find the first occurence of a byte, like memchr                        
+   ///   @param data - span of bytes or char8_t characters                    
+   ///   @param value - the byte to search for                                
+   ///   @return the index of the byte, or the size of 'data' if not found    
+   template<class DATA> NOD() LANGULUS(INLINED)
+   Offset FindByte(const DATA& data, ::std::uint8_t value) noexcept {
+      const auto [p, count] = Inner::SearchElements(data);
+      static_assert(sizeof(*p) == 1, "Data must be made of bytes");
+      return Inner::FindBulk(p, count, Inner::MatchOne<::std::uint8_t> {value});
+   }
+
+   /// Find the first byte that is any of the bytes in a set, like strpbrk    
+   /// Each byte in the set costs one comparison per register, so this is     
+   /// meant for small sets, like delimiters                                  
+   ///   @param data - span of bytes or char8_t characters                    
+   ///   @param set - span of bytes to search for, e.g. a string_view         
+   ///   @return the index of the byte, or the size of 'data' if not found    
+   template<class DATA, class SET> NOD() LANGULUS(INLINED)
+   Offset FindAnyOf(const DATA& data, const SET& set) noexcept {
+      const auto [p, count] = Inner::SearchElements(data);
+      const auto [s, setCount] = Inner::SearchElements(set);
+      static_assert(sizeof(*p) == 1 and sizeof(*s) == 1,
+         "Data and set must be made of bytes");
+      if (not setCount)
+         return count;
+      return Inner::FindBulk(p, count, Inner::MatchAny<::std::uint8_t> {s, setCount});
+   }
+
+   /// Count the occurences of a byte, e.g. the number of lines in a text     
+   ///   @param data - span of bytes or char8_t characters                    
+   ///   @param value - the byte to count                                     
+   ///   @return the number of occurences                                     
+   template<class DATA> NOD() LANGULUS(INLINED)
+   Count CountByte(const DATA& data, ::std::uint8_t value) noexcept {
+      const auto [p, count] = Inner::SearchElements(data);
+      static_assert(sizeof(*p) == 1, "Data must be made of bytes");
+      return Inner::CountBulk(p, count, Inner::MatchOne<::std::uint8_t> {value});
+   }
+
+   /// Get the length of a zero-terminated string, like strlen                
+   ///   @param str - the string of char, char8_t, char16_t, char32_t, or     
+   ///                wchar_t; must be aligned to its character size          
+   ///   @return the number of characters before the terminating zero         
+   template<class T> NOD() LANGULUS(INLINED)
+   Count Length(const T* str) noexcept {
+      using E = Inner::SearchElement<T>;
+      static_assert(::std::is_trivially_copyable_v<T>
+         and (sizeof(T) == 1 or sizeof(T) == 2 or sizeof(T) == 4),
+         "Can only measure strings of 1, 2 or 4-byte characters");
+      LANGULUS_ASSUME(UserAssumes, reinterpret_cast<::std::uintptr_t>(str) % sizeof(T) == 0,
+         "String isn't aligned to its character size");
+      return Inner::LengthBulk(reinterpret_cast<const E*>(str));
+   }
+
+   /// Get the length of a string, that might not be zero-terminated,         
+   /// like strnlen                                                           
+   ///   @param str - span of char, char8_t, char16_t, char32_t, or wchar_t   
+   ///   @return the number of characters before the first zero, or the size  
+   ///           of the span, if there is no zero                             
+   template<class DATA> requires requires (const DATA& d) { ::std::span {d}; }
+   NOD() LANGULUS(INLINED)
+   Count Length(const DATA& str) noexcept {
+      const auto [p, count] = Inner::SearchElements(str);
+      using E = Decvq<Deptr<decltype(p)>>;
+      return Inner::FindBulk(p, count, Inner::MatchOne<E> {0});
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,417 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Search.hpp"
+#include "../binary/Add.hpp"
+#include "../binary/Min.hpp"
+#include "../binary/Max.hpp"
+#include "../binary/Lesser.hpp"
+#include "../binary/Greater.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+
+///                                                                           
+///   Selection of the smallest and biggest elements                          
+///                                                                           
+/// ArgMin/ArgMax of 32bit and 64bit elements keep the best element of each   
+/// lane in one register, and its index in another, so that a single pass     
+/// is needed. 8bit and 16bit elements have too small lanes for indices, so   
+/// blocks are reduced with Min/Max instead (finishing 16bit ones with        
+/// phminposuw), and the best block is then searched for the first match.     
+///                                                                           
+/// TopK keeps the worst of the best K candidates so far in a register, and   
+/// compares whole registers against it - only the few elements that beat     
+/// it are collected, and the collection is trimmed back to K when full.      
+///                                                                           
+/// NaNs are never picked, and ties go to the element with lower index        
+///                                                                           
+namespace Langulus::SIMD
+{
+
+   /// Outcome of ArgMin/ArgMax                                               
+   template<class T>
+   struct ArgResult {
+      // The picked element                                             
+      T mValue {};
+      // Index of the picked element, or the size of the input, if there
+      // was nothing to pick - the input was empty or all NaN           
+      Offset mIndex = 0;
+   };
+
+   namespace Inner
+   {
+
+      /// Check if a is better than b, i.e. smaller for ArgMin                
+      template<bool MAX, class T> NOD() LANGULUS(INLINED)
+      constexpr bool ArgBetter(const T& a, const T& b) noexcept {
+         if constexpr (MAX) return b < a;
+         else               return a < b;
+      }
+
+      /// The worst possible element, that every other element beats          
+      template<bool MAX, class T>
+      constexpr T ArgWorst = CT::Real<T>
+         ? (MAX ? -::std::numeric_limits<T>::infinity() : ::std::numeric_limits<T>::infinity())
+         : (MAX ?  ::std::numeric_limits<T>::lowest()   : ::std::numeric_limits<T>::max());
+
+      /// Lanes where a is better than b, i.e. smaller for ArgMin             
+      template<bool MAX, CT::SIMD R> NOD() LANGULUS(INLINED)
+      CompareOf<R> BetterMask(const R& a, const R& b) noexcept {
+         if constexpr (MAX) return GreaterSIMD(a, b);
+         else               return LesserSIMD(a, b);
+      }
+
+      /// Get one bit per lane set in a mask, at bit lane * MatchStride<R>    
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto MaskBits(const CompareOf<R>& mask) noexcept {
+         constexpr Count S = MatchStride<R>;
+         // Keep only the lowest bit of each lane                       
+         constexpr ::std::uint64_t lowest = ~::std::uint64_t {0} / (((::std::uint64_t {1} << S) - 1) | (S == 64));
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>)
+               return static_cast<::std::uint16_t>(simde_mm_movemask_epi8(
+                  ReinterpretSIMD<::std::uint8_t>(mask))) & lowest;
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>)
+               return static_cast<::std::uint32_t>(simde_mm256_movemask_epi8(
+                  ReinterpretSIMD<::std::uint8_t>(mask))) & lowest;
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>)
+               return static_cast<::std::uint64_t>(MaskFrom<R>(mask));
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Pick the better of two results, the first one on a tie              
+      template<bool MAX, class T> NOD() LANGULUS(INLINED)
+      ArgResult<T> ArgCombine(const ArgResult<T>& a, const ArgResult<T>& b, Count size) noexcept {
+         if (a.mIndex == size)
+            return b;
+         if (b.mIndex == size)
+            return a;
+         return ArgBetter<MAX>(b.mValue, a.mValue) ? b : a;
+      }
+
+      /// Find the best 32bit or 64bit element, tracking indices in a         
+      /// register of the same size                                           
+      ///   @param data - the elements                                        
+      ///   @param n - number of elements, small enough for the index lanes   
+      ///   @param i - [in/out] the first element to search, updated to the   
+      ///              first element that wasn't searched                     
+      ///   @return the result, with mIndex == n if nothing was found         
+      template<bool MAX, CT::SIMD R, class T>
+      ArgResult<T> ArgStream(const T* data, Count n, Offset& i) noexcept {
+         using I = Conditional<sizeof(T) == 4, ::std::int32_t, ::std::int64_t>;
+         constexpr Count L = CountOf<R>;
+         using IR = Deref<decltype(Fill<sizeof(R)>(I {}))>;
+         if (i + L > n)
+            return {T {}, n};
+
+         constexpr auto iota = [] {
+            ::std::array<I, L> result {};
+            for (Offset l = 0; l < L; ++l)
+               result[l] = static_cast<I>(l);
+            return result;
+         }();
+
+         R  best  = Fill<sizeof(R)>(ArgWorst<MAX, T>);
+         IR index = Fill<sizeof(R)>(I {-1});
+         IR lanes = AddSIMD(LoadUnaligned<IR>(iota.data()), IR {Fill<sizeof(R)>(static_cast<I>(i))});
+         const IR step = Fill<sizeof(R)>(static_cast<I>(L));
+         for (; i + L <= n; i += L) {
+            const auto better = BetterMask<MAX>(LoadUnaligned<R>(data + i), best);
+            best  = SelectSIMD(better, best, LoadUnaligned<R>(data + i));
+            index = SelectSIMD(better, index, lanes);
+            lanes = AddSIMD(lanes, step);
+         }
+
+         // Pick the best lane, or the one with lowest index on a tie   
+         T values[L];
+         I indices[L];
+         StoreUnaligned(values, best);
+         StoreUnaligned(indices, index);
+         ArgResult<T> result {T {}, n};
+         for (Offset l = 0; l < L; ++l) {
+            if (indices[l] < 0)
+               continue;
+            if (result.mIndex == n or ArgBetter<MAX>(values[l], result.mValue)
+            or (values[l] == result.mValue and static_cast<Offset>(indices[l]) < result.mIndex))
+               result = {values[l], static_cast<Offset>(indices[l])};
+         }
+         return result;
+      }
+
+      /// Reduce a block of 8bit or 16bit elements to its best element        
+      template<bool MAX, class T>
+      T ArgReduce(const T* data, Count n) noexcept {
+         T best = ArgWorst<MAX, T>;
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            using R128 = V128<T>;
+            const auto reduce = [&]<class R>() {
+               constexpr Count L = CountOf<R>;
+               if (i + L > n)
+                  return;
+               R acc = LoadUnaligned<R>(data + i);
+               for (i += L; i + L <= n; i += L) {
+                  if constexpr (MAX) acc = MaxSIMD(acc, LoadUnaligned<R>(data + i));
+                  else               acc = MinSIMD(acc, LoadUnaligned<R>(data + i));
+               }
+
+               T lanes[L];
+               StoreUnaligned(lanes, acc);
+               if constexpr (sizeof(T) == 2 and CT::SIMD128<R>) {
+                  // phminposuw finds the smallest unsigned 16bit lane -
+                  // signed lanes get their sign flipped, and maximums  
+                  // are found as minimums of the complement            
+                  const ::std::uint16_t flip = (MAX ? 0xFFFF : 0)
+                     ^ (CT::Signed<T> ? 0x8000 : 0);
+                  const auto f = simde_mm_set1_epi16(static_cast<short>(flip));
+                  const auto pos = simde_mm_minpos_epu16(simde_mm_xor_si128(acc, f));
+                  const auto v = static_cast<::std::uint16_t>(simde_mm_cvtsi128_si32(pos) ^ flip);
+                  const T candidate = ::std::bit_cast<T>(v);
+                  if (ArgBetter<MAX>(candidate, best))
+                     best = candidate;
+               }
+               else {
+                  for (auto l : lanes) {
+                     if (ArgBetter<MAX>(l, best))
+                        best = l;
+                  }
+               }
+            };
+
+            #if LANGULUS_SIMD(512BIT)
+               reduce.template operator()<V512<T>>();
+            #endif
+            #if LANGULUS_SIMD(256BIT)
+               reduce.template operator()<V256<T>>();
+            #endif
+            reduce.template operator()<R128>();
+         #endif
+
+         for (; i < n; ++i) {
+            if (ArgBetter<MAX>(data[i], best))
+               best = data[i];
+         }
+         return best;
+      }
+
+      /// Find the best element                                               
+      ///   @param data - the elements                                        
+      ///   @param n - number of elements                                     
+      ///   @return the result, with mIndex == n if nothing was found         
+      template<bool MAX, class T>
+      ArgResult<T> ArgBulk(const T* data, Count n) noexcept {
+         ArgResult<T> result {T {}, n};
+         if constexpr (sizeof(T) <= 2) {
+            // Find the best block first, and the element in it then    
+            constexpr Count B = 4096;
+            Offset block = n;
+            T best = ArgWorst<MAX, T>;
+            for (Offset b = 0; b < n; b += B) {
+               const T candidate = ArgReduce<MAX>(data + b, ::std::min(B, n - b));
+               if (block == n or ArgBetter<MAX>(candidate, best)) {
+                  best = candidate;
+                  block = b;
+               }
+            }
+
+            if (block < n) {
+               using E = SearchElement<T>;
+               const Count size = ::std::min(B, n - block);
+               result.mValue = best;
+               result.mIndex = block + FindBulk(reinterpret_cast<const E*>(data + block),
+                  size, MatchOne<E> {::std::bit_cast<E>(best)});
+            }
+            return result;
+         }
+         else {
+            Offset i = 0;
+            #if LANGULUS_SIMD(128BIT)
+               // 32bit indices are limited, so work in chunks, each    
+               // indexed relative to its own start                     
+               constexpr Count chunk = sizeof(T) == 4 ? Count {1} << 30 : ~Count {0};
+               #if LANGULUS_SIMD(512BIT)
+                  using R = V512<T>;
+               #elif LANGULUS_SIMD(256BIT)
+                  using R = V256<T>;
+               #else
+                  using R = V128<T>;
+               #endif
+
+               while (i + CountOf<R> <= n) {
+                  const Offset start = i;
+                  const Count size = ::std::min(chunk, n - start);
+                  Offset j = 0;
+                  auto r = ArgStream<MAX, R>(data + start, size, j);
+                  i = start + j;
+                  r.mIndex = r.mIndex == size ? n : start + r.mIndex;
+                  result = ArgCombine<MAX>(result, r, n);
+               }
+            #endif
+
+            for (; i < n; ++i) {
+               if (ArgBetter<MAX>(data[i], result.mIndex == n ? ArgWorst<MAX, T> : result.mValue))
+                  result = {data[i], i};
+            }
+
+            // Nothing beats the worst possible value, so if there's no 
+            // result, look for it explicitly                           
+            if (result.mIndex == n) {
+               for (i = 0; i < n; ++i) {
+                  if (data[i] == ArgWorst<MAX, T>)
+                     return {data[i], i};
+               }
+            }
+            return result;
+         }
+      }
+
+      /// Collect the best K elements, along with their indices               
+      ///   @param data - the elements                                        
+      ///   @param n - number of elements                                     
+      ///   @param k - number of elements to pick                             
+      ///   @return up to K best elements, ordered from the best              
+      template<bool MAX, class T>
+      auto TopBulk(const T* data, Count n, Count k) {
+         using Candidate = ::std::pair<T, Offset>;
+         ::std::vector<Candidate> candidates;
+         if (k == 0)
+            return candidates;
+
+         const auto order = [](const Candidate& a, const Candidate& b) noexcept {
+            return ArgBetter<MAX>(a.first, b.first)
+               or (a.first == b.first and a.second < b.second);
+         };
+
+         // Take the first K elements as they are                       
+         Offset i = 0;
+         for (; i < n and candidates.size() < k; ++i) {
+            if (data[i] == data[i])
+               candidates.push_back({data[i], i});
+         }
+         if (candidates.size() < k) {
+            ::std::sort(candidates.begin(), candidates.end(), order);
+            return candidates;
+         }
+
+         // From now on, only elements that beat the worst candidate    
+         // matter - collect those, and trim back to K when full        
+         const Count capacity = k * 2 + 64;
+         candidates.reserve(capacity);
+         T worst = ::std::max_element(candidates.begin(), candidates.end(), order)->first;
+         const auto trim = [&] {
+            ::std::nth_element(candidates.begin(), candidates.begin() + (k - 1), candidates.end(), order);
+            candidates.resize(k);
+            worst = candidates[k - 1].first;
+         };
+
+         #if LANGULUS_SIMD(128BIT)
+            const auto stream = [&]<class R>() {
+               constexpr Count L = CountOf<R>;
+               R threshold = Fill<sizeof(R)>(worst);
+               for (; i + L <= n; i += L) {
+                  auto bits = MaskBits<R>(BetterMask<MAX>(LoadUnaligned<R>(data + i), threshold));
+                  if (not bits)
+                     continue;
+
+                  do {
+                     const Offset at = i + ::std::countr_zero(bits) / MatchStride<R>;
+                     candidates.push_back({data[at], at});
+                     bits &= bits - 1;
+                  }
+                  while (bits);
+
+                  if (candidates.size() + L > capacity) {
+                     trim();
+                     threshold = Fill<sizeof(R)>(worst);
+                  }
+               }
+            };
+
+            #if LANGULUS_SIMD(512BIT)
+               stream.template operator()<V512<T>>();
+            #endif
+            #if LANGULUS_SIMD(256BIT)
+               stream.template operator()<V256<T>>();
+            #endif
+            stream.template operator()<V128<T>>();
+         #endif
+
+         for (; i < n; ++i) {
+            if (ArgBetter<MAX>(data[i], worst)) {
+               candidates.push_back({data[i], i});
+               if (candidates.size() == capacity)
+                  trim();
+            }
+         }
+
+         ::std::partial_sort(candidates.begin(), candidates.begin() + k, candidates.end(), order);
+         candidates.resize(k);
+         return candidates;
+      }
+
+      /// Get the elements of a span of numbers                               
+      template<class DATA> NOD() LANGULUS(INLINED)
+      auto SelectElements(const DATA& data) noexcept {
+         const ::std::span span {data};
+         using T = Decvq<typename decltype(span)::element_type>;
+         static_assert(CT::Integer<T> or CT::Real<T>, "Can only select numbers");
+         return ::std::pair {static_cast<const T*>(span.data()), span.size()};
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Find the smallest element, and its index                               
+   ///   @param data - span of numbers                                        
+   ///   @return the first smallest element and its index                     
+   template<class DATA> NOD() LANGULUS(INLINED)
+   auto ArgMin(const DATA& data) noexcept {
+      const auto [p, n] = Inner::SelectElements(data);
+      return Inner::ArgBulk<false>(p, n);
+   }
+
+   /// Find the biggest element, and its index                                
+   ///   @param data - span of numbers                                        
+   ///   @return the first biggest element and its index                      
+   template<class DATA> NOD() LANGULUS(INLINED)
+   auto ArgMax(const DATA& data) noexcept {
+      const auto [p, n] = Inner::SelectElements(data);
+      return Inner::ArgBulk<true>(p, n);
+   }
+
+   /// Find the indices of the K biggest (or smallest) elements               
+   ///   @tparam SMALLEST - pick the smallest elements instead                
+   ///   @param data - span of numbers                                        
+   ///   @param indices - span of integers, that receives the indices,        
+   ///                    ordered from the best element - K is its size       
+   ///   @return the number of indices written, which is less than K only if  
+   ///           there are less than K elements (that aren't NaN)             
+   template<bool SMALLEST = false, class DATA, class OUT>
+   Count TopK(const DATA& data, OUT&& indices) {
+      const auto [p, n] = Inner::SelectElements(data);
+      const ::std::span out {indices};
+      using I = typename decltype(out)::element_type;
+      static_assert(CT::Integer<I> and not ::std::is_const_v<I>,
+         "Indices must be a mutable span of integers");
+
+      const auto best = Inner::TopBulk<not SMALLEST>(p, n, out.size());
+      for (Offset i = 0; i < best.size(); ++i)
+         out[i] = static_cast<I>(best[i].second);
+      return best.size();
+   }
+
+} // namespace Langulus::SIMD
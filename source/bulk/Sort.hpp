@@ -0,0 +1,1072 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "Bulk.hpp"
+#include "../binary/Min.hpp"
+#include "../binary/Max.hpp"
+#include "../binary/XOr.hpp"
+#include "../binary/Greater.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+
+///                                                                           
+///   Sorting networks                                                        
+///                                                                           
+/// A single register is sorted by a bitonic network - log2(lanes) stages     
+/// of compare-exchange steps, each made of a lane permutation, a min, a      
+/// max and a blend. Two sorted registers are merged by reversing one of      
+/// them and running the second half of the same network. Small arrays are    
+/// sorted by sorting each register, and then merging registers pairwise.     
+///                                                                           
+/// All keys are first mapped to signed integers of the same size, that       
+/// order the same way - unsigned integers get their top bit flipped, and     
+/// negative floats get all bits but the sign flipped. Floats are thus        
+/// ordered totally: -NaN < -inf < ... < -0 < +0 < ... < +inf < +NaN.         
+/// Sorting is not stable                                                     
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Signed integer that orders the same way as T                        
+      template<class T>
+      using SortKey = Conditional<sizeof(T) == 4, ::std::int32_t, ::std::int64_t>;
+
+      /// Check if T can be sorted                                            
+      template<class T>
+      constexpr bool Sortable = (CT::Integer<T> or CT::Real<T>)
+         and (sizeof(T) == 4 or sizeof(T) == 8);
+
+      /// Largest key, used to pad arrays up to a whole number of registers   
+      template<class K>
+      constexpr K SortPadding = ::std::numeric_limits<K>::max();
+
+      /// Map a number to its key                                             
+      template<class T> NOD() LANGULUS(INLINED)
+      constexpr SortKey<T> ToSortKey(const T& x) noexcept {
+         using K = SortKey<T>;
+         const auto k = ::std::bit_cast<K>(x);
+         if constexpr (CT::Real<T>)
+            return k ^ ((k >> (sizeof(K) * 8 - 1)) & ::std::numeric_limits<K>::max());
+         else if constexpr (CT::Signed<T>)
+            return k;
+         else
+            return k ^ ::std::numeric_limits<K>::min();
+      }
+
+      /// Map a key back to its number                                        
+      template<class T> NOD() LANGULUS(INLINED)
+      constexpr T FromSortKey(SortKey<T> k) noexcept {
+         using K = SortKey<T>;
+         if constexpr (CT::Real<T>)
+            k ^= (k >> (sizeof(K) * 8 - 1)) & ::std::numeric_limits<K>::max();
+         else if constexpr (not CT::Signed<T>)
+            k ^= ::std::numeric_limits<K>::min();
+         return ::std::bit_cast<T>(k);
+      }
+
+      /// Partner of each lane, in a compare-exchange step at distance J      
+      template<Count L>
+      consteval auto SortPartners(Count j) {
+         ::std::array<int, L> result {};
+         for (Offset i = 0; i < L; ++i)
+            result[i] = static_cast<int>(i ^ j);
+         return result;
+      }
+
+      /// Lanes in reverse order                                              
+      template<Count L>
+      consteval auto SortReversed() {
+         ::std::array<int, L> result {};
+         for (Offset i = 0; i < L; ++i)
+            result[i] = static_cast<int>(L - 1 - i);
+         return result;
+      }
+
+      /// Lanes that keep the smaller key, in the step of the bitonic         
+      /// network that builds runs of K elements, at distance J               
+      template<Count L>
+      consteval ::std::uint64_t SortMinLanes(Count k, Count j) {
+         ::std::uint64_t result = 0;
+         for (Offset i = 0; i < L; ++i) {
+            if (((i & k) == 0) == ((i & j) == 0))
+               result |= ::std::uint64_t {1} << i;
+         }
+         return result;
+      }
+
+      /// Pick lanes from b where a bit in MASK is set, and from a elsewhere  
+      template<::std::uint64_t MASK, CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SortBlend(const R& a, const R& b) noexcept {
+         constexpr Count L = CountOf<R>;
+         // Spread each lane's bit over its 16bit or 32bit parts        
+         constexpr auto spread = [](Count parts) consteval {
+            int imm = 0;
+            for (Offset i = 0; i < L; ++i) {
+               if (MASK & (::std::uint64_t {1} << i))
+                  imm |= ((1 << parts) - 1) << (i * parts);
+            }
+            return imm;
+         };
+
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>)
+               return R {simde_mm_blend_epi16(a, b, spread(8 / L))};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>)
+               return R {simde_mm256_blend_epi32(a, b, spread(8 / L))};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if constexpr (L == 16)
+                  return R {simde_mm512_mask_blend_epi32(static_cast<simde__mmask16>(MASK), a, b)};
+               else
+                  return R {simde_mm512_mask_blend_epi64(static_cast<simde__mmask8>(MASK), a, b)};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Permute the lanes of a register, so that lane i gets lane IDX[i]    
+      /// Uses a cheap in-lane shuffle, if the permutation is the same for    
+      /// all 128bit lanes                                                    
+      template<auto IDX, CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SortPermute(const R& x) noexcept {
+         constexpr Count L = CountOf<R>;
+         constexpr Count D = sizeof(R) / 4;
+         static_assert(IDX.size() == L, "Permutation size mismatch");
+         constexpr auto dwords = [] {
+            ::std::array<int, D> result {};
+            for (Offset i = 0; i < D; ++i)
+               result[i] = IDX[i / (D / L)] * static_cast<int>(D / L) + static_cast<int>(i % (D / L));
+            return result;
+         }();
+
+         // Check if the permutation repeats inside 128bit lanes        
+         constexpr int imm8 = [dwords] {
+            for (Offset i = 0; i < D; ++i) {
+               if (dwords[i] / 4 != static_cast<int>(i / 4) or dwords[i] % 4 != dwords[i % 4])
+                  return -1;
+            }
+            return (dwords[3] << 6) | (dwords[2] << 4) | (dwords[1] << 2) | dwords[0];
+         }();
+
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>)
+               return R {simde_mm_shuffle_epi32(x, imm8)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if constexpr (imm8 >= 0)
+                  return R {simde_mm256_shuffle_epi32(x, imm8)};
+               else {
+                  return R {simde_mm256_permutevar8x32_epi32(x,
+                     [dwords]<Offset...I>(::std::index_sequence<I...>) {
+                        return simde_mm256_setr_epi32(dwords[I]...);
+                     }(::std::make_index_sequence<D> {})
+                  )};
+               }
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if constexpr (imm8 >= 0)
+                  return R {simde_mm512_shuffle_epi32(x, static_cast<SIMDE_MM_PERM_ENUM>(imm8))};
+               else {
+                  return R {simde_mm512_permutexvar_epi32(
+                     [dwords]<Offset...I>(::std::index_sequence<I...>) {
+                        return simde_mm512_setr_epi32(dwords[I]...);
+                     }(::std::make_index_sequence<D> {}), x
+                  )};
+               }
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Smaller and bigger keys of two registers                            
+      /// 64bit keys are compared and blended, unless AVX-512 has min/max     
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SortMin(const R& a, const R& b) noexcept {
+         if constexpr (CT::SIMD<decltype(MinSIMD(a, b))>)
+            return MinSIMD(a, b);
+         else
+            return SelectSIMD(GreaterSIMD(a, b), a, b);
+      }
+
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SortMax(const R& a, const R& b) noexcept {
+         if constexpr (CT::SIMD<decltype(MaxSIMD(a, b))>)
+            return MaxSIMD(a, b);
+         else
+            return SelectSIMD(GreaterSIMD(a, b), b, a);
+      }
+
+      /// Lanes that have to take their partner's key, in a compare-exchange  
+      /// step - lanes in MIN take it if it's smaller, the rest if it's bigger
+      template<::std::uint64_t MIN, CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto SortTake(const R& x, const R& y) noexcept {
+         constexpr ::std::uint64_t MAX = ~MIN & ((::std::uint64_t {1} << CountOf<R>) - 1);
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using M = MaskOf<R>;
+               return static_cast<M>((MaskFrom<R>(GreaterSIMD(x, y)) & static_cast<M>(MIN))
+                                   | (MaskFrom<R>(GreaterSIMD(y, x)) & static_cast<M>(MAX)));
+            }
+            else
+         #endif
+         return SortBlend<MAX>(GreaterSIMD(x, y), GreaterSIMD(y, x));
+      }
+
+      /// A compare-exchange step inside a register                           
+      /// Values, if any, follow their keys                                   
+      ///   @tparam MIN - lanes that keep the smaller key                     
+      ///   @tparam PARTNERS - the lane to compare with, for each lane        
+      ///   @param x - the keys                                               
+      ///   @param v - the values (optional)                                  
+      template<::std::uint64_t MIN, auto PARTNERS, CT::SIMD R, class...V>
+      LANGULUS(INLINED)
+      void SortStep(R& x, V&...v) noexcept {
+         const R y = SortPermute<PARTNERS>(x);
+         if constexpr (sizeof...(V) == 0) {
+            constexpr ::std::uint64_t MAX = ~MIN & ((::std::uint64_t {1} << CountOf<R>) - 1);
+            x = SortBlend<MAX>(SortMin(x, y), SortMax(x, y));
+         }
+         else {
+            const auto take = SortTake<MIN>(x, y);
+            x = SelectSIMD(take, x, y);
+            ((v = SelectSIMD(take, v, SortPermute<PARTNERS>(v))), ...);
+         }
+      }
+
+      /// Compare-exchange two registers, so that a gets the smaller keys     
+      ///   @param a, b - the keys                                            
+      ///   @param v - the values of a and b (optional)                       
+      template<CT::SIMD R, class...V> LANGULUS(INLINED)
+      void SortExchange(R& a, R& b, V&...v) noexcept {
+         if constexpr (sizeof...(V) == 0) {
+            const R lo = SortMin(a, b);
+            b = SortMax(a, b);
+            a = lo;
+         }
+         else {
+            const auto take = GreaterSIMD(a, b);
+            const R lo = SelectSIMD(take, a, b);
+            b = SelectSIMD(take, b, a);
+            a = lo;
+            [&take](R& va, R& vb) {
+               const R vlo = SelectSIMD(take, va, vb);
+               vb = SelectSIMD(take, vb, va);
+               va = vlo;
+            }(v...);
+         }
+      }
+
+      /// Sort a register of keys with a bitonic network                      
+      ///   @tparam K - length of the runs being built                        
+      ///   @tparam J - distance of the current step                          
+      template<Count K = 2, Count J = 1, CT::SIMD R, class...V> LANGULUS(INLINED)
+      void SortNetwork(R& x, V&...v) noexcept {
+         constexpr Count L = CountOf<R>;
+         SortStep<SortMinLanes<L>(K, J), SortPartners<L>(J)>(x, v...);
+         if constexpr (J > 1)
+            SortNetwork<K, J / 2>(x, v...);
+         else if constexpr (K < L)
+            SortNetwork<K * 2, K>(x, v...);
+      }
+
+      /// Sort a bitonic register of keys, i.e. the second half of a network  
+      template<Count J, CT::SIMD R, class...V> LANGULUS(INLINED)
+      void SortCleanup(R& x, V&...v) noexcept {
+         constexpr Count L = CountOf<R>;
+         SortStep<SortMinLanes<L>(L, J), SortPartners<L>(J)>(x, v...);
+         if constexpr (J > 1)
+            SortCleanup<J / 2>(x, v...);
+      }
+
+
+      /// Merge two sorted registers of keys, so that lo gets the smaller     
+      /// half, and hi gets the bigger half, both sorted                      
+      ///   @param lo, hi - the keys                                          
+      ///   @param v - the values of lo and hi (optional)                     
+      template<CT::SIMD R, class...V> LANGULUS(INLINED)
+      void SortMerge(R& lo, R& hi, V&...v) noexcept {
+         constexpr Count L = CountOf<R>;
+         constexpr auto reversed = SortReversed<L>();
+         if constexpr (sizeof...(V) == 0) {
+            hi = SortPermute<reversed>(hi);
+            SortExchange(lo, hi);
+            SortCleanup<L / 2>(lo);
+            SortCleanup<L / 2>(hi);
+         }
+         else [&](R& vlo, R& vhi) {
+            hi  = SortPermute<reversed>(hi);
+            vhi = SortPermute<reversed>(vhi);
+            SortExchange(lo, hi, vlo, vhi);
+            SortCleanup<L / 2>(lo, vlo);
+            SortCleanup<L / 2>(hi, vhi);
+         }(v...);
+      }
+
+      /// Map a register of numbers to a register of keys, and back -         
+      /// both ways are the same, because the sign bit never changes          
+      template<class T, CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto SortKeys(const R& x) noexcept {
+         using K = SortKey<T>;
+         const auto k = ReinterpretSIMD<K>(x);
+         using KR = Deref<decltype(k)>;
+
+         if constexpr (CT::Real<T>) {
+            // Flip all but the sign bit of negative numbers            
+            const KR flip = SelectSIMD(GreaterSIMD(KR::Zero(), k),
+               KR::Zero(), KR {Fill<sizeof(R)>(::std::numeric_limits<K>::max())});
+            return KR {XOrSIMD(k, flip)};
+         }
+         else if constexpr (CT::Signed<T>)
+            return k;
+         else
+            return KR {XOrSIMD(k, KR {Fill<sizeof(R)>(::std::numeric_limits<K>::min())})};
+      }
+
+      /// Sort a register in ascending order                                  
+      ///   @param x - the register to sort                                   
+      ///   @return the sorted register                                       
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R SortSIMD(const R& x) noexcept {
+         using T = TypeOf<R>;
+         static_assert(Sortable<T>, "Can only sort 32bit or 64bit numbers");
+         auto k = SortKeys<T>(x);
+         SortNetwork(k);
+         return ReinterpretSIMD<T>(SortKeys<T>(k));
+      }
+
+      /// Sort a register of keys in ascending order, along with a register   
+      /// of values                                                           
+      ///   @param keys - the keys to sort                                    
+      ///   @param values - the values to move along with their keys          
+      template<CT::SIMD R, CT::SIMD V> LANGULUS(INLINED)
+      void SortSIMD(R& keys, V& values) noexcept {
+         using T = TypeOf<R>;
+         static_assert(Sortable<T>, "Can only sort 32bit or 64bit numbers");
+         static_assert(sizeof(R) == sizeof(V) and CountOf<R> == CountOf<V>,
+            "Values must be a register of the same size and lane count");
+         auto k = SortKeys<T>(keys);
+         auto v = ReinterpretSIMD<SortKey<T>>(values);
+         SortNetwork(k, v);
+         keys = ReinterpretSIMD<T>(SortKeys<T>(k));
+         values = ReinterpretSIMD<TypeOf<V>>(v);
+      }
+
+      /// Merge two sorted registers, so that lo gets the smaller half, and   
+      /// hi gets the bigger half, both sorted in ascending order             
+      ///   @param lo, hi - the sorted registers                              
+      template<CT::SIMD R> LANGULUS(INLINED)
+      void MergeSIMD(R& lo, R& hi) noexcept {
+         using T = TypeOf<R>;
+         static_assert(Sortable<T>, "Can only sort 32bit or 64bit numbers");
+         auto l = SortKeys<T>(lo);
+         auto h = SortKeys<T>(hi);
+         SortMerge(l, h);
+         lo = ReinterpretSIMD<T>(SortKeys<T>(l));
+         hi = ReinterpretSIMD<T>(SortKeys<T>(h));
+      }
+
+      /// Merge two sorted registers of keys, along with their values         
+      ///   @param lo, hi - the sorted keys                                   
+      ///   @param vlo, vhi - the values of lo and hi                         
+      template<CT::SIMD R, CT::SIMD V> LANGULUS(INLINED)
+      void MergeSIMD(R& lo, R& hi, V& vlo, V& vhi) noexcept {
+         using T = TypeOf<R>;
+         static_assert(Sortable<T>, "Can only sort 32bit or 64bit numbers");
+         static_assert(sizeof(R) == sizeof(V) and CountOf<R> == CountOf<V>,
+            "Values must be a register of the same size and lane count");
+         auto l = SortKeys<T>(lo);
+         auto h = SortKeys<T>(hi);
+         auto vl = ReinterpretSIMD<SortKey<T>>(vlo);
+         auto vh = ReinterpretSIMD<SortKey<T>>(vhi);
+         SortMerge(l, h, vl, vh);
+         lo  = ReinterpretSIMD<T>(SortKeys<T>(l));
+         hi  = ReinterpretSIMD<T>(SortKeys<T>(h));
+         vlo = ReinterpretSIMD<TypeOf<V>>(vl);
+         vhi = ReinterpretSIMD<TypeOf<V>>(vh);
+      }
+
+      /// Sort M registers worth of keys in place, by sorting each register,  
+      /// and then merging runs of 1, 2, 4... registers with a bitonic        
+      /// network                                                             
+      ///   @tparam R - the register of keys                                  
+      ///   @tparam M - number of registers, a power of two                   
+      ///   @param keys - the keys                                            
+      ///   @param values - the values, nullptr if KV is false                
+      template<CT::SIMD R, Count M, bool KV>
+      void SortRegisters(TypeOf<R>* keys, TypeOf<R>* values) noexcept {
+         constexpr Count L = CountOf<R>;
+         const auto load = [](const TypeOf<R>* p) {
+            return [p]<Offset...I>(::std::index_sequence<I...>) {
+               return ::std::array<R, M> {LoadUnaligned<R>(p + I * L)...};
+            }(::std::make_index_sequence<M> {});
+         };
+
+         auto k = load(keys);
+         auto v = load(KV ? values : keys);
+         const auto exchange = [&](Offset a, Offset b) {
+            if constexpr (KV) SortExchange(k[a], k[b], v[a], v[b]);
+            else              SortExchange(k[a], k[b]);
+         };
+
+         for (Offset r = 0; r < M; ++r) {
+            if constexpr (KV) SortNetwork(k[r], v[r]);
+            else              SortNetwork(k[r]);
+         }
+
+         constexpr auto reversed = SortReversed<L>();
+         for (Count s = 1; s < M; s *= 2) {
+            for (Offset g = 0; g < M; g += s * 2) {
+               // Reverse the second run, so that both form a bitonic   
+               // sequence                                              
+               for (Offset r = 0; r < s / 2; ++r) {
+                  ::std::swap(k[g + s + r], k[g + s * 2 - 1 - r]);
+                  if constexpr (KV)
+                     ::std::swap(v[g + s + r], v[g + s * 2 - 1 - r]);
+               }
+               for (Offset r = g + s; r < g + s * 2; ++r) {
+                  k[r] = SortPermute<reversed>(k[r]);
+                  if constexpr (KV)
+                     v[r] = SortPermute<reversed>(v[r]);
+               }
+
+               // Then sort it, first across registers, then inside them
+               for (Count d = s; d > 0; d /= 2) {
+                  for (Offset r = g; r < g + s * 2; ++r) {
+                     if (((r - g) & d) == 0)
+                        exchange(r, r + d);
+                  }
+               }
+               for (Offset r = g; r < g + s * 2; ++r) {
+                  if constexpr (KV) SortCleanup<L / 2>(k[r], v[r]);
+                  else              SortCleanup<L / 2>(k[r]);
+               }
+            }
+         }
+
+         for (Offset r = 0; r < M; ++r) {
+            StoreUnaligned(keys + r * L, k[r]);
+            if constexpr (KV)
+               StoreUnaligned(values + r * L, v[r]);
+         }
+      }
+
+      /// Sort keys, and optionally values, without registers                 
+      ///   @param keys - the keys                                            
+      ///   @param values - the values, ignored if KV is false                
+      ///   @param n - number of elements                                     
+      template<bool KV, class K>
+      void SortFallback(K* keys, K* values, Count n) {
+         if constexpr (not KV)
+            ::std::sort(keys, keys + n);
+         else {
+            ::std::vector<::std::pair<K, K>> pairs(n);
+            for (Offset i = 0; i < n; ++i)
+               pairs[i] = {keys[i], values[i]};
+            ::std::sort(pairs.begin(), pairs.end(), [](const auto& a, const auto& b) {
+               return a.first < b.first;
+            });
+            for (Offset i = 0; i < n; ++i) {
+               keys[i]   = pairs[i].first;
+               values[i] = pairs[i].second;
+            }
+         }
+      }
+
+      /// Elements padded with the largest key may swap places with real      
+      /// elements of the same key, so give the real ones their values back   
+      ///   @param k, v - the sorted keys and values                          
+      ///   @param n - number of real elements, at the front                  
+      ///   @param key - gets the key of a real element, in its original spot 
+      ///   @param value - gets the value of a real element                   
+      template<class K>
+      void SortRestorePadded(const K* k, K* v, Count n, const auto& key, const auto& value) noexcept {
+         Offset p = n;
+         while (p > 0 and k[p - 1] == SortPadding<K>)
+            --p;
+         for (Offset i = 0; i < n and p < n; ++i) {
+            if (key(i) == SortPadding<K>)
+               v[p++] = value(i);
+         }
+      }
+
+      /// Widest register available for sorting, in bytes                     
+      #if LANGULUS_SIMD(512BIT)
+         constexpr Count SortWidest = 64;
+      #elif LANGULUS_SIMD(256BIT)
+         constexpr Count SortWidest = 32;
+      #elif LANGULUS_SIMD(128BIT)
+         constexpr Count SortWidest = 16;
+      #else
+         constexpr Count SortWidest = 0;
+      #endif
+
+      /// Sort a small array of keys, and optionally values                   
+      ///   @tparam N - number of elements                                    
+      ///   @param keys - the keys, accessed with operator []                 
+      ///   @param values - the values, accessed with operator [] (optional)  
+      template<Count N, class KEYS, class...VALUES>
+      void SortSmall(KEYS& keys, VALUES&...values) noexcept {
+         using T = Decvq<Deref<decltype(keys[0])>>;
+         using K = SortKey<T>;
+         constexpr bool KV = sizeof...(VALUES) > 0;
+
+         // Pick the narrowest register that fits all elements, or the  
+         // widest one there is                                         
+         constexpr Count bytes = SortWidest
+            ? ::std::clamp<Count>(::std::bit_ceil(N * sizeof(K)), 16, SortWidest) : 0;
+         constexpr Count L = bytes ? bytes / sizeof(K) : 1;
+         constexpr Count M = ::std::bit_ceil((N + L - 1) / L);
+
+         // Map to keys, and pad with the largest key                   
+         K k[M * L];
+         K v[KV ? M * L : 1];
+         for (Offset i = 0; i < N; ++i)
+            k[i] = ToSortKey(static_cast<T>(keys[i]));
+         ::std::fill(k + N, k + M * L, SortPadding<K>);
+         if constexpr (KV) {
+            [&](const auto& vals) {
+               for (Offset i = 0; i < N; ++i)
+                  v[i] = ::std::bit_cast<K>(vals[i]);
+               ::std::fill(v + N, v + M * L, K {0});
+            }(values...);
+         }
+
+         if constexpr (bytes == 0) {
+            // No registers                                             
+            SortFallback<KV>(k, v, N);
+         }
+         else {
+            #if LANGULUS_SIMD(128BIT)
+               if constexpr (bytes == 16)
+                  SortRegisters<V128<K>, M, KV>(k, v);
+            #endif
+            #if LANGULUS_SIMD(256BIT)
+               if constexpr (bytes == 32)
+                  SortRegisters<V256<K>, M, KV>(k, v);
+            #endif
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (bytes == 64)
+                  SortRegisters<V512<K>, M, KV>(k, v);
+            #endif
+
+            if constexpr (KV and N < M * L) {
+               [&](const auto& vals) {
+                  SortRestorePadded(k, v, N,
+                     [&](Offset i) { return ToSortKey(static_cast<T>(keys[i])); },
+                     [&](Offset i) { return ::std::bit_cast<K>(vals[i]); }
+                  );
+               }(values...);
+            }
+         }
+
+         // Map back                                                    
+         for (Offset i = 0; i < N; ++i)
+            keys[i] = FromSortKey<T>(k[i]);
+         if constexpr (KV) {
+            [&](auto& vals) {
+               using U = Decvq<Deref<decltype(vals[0])>>;
+               for (Offset i = 0; i < N; ++i)
+                  vals[i] = ::std::bit_cast<U>(v[i]);
+            }(values...);
+         }
+      }
+
+      /// Largest partition, in registers, that is sorted with networks       
+      constexpr Count SortLeafRegisters = 8;
+
+      /// Sort up to SortLeafRegisters registers worth of keys with networks  
+      ///   @param keys - the keys                                            
+      ///   @param values - the values, ignored if KV is false                
+      ///   @param n - number of elements                                     
+      template<CT::SIMD R, bool KV>
+      void SortLeaf(TypeOf<R>* keys, TypeOf<R>* values, Count n) noexcept {
+         using K = TypeOf<R>;
+         constexpr Count L = CountOf<R>;
+         if (n < 2)
+            return;
+
+         K k[SortLeafRegisters * L];
+         K v[KV ? SortLeafRegisters * L : 1];
+         const Count m = ::std::bit_ceil((n + L - 1) / L);
+         ::std::copy_n(keys, n, k);
+         ::std::fill(k + n, k + m * L, SortPadding<K>);
+         if constexpr (KV) {
+            ::std::copy_n(values, n, v);
+            ::std::fill(v + n, v + m * L, K {0});
+         }
+
+         switch (m) {
+         case 1:  SortRegisters<R, 1, KV>(k, v); break;
+         case 2:  SortRegisters<R, 2, KV>(k, v); break;
+         case 4:  SortRegisters<R, 4, KV>(k, v); break;
+         default: SortRegisters<R, SortLeafRegisters, KV>(k, v); break;
+         }
+
+         if constexpr (KV) {
+            if (n < m * L) {
+               SortRestorePadded(k, v, n,
+                  [keys](Offset i)   { return keys[i]; },
+                  [values](Offset i) { return values[i]; }
+               );
+            }
+            ::std::copy_n(v, n, values);
+         }
+         ::std::copy_n(k, n, keys);
+      }
+
+      /// Lane shuffles that move lanes outside a mask to the bottom of a     
+      /// register, and lanes inside the mask to the top, for every mask      
+      /// 128bit registers use byte shuffles                                  
+      template<Count L>
+      consteval auto PartitionBytes() {
+         ::std::array<::std::array<::std::uint8_t, 16>, (1 << L)> result {};
+         constexpr Count B = 16 / L;
+         for (Offset mask = 0; mask < (1 << L); ++mask) {
+            Offset w = 0;
+            for (Offset top = 0; top < 2; ++top) {
+               for (Offset i = 0; i < L; ++i) {
+                  if (((mask >> i) & 1) != top)
+                     continue;
+                  for (Offset b = 0; b < B; ++b)
+                     result[mask][w * B + b] = static_cast<::std::uint8_t>(i * B + b);
+                  ++w;
+               }
+            }
+         }
+         return result;
+      }
+
+      /// 256bit registers use 32bit permutations, packed in nibbles          
+      template<Count L>
+      consteval auto PartitionDwords() {
+         ::std::array<::std::uint32_t, (1 << L)> result {};
+         constexpr Count D = 8 / L;
+         for (Offset mask = 0; mask < (1 << L); ++mask) {
+            Offset w = 0;
+            for (Offset top = 0; top < 2; ++top) {
+               for (Offset i = 0; i < L; ++i) {
+                  if (((mask >> i) & 1) != top)
+                     continue;
+                  for (Offset d = 0; d < D; ++d) {
+                     result[mask] |= static_cast<::std::uint32_t>(i * D + d) << (4 * (w * D + d));
+                  }
+                  ++w;
+               }
+            }
+         }
+         return result;
+      }
+
+      template<Count L>
+      constexpr auto PartitionBytesTable = PartitionBytes<L>();
+      template<Count L>
+      constexpr auto PartitionDwordsTable = PartitionDwords<L>();
+
+      /// Get a bitmask of the lanes, whose keys are bigger than the pivot    
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      auto PartitionMask(const R& x, const R& pivot) noexcept {
+         constexpr bool S4 = sizeof(TypeOf<R>) == 4;
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               const auto gt = GreaterSIMD(x, pivot);
+               if constexpr (S4) return simde_mm_movemask_ps(simde_mm_castsi128_ps(gt));
+               else              return simde_mm_movemask_pd(simde_mm_castsi128_pd(gt));
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               const auto gt = GreaterSIMD(x, pivot);
+               if constexpr (S4) return simde_mm256_movemask_ps(simde_mm256_castsi256_ps(gt));
+               else              return simde_mm256_movemask_pd(simde_mm256_castsi256_pd(gt));
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>)
+               return MaskFrom<R>(GreaterSIMD(x, pivot));
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Move the lanes outside a mask to the bottom of a register, and the  
+      /// lanes inside the mask to the top                                    
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R PartitionPermute(const R& x, unsigned mask) noexcept {
+         constexpr Count L = CountOf<R>;
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               return R {simde_mm_shuffle_epi8(x, simde_mm_loadu_si128(
+                  PartitionBytesTable<L>[mask].data()))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               const auto nibbles = simde_mm256_srlv_epi32(
+                  simde_mm256_set1_epi32(static_cast<int>(PartitionDwordsTable<L>[mask])),
+                  simde_mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28)
+               );
+               return R {simde_mm256_permutevar8x32_epi32(x, nibbles)};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Write a register of keys to both ends of the free space - keys not  
+      /// bigger than the pivot at the left end, and the rest at the right    
+      ///   @param x, vx - the keys and their values                          
+      ///   @param pivot - the pivot in all lanes                             
+      ///   @param keys, values - where to write                              
+      ///   @param left, right - the ends of the free space, moved inwards    
+      template<CT::SIMD R, bool KV> LANGULUS(INLINED)
+      void PartitionStore(
+         const R& x, const R& vx, const R& pivot,
+         TypeOf<R>* keys, TypeOf<R>* values, Offset& left, Offset& right
+      ) noexcept {
+         constexpr Count L = CountOf<R>;
+         const unsigned mask = PartitionMask(x, pivot);
+         const Count bigger = ::std::popcount(mask);
+
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               // AVX-512 writes only the lanes it needs                
+               using M = MaskOf<R>;
+               const auto gt = static_cast<M>(mask);
+               const auto le = static_cast<M>(~mask);
+               if constexpr (L == 16) {
+                  simde_mm512_mask_compressstoreu_epi32(keys + left, le, x);
+                  simde_mm512_mask_compressstoreu_epi32(keys + right - bigger, gt, x);
+                  if constexpr (KV) {
+                     simde_mm512_mask_compressstoreu_epi32(values + left, le, vx);
+                     simde_mm512_mask_compressstoreu_epi32(values + right - bigger, gt, vx);
+                  }
+               }
+               else {
+                  simde_mm512_mask_compressstoreu_epi64(keys + left, le, x);
+                  simde_mm512_mask_compressstoreu_epi64(keys + right - bigger, gt, x);
+                  if constexpr (KV) {
+                     simde_mm512_mask_compressstoreu_epi64(values + left, le, vx);
+                     simde_mm512_mask_compressstoreu_epi64(values + right - bigger, gt, vx);
+                  }
+               }
+            }
+            else
+         #endif
+         {
+            // Otherwise the whole permuted register is written at both 
+            // ends, and each end keeps only its part of it             
+            const R p = PartitionPermute(x, mask);
+            StoreUnaligned(keys + left, p);
+            StoreUnaligned(keys + right - L, p);
+            if constexpr (KV) {
+               const R vp = PartitionPermute(vx, mask);
+               StoreUnaligned(values + left, vp);
+               StoreUnaligned(values + right - L, vp);
+            }
+         }
+
+         left  += L - bigger;
+         right -= bigger;
+      }
+
+      /// Partition keys in place around a pivot                              
+      /// The first and last registers are read in advance, which leaves      
+      /// free space at both ends. Each register is then read from the end    
+      /// that has less free space, so that both always have room for it      
+      ///   @param keys - the keys, at least two registers worth              
+      ///   @param values - the values, ignored if KV is false                
+      ///   @param n - number of elements                                     
+      ///   @param pivot - the pivot                                          
+      ///   @return number of keys not bigger than the pivot, that are now    
+      ///           at the front                                              
+      template<CT::SIMD R, bool KV>
+      Offset Partition(TypeOf<R>* keys, TypeOf<R>* values, Count n, TypeOf<R> pivot) noexcept {
+         using K = TypeOf<R>;
+         constexpr Count L = CountOf<R>;
+         const R p = Fill<sizeof(R)>(pivot);
+         const auto load = [values](Offset at) {
+            if constexpr (KV) return LoadUnaligned<R>(values + at);
+            else              return R::Zero();
+         };
+
+         const R first  = LoadUnaligned<R>(keys);
+         const R last   = LoadUnaligned<R>(keys + n - L);
+         const R vfirst = load(0);
+         const R vlast  = load(n - L);
+
+         Offset readLeft = L, readRight = n - L;
+         Offset left = 0, right = n;
+         while (readRight - readLeft >= L) {
+            Offset at;
+            if (readLeft - left <= right - readRight) {
+               at = readLeft;
+               readLeft += L;
+            }
+            else {
+               readRight -= L;
+               at = readRight;
+            }
+
+            PartitionStore<R, KV>(LoadUnaligned<R>(keys + at), load(at),
+               p, keys, values, left, right);
+         }
+
+         // The unread rest, and the registers read in advance, fill the
+         // free space exactly                                          
+         K k[L * 3], v[KV ? L * 3 : 1];
+         const Count rest = readRight - readLeft;
+         ::std::copy_n(keys + readLeft, rest, k);
+         StoreUnaligned(k + rest, first);
+         StoreUnaligned(k + rest + L, last);
+         if constexpr (KV) {
+            ::std::copy_n(values + readLeft, rest, v);
+            StoreUnaligned(v + rest, vfirst);
+            StoreUnaligned(v + rest + L, vlast);
+         }
+
+         for (Offset i = 0; i < rest + L * 2; ++i) {
+            const Offset to = k[i] > pivot ? --right : left++;
+            keys[to] = k[i];
+            if constexpr (KV)
+               values[to] = v[i];
+         }
+         return left;
+      }
+
+      /// Pick a pivot, as the median of a sorted sample                      
+      template<class K> NOD()
+      K SortPivot(const K* keys, Count n) noexcept {
+         constexpr Count S = 32;
+         ::std::array<K, S> sample;
+         for (Offset i = 0; i < S; ++i)
+            sample[i] = keys[i * n / S];
+         SortSmall<S>(sample);
+         return sample[S / 2];
+      }
+
+      /// Sort keys in place, by partitioning them until they are small       
+      /// enough to be sorted by networks                                     
+      ///   @param keys - the keys                                            
+      ///   @param values - the values, ignored if KV is false                
+      ///   @param n - number of elements                                     
+      ///   @param depth - partitions left before giving up on bad pivots,    
+      ///                  and falling back to std::sort                      
+      template<CT::SIMD R, bool KV>
+      void QuickSort(TypeOf<R>* keys, TypeOf<R>* values, Count n, int depth) {
+         using K = TypeOf<R>;
+         while (n > SortLeafRegisters * CountOf<R>) {
+            if (depth-- == 0) {
+               SortFallback<KV>(keys, values, n);
+               return;
+            }
+
+            const K pivot = SortPivot(keys, n);
+            Offset split = Partition<R, KV>(keys, values, n, pivot);
+            if (split == n) {
+               // Nothing is bigger than the pivot, so separate the keys
+               // equal to it, which are then in their final place      
+               if (pivot == ::std::numeric_limits<K>::min())
+                  return;
+               n = Partition<R, KV>(keys, values, n, pivot - 1);
+               continue;
+            }
+
+            // Recurse into the smaller part, and loop over the bigger one
+            if (split < n - split) {
+               QuickSort<R, KV>(keys, values, split, depth);
+               keys += split;
+               if constexpr (KV)
+                  values += split;
+               n -= split;
+            }
+            else {
+               QuickSort<R, KV>(keys + split, KV ? values + split : values, n - split, depth);
+               n = split;
+            }
+         }
+
+         SortLeaf<R, KV>(keys, values, n);
+      }
+
+      /// Map numbers to keys in place, or back                               
+      /// Keys are only copied into the numbers' storage as bytes, so that    
+      /// it's never accessed through a pointer to another type               
+      ///   @tparam T - the type of the numbers                               
+      ///   @tparam TO_KEYS - whether to map to keys, or back to numbers      
+      template<class T, bool TO_KEYS>
+      void SortMapInPlace(T* data, Count n) noexcept {
+         using K = SortKey<T>;
+         if constexpr (CT::Integer<T> and CT::Signed<T>)
+            return;
+
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            const auto map = [&]<class R>(Offset i) {
+               constexpr Count L = CountOf<R>;
+               for (; i + L <= n; i += L) {
+                  if constexpr (TO_KEYS) {
+                     StoreUnaligned(data + i, SortKeys<T>(LoadUnaligned<R>(data + i)));
+                  }
+                  else {
+                     using KR = Deref<decltype(ReinterpretSIMD<K>(::std::declval<R>()))>;
+                     StoreUnaligned(data + i, ReinterpretSIMD<T>(SortKeys<T>(LoadUnaligned<KR>(data + i))));
+                  }
+               }
+               return i;
+            };
+
+            #if LANGULUS_SIMD(512BIT)
+               i = map.template operator()<V512<T>>(i);
+            #elif LANGULUS_SIMD(256BIT)
+               i = map.template operator()<V256<T>>(i);
+            #else
+               i = map.template operator()<V128<T>>(i);
+            #endif
+         #endif
+
+         for (; i < n; ++i) {
+            if constexpr (TO_KEYS) {
+               const K key = ToSortKey(data[i]);
+               ::std::memcpy(data + i, &key, sizeof(K));
+            }
+            else {
+               K key;
+               ::std::memcpy(&key, data + i, sizeof(K));
+               data[i] = FromSortKey<T>(key);
+            }
+         }
+      }
+
+      /// Sort an array of numbers in place, with optional values             
+      ///   @param data - the numbers                                         
+      ///   @param values - the values, ignored if KV is false                
+      ///   @param n - number of elements                                     
+      template<bool KV, class T>
+      void SortBulk(T* data, void* values, Count n) {
+         using K = SortKey<T>;
+         if (n < 2)
+            return;
+
+         // Moving the mapped numbers onto themselves implicitly creates
+         // keys in their place, which can then be accessed as such -   
+         // compilers drop the move itself. Values can be of any type of
+         // the same size, so they get the same treatment               
+         SortMapInPlace<T, true>(data, n);
+         const auto keys = static_cast<K*>(::std::memmove(data, data, n * sizeof(K)));
+         K* vals = nullptr;
+         if constexpr (KV)
+            vals = static_cast<K*>(::std::memmove(values, values, n * sizeof(K)));
+         const int depth = 2 * static_cast<int>(::std::bit_width(n));
+
+         #if LANGULUS_SIMD(512BIT)
+            QuickSort<V512<K>, KV>(keys, vals, n, depth);
+         #elif LANGULUS_SIMD(256BIT)
+            QuickSort<V256<K>, KV>(keys, vals, n, depth);
+         #elif LANGULUS_SIMD(128BIT)
+            QuickSort<V128<K>, KV>(keys, vals, n, depth);
+         #else
+            (void)depth;
+            SortFallback<KV>(keys, vals, n);
+         #endif
+
+         SortMapInPlace<T, false>(static_cast<T*>(::std::memmove(keys, keys, n * sizeof(K))), n);
+         if constexpr (KV)
+            ::std::memmove(vals, vals, n * sizeof(K));
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Sort a small array in ascending order                                  
+   /// Uses sorting networks in registers - for bigger arrays, std::sort is   
+   /// usually faster                                                         
+   ///   @param data - a Vector, std::array or C array of up to 64 elements   
+   ///                 of int32, uint32, float, int64, uint64 or double       
+   template<class DATA> requires (CountOf<DATA> > 0) LANGULUS(INLINED)
+   void Sort(DATA& data) noexcept {
+      using T = Decvq<Deref<decltype(data[0])>>;
+      constexpr Count N = CountOf<DATA>;
+      static_assert(Inner::Sortable<T>, "Can only sort 32bit or 64bit numbers");
+      static_assert(N <= 64, "Sorting networks are meant for up to 64 elements");
+      Inner::SortSmall<N>(data);
+   }
+
+   /// Sort a small array of keys in ascending order, and move the values     
+   /// along with their keys                                                  
+   ///   @param keys - a Vector, std::array or C array of up to 64 elements   
+   ///                 of int32, uint32, float, int64, uint64 or double       
+   ///   @param values - an array of the same length, whose elements are of   
+   ///                   the same size as the keys                            
+   template<class KEYS, class VALUES> requires (CountOf<KEYS> > 0) LANGULUS(INLINED)
+   void Sort(KEYS& keys, VALUES& values) noexcept {
+      using T = Decvq<Deref<decltype(keys[0])>>;
+      using U = Decvq<Deref<decltype(values[0])>>;
+      constexpr Count N = CountOf<KEYS>;
+      static_assert(Inner::Sortable<T>, "Can only sort 32bit or 64bit numbers");
+      static_assert(N <= 64, "Sorting networks are meant for up to 64 elements");
+      static_assert(CountOf<VALUES> == N, "Values must be as many as keys");
+      static_assert(sizeof(U) == sizeof(T) and ::std::is_trivially_copyable_v<U>,
+         "Values must be of the same size as the keys");
+      Inner::SortSmall<N>(keys, values);
+   }
+
+   /// Sort an array of any size in ascending order                           
+   /// Partitions it with registers around pivots, until the parts are small  
+   /// enough to be sorted with networks                                      
+   ///   @param data - span of int32, uint32, float, int64, uint64 or double  
+   template<class DATA> LANGULUS(INLINED)
+   void SortArray(DATA&& data) {
+      const ::std::span span {data};
+      using T = typename decltype(span)::element_type;
+      static_assert(Inner::Sortable<T> and not ::std::is_const_v<T>,
+         "Can only sort mutable spans of 32bit or 64bit numbers");
+      Inner::SortBulk<false>(span.data(), nullptr, span.size());
+   }
+
+   /// Sort an array of keys of any size in ascending order, and move the     
+   /// values along with their keys                                           
+   ///   @param keys - span of int32, uint32, float, int64, uint64 or double  
+   ///   @param values - span of elements of the same size as the keys, at    
+   ///                   least as long as 'keys'                              
+   template<class KEYS, class VALUES> LANGULUS(INLINED)
+   void SortArray(KEYS&& keys, VALUES&& values) {
+      const ::std::span k {keys};
+      const ::std::span v {values};
+      using T = typename decltype(k)::element_type;
+      using U = typename decltype(v)::element_type;
+      static_assert(Inner::Sortable<T> and not ::std::is_const_v<T>,
+         "Can only sort mutable spans of 32bit or 64bit numbers");
+      static_assert(sizeof(U) == sizeof(T) and not ::std::is_const_v<U>
+         and ::std::is_trivially_copyable_v<U>,
+         "Values must be mutable, and of the same size as the keys");
+      LANGULUS_ASSUME(UserAssumes, v.size() >= k.size(),
+         "Not enough values for the keys");
+      Inner::SortBulk<true>(k.data(), static_cast<void*>(v.data()), k.size());
+   }
+
+} // namespace Langulus::SIMD
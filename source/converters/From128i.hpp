@@ -6,7 +6,7 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #pragma once
-#include "../Common.hpp"
+#include "../Pack.hpp"
 
 
 namespace Langulus::SIMD::Inner
@@ -14,13 +14,21 @@ namespace Langulus::SIMD::Inner
 
    /// Convert V128i to any other register                                    
    ///   @tparam TO - the desired element type                                
+   ///   @tparam P - whether to saturate integers that don't fit in TO        
+   ///      (see ConvertPolicy)                                               
    ///   @param v - the input register                                        
    ///   @return the converted register                                       
-   template<Element TO> NOD() LANGULUS(INLINED)
+   template<Element TO, ConvertPolicy P = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
    auto ConvertFrom128i(CT::SIMD128i auto v) noexcept {
       using R = decltype(v);
       using T = TypeOf<R>;
 
+      if constexpr (ConvertSaturates<P> and CT::Integer<TO> and sizeof(TO) > sizeof(T)
+                and CT::Signed<T> and not CT::Signed<TO>) {
+         // Negative integers saturate to zero, before widening them    
+         v = PackSign(v);
+      }
+
       if constexpr (CT::Double<TO>) {
          //                                                             
          // Converting as many doubles as possible                      
@@ -133,47 +141,24 @@ namespace Langulus::SIMD::Inner
          }
          else static_assert(false, "Unsupported conversion");
       }
-      else if constexpr (CT::Integer8<TO>) {
+      else if constexpr (sizeof(TO) <= sizeof(T)) {
          //                                                             
-         // Converting to 8bit integer                                  
+         // Converting to smaller integers, or to the other signedness  
          //                                                             
-         if constexpr (CT::Integer8<T>) {
-            LANGULUS_SIMD_VERBOSE("No conversion required");
-            return V128<TO> {v};
-         }
-         else if constexpr (CT::Integer16<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 16bit ints -> 8bit ints");
-            return V128<TO> {v.Pack()};
-         }
-         else if constexpr (CT::Integer32<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 32bit ints -> 8bit ints");
-            return V128<TO> {v.Pack().Pack()};
-         }
-         else if constexpr (CT::Integer64<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 64bit ints -> 8bit ints");
-            return V128<TO> {v.Pack().Pack().Pack()};
-         }
-         else static_assert(false, "Unsupported conversion");
+         LANGULUS_SIMD_VERBOSE("Packing ints -> smaller ints");
+         return PackTo<TO, P>(v);
       }
       else if constexpr (CT::Integer16<TO>) {
          //                                                             
          // Converting to 16bit integer                                 
          //                                                             
-         if constexpr (CT::Integer8<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 8bit ints -> 16bit ints");
-            return V128<TO> {v.UnpackLo()};
-         }
-         else if constexpr (CT::Integer16<T>) {
-            LANGULUS_SIMD_VERBOSE("No conversion required");
-            return V128<TO> {v};
-         }
-         else if constexpr (CT::Integer32<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 32bit ints -> 16bit ints");
-            return V128<TO> {v.Pack()};
+         if constexpr (CT::SignedInteger8<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting signed 8bit ints -> 16bit ints");
+            return V128<TO> {simde_mm_cvtepi8_epi16(v)};
          }
-         else if constexpr (CT::Integer64<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 64bit ints -> 16bit ints");
-            return V128<TO> {v.Pack().Pack()};
+         else if constexpr (CT::UnsignedInteger8<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting unsigned 8bit ints -> 16bit ints");
+            return V128<TO> {simde_mm_cvtepu8_epi16(v)};
          }
          else static_assert(false, "Unsupported conversion");
       }
@@ -181,21 +166,21 @@ namespace Langulus::SIMD::Inner
          //                                                             
          // Converting to 32bit integer                                 
          //                                                             
-         if constexpr (CT::Integer8<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 8bit ints -> 32bit ints");
-            return V128<TO> {v.UnpackLo().UnpackLo()};
+         if constexpr (CT::SignedInteger8<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting signed 8bit ints -> 32bit ints");
+            return V128<TO> {simde_mm_cvtepi8_epi32(v)};
          }
-         else if constexpr (CT::Integer16<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 16bit ints -> 32bit ints");
-            return V128<TO> {v.UnpackLo()};
+         else if constexpr (CT::UnsignedInteger8<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting unsigned 8bit ints -> 32bit ints");
+            return V128<TO> {simde_mm_cvtepu8_epi32(v)};
          }
-         else if constexpr (CT::Integer32<T>) {
-            LANGULUS_SIMD_VERBOSE("No conversion required");
-            return V128<TO> {v};
+         else if constexpr (CT::SignedInteger16<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting signed 16bit ints -> 32bit ints");
+            return V128<TO> {simde_mm_cvtepi16_epi32(v)};
          }
-         else if constexpr (CT::Integer64<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 64bit ints -> 32bit ints");
-            return V128<TO> {v.Pack()};
+         else if constexpr (CT::UnsignedInteger16<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting unsigned 16bit ints -> 32bit ints");
+            return V128<TO> {simde_mm_cvtepu16_epi32(v)};
          }
          else static_assert(false, "Unsupported conversion");
       }
@@ -203,21 +188,29 @@ namespace Langulus::SIMD::Inner
          //                                                             
          // Converting to 64bit integer                                 
          //                                                             
-         if constexpr (CT::Integer8<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 8bit ints -> 64bit ints");
-            return V128<TO> {v.UnpackLo().UnpackLo().UnpackLo()};
+         if constexpr (CT::SignedInteger8<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting signed 8bit ints -> 64bit ints");
+            return V128<TO> {simde_mm_cvtepi8_epi64(v)};
          }
-         else if constexpr (CT::Integer16<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 16bit ints -> 64bit ints");
-            return V128<TO> {v.UnpackLo().UnpackLo()};
+         else if constexpr (CT::UnsignedInteger8<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting unsigned 8bit ints -> 64bit ints");
+            return V128<TO> {simde_mm_cvtepu8_epi64(v)};
          }
-         else if constexpr (CT::Integer32<T>) {
-            LANGULUS_SIMD_VERBOSE("Converting 32bit ints -> 64bit ints");
-            return V128<TO> {v.UnpackLo()};
+         else if constexpr (CT::SignedInteger16<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting signed 16bit ints -> 64bit ints");
+            return V128<TO> {simde_mm_cvtepi16_epi64(v)};
+         }
+         else if constexpr (CT::UnsignedInteger16<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting unsigned 16bit ints -> 64bit ints");
+            return V128<TO> {simde_mm_cvtepu16_epi64(v)};
+         }
+         else if constexpr (CT::SignedInteger32<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting signed 32bit ints -> 64bit ints");
+            return V128<TO> {simde_mm_cvtepi32_epi64(v)};
          }
-         else if constexpr (CT::Integer64<T>) {
-            LANGULUS_SIMD_VERBOSE("No conversion required");
-            return V128<TO> {v};
+         else if constexpr (CT::UnsignedInteger32<T>) {
+            LANGULUS_SIMD_VERBOSE("Converting unsigned 32bit ints -> 64bit ints");
+            return V128<TO> {simde_mm_cvtepu32_epi64(v)};
          }
          else static_assert(false, "Unsupported conversion");
       }
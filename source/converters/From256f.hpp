@@ -6,7 +6,7 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #pragma once
-#include "../Common.hpp"
+#include "../Pack.hpp"
 
 
 namespace Langulus::SIMD::Inner
@@ -14,61 +14,39 @@ namespace Langulus::SIMD::Inner
 
    /// Convert V256f to any other register                                    
    ///   @tparam TO - the desired element type                                
+   ///   @tparam P - how to round the floats, and whether to saturate them    
+   ///      (see ConvertPolicy)                                               
    ///   @param v - the input register                                        
    ///   @return the converted register                                       
-   template<Element TO> NOD() LANGULUS(INLINED)
+   template<Element TO, ConvertPolicy P = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
    auto ConvertFrom256f(CT::SIMD256f auto v) noexcept {
       if constexpr (CT::Double<TO>)
          return V256<TO> {simde_mm256_cvtps_pd(simde_mm256_castps256_ps128(v))};
       else if constexpr (CT::Float<TO>)
          return v;
-      else if constexpr (CT::SignedInteger8<TO>) {
-         const V256i32 t32 {simde_mm256_cvtps_epi32(v)};
-         return t32.Pack().Pack();
-      }
-      else if constexpr (CT::UnsignedInteger8<TO>) {
-         #if LANGULUS_SIMD(AVX512F) and LANGULUS_SIMD(AVX512VL)
-            const V256u32 t32 {simde_mm256_cvtps_epu32(v)};
-         #else
-            const V256u32 t32 {simde_mm256_cvtps_epi32(v)};
-         #endif
-         return t32.Pack().Pack();
-      }
-      else if constexpr (CT::SignedInteger16<TO>) {
-         const V256i32 t32 {simde_mm256_cvtps_epi32(v)};
-         return t32.Pack();
-      }
-      else if constexpr (CT::UnsignedInteger16<TO>) {
-         #if LANGULUS_SIMD(AVX512F) and LANGULUS_SIMD(AVX512VL)
-            const V256u32 t32 {simde_mm256_cvtps_epu32(v)};
-         #else
-            const V256u32 t32 {simde_mm256_cvtps_epi32(v)};
-         #endif
-         return t32.Pack();
-      }
-      else if constexpr (CT::SignedInteger32<TO>)
-         return V256<TO> {simde_mm256_cvtps_epi32(v)};
+      else if constexpr (sizeof(TO) < 4 or CT::SignedInteger32<TO>)
+         return PackTo<TO, P>(ConvertRealsToInt32<P>(v));
       else if constexpr (CT::UnsignedInteger32<TO>) {
          #if LANGULUS_SIMD(AVX512F) and LANGULUS_SIMD(AVX512VL)
-            return V256<TO> {simde_mm256_cvtps_epu32(v)};
+            return ConvertSaturateTop<P>(v, V256<TO> {simde_mm256_cvtps_epu32(ConvertPrepareReals<TO, P>(v))});
          #else
-            return V256<TO> {simde_mm256_cvtps_epi32(v)};
+            return ConvertRealsOneByOne<V256<TO>, P>(v);
          #endif
       }
       else if constexpr (CT::SignedInteger64<TO>) {
          #if LANGULUS_SIMD(AVX512DQ) and LANGULUS_SIMD(AVX512VL)
-            return V256<TO> {simde_mm256_cvtps_epi64(v)};
+            const auto y = ConvertPrepareReals<TO, P>(v);
+            return ConvertSaturateTop<P>(v, V256<TO> {simde_mm256_cvtps_epi64(simde_mm256_castps256_ps128(y))});
          #else
-            const V256i32 t32 {simde_mm256_cvtps_epi32(v)};
-            return t32.UnpackLo();
+            return ConvertRealsOneByOne<V256<TO>, P>(v);
          #endif
       }
       else if constexpr (CT::UnsignedInteger64<TO>) {
          #if LANGULUS_SIMD(AVX512DQ) and LANGULUS_SIMD(AVX512VL)
-            return V256<TO> {simde_mm256_cvtps_epu64(v)};
+            const auto y = ConvertPrepareReals<TO, P>(v);
+            return ConvertSaturateTop<P>(v, V256<TO> {simde_mm256_cvtps_epu64(simde_mm256_castps256_ps128(y))});
          #else
-            const V256u32 t32 {simde_mm256_cvtps_epi32(v)};
-            return t32.UnpackLo();
+            return ConvertRealsOneByOne<V256<TO>, P>(v);
          #endif
       }
       else static_assert(false, "Unsupported register");
@@ -6,7 +6,7 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #pragma once
-#include "../Common.hpp"
+#include "../Pack.hpp"
 
 
 namespace Langulus::SIMD::Inner
@@ -14,13 +14,21 @@ namespace Langulus::SIMD::Inner
 
    /// Convert V256i to any other register                                    
    ///   @tparam TO - the desired element type                                
+   ///   @tparam P - whether to saturate integers that don't fit in TO        
+   ///      (see ConvertPolicy)                                               
    ///   @param v - the input register                                        
    ///   @return the converted register                                       
-   template<Element TO> NOD() LANGULUS(INLINED)
+   template<Element TO, ConvertPolicy P = ConvertPolicy::Wrap> NOD() LANGULUS(INLINED)
    auto ConvertFrom256i(CT::SIMD256i auto v) noexcept {
       using R = decltype(v);
       using T = TypeOf<R>;
 
+      if constexpr (ConvertSaturates<P> and CT::Integer<TO> and sizeof(TO) > sizeof(T)
+                and CT::Signed<T> and not CT::Signed<TO>) {
+         // Negative integers saturate to zero, before widening them    
+         v = PackSign(v);
+      }
+
       if constexpr (CT::Double<TO>) {
          //                                                             
          // Converting as many doubles as possible                      
@@ -131,33 +139,20 @@ namespace Langulus::SIMD::Inner
          }
          else static_assert(false, "Unsupported conversion");
       }
-      else if constexpr (CT::Integer8<TO>) {
+      else if constexpr (sizeof(TO) <= sizeof(T)) {
          //                                                             
-         // Converting to 8bit integer                                  
+         // Converting to smaller integers, or to the other signedness  
          //                                                             
-         if constexpr (CT::Integer8<T>)
-            return V256<TO> {v};
-         else if constexpr (CT::Integer16<T>)
-            return V256<TO> {v.Pack()};
-         else if constexpr (CT::Integer32<T>)
-            return V256<TO> {v.Pack().Pack()};
-         else if constexpr (CT::Integer64<T>)
-            return V256<TO> {v.Pack().Pack().Pack()};
-         else
-            static_assert(false, "Unsupported conversion");
+         return PackTo<TO, P>(v);
       }
       else if constexpr (CT::Integer16<TO>) {
          //                                                             
          // Converting to 16bit integer                                 
          //                                                             
-         if constexpr (CT::Integer8<T>)
-            return V256<TO> {v.UnpackLo()};
-         else if constexpr (CT::Integer16<T>)
-            return V256<TO> {v};
-         else if constexpr (CT::Integer32<T>)
-            return V256<TO> {v.Pack()};
-         else if constexpr (CT::Integer64<T>)
-            return V256<TO> {v.Pack().Pack()};
+         if constexpr (CT::SignedInteger8<T>)
+            return V256<TO> {simde_mm256_cvtepi8_epi16(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::UnsignedInteger8<T>)
+            return V256<TO> {simde_mm256_cvtepu8_epi16(simde_mm256_castsi256_si128(v))};
          else
             static_assert(false, "Unsupported conversion");
       }
@@ -165,14 +160,14 @@ namespace Langulus::SIMD::Inner
          //                                                             
          // Converting to 32bit integer                                 
          //                                                             
-         if constexpr (CT::Integer8<T>)
-            return V256<TO> {v.UnpackLo().UnpackLo()};
-         else if constexpr (CT::Integer16<T>)
-            return V256<TO> {v.UnpackLo()};
-         else if constexpr (CT::Integer32<T>)
-            return V256<TO> {v};
-         else if constexpr (CT::Integer64<T>)
-            return V256<TO> {v.Pack()};
+         if constexpr (CT::SignedInteger8<T>)
+            return V256<TO> {simde_mm256_cvtepi8_epi32(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::UnsignedInteger8<T>)
+            return V256<TO> {simde_mm256_cvtepu8_epi32(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::SignedInteger16<T>)
+            return V256<TO> {simde_mm256_cvtepi16_epi32(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::UnsignedInteger16<T>)
+            return V256<TO> {simde_mm256_cvtepu16_epi32(simde_mm256_castsi256_si128(v))};
          else
             static_assert(false, "Unsupported conversion");
       }
@@ -180,14 +175,18 @@ namespace Langulus::SIMD::Inner
          //                                                             
          // Converting to 64bit integer                                 
          //                                                             
-         if constexpr (CT::Integer8<T>)
-            return V256<TO> {v.UnpackLo().UnpackLo().UnpackLo()};
-         else if constexpr (CT::Integer16<T>)
-            return V256<TO> {v.UnpackLo().UnpackLo()};
-         else if constexpr (CT::Integer32<T>)
-            return V256<TO> {v.UnpackLo()};
-         else if constexpr (CT::Integer64<T>)
-            return V256<TO> {v};
+         if constexpr (CT::SignedInteger8<T>)
+            return V256<TO> {simde_mm256_cvtepi8_epi64(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::UnsignedInteger8<T>)
+            return V256<TO> {simde_mm256_cvtepu8_epi64(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::SignedInteger16<T>)
+            return V256<TO> {simde_mm256_cvtepi16_epi64(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::UnsignedInteger16<T>)
+            return V256<TO> {simde_mm256_cvtepu16_epi64(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::SignedInteger32<T>)
+            return V256<TO> {simde_mm256_cvtepi32_epi64(simde_mm256_castsi256_si128(v))};
+         else if constexpr (CT::UnsignedInteger32<T>)
+            return V256<TO> {simde_mm256_cvtepu32_epi64(simde_mm256_castsi256_si128(v))};
          else
             static_assert(false, "Unsupported conversion");
       }
@@ -0,0 +1,316 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "../Common.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+namespace Langulus::SIMD
+{
+
+   /// How Convert treats numbers that don't fit in the output, and reals     
+   /// converted to integers. An overflow policy can be combined with a       
+   /// rounding policy, i.e. ConvertPolicy::Saturate | ConvertPolicy::Floor   
+   enum class ConvertPolicy : unsigned {
+      // Integers wrap around, as with static_cast. Reals that don't fit
+      // in the output give unspecified results                         
+      Wrap = 0,
+      // Numbers are clamped to the range of the output, NaNs become zero
+      Saturate = 1,
+
+      // Reals are truncated towards zero, as with static_cast          
+      TowardZero = 0,
+      // Reals are rounded to the nearest integer, ties to even         
+      RoundNearest = 2,
+      // Reals are rounded down                                         
+      Floor = 4,
+      // Reals are rounded up                                           
+      Ceil = 6
+   };
+
+   /// Combine an overflow policy with a rounding policy                      
+   NOD() LANGULUS(INLINED)
+   constexpr ConvertPolicy operator | (ConvertPolicy a, ConvertPolicy b) noexcept {
+      return static_cast<ConvertPolicy>(static_cast<unsigned>(a) | static_cast<unsigned>(b));
+   }
+
+   namespace Inner
+   {
+
+      /// Check if a policy saturates                                         
+      template<ConvertPolicy P>
+      constexpr bool ConvertSaturates = (static_cast<unsigned>(P) & 1) != 0;
+
+      /// The rounding part of a policy                                       
+      template<ConvertPolicy P>
+      constexpr ConvertPolicy ConvertRounding = static_cast<ConvertPolicy>(static_cast<unsigned>(P) & 6);
+
+      /// Convert a single number                                             
+      ///   @tparam P - the policy                                            
+      ///   @param x - the number to convert                                  
+      ///   @return the converted number                                      
+      template<ConvertPolicy P, class TO, class FROM> NOD() LANGULUS(INLINED)
+      constexpr TO ConvertScalar(const FROM& x) noexcept {
+         constexpr auto ROUND = ConvertRounding<P>;
+         using LIMITS = ::std::numeric_limits<TO>;
+
+         if constexpr (CT::Integer<TO> and (CT::Float<FROM> or CT::Double<FROM>)) {
+            FROM r = x;
+            if      constexpr (ROUND == ConvertPolicy::RoundNearest) r = ::std::nearbyint(x);
+            else if constexpr (ROUND == ConvertPolicy::Floor)        r = ::std::floor(x);
+            else if constexpr (ROUND == ConvertPolicy::Ceil)         r = ::std::ceil(x);
+
+            if constexpr (ConvertSaturates<P>) {
+               // The biggest integers might round up when converted to 
+               // reals, but then anything that reaches them saturates  
+               if (r != r)
+                  return TO {0};
+               if (r <= static_cast<FROM>(LIMITS::lowest()))
+                  return LIMITS::lowest();
+               if (r >= static_cast<FROM>(LIMITS::max()))
+                  return LIMITS::max();
+            }
+            return static_cast<TO>(r);
+         }
+         else if constexpr (ConvertSaturates<P> and CT::Integer<FROM, TO>) {
+            if constexpr (CT::Signed<FROM>) {
+               if (x < 0) {
+                  if constexpr (not CT::Signed<TO>)
+                     return TO {0};
+                  else if (static_cast<::std::int64_t>(x) < static_cast<::std::int64_t>(LIMITS::lowest()))
+                     return LIMITS::lowest();
+                  return static_cast<TO>(x);
+               }
+            }
+            if (static_cast<::std::uint64_t>(x) > static_cast<::std::uint64_t>(LIMITS::max()))
+               return LIMITS::max();
+            return static_cast<TO>(x);
+         }
+         else return static_cast<TO>(x);
+      }
+
+      /// The biggest real F, that isn't bigger than the biggest TO. The      
+      /// biggest TO rounds up to a power of two, if it has more digits than  
+      /// F, so then it's stepped down to the real just below it              
+      template<class F, class TO>
+      constexpr F ConvertRealsTop = ::std::numeric_limits<TO>::digits > ::std::numeric_limits<F>::digits
+         ? static_cast<F>(::std::numeric_limits<TO>::max()) * (F {1} - ::std::numeric_limits<F>::epsilon() / 2)
+         : static_cast<F>(::std::numeric_limits<TO>::max());
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Prepare a register of reals for converting to integers of TO     
+         /// The reals are rounded to whole numbers by policy - rounding to   
+         /// nearest is left to the conversion itself. If the policy          
+         /// saturates, they're also clamped to the range of TO (see          
+         /// ConvertRealsTop), and NaNs become zero                           
+         ///   @tparam TO - the integer that the reals are converted to       
+         ///   @tparam P - the policy                                         
+         ///   @param x - register of floats or doubles                       
+         ///   @return the prepared register                                  
+         template<class TO, ConvertPolicy P, CT::SIMD R> NOD() LANGULUS(INLINED)
+         R ConvertPrepareReals(const R& x) noexcept {
+            using F = TypeOf<R>;
+            constexpr auto ROUND = ConvertRounding<P>;
+            constexpr int MODE = (ROUND == ConvertPolicy::Floor ? SIMDE_MM_FROUND_TO_NEG_INF
+                                : ROUND == ConvertPolicy::Ceil  ? SIMDE_MM_FROUND_TO_POS_INF
+                                                                : SIMDE_MM_FROUND_TO_ZERO)
+                               | SIMDE_MM_FROUND_NO_EXC;
+            constexpr auto lo = static_cast<F>(::std::numeric_limits<TO>::lowest());
+            constexpr auto hi = ConvertRealsTop<F, TO>;
+            constexpr bool ROUNDS = ROUND != ConvertPolicy::RoundNearest;
+
+            auto y = x;
+            if constexpr (CT::SIMD128<R>) {
+               if constexpr (CT::Float<F>) {
+                  if constexpr (ConvertSaturates<P>) {
+                     y = simde_mm_and_ps(y, simde_mm_cmpord_ps(y, y));
+                     y = simde_mm_min_ps(simde_mm_max_ps(y, simde_mm_set1_ps(lo)), simde_mm_set1_ps(hi));
+                  }
+                  if constexpr (ROUNDS)
+                     y = simde_mm_round_ps(y, MODE);
+               }
+               else {
+                  if constexpr (ConvertSaturates<P>) {
+                     y = simde_mm_and_pd(y, simde_mm_cmpord_pd(y, y));
+                     y = simde_mm_min_pd(simde_mm_max_pd(y, simde_mm_set1_pd(lo)), simde_mm_set1_pd(hi));
+                  }
+                  if constexpr (ROUNDS)
+                     y = simde_mm_round_pd(y, MODE);
+               }
+            }
+            else
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if constexpr (CT::Float<F>) {
+                  if constexpr (ConvertSaturates<P>) {
+                     y = simde_mm256_and_ps(y, simde_mm256_cmp_ps(y, y, SIMDE_CMP_ORD_Q));
+                     y = simde_mm256_min_ps(simde_mm256_max_ps(y, simde_mm256_set1_ps(lo)), simde_mm256_set1_ps(hi));
+                  }
+                  if constexpr (ROUNDS)
+                     y = simde_mm256_round_ps(y, MODE);
+               }
+               else {
+                  if constexpr (ConvertSaturates<P>) {
+                     y = simde_mm256_and_pd(y, simde_mm256_cmp_pd(y, y, SIMDE_CMP_ORD_Q));
+                     y = simde_mm256_min_pd(simde_mm256_max_pd(y, simde_mm256_set1_pd(lo)), simde_mm256_set1_pd(hi));
+                  }
+                  if constexpr (ROUNDS)
+                     y = simde_mm256_round_pd(y, MODE);
+               }
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if constexpr (CT::Float<F>) {
+                  if constexpr (ConvertSaturates<P>) {
+                     y = simde_mm512_maskz_mov_ps(simde_mm512_cmp_ps_mask(y, y, SIMDE_CMP_ORD_Q), y);
+                     y = simde_mm512_min_ps(simde_mm512_max_ps(y, simde_mm512_set1_ps(lo)), simde_mm512_set1_ps(hi));
+                  }
+                  if constexpr (ROUNDS)
+                     y = simde_mm512_roundscale_ps(y, MODE);
+               }
+               else {
+                  if constexpr (ConvertSaturates<P>) {
+                     y = simde_mm512_maskz_mov_pd(simde_mm512_cmp_pd_mask(y, y, SIMDE_CMP_ORD_Q), y);
+                     y = simde_mm512_min_pd(simde_mm512_max_pd(y, simde_mm512_set1_pd(lo)), simde_mm512_set1_pd(hi));
+                  }
+                  if constexpr (ROUNDS)
+                     y = simde_mm512_roundscale_pd(y, MODE);
+               }
+            }
+            else
+         #endif
+            static_assert(false, "Unsupported register");
+            return y;
+         }
+
+         /// Convert a register of reals to 32bit integers by policy          
+         /// Doubles give half as many integers, in a register of half the    
+         /// width, or in the lower half of a 128bit register. Saturated      
+         /// floats from 2^31 up are clamped to the biggest float below it,   
+         /// and get the missing low bits of the biggest integer here         
+         ///   @tparam P - the policy                                         
+         ///   @param x - register of floats or doubles                       
+         ///   @return the register of integers                               
+         template<ConvertPolicy P, CT::SIMD R> NOD() LANGULUS(INLINED)
+         auto ConvertRealsToInt32(const R& x) noexcept {
+            using F = TypeOf<R>;
+            using I = ::std::int32_t;
+            const auto y = ConvertPrepareReals<I, P>(x);
+
+            if constexpr (CT::SIMD128<R>) {
+               if constexpr (CT::Double<F>)
+                  return V128<I> {simde_mm_cvtpd_epi32(y)};
+               else if constexpr (ConvertSaturates<P>) {
+                  return V128<I> {simde_mm_or_si128(simde_mm_cvtps_epi32(y), simde_mm_and_si128(
+                     simde_mm_castps_si128(simde_mm_cmpge_ps(x, simde_mm_set1_ps(2147483648.0f))),
+                     simde_mm_set1_epi32(0x7F)))};
+               }
+               else return V128<I> {simde_mm_cvtps_epi32(y)};
+            }
+            else
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               if constexpr (CT::Double<F>)
+                  return V128<I> {simde_mm256_cvtpd_epi32(y)};
+               else if constexpr (ConvertSaturates<P>) {
+                  return V256<I> {simde_mm256_or_si256(simde_mm256_cvtps_epi32(y), simde_mm256_and_si256(
+                     simde_mm256_castps_si256(simde_mm256_cmp_ps(x, simde_mm256_set1_ps(2147483648.0f), SIMDE_CMP_GE_OQ)),
+                     simde_mm256_set1_epi32(0x7F)))};
+               }
+               else return V256<I> {simde_mm256_cvtps_epi32(y)};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               if constexpr (CT::Double<F>)
+                  return V256<I> {simde_mm512_cvtpd_epi32(y)};
+               else if constexpr (ConvertSaturates<P>) {
+                  return V512<I> {simde_mm512_mask_or_epi32(simde_mm512_cvtps_epi32(y),
+                     simde_mm512_cmp_ps_mask(x, simde_mm512_set1_ps(2147483648.0f), SIMDE_CMP_GE_OQ),
+                     simde_mm512_cvtps_epi32(y), simde_mm512_set1_epi32(0x7F))};
+               }
+               else return V512<I> {simde_mm512_cvtps_epi32(y)};
+            }
+            else
+         #endif
+            static_assert(false, "Unsupported register");
+         }
+
+         /// Convert a register of reals to integers one by one, for          
+         /// integers without a fitting instruction                           
+         ///   @tparam OUT - the register of integers to convert to           
+         ///   @tparam P - the policy                                         
+         ///   @param x - register of floats or doubles                       
+         ///   @return the register of integers, with as many of them as fit  
+         template<CT::SIMD OUT, ConvertPolicy P, CT::SIMD R> NOD() LANGULUS(INLINED)
+         OUT ConvertRealsOneByOne(const R& x) noexcept {
+            using F = TypeOf<R>;
+            using TO = TypeOf<OUT>;
+            constexpr Count FN = sizeof(R::m) / sizeof(F);
+            constexpr Count TN = sizeof(OUT::m) / sizeof(TO);
+
+            const auto from = ::std::bit_cast<::std::array<F, FN>>(x.m);
+            ::std::array<TO, TN> to {};
+            for (Offset i = 0; i < (FN < TN ? FN : TN); ++i)
+               to[i] = ConvertScalar<P, TO>(from[i]);
+            return OUT {::std::bit_cast<decltype(OUT::m)>(to)};
+         }
+
+         #if LANGULUS_SIMD(AVX512F) and LANGULUS_SIMD(AVX512VL)
+            /// Saturate integers converted from reals, that reached the      
+            /// biggest TO - those were clamped to ConvertRealsTop, which is  
+            /// below it, if TO has more digits than the reals                
+            ///   @tparam P - the policy                                      
+            ///   @param x - register of the reals, before preparing them     
+            ///   @param y - register of the converted integers               
+            ///   @return the saturated integers                              
+            template<ConvertPolicy P, CT::SIMD OUT, CT::SIMD R> NOD() LANGULUS(INLINED)
+            OUT ConvertSaturateTop(const R& x, const OUT& y) noexcept {
+               using F = TypeOf<R>;
+               using TO = TypeOf<OUT>;
+               if constexpr (not ConvertSaturates<P>
+                          or ::std::numeric_limits<TO>::digits <= ::std::numeric_limits<F>::digits)
+                  return y;
+               else {
+                  // The biggest TO rounds up to a power of two         
+                  constexpr auto TOP = static_cast<F>(::std::numeric_limits<TO>::max());
+                  const auto mask = [&] {
+                     if constexpr (CT::SIMD128<R> and CT::Float<F>)
+                        return simde_mm_cmp_ps_mask(x, simde_mm_set1_ps(TOP), SIMDE_CMP_GE_OQ);
+                     else if constexpr (CT::SIMD128<R>)
+                        return simde_mm_cmp_pd_mask(x, simde_mm_set1_pd(TOP), SIMDE_CMP_GE_OQ);
+                     else if constexpr (CT::Float<F>)
+                        return simde_mm256_cmp_ps_mask(x, simde_mm256_set1_ps(TOP), SIMDE_CMP_GE_OQ);
+                     else
+                        return simde_mm256_cmp_pd_mask(x, simde_mm256_set1_pd(TOP), SIMDE_CMP_GE_OQ);
+                  }();
+
+                  constexpr auto MAX = ::std::numeric_limits<TO>::max();
+                  if constexpr (CT::SIMD128<OUT> and sizeof(TO) == 4)
+                     return OUT {simde_mm_mask_mov_epi32(y, mask, simde_mm_set1_epi32(static_cast<int>(MAX)))};
+                  else if constexpr (CT::SIMD128<OUT>)
+                     return OUT {simde_mm_mask_mov_epi64(y, mask, simde_mm_set1_epi64x(static_cast<long long>(MAX)))};
+                  else if constexpr (sizeof(TO) == 4)
+                     return OUT {simde_mm256_mask_mov_epi32(y, mask, simde_mm256_set1_epi32(static_cast<int>(MAX)))};
+                  else
+                     return OUT {simde_mm256_mask_mov_epi64(y, mask, simde_mm256_set1_epi64x(static_cast<long long>(MAX)))};
+               }
+            }
+         #endif
+      #endif
+
+   } // namespace Langulus::SIMD::Inner
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,758 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "../bulk/Interleave.hpp"
+#include "../binary/Add.hpp"
+#include "../binary/Multiply.hpp"
+#include "../Fill.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+///                                                                           
+///   4x4 matrix kernels                                                      
+///                                                                           
+/// Matrices are 16 contiguous elements - T[16], std::array<T, 16>, or        
+/// anything else a fixed-size std::span can be made of. They're in           
+/// column-major order, so each four consecutive elements form a column,      
+/// and points are transformed as column vectors, i.e. matrix * point         
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Get the elements of a matrix, checking its size at compile time     
+      ///   @tparam S - the required number of elements                       
+      ///   @param m - the matrix                                             
+      ///   @return a pointer to the first element                            
+      template<Count S> NOD() LANGULUS(INLINED)
+      auto MatrixData(auto& m) noexcept {
+         const ::std::span s {m};
+         static_assert(decltype(s)::extent == S,
+            "Matrix has the wrong number of elements");
+         return s.data();
+      }
+
+      /// Multiply and add registers (a * b + c), using FMA if available      
+      ///   @param a - first factor                                           
+      ///   @param b - second factor                                          
+      ///   @param c - the addend                                             
+      ///   @return the resulting register                                    
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R MulAdd(const R& a, const R& b, const R& c) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               #if LANGULUS_SIMD(FMA)
+                  using T = TypeOf<R>;
+                  if      constexpr (CT::Float<T>)  return R {simde_mm_fmadd_ps(a, b, c)};
+                  else if constexpr (CT::Double<T>) return R {simde_mm_fmadd_pd(a, b, c)};
+                  else static_assert(false, "Unsupported element");
+               #else
+                  return AddSIMD(MultiplySIMD(a, b), c);
+               #endif
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               #if LANGULUS_SIMD(FMA)
+                  using T = TypeOf<R>;
+                  if      constexpr (CT::Float<T>)  return R {simde_mm256_fmadd_ps(a, b, c)};
+                  else if constexpr (CT::Double<T>) return R {simde_mm256_fmadd_pd(a, b, c)};
+                  else static_assert(false, "Unsupported element");
+               #else
+                  return AddSIMD(MultiplySIMD(a, b), c);
+               #endif
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               using T = TypeOf<R>;
+               if      constexpr (CT::Float<T>)  return R {simde_mm512_fmadd_ps(a, b, c)};
+               else if constexpr (CT::Double<T>) return R {simde_mm512_fmadd_pd(a, b, c)};
+               else static_assert(false, "Unsupported element");
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Number of registers R, that a single column of four T occupies      
+      template<class R, class T>
+      constexpr Count ColumnParts = sizeof(T) * 4 > sizeof(R)
+         ? sizeof(T) * 4 / sizeof(R) : 1;
+
+      /// Number of columns of four T, that fit in a single register R        
+      template<class R, class T>
+      constexpr Count ColumnGroup = sizeof(R) > sizeof(T) * 4
+         ? sizeof(R) / (sizeof(T) * 4) : 1;
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Get the register of WidestRegisterSize bytes for T, which        
+         /// respects LANGULUS_SIMD_PREFER_WIDTH                              
+         template<class T>
+         consteval auto WidestRegisterOf() {
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (WidestRegisterSize == 64)
+                  return (V512<T>*) nullptr;
+               else
+            #endif
+            #if LANGULUS_SIMD(256BIT)
+               if constexpr (WidestRegisterSize == 32)
+                  return (V256<T>*) nullptr;
+               else
+            #endif
+            return (V128<T>*) nullptr;
+         }
+
+         /// The widest register available                                    
+         template<class T>
+         using WidestRegister = Deptr<decltype(WidestRegisterOf<T>())>;
+      #endif
+
+      #if LANGULUS_SIMD(256BIT)
+         /// The narrowest register that fits a whole column of four T        
+         template<class T>
+         using ColumnRegister = Conditional<CT::Double<T>, V256<T>, V128<T>>;
+      #elif LANGULUS_SIMD(128BIT)
+         template<class T>
+         using ColumnRegister = V128<T>;
+      #endif
+
+      /// Load a matrix column, repeated for every column group in R          
+      ///   @param column - the four elements of the column                   
+      ///   @return the column parts                                          
+      template<CT::SIMD R, class T> NOD() LANGULUS(INLINED)
+      auto LoadColumn(const T* column) noexcept {
+         constexpr Count H = ColumnParts<R, T>;
+         constexpr Count G = ColumnGroup<R, T>;
+
+         if constexpr (H == 2)
+            return ::std::array<R, 2> {LoadUnaligned<R>(column), LoadUnaligned<R>(column + 2)};
+         else if constexpr (G == 1)
+            return ::std::array<R, 1> {LoadUnaligned<R>(column)};
+         else {
+            #if LANGULUS_SIMD(256BIT)
+               if constexpr (CT::SIMD256<R>) {
+                  const auto c = simde_mm_loadu_ps(column);
+                  return ::std::array<R, 1> {R {simde_mm256_insertf128_ps(
+                     simde_mm256_castps128_ps256(c), c, 1)}};
+               }
+               else
+            #endif
+            #if LANGULUS_SIMD(512BIT)
+               if constexpr (CT::SIMD512<R>) {
+                  if constexpr (CT::Float<T>) {
+                     return ::std::array<R, 1> {R {simde_mm512_broadcast_f32x4(
+                        simde_mm_loadu_ps(column))}};
+                  }
+                  else {
+                     return ::std::array<R, 1> {R {simde_mm512_broadcast_f64x4(
+                        simde_mm256_loadu_pd(column))}};
+                  }
+               }
+               else
+            #endif
+            static_assert(false, "Unsupported register");
+         }
+      }
+
+      /// Load all columns of a matrix                                        
+      ///   @param m - the 16 matrix elements                                 
+      ///   @return the four columns, each split in ColumnParts registers     
+      template<CT::SIMD R, class T> NOD() LANGULUS(INLINED)
+      auto LoadColumns(const T* m) noexcept {
+         return [&]<Offset...K>(ExpandedSequence<K...>) {
+            return ::std::array {LoadColumn<R>(m + K * 4)...};
+         }(Sequence<4>::Expand);
+      }
+
+      /// Broadcast each of the four weights of a column group, inside the    
+      /// 'ColumnGroup' parts of register R                                   
+      ///   @param w - ColumnGroup consecutive groups of four weights         
+      ///   @return the four broadcasted weights                              
+      template<CT::SIMD R, class T> NOD() LANGULUS(INLINED)
+      auto SplatWeights(const T* w) noexcept {
+         if constexpr (ColumnGroup<R, T> == 1) {
+            return [&]<Offset...K>(ExpandedSequence<K...>) {
+               return ::std::array<R, 4> {R {Fill<sizeof(R)>(w[K])}...};
+            }(Sequence<4>::Expand);
+         }
+         else {
+            const auto load = LoadUnaligned<R>(w);
+            const auto splat = [&]<int K>() -> R {
+               #if LANGULUS_SIMD(256BIT)
+                  if constexpr (CT::SIMD256<R>)
+                     return R {simde_mm256_permute_ps(load, Shuffle(K, K, K, K))};
+                  else
+               #endif
+               #if LANGULUS_SIMD(512BIT)
+                  if constexpr (CT::SIMD512<R> and CT::Float<T>)
+                     return R {simde_mm512_permute_ps(load, Shuffle(K, K, K, K))};
+                  else if constexpr (CT::SIMD512<R>)
+                     return R {simde_mm512_permutex_pd(load, Shuffle(K, K, K, K))};
+                  else
+               #endif
+               static_assert(false, "Unsupported register");
+            };
+
+            return ::std::array<R, 4> {
+               splat.template operator() <0> (),
+               splat.template operator() <1> (),
+               splat.template operator() <2> (),
+               splat.template operator() <3> ()
+            };
+         }
+      }
+
+      /// Multiply matrix columns by weights, i.e. matrix * vector            
+      /// Processes ColumnGroup<R, T> vectors at once                         
+      ///   @param columns - the matrix columns, from LoadColumns             
+      ///   @param w - the vectors to multiply                                
+      ///   @param out - where to store the resulting vectors                 
+      template<CT::SIMD R, class T> LANGULUS(INLINED)
+      void CombineColumns(const auto& columns, const T* w, T* out) noexcept {
+         constexpr Count L = sizeof(R) / sizeof(T);
+         const auto s = SplatWeights<R>(w);
+
+         for (Offset h = 0; h < ColumnParts<R, T>; ++h) {
+            auto r = MultiplySIMD(columns[0][h], s[0]);
+            r = MulAdd(columns[1][h], s[1], r);
+            r = MulAdd(columns[2][h], s[2], r);
+            r = MulAdd(columns[3][h], s[3], r);
+            StoreUnaligned(out + h * L, r);
+         }
+      }
+
+      /// Multiply a matrix by 'count' vectors of four elements               
+      ///   @param m - the matrix                                             
+      ///   @param w - the vectors                                            
+      ///   @param out - the resulting vectors (can be the same as 'w')       
+      ///   @param count - number of vectors                                  
+      template<class T>
+      void MultiplyColumns(const T* m, const T* w, T* out, Count count) noexcept {
+         const Count total = count * 4;
+         Offset i = 0;
+
+         #if LANGULUS_SIMD(128BIT)
+            using RW = WidestRegister<T>;
+            using RC = ColumnRegister<T>;
+            const auto wide = LoadColumns<RW>(m);
+            constexpr Count step = ColumnGroup<RW, T> * 4;
+            for (; i + step <= total; i += step)
+               CombineColumns<RW>(wide, w + i, out + i);
+
+            if constexpr (not CT::Exact<RW, RC>) {
+               const auto narrow = LoadColumns<RC>(m);
+               for (; i < total; i += 4)
+                  CombineColumns<RC>(narrow, w + i, out + i);
+            }
+         #endif
+
+         // Fallback for when there are no registers - the matrix is    
+         // copied, because 'out' is allowed to overlap it              
+         if (i < total) {
+            T mc[16];
+            ::std::copy_n(m, 16, mc);
+            for (; i < total; i += 4) {
+               const T x = w[i], y = w[i + 1], z = w[i + 2], t = w[i + 3];
+               for (Offset r = 0; r < 4; ++r)
+                  out[i + r] = mc[r] * x + mc[4 + r] * y + mc[8 + r] * z + mc[12 + r] * t;
+            }
+         }
+      }
+
+      /// Transform 'count' points of three elements, with an implicit w = 1  
+      /// Points are deinterleaved in chunks, and transformed through the     
+      /// widest registers, so no lanes are wasted                            
+      ///   @param m - the matrix                                             
+      ///   @param in - the points                                            
+      ///   @param out - the transformed points (can be the same as 'in')     
+      ///   @param count - number of points                                   
+      template<class T>
+      void TransformPoints3(const T* m, const T* in, T* out, Count count) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            using R = WidestRegister<T>;
+            constexpr Count L = sizeof(R) / sizeof(T);
+            constexpr Count C = 64;
+            static_assert(C % L == 0);
+
+            const auto mr = [&]<Offset...K>(ExpandedSequence<K...>) {
+               return ::std::array<R, 12> {R {Fill<sizeof(R)>(m[K + K / 3])}...};
+            }(Sequence<12>::Expand);
+
+            T soa[3][C] {}, res[3][C] {};
+            for (Offset base = 0; base < count; base += C) {
+               const Count n = ::std::min(C, count - base);
+               Deinterleave<3>(in + base * 3, {soa[0], soa[1], soa[2]}, n);
+
+               for (Offset j = 0; j < n; j += L) {
+                  const auto x = LoadUnaligned<R>(soa[0] + j);
+                  const auto y = LoadUnaligned<R>(soa[1] + j);
+                  const auto z = LoadUnaligned<R>(soa[2] + j);
+                  for (Offset r = 0; r < 3; ++r) {
+                     // Row 'r' of the matrix is at mr[r + 3 * column]  
+                     StoreUnaligned(res[r] + j, MulAdd(x, mr[r],
+                        MulAdd(y, mr[3 + r], MulAdd(z, mr[6 + r], mr[9 + r]))));
+                  }
+               }
+
+               Interleave<3>({res[0], res[1], res[2]}, out + base * 3, n);
+            }
+         #else
+            for (Offset i = 0; i < count * 3; i += 3) {
+               const T x = in[i], y = in[i + 1], z = in[i + 2];
+               for (Offset r = 0; r < 3; ++r)
+                  out[i + r] = m[r] * x + m[4 + r] * y + m[8 + r] * z + m[12 + r];
+            }
+         #endif
+      }
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Rearrange the elements of a float register                       
+         template<int E0, int E1, int E2, int E3> NOD() LANGULUS(INLINED)
+         simde__m128 Swizzle(const simde__m128& v) noexcept {
+            return simde_mm_shuffle_ps(v, v, Shuffle(E3, E2, E1, E0));
+         }
+
+         /// Pick {a[E0], a[E1], b[E2], b[E3]}                                
+         template<int E0, int E1, int E2, int E3> NOD() LANGULUS(INLINED)
+         simde__m128 Shuffle2(const simde__m128& a, const simde__m128& b) noexcept {
+            return simde_mm_shuffle_ps(a, b, Shuffle(E3, E2, E1, E0));
+         }
+
+         /// 2x2 matrix multiplication A * B, matrices are {00, 01, 10, 11}   
+         NOD() LANGULUS(INLINED)
+         simde__m128 Mat2Mul(const simde__m128& a, const simde__m128& b) noexcept {
+            return simde_mm_add_ps(
+               simde_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)),
+               simde_mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+         }
+
+         /// 2x2 matrix adjugate multiplication adj(A) * B                    
+         NOD() LANGULUS(INLINED)
+         simde__m128 Mat2AdjMul(const simde__m128& a, const simde__m128& b) noexcept {
+            return simde_mm_sub_ps(
+               simde_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b),
+               simde_mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+         }
+
+         /// 2x2 matrix multiplication by adjugate A * adj(B)                 
+         NOD() LANGULUS(INLINED)
+         simde__m128 Mat2MulAdj(const simde__m128& a, const simde__m128& b) noexcept {
+            return simde_mm_sub_ps(
+               simde_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)),
+               simde_mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+         }
+
+         /// Cross product of the first three elements, w is zero if both     
+         /// inputs have w equal to zero                                      
+         NOD() LANGULUS(INLINED)
+         simde__m128 Cross3(const simde__m128& a, const simde__m128& b) noexcept {
+            return simde_mm_sub_ps(
+               simde_mm_mul_ps(Swizzle<1, 2, 0, 3>(a), Swizzle<2, 0, 1, 3>(b)),
+               simde_mm_mul_ps(Swizzle<2, 0, 1, 3>(a), Swizzle<1, 2, 0, 3>(b)));
+         }
+
+         /// Sum all elements, and broadcast the result                       
+         NOD() LANGULUS(INLINED)
+         simde__m128 SumAll(const simde__m128& v) noexcept {
+            const auto t = simde_mm_add_ps(v, Swizzle<2, 3, 0, 1>(v));
+            return simde_mm_add_ps(t, Swizzle<1, 0, 3, 2>(t));
+         }
+
+         /// Invert a general float matrix, using 2x2 block decomposition     
+         /// Works in any majority, as long as input and output match         
+         inline void InverseSIMD(const float* in, float* out) {
+            const auto r0 = simde_mm_loadu_ps(in);
+            const auto r1 = simde_mm_loadu_ps(in + 4);
+            const auto r2 = simde_mm_loadu_ps(in + 8);
+            const auto r3 = simde_mm_loadu_ps(in + 12);
+
+            // 2x2 sub-matrices                                         
+            const auto A = simde_mm_movelh_ps(r0, r1);
+            const auto B = simde_mm_movehl_ps(r1, r0);
+            const auto C = simde_mm_movelh_ps(r2, r3);
+            const auto D = simde_mm_movehl_ps(r3, r2);
+
+            // Sub-determinants as {|A|, |B|, |C|, |D|}                 
+            const auto detSub = simde_mm_sub_ps(
+               simde_mm_mul_ps(Shuffle2<0, 2, 0, 2>(r0, r2), Shuffle2<1, 3, 1, 3>(r1, r3)),
+               simde_mm_mul_ps(Shuffle2<1, 3, 1, 3>(r0, r2), Shuffle2<0, 2, 0, 2>(r1, r3)));
+            const auto detA = Swizzle<0, 0, 0, 0>(detSub);
+            const auto detB = Swizzle<1, 1, 1, 1>(detSub);
+            const auto detC = Swizzle<2, 2, 2, 2>(detSub);
+            const auto detD = Swizzle<3, 3, 3, 3>(detSub);
+
+            // inverse = 1/|M| * | X  Y |, where                        
+            //                   | Z  W |                               
+            const auto D_C = Mat2AdjMul(D, C);
+            const auto A_B = Mat2AdjMul(A, B);
+            auto X_ = simde_mm_sub_ps(simde_mm_mul_ps(detD, A), Mat2Mul(B, D_C));
+            auto W_ = simde_mm_sub_ps(simde_mm_mul_ps(detA, D), Mat2Mul(C, A_B));
+            auto Y_ = simde_mm_sub_ps(simde_mm_mul_ps(detB, C), Mat2MulAdj(D, A_B));
+            auto Z_ = simde_mm_sub_ps(simde_mm_mul_ps(detC, B), Mat2MulAdj(A, D_C));
+
+            // |M| = |A|*|D| + |B|*|C| - tr((A#B)(D#C))                 
+            auto detM = simde_mm_add_ps(
+               simde_mm_mul_ps(detA, detD),
+               simde_mm_mul_ps(detB, detC));
+            detM = simde_mm_sub_ps(detM,
+               SumAll(simde_mm_mul_ps(A_B, Swizzle<0, 2, 1, 3>(D_C))));
+
+            if (simde_mm_cvtss_f32(detM) == 0)
+               LANGULUS_THROW(DivisionByZero, "Singular matrix");
+
+            const auto rDetM = simde_mm_div_ps(
+               simde_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+            X_ = simde_mm_mul_ps(X_, rDetM);
+            Y_ = simde_mm_mul_ps(Y_, rDetM);
+            Z_ = simde_mm_mul_ps(Z_, rDetM);
+            W_ = simde_mm_mul_ps(W_, rDetM);
+
+            // Apply the adjugate while storing                         
+            simde_mm_storeu_ps(out,      Shuffle2<3, 1, 3, 1>(X_, Y_));
+            simde_mm_storeu_ps(out + 4,  Shuffle2<2, 0, 2, 0>(X_, Y_));
+            simde_mm_storeu_ps(out + 8,  Shuffle2<3, 1, 3, 1>(Z_, W_));
+            simde_mm_storeu_ps(out + 12, Shuffle2<2, 0, 2, 0>(Z_, W_));
+         }
+
+         /// Invert an affine float matrix, by inverting the 3x3 part via     
+         /// cross products, and transforming the negated translation         
+         inline void InverseAffineSIMD(const float* in, float* out) {
+            const auto a = simde_mm_loadu_ps(in);
+            const auto b = simde_mm_loadu_ps(in + 4);
+            const auto c = simde_mm_loadu_ps(in + 8);
+            const auto t = simde_mm_loadu_ps(in + 12);
+
+            // Rows of the inverted 3x3 part, scaled by the determinant 
+            auto r0 = Cross3(b, c);
+            auto r1 = Cross3(c, a);
+            auto r2 = Cross3(a, b);
+            const auto det = SumAll(simde_mm_mul_ps(a, r0));
+            if (simde_mm_cvtss_f32(det) == 0)
+               LANGULUS_THROW(DivisionByZero, "Singular matrix");
+
+            const auto rDet = simde_mm_div_ps(simde_mm_set1_ps(1.f), det);
+            r0 = simde_mm_mul_ps(r0, rDet);
+            r1 = simde_mm_mul_ps(r1, rDet);
+            r2 = simde_mm_mul_ps(r2, rDet);
+
+            // Transpose the rows into columns                          
+            const auto e3 = simde_mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+            const auto t0 = simde_mm_unpacklo_ps(r0, r1);
+            const auto t1 = simde_mm_unpacklo_ps(r2, e3);
+            const auto t2 = simde_mm_unpackhi_ps(r0, r1);
+            const auto t3 = simde_mm_unpackhi_ps(r2, e3);
+            const auto c0 = simde_mm_movelh_ps(t0, t1);
+            const auto c1 = simde_mm_movehl_ps(t1, t0);
+            const auto c2 = simde_mm_movelh_ps(t2, t3);
+
+            // Translation is -(inverse * t)                            
+            auto c3 = simde_mm_mul_ps(c0, Swizzle<0, 0, 0, 0>(t));
+            c3 = simde_mm_add_ps(c3, simde_mm_mul_ps(c1, Swizzle<1, 1, 1, 1>(t)));
+            c3 = simde_mm_add_ps(c3, simde_mm_mul_ps(c2, Swizzle<2, 2, 2, 2>(t)));
+            c3 = simde_mm_sub_ps(e3, c3);
+
+            simde_mm_storeu_ps(out,      c0);
+            simde_mm_storeu_ps(out + 4,  c1);
+            simde_mm_storeu_ps(out + 8,  c2);
+            simde_mm_storeu_ps(out + 12, c3);
+         }
+      #endif
+
+      /// Invert a general matrix conventionally, via Gauss-Jordan            
+      /// elimination with partial pivoting                                   
+      template<class T>
+      void InverseFallback(const T* in, T* out) {
+         T a[4][8];
+         for (Offset r = 0; r < 4; ++r) {
+            for (Offset c = 0; c < 4; ++c) {
+               a[r][c] = in[r * 4 + c];
+               a[r][c + 4] = r == c ? T {1} : T {0};
+            }
+         }
+
+         for (Offset c = 0; c < 4; ++c) {
+            Offset pivot = c;
+            for (Offset r = c + 1; r < 4; ++r) {
+               if (::std::abs(a[r][c]) > ::std::abs(a[pivot][c]))
+                  pivot = r;
+            }
+
+            if (a[pivot][c] == T {0})
+               LANGULUS_THROW(DivisionByZero, "Singular matrix");
+            if (pivot != c)
+               ::std::swap(a[pivot], a[c]);
+
+            const T rcp = T {1} / a[c][c];
+            for (auto& e : a[c])
+               e *= rcp;
+
+            for (Offset r = 0; r < 4; ++r) {
+               if (r == c)
+                  continue;
+               const T f = a[r][c];
+               for (Offset k = 0; k < 8; ++k)
+                  a[r][k] -= f * a[c][k];
+            }
+         }
+
+         for (Offset r = 0; r < 4; ++r) {
+            for (Offset c = 0; c < 4; ++c)
+               out[r * 4 + c] = a[r][c + 4];
+         }
+      }
+
+      /// Invert an affine matrix conventionally                              
+      template<class T>
+      void InverseAffineFallback(const T* in, T* out) {
+         const T* a = in;
+         const T* b = in + 4;
+         const T* c = in + 8;
+         const T* t = in + 12;
+         const auto cross = [](const T* u, const T* v) {
+            return ::std::array<T, 3> {
+               u[1] * v[2] - u[2] * v[1],
+               u[2] * v[0] - u[0] * v[2],
+               u[0] * v[1] - u[1] * v[0]
+            };
+         };
+
+         const ::std::array<T, 3> r[3] {cross(b, c), cross(c, a), cross(a, b)};
+         const T det = a[0] * r[0][0] + a[1] * r[0][1] + a[2] * r[0][2];
+         if (det == T {0})
+            LANGULUS_THROW(DivisionByZero, "Singular matrix");
+
+         const T rcp = T {1} / det;
+         T inv[16];
+         for (Offset col = 0; col < 3; ++col) {
+            for (Offset row = 0; row < 3; ++row)
+               inv[col * 4 + row] = r[row][col] * rcp;
+            inv[col * 4 + 3] = T {0};
+         }
+
+         for (Offset row = 0; row < 3; ++row)
+            inv[12 + row] = -(inv[row] * t[0] + inv[4 + row] * t[1] + inv[8 + row] * t[2]);
+         inv[15] = T {1};
+         ::std::copy_n(inv, 16, out);
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Multiply two 4x4 matrices (lhs * rhs)                                  
+   ///   @param lhs - left matrix                                             
+   ///   @param rhs - right matrix                                            
+   ///   @param out - the resulting matrix (can be the same as lhs or rhs)    
+   template<class LHS, class RHS, class OUT>
+   void Mat4Multiply(const LHS& lhs, const RHS& rhs, OUT&& out) noexcept {
+      const auto l = Inner::MatrixData<16>(lhs);
+      const auto r = Inner::MatrixData<16>(rhs);
+      const auto o = Inner::MatrixData<16>(out);
+      static_assert(CT::Real<Deptr<decltype(o)>>, "Matrix must contain real numbers");
+
+      // Each column of rhs is a vector, transformed by lhs             
+      Inner::MultiplyColumns(l, r, o, 4);
+   }
+
+   /// Transpose a 4x4 matrix of floats or doubles                            
+   ///   @param in - the matrix to transpose                                  
+   ///   @param out - the transposed matrix (can be the same as 'in')         
+   template<class IN, class OUT>
+   void Transpose4x4(const IN& in, OUT&& out) noexcept {
+      const auto i = Inner::MatrixData<16>(in);
+      const auto o = Inner::MatrixData<16>(out);
+      using T = Deptr<decltype(o)>;
+      static_assert(CT::Real<T>, "Matrix must contain real numbers");
+
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::Float<T>) {
+            const auto r0 = simde_mm_loadu_ps(i);
+            const auto r1 = simde_mm_loadu_ps(i + 4);
+            const auto r2 = simde_mm_loadu_ps(i + 8);
+            const auto r3 = simde_mm_loadu_ps(i + 12);
+            const auto t0 = simde_mm_unpacklo_ps(r0, r1);
+            const auto t1 = simde_mm_unpacklo_ps(r2, r3);
+            const auto t2 = simde_mm_unpackhi_ps(r0, r1);
+            const auto t3 = simde_mm_unpackhi_ps(r2, r3);
+            simde_mm_storeu_ps(o,      simde_mm_movelh_ps(t0, t1));
+            simde_mm_storeu_ps(o + 4,  simde_mm_movehl_ps(t1, t0));
+            simde_mm_storeu_ps(o + 8,  simde_mm_movelh_ps(t2, t3));
+            simde_mm_storeu_ps(o + 12, simde_mm_movehl_ps(t3, t2));
+            return;
+         }
+      #endif
+
+      #if LANGULUS_SIMD(256BIT)
+         if constexpr (CT::Double<T>) {
+            const auto r0 = simde_mm256_loadu_pd(i);
+            const auto r1 = simde_mm256_loadu_pd(i + 4);
+            const auto r2 = simde_mm256_loadu_pd(i + 8);
+            const auto r3 = simde_mm256_loadu_pd(i + 12);
+            const auto t0 = simde_mm256_unpacklo_pd(r0, r1);
+            const auto t1 = simde_mm256_unpackhi_pd(r0, r1);
+            const auto t2 = simde_mm256_unpacklo_pd(r2, r3);
+            const auto t3 = simde_mm256_unpackhi_pd(r2, r3);
+            simde_mm256_storeu_pd(o,      simde_mm256_permute2f128_pd(t0, t2, 0x20));
+            simde_mm256_storeu_pd(o + 4,  simde_mm256_permute2f128_pd(t1, t3, 0x20));
+            simde_mm256_storeu_pd(o + 8,  simde_mm256_permute2f128_pd(t0, t2, 0x31));
+            simde_mm256_storeu_pd(o + 12, simde_mm256_permute2f128_pd(t1, t3, 0x31));
+            return;
+         }
+      #elif LANGULUS_SIMD(128BIT)
+         if constexpr (CT::Double<T>) {
+            // Transpose each of the 2x2 blocks, and swap blocks 01/10  
+            simde__m128d b[4][2];
+            for (Offset k = 0; k < 4; ++k) {
+               const Offset col = (k % 2) * 2, row = (k / 2) * 2;
+               const auto c0 = simde_mm_loadu_pd(i + col * 4 + row);
+               const auto c1 = simde_mm_loadu_pd(i + col * 4 + 4 + row);
+               b[k][0] = simde_mm_unpacklo_pd(c0, c1);
+               b[k][1] = simde_mm_unpackhi_pd(c0, c1);
+            }
+            for (Offset k = 0; k < 4; ++k) {
+               const Offset col = (k / 2) * 2, row = (k % 2) * 2;
+               simde_mm_storeu_pd(o + col * 4 + row,     b[k][0]);
+               simde_mm_storeu_pd(o + col * 4 + 4 + row, b[k][1]);
+            }
+            return;
+         }
+      #endif
+
+      T t[16];
+      for (Offset c = 0; c < 4; ++c) {
+         for (Offset r = 0; r < 4; ++r)
+            t[r * 4 + c] = i[c * 4 + r];
+      }
+      ::std::copy_n(t, 16, o);
+   }
+
+   /// Transpose an 8x8 matrix of 16bit integers                              
+   ///   @param in - the matrix to transpose                                  
+   ///   @param out - the transposed matrix (can be the same as 'in')         
+   template<class IN, class OUT>
+   void Transpose8x8(const IN& in, OUT&& out) noexcept {
+      const auto i = Inner::MatrixData<64>(in);
+      const auto o = Inner::MatrixData<64>(out);
+      using T = Deptr<decltype(o)>;
+      static_assert(CT::Integer16<T>, "Matrix must contain 16bit integers");
+
+      #if LANGULUS_SIMD(128BIT)
+         simde__m128i r[8], a[8], b[8];
+         for (Offset k = 0; k < 8; ++k)
+            r[k] = simde_mm_loadu_si128(i + k * 8);
+
+         for (Offset k = 0; k < 8; k += 2) {
+            a[k]     = simde_mm_unpacklo_epi16(r[k], r[k + 1]);
+            a[k + 1] = simde_mm_unpackhi_epi16(r[k], r[k + 1]);
+         }
+
+         for (Offset k = 0; k < 8; k += 4) {
+            b[k]     = simde_mm_unpacklo_epi32(a[k],     a[k + 2]);
+            b[k + 1] = simde_mm_unpackhi_epi32(a[k],     a[k + 2]);
+            b[k + 2] = simde_mm_unpacklo_epi32(a[k + 1], a[k + 3]);
+            b[k + 3] = simde_mm_unpackhi_epi32(a[k + 1], a[k + 3]);
+         }
+
+         for (Offset k = 0; k < 4; ++k) {
+            simde_mm_storeu_si128(o + k * 16,     simde_mm_unpacklo_epi64(b[k], b[k + 4]));
+            simde_mm_storeu_si128(o + k * 16 + 8, simde_mm_unpackhi_epi64(b[k], b[k + 4]));
+         }
+      #else
+         T t[64];
+         for (Offset c = 0; c < 8; ++c) {
+            for (Offset r = 0; r < 8; ++r)
+               t[r * 8 + c] = i[c * 8 + r];
+         }
+         ::std::copy_n(t, 64, o);
+      #endif
+   }
+
+   /// Invert a general 4x4 matrix                                            
+   ///   @param in - the matrix to invert                                     
+   ///   @param out - the inverted matrix (can be the same as 'in')           
+   ///   @attention throws DivisionByZero if matrix is singular               
+   template<class IN, class OUT>
+   void Inverse4x4(const IN& in, OUT&& out) {
+      const auto i = Inner::MatrixData<16>(in);
+      const auto o = Inner::MatrixData<16>(out);
+      using T = Deptr<decltype(o)>;
+      static_assert(CT::Real<T>, "Matrix must contain real numbers");
+
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::Float<T>) {
+            Inner::InverseSIMD(i, o);
+            return;
+         }
+      #endif
+      Inner::InverseFallback(i, o);
+   }
+
+   /// Invert an affine 4x4 matrix, i.e. one with a bottom row of {0,0,0,1}   
+   /// Faster than Inverse4x4, but the projective row is ignored              
+   ///   @param in - the matrix to invert                                     
+   ///   @param out - the inverted matrix (can be the same as 'in')           
+   ///   @attention throws DivisionByZero if matrix is singular               
+   template<class IN, class OUT>
+   void InverseAffine4x4(const IN& in, OUT&& out) {
+      const auto i = Inner::MatrixData<16>(in);
+      const auto o = Inner::MatrixData<16>(out);
+      using T = Deptr<decltype(o)>;
+      static_assert(CT::Real<T>, "Matrix must contain real numbers");
+
+      #if LANGULUS_SIMD(128BIT)
+         if constexpr (CT::Float<T>) {
+            Inner::InverseAffineSIMD(i, o);
+            return;
+         }
+      #endif
+      Inner::InverseAffineFallback(i, o);
+   }
+
+   /// Transform a batch of points by a 4x4 matrix                            
+   /// Vectors of three elements are treated as points with w = 1, and the    
+   /// resulting w is discarded (no perspective division takes place)         
+   ///   @param mat - the matrix                                              
+   ///   @param points - the vectors of three or four elements to transform   
+   ///   @param out - the transformed vectors, at least as many as 'points'   
+   template<class MAT, class IN, class OUT>
+   void TransformPoints(const MAT& mat, const IN& points, OUT&& out) noexcept {
+      const auto m = Inner::MatrixData<16>(mat);
+      const ::std::span from {points};
+      const ::std::span to {out};
+      using V = Decvq<typename decltype(from)::element_type>;
+      using T = Decvq<TypeOf<V>>;
+      constexpr Count N = CountOf<V>;
+      static_assert(CT::Exact<V, typename decltype(to)::element_type>,
+         "Output must be mutable, and of the same type");
+      static_assert(CT::Real<T> and CT::Exact<T, Decvq<Deptr<decltype(m)>>>,
+         "Matrix and points must be of the same real type");
+      static_assert((N == 3 or N == 4) and sizeof(V) == sizeof(T) * N,
+         "Points must be tightly packed vectors of three or four elements");
+      LANGULUS_ASSUME(UserAssumes, to.size() >= from.size(),
+         "Output is too short");
+
+      const auto i = reinterpret_cast<const T*>(from.data());
+      const auto o = reinterpret_cast<T*>(to.data());
+      if constexpr (N == 3)
+         Inner::TransformPoints3(m, i, o, from.size());
+      else
+         Inner::MultiplyColumns(m, i, o, from.size());
+   }
+
+   /// Transform a batch of points by a 4x4 matrix in place                   
+   ///   @param mat - the matrix                                              
+   ///   @param points - the vectors of three or four elements to transform   
+   template<class MAT, class PTS>
+   void TransformPoints(const MAT& mat, PTS&& points) noexcept {
+      TransformPoints(mat, points, points);
+   }
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,459 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "../bulk/Interleave.hpp"
+#include "../binary/XOr.hpp"
+#include "../MoreSIMD.hpp"
+#include <cmath>
+
+
+///                                                                           
+///   RGBA8 pixel kernels                                                     
+///                                                                           
+/// Pixels are four consecutive bytes - red, green, blue and alpha. Spans of  
+/// bytes, packed 32bit integers, or any other tightly packed 4-byte type     
+/// are accepted. Products of two channels are divided by 255 exactly,        
+/// i.e. x * y / 255 is truncated, the same way _mm_scale_epu8 does it        
+///                                                                           
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Generate a simde_mm*_shuffle_epi8 control, that broadcasts the      
+      /// alpha of each pixel to all four of its channels                     
+      template<Count B>
+      consteval auto AlphaControl() {
+         ::std::array<::std::int8_t, B> result {};
+         for (Offset j = 0; j < B; ++j)
+            result[j] = static_cast<::std::int8_t>(((j % 16) / 4) * 4 + 3);
+         return result;
+      }
+
+      template<Count B>
+      constexpr auto AlphaControlTable = AlphaControl<B>();
+
+      /// Fill a byte register with a repeating 32bit pattern                 
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R FillPixel(::std::uint32_t pattern) noexcept {
+         const auto p = static_cast<int>(pattern);
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {simde_mm_set1_epi32(p)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_set1_epi32(p)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) return R {simde_mm512_set1_epi32(p)};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Broadcast the alpha of each pixel to all of its channels            
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R BroadcastAlpha(const R& x) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) {
+               return R {simde_mm_shuffle_epi8(x,
+                  simde_mm_loadu_si128(AlphaControlTable<16>.data()))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               return R {simde_mm256_shuffle_epi8(x,
+                  simde_mm256_loadu_si256(AlphaControlTable<32>.data()))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               return R {simde_mm512_shuffle_epi8(x,
+                  simde_mm512_loadu_si512(AlphaControlTable<64>.data()))};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Scale each byte of x by the matching byte of y: x * y / 255         
+      /// The 128bit version is _mm_scale_epu8, the wider ones do the same    
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R ScaleBytes(const R& x, const R& y) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>)
+               return R {_mm_scale_epu8(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) {
+               const auto zero = simde_mm256_setzero_si256();
+               const auto div255 = [](const simde__m256i& v) noexcept {
+                  return simde_mm256_srli_epi16(simde_mm256_adds_epu16(
+                     simde_mm256_adds_epu16(v, simde_mm256_set1_epi16(1)),
+                     simde_mm256_srli_epi16(v, 8)
+                  ), 8);
+               };
+               const auto lo = simde_mm256_mullo_epi16(
+                  simde_mm256_unpacklo_epi8(x, zero), simde_mm256_unpacklo_epi8(y, zero));
+               const auto hi = simde_mm256_mullo_epi16(
+                  simde_mm256_unpackhi_epi8(x, zero), simde_mm256_unpackhi_epi8(y, zero));
+               return R {simde_mm256_packus_epi16(div255(lo), div255(hi))};
+            }
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               const auto zero = simde_mm512_setzero_si512();
+               const auto div255 = [](const simde__m512i& v) noexcept {
+                  return simde_mm512_srli_epi16(simde_mm512_adds_epu16(
+                     simde_mm512_adds_epu16(v, simde_mm512_set1_epi16(1)),
+                     simde_mm512_srli_epi16(v, 8)
+                  ), 8);
+               };
+               const auto lo = simde_mm512_mullo_epi16(
+                  simde_mm512_unpacklo_epi8(x, zero), simde_mm512_unpacklo_epi8(y, zero));
+               const auto hi = simde_mm512_mullo_epi16(
+                  simde_mm512_unpackhi_epi8(x, zero), simde_mm512_unpackhi_epi8(y, zero));
+               return R {simde_mm512_packus_epi16(div255(lo), div255(hi))};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Saturated addition of bytes                                         
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R AddBytes(const R& x, const R& y) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {simde_mm_adds_epu8(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_adds_epu8(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) return R {simde_mm512_adds_epu8(x, y)};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Get 255 - x for each byte                                           
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R InvertBytes(const R& x) noexcept {
+         return R {XOrSIMD(x, FillPixel<R>(0xFFFFFFFFu))};
+      }
+
+      /// Get x | y                                                           
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R OrBytes(const R& x, const R& y) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {simde_mm_or_si128(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_or_si256(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) return R {simde_mm512_or_si512(x, y)};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Rounded average of bytes: (x + y + 1) / 2                           
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R AverageBytes(const R& x, const R& y) noexcept {
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return R {simde_mm_avg_epu8(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>) return R {simde_mm256_avg_epu8(x, y)};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) return R {simde_mm512_avg_epu8(x, y)};
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Average each pair of neighbouring pixels in 'a' and 'b'             
+      /// The result contains the averages of a's pairs, then b's pairs       
+      template<CT::SIMD R> NOD() LANGULUS(INLINED)
+      R AveragePairs(const R& a, const R& b) noexcept {
+         const R pairs = AverageBytes(PickEven32<false>(a, b), PickEven32<true>(a, b));
+
+         // Picking works inside 128bit lanes, so for wider registers   
+         // the 64bit halves of 'a' and 'b' end up interleaved          
+         #if LANGULUS_SIMD(128BIT)
+            if constexpr (CT::SIMD128<R>) return pairs;
+            else
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            if constexpr (CT::SIMD256<R>)
+               return R {simde_mm256_permute4x64_epi64(pairs, Shuffle(3, 1, 2, 0))};
+            else
+         #endif
+         #if LANGULUS_SIMD(512BIT)
+            if constexpr (CT::SIMD512<R>) {
+               return R {simde_mm512_permutexvar_epi64(
+                  simde_mm512_set_epi64(7, 5, 3, 1, 6, 4, 2, 0), pairs)};
+            }
+            else
+         #endif
+         static_assert(false, "Unsupported register");
+      }
+
+      /// Run a pixel kernel through the widest registers                     
+      ///   @param kernel - templated on the register, returns the first      
+      ///                   byte it didn't process                            
+      ///   @return the first byte that wasn't processed                      
+      template<class F> LANGULUS(INLINED)
+      Offset PixelStream(F&& kernel) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(512BIT)
+            i = kernel.template operator() <V512<::std::uint8_t>> (i);
+         #endif
+         #if LANGULUS_SIMD(256BIT)
+            i = kernel.template operator() <V256<::std::uint8_t>> (i);
+         #endif
+         #if LANGULUS_SIMD(128BIT)
+            i = kernel.template operator() <V128<::std::uint8_t>> (i);
+         #endif
+         (void)kernel;
+         return i;
+      }
+
+      /// Scalar x * y / 255, exactly like _mm_div255_epu16                   
+      NOD() LANGULUS(INLINED)
+      constexpr ::std::uint8_t ScaleByte(unsigned x, unsigned y) noexcept {
+         return static_cast<::std::uint8_t>(x * y / 255);
+      }
+
+      /// Get a span of pixels as raw bytes                                   
+      ///   @param data - span of bytes, or of 4-byte pixels                  
+      ///   @return the byte pointer and number of bytes                      
+      template<class DATA> NOD() LANGULUS(INLINED)
+      auto PixelBytes(DATA& data) {
+         const ::std::span span {data};
+         using V = typename decltype(span)::element_type;
+         static_assert(::std::is_trivially_copyable_v<V>
+            and (sizeof(V) == 1 or sizeof(V) % 4 == 0),
+            "Pixels must be bytes, or tightly packed RGBA8");
+         LANGULUS_ASSUME(UserAssumes, span.size_bytes() % 4 == 0,
+            "Span must contain whole RGBA8 pixels");
+
+         using B = Conditional<::std::is_const_v<V>, const ::std::uint8_t, ::std::uint8_t>;
+         return ::std::pair {reinterpret_cast<B*>(span.data()), span.size_bytes()};
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   namespace Pixel
+   {
+
+      /// Composite premultiplied 'src' over premultiplied 'dst'              
+      /// out = src + dst * (255 - src.alpha) / 255, for all four channels    
+      ///   @param src - the foreground pixels                                
+      ///   @param dst - the background pixels, same count                    
+      ///   @param out - the output, can be the same as any of the inputs     
+      template<class SRC, class DST, class OUT>
+      void AlphaOver(const SRC& src, const DST& dst, OUT&& out) {
+         const auto [s, bytes] = Inner::PixelBytes(src);
+         const auto [d, dstBytes] = Inner::PixelBytes(dst);
+         const auto [o, outBytes] = Inner::PixelBytes(out);
+         LANGULUS_ASSUME(UserAssumes, dstBytes >= bytes and outBytes >= bytes,
+            "Pixel spans must be of the same size");
+
+         Offset i = Inner::PixelStream([&]<class R>(Offset i) noexcept {
+            for (; i + sizeof(R) <= bytes; i += sizeof(R)) {
+               const auto fg = Inner::LoadUnaligned<R>(s + i);
+               const auto bg = Inner::LoadUnaligned<R>(d + i);
+               const auto inv = Inner::InvertBytes(Inner::BroadcastAlpha(fg));
+               Inner::StoreUnaligned(o + i, Inner::AddBytes(fg, Inner::ScaleBytes(bg, inv)));
+            }
+            return i;
+         });
+
+         // Remaining pixels                                            
+         for (; i < bytes; i += 4) {
+            const unsigned inv = 255u - s[i + 3];
+            for (Offset c = 0; c < 4; ++c) {
+               const unsigned r = s[i + c] + Inner::ScaleByte(d[i + c], inv);
+               o[i + c] = static_cast<::std::uint8_t>(r > 255 ? 255 : r);
+            }
+         }
+      }
+
+      /// Multiply the color channels by alpha, alpha stays the same          
+      ///   @param in - the straight-alpha pixels                             
+      ///   @param out - the premultiplied pixels, can be the same as 'in'    
+      template<class IN, class OUT>
+      void Premultiply(const IN& in, OUT&& out) {
+         const auto [p, bytes] = Inner::PixelBytes(in);
+         const auto [o, outBytes] = Inner::PixelBytes(out);
+         LANGULUS_ASSUME(UserAssumes, outBytes >= bytes,
+            "Output span is too short");
+
+         Offset i = Inner::PixelStream([&]<class R>(Offset i) noexcept {
+            // Alpha channel is scaled by 255, which leaves it the same 
+            const auto alpha = Inner::FillPixel<R>(0xFF000000u);
+            for (; i + sizeof(R) <= bytes; i += sizeof(R)) {
+               const auto x = Inner::LoadUnaligned<R>(p + i);
+               const auto factor = Inner::OrBytes(Inner::BroadcastAlpha(x), alpha);
+               Inner::StoreUnaligned(o + i, Inner::ScaleBytes(x, factor));
+            }
+            return i;
+         });
+
+         // Remaining pixels                                            
+         for (; i < bytes; i += 4) {
+            const auto a = p[i + 3];
+            for (Offset c = 0; c < 3; ++c)
+               o[i + c] = Inner::ScaleByte(p[i + c], a);
+            o[i + 3] = a;
+         }
+      }
+
+      /// Divide the color channels by alpha, alpha stays the same            
+      /// Colors are rounded to nearest, and are zero where alpha is zero     
+      /// This divides, so it is done in floats, on 128bit registers only     
+      ///   @param in - the premultiplied pixels                              
+      ///   @param out - the straight-alpha pixels, can be the same as 'in'   
+      template<class IN, class OUT>
+      void Unpremultiply(const IN& in, OUT&& out) {
+         const auto [p, bytes] = Inner::PixelBytes(in);
+         const auto [o, outBytes] = Inner::PixelBytes(out);
+         LANGULUS_ASSUME(UserAssumes, outBytes >= bytes,
+            "Output span is too short");
+
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            const auto zero = simde_mm_setzero_ps();
+            const auto one  = simde_mm_set1_ps(1.0f);
+            const auto max  = simde_mm_set1_ps(255.0f);
+
+            // Unpremultiply the K-th pixel of a register               
+            const auto pixel = [&]<int K>(const simde__m128i& px) noexcept {
+               const auto f = simde_mm_cvtepi32_ps(
+                  simde_mm_cvtepu8_epi32(simde_mm_srli_si128(px, K * 4)));
+               const auto a = simde_mm_shuffle_ps(f, f, Shuffle(3, 3, 3, 3));
+               auto scale = simde_mm_and_ps(simde_mm_div_ps(max, a), simde_mm_cmpneq_ps(a, zero));
+               scale = simde_mm_blend_ps(scale, one, 0b1000);
+               return simde_mm_cvtps_epi32(simde_mm_min_ps(simde_mm_mul_ps(f, scale), max));
+            };
+
+            for (; i + 16 <= bytes; i += 16) {
+               const auto px = simde_mm_loadu_si128(p + i);
+               simde_mm_storeu_si128(o + i, simde_mm_packus_epi16(
+                  simde_mm_packus_epi32(pixel.template operator() <0> (px), pixel.template operator() <1> (px)),
+                  simde_mm_packus_epi32(pixel.template operator() <2> (px), pixel.template operator() <3> (px))
+               ));
+            }
+         #endif
+
+         // Remaining pixels                                            
+         for (; i < bytes; i += 4) {
+            const auto a = p[i + 3];
+            const float scale = a ? 255.0f / static_cast<float>(a) : 0.0f;
+            for (Offset c = 0; c < 3; ++c) {
+               o[i + c] = static_cast<::std::uint8_t>(::std::nearbyint(
+                  ::std::min(static_cast<float>(p[i + c]) * scale, 255.0f)));
+            }
+            o[i + 3] = a;
+         }
+      }
+
+      /// Scale each channel by a constant: x * factor / 255                  
+      ///   @param in - the pixels                                            
+      ///   @param factors - the R, G, B and A factors                        
+      ///   @param out - the scaled pixels, can be the same as 'in'           
+      template<class IN, class OUT>
+      void Scale(const IN& in, const ::std::array<::std::uint8_t, 4>& factors, OUT&& out) {
+         const auto [p, bytes] = Inner::PixelBytes(in);
+         const auto [o, outBytes] = Inner::PixelBytes(out);
+         LANGULUS_ASSUME(UserAssumes, outBytes >= bytes,
+            "Output span is too short");
+
+         const auto pattern = ::std::uint32_t(factors[0])
+                           | (::std::uint32_t(factors[1]) << 8)
+                           | (::std::uint32_t(factors[2]) << 16)
+                           | (::std::uint32_t(factors[3]) << 24);
+
+         Offset i = Inner::PixelStream([&]<class R>(Offset i) noexcept {
+            const auto factor = Inner::FillPixel<R>(pattern);
+            for (; i + sizeof(R) <= bytes; i += sizeof(R)) {
+               Inner::StoreUnaligned(o + i, Inner::ScaleBytes(
+                  Inner::LoadUnaligned<R>(p + i), factor));
+            }
+            return i;
+         });
+
+         // Remaining pixels                                            
+         for (; i < bytes; ++i)
+            o[i] = Inner::ScaleByte(p[i], factors[i % 4]);
+      }
+
+      /// Halve an image in both dimensions, by averaging each 2x2 block      
+      /// Rows are averaged first, then columns, each with avg_epu8           
+      /// rounding. An odd last row or column is ignored                      
+      ///   @param in - the width * height source pixels, row by row          
+      ///   @param width - the source width, in pixels                        
+      ///   @param height - the source height, in pixels                      
+      ///   @param out - the (width / 2) * (height / 2) output pixels         
+      template<class IN, class OUT>
+      void Downsample2x(const IN& in, Count width, Count height, OUT&& out) {
+         const auto [p, bytes] = Inner::PixelBytes(in);
+         const auto [o, outBytes] = Inner::PixelBytes(out);
+         const Count outWidth = width / 2;
+         const Count outHeight = height / 2;
+         LANGULUS_ASSUME(UserAssumes, bytes >= width * height * 4,
+            "Source span is smaller than the image");
+         LANGULUS_ASSUME(UserAssumes, outBytes >= outWidth * outHeight * 4,
+            "Output span is too short");
+
+         const Count rowBytes = outWidth * 4;
+         for (Offset y = 0; y < outHeight; ++y) {
+            const auto top = p + y * 2 * width * 4;
+            const auto bottom = top + width * 4;
+            const auto to = o + y * rowBytes;
+
+            Offset i = Inner::PixelStream([&]<class R>(Offset i) noexcept {
+               for (; i + sizeof(R) <= rowBytes; i += sizeof(R)) {
+                  const auto a = Inner::AverageBytes(
+                     Inner::LoadUnaligned<R>(top + i * 2),
+                     Inner::LoadUnaligned<R>(bottom + i * 2));
+                  const auto b = Inner::AverageBytes(
+                     Inner::LoadUnaligned<R>(top + i * 2 + sizeof(R)),
+                     Inner::LoadUnaligned<R>(bottom + i * 2 + sizeof(R)));
+                  Inner::StoreUnaligned(to + i, Inner::AveragePairs(a, b));
+               }
+               return i;
+            });
+
+            // Remaining pixels of the row                              
+            for (; i < rowBytes; ++i) {
+               const Offset at = (i / 4) * 8 + i % 4;
+               const unsigned left  = (top[at]     + bottom[at]     + 1u) / 2;
+               const unsigned right = (top[at + 4] + bottom[at + 4] + 1u) / 2;
+               to[i] = static_cast<::std::uint8_t>((left + right + 1) / 2);
+            }
+         }
+      }
+
+   } // namespace Langulus::SIMD::Pixel
+
+} // namespace Langulus::SIMD
@@ -0,0 +1,620 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "../bulk/Search.hpp"
+#include <cstring>
+
+
+///                                                                           
+///   Unicode validation and transcoding                                      
+///                                                                           
+/// The encoding is picked by the size of the character: 1-byte characters    
+/// (char, char8_t) are UTF-8, 2-byte ones (char16_t, wchar_t on Windows)     
+/// are UTF-16, and 4-byte ones (char32_t, wchar_t elsewhere) are UTF-32.     
+/// UTF-8 is validated with the lookup approach of Keiser and Lemire - each   
+/// byte is classified by the nibbles of itself and its predecessor, via      
+/// three pshufb table lookups. Transcoding copies runs of ASCII (or of       
+/// BMP characters, between UTF-16 and UTF-32) a register at a time, and      
+/// decodes everything else one code point at a time. When any error is       
+/// detected, the exact offset is found by rescanning from the last known     
+/// character boundary                                                        
+///                                                                           
+namespace Langulus::SIMD
+{
+
+   /// Outcome of validation, measuring or transcoding of text                
+   struct TextResult {
+      // Offset of the first invalid code unit in the input, or the     
+      // size of the input if all of it is valid                        
+      Offset mPosition = 0;
+      // Number of code units written to (or required for) the output   
+      Count mCount = 0;
+      // Whether the whole input is valid                               
+      bool mValid = true;
+   };
+
+   namespace Inner
+   {
+
+      /// A decoded code point, and the number of code units it took          
+      /// The size is zero if the code units are invalid                      
+      struct Decoded {
+         char32_t mCode;
+         Count mSize;
+      };
+
+      /// Decode a code point from UTF-8, rejecting overlong encodings,       
+      /// surrogates, code points above 0x10FFFF and truncated sequences      
+      NOD() LANGULUS(INLINED)
+      constexpr Decoded DecodeUtf8(const ::std::uint8_t* p, Count available) noexcept {
+         const char32_t lead = p[0];
+         if (lead < 0x80)
+            return {lead, 1};
+
+         Count size;
+         char32_t code;
+         if      (lead < 0xC2) return {0, 0};
+         else if (lead < 0xE0) { size = 2; code = lead & 0x1F; }
+         else if (lead < 0xF0) { size = 3; code = lead & 0x0F; }
+         else if (lead < 0xF5) { size = 4; code = lead & 0x07; }
+         else return {0, 0};
+
+         if (available < size)
+            return {0, 0};
+         for (Offset i = 1; i < size; ++i) {
+            if ((p[i] & 0xC0) != 0x80)
+               return {0, 0};
+            code = (code << 6) | (p[i] & 0x3F);
+         }
+
+         if ((size == 3 and code < 0x800)
+         or  (size == 4 and (code < 0x10000 or code > 0x10FFFF))
+         or  (code >= 0xD800 and code <= 0xDFFF))
+            return {0, 0};
+         return {code, size};
+      }
+
+      /// Decode a code point from UTF-16, rejecting unpaired surrogates      
+      NOD() LANGULUS(INLINED)
+      constexpr Decoded DecodeUtf16(const ::std::uint16_t* p, Count available) noexcept {
+         const char32_t high = p[0];
+         if (high < 0xD800 or high > 0xDFFF)
+            return {high, 1};
+         if (high >= 0xDC00 or available < 2)
+            return {0, 0};
+
+         const char32_t low = p[1];
+         if (low < 0xDC00 or low > 0xDFFF)
+            return {0, 0};
+         return {0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00), 2};
+      }
+
+      /// Decode a code point from UTF-32, rejecting surrogates and code      
+      /// points above 0x10FFFF                                               
+      NOD() LANGULUS(INLINED)
+      constexpr Decoded DecodeUtf32(const ::std::uint32_t* p, Count) noexcept {
+         const char32_t code = p[0];
+         if (code > 0x10FFFF or (code >= 0xD800 and code <= 0xDFFF))
+            return {0, 0};
+         return {code, 1};
+      }
+
+      /// Decode a code point in the encoding of U                            
+      template<class U> NOD() LANGULUS(INLINED)
+      constexpr Decoded DecodeUnicode(const U* p, Count available) noexcept {
+         if      constexpr (sizeof(U) == 1) return DecodeUtf8 (p, available);
+         else if constexpr (sizeof(U) == 2) return DecodeUtf16(p, available);
+         else if constexpr (sizeof(U) == 4) return DecodeUtf32(p, available);
+         else static_assert(false, "Unsupported code unit");
+      }
+
+      /// Number of code units of type U, needed to encode a code point       
+      template<class U> NOD() LANGULUS(INLINED)
+      constexpr Count EncodedSize(char32_t code) noexcept {
+         if constexpr (sizeof(U) == 1)
+            return code < 0x80 ? 1 : code < 0x800 ? 2 : code < 0x10000 ? 3 : 4;
+         else if constexpr (sizeof(U) == 2)
+            return code < 0x10000 ? 1 : 2;
+         else
+            return 1;
+      }
+
+      /// Encode a valid code point as code units of type U                   
+      ///   @return the number of written code units                          
+      template<class U> LANGULUS(INLINED)
+      constexpr Count EncodeUnicode(char32_t code, U* out) noexcept {
+         if constexpr (sizeof(U) == 1) {
+            if (code < 0x80) {
+               out[0] = static_cast<U>(code);
+               return 1;
+            }
+            else if (code < 0x800) {
+               out[0] = static_cast<U>(0xC0 | (code >> 6));
+               out[1] = static_cast<U>(0x80 | (code & 0x3F));
+               return 2;
+            }
+            else if (code < 0x10000) {
+               out[0] = static_cast<U>(0xE0 | (code >> 12));
+               out[1] = static_cast<U>(0x80 | ((code >> 6) & 0x3F));
+               out[2] = static_cast<U>(0x80 | (code & 0x3F));
+               return 3;
+            }
+            else {
+               out[0] = static_cast<U>(0xF0 | (code >> 18));
+               out[1] = static_cast<U>(0x80 | ((code >> 12) & 0x3F));
+               out[2] = static_cast<U>(0x80 | ((code >> 6) & 0x3F));
+               out[3] = static_cast<U>(0x80 | (code & 0x3F));
+               return 4;
+            }
+         }
+         else if constexpr (sizeof(U) == 2) {
+            if (code < 0x10000) {
+               out[0] = static_cast<U>(code);
+               return 1;
+            }
+            code -= 0x10000;
+            out[0] = static_cast<U>(0xD800 | (code >> 10));
+            out[1] = static_cast<U>(0xDC00 | (code & 0x3FF));
+            return 2;
+         }
+         else {
+            out[0] = static_cast<U>(code);
+            return 1;
+         }
+      }
+
+      /// Transcode one code point at a time                                  
+      ///   @tparam WRITE - false to only count the output code units         
+      ///   @param in - the input code units                                  
+      ///   @param count - number of input code units                         
+      ///   @param out - the output code units, can be nullptr if not WRITE   
+      ///   @param capacity - number of output code units                     
+      ///   @param i - [in/out] the input position                            
+      ///   @param written - [in/out] the number of output code units         
+      ///   @param until - continue until this input position is reached      
+      ///   @return false if invalid input was met, 'i' points to it then     
+      template<bool WRITE, class FROM, class TO> LANGULUS(INLINED)
+      bool TranscodeScalar(
+         const FROM* in, const Count count, TO* out, const Count capacity,
+         Offset& i, Count& written, const Offset until
+      ) noexcept {
+         (void)out; (void)capacity;
+         while (i < until) {
+            const auto decoded = DecodeUnicode(in + i, count - i);
+            if (not decoded.mSize)
+               return false;
+
+            if constexpr (WRITE) {
+               LANGULUS_ASSUME(UserAssumes,
+                  written + EncodedSize<TO>(decoded.mCode) <= capacity,
+                  "Output span is too short");
+               written += EncodeUnicode(decoded.mCode, out + written);
+            }
+            else written += EncodedSize<TO>(decoded.mCode);
+            i += decoded.mSize;
+         }
+         return true;
+      }
+
+      /// Find a character boundary near 'i', from which decoding can         
+      /// resume, given that everything before 'i' was checked already        
+      /// Only the last (up to three) bytes before 'i' can belong to an       
+      /// incomplete sequence, so decoding resumes from its lead              
+      NOD() LANGULUS(INLINED)
+      constexpr Offset Utf8Boundary(const ::std::uint8_t* p, Offset i) noexcept {
+         Offset k = i > 3 ? i - 3 : 0;
+         while (k < i and (p[k] & 0xC0) == 0x80)
+            ++k;
+         return k;
+      }
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Error classes of the UTF-8 lookup tables                         
+         namespace Utf8Error
+         {
+            constexpr ::std::uint8_t TooShort    = 1 << 0;   // lead, then no continuation
+            constexpr ::std::uint8_t TooLong     = 1 << 1;   // ASCII, then continuation
+            constexpr ::std::uint8_t Overlong3   = 1 << 2;
+            constexpr ::std::uint8_t TooLarge    = 1 << 3;
+            constexpr ::std::uint8_t Surrogate   = 1 << 4;
+            constexpr ::std::uint8_t Overlong2   = 1 << 5;
+            constexpr ::std::uint8_t TooLarge1000 = 1 << 6;
+            constexpr ::std::uint8_t Overlong4   = 1 << 6;
+            constexpr ::std::uint8_t TwoConts    = 1 << 7;   // continuation, then continuation
+            constexpr ::std::uint8_t Carry = TooShort | TooLong | TwoConts;
+         }
+
+         /// Classification by the high nibble of the previous byte           
+         constexpr ::std::uint8_t Utf8Byte1High[16] {
+            // 0_______ ________ - ASCII                                
+            Utf8Error::TooLong, Utf8Error::TooLong, Utf8Error::TooLong, Utf8Error::TooLong,
+            Utf8Error::TooLong, Utf8Error::TooLong, Utf8Error::TooLong, Utf8Error::TooLong,
+            // 10______ ________ - continuation                         
+            Utf8Error::TwoConts, Utf8Error::TwoConts, Utf8Error::TwoConts, Utf8Error::TwoConts,
+            // 1100____ ________ - two byte lead                        
+            Utf8Error::TooShort | Utf8Error::Overlong2,
+            // 1101____ ________ - two byte lead                        
+            Utf8Error::TooShort,
+            // 1110____ ________ - three byte lead                      
+            Utf8Error::TooShort | Utf8Error::Overlong3 | Utf8Error::Surrogate,
+            // 1111____ ________ - four byte lead                       
+            Utf8Error::TooShort | Utf8Error::TooLarge | Utf8Error::TooLarge1000 | Utf8Error::Overlong4
+         };
+
+         /// Classification by the low nibble of the previous byte            
+         constexpr ::std::uint8_t Utf8Byte1Low[16] {
+            // ____0000 ________                                        
+            Utf8Error::Carry | Utf8Error::Overlong3 | Utf8Error::Overlong2 | Utf8Error::Overlong4,
+            // ____0001 ________                                        
+            Utf8Error::Carry | Utf8Error::Overlong2,
+            // ____001_ ________                                        
+            Utf8Error::Carry,
+            Utf8Error::Carry,
+            // ____0100 ________                                        
+            Utf8Error::Carry | Utf8Error::TooLarge,
+            // ____0101 ________ and above                              
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            // ____1101 ________                                        
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000 | Utf8Error::Surrogate,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000,
+            Utf8Error::Carry | Utf8Error::TooLarge | Utf8Error::TooLarge1000
+         };
+
+         /// Classification by the high nibble of the current byte            
+         constexpr ::std::uint8_t Utf8Byte2High[16] {
+            // ________ 0_______ - ASCII                                
+            Utf8Error::TooShort, Utf8Error::TooShort, Utf8Error::TooShort, Utf8Error::TooShort,
+            Utf8Error::TooShort, Utf8Error::TooShort, Utf8Error::TooShort, Utf8Error::TooShort,
+            // ________ 1000____                                        
+            Utf8Error::TooLong | Utf8Error::Overlong2 | Utf8Error::TwoConts
+               | Utf8Error::Overlong3 | Utf8Error::TooLarge1000 | Utf8Error::Overlong4,
+            // ________ 1001____                                        
+            Utf8Error::TooLong | Utf8Error::Overlong2 | Utf8Error::TwoConts
+               | Utf8Error::Overlong3 | Utf8Error::TooLarge,
+            // ________ 101_____                                        
+            Utf8Error::TooLong | Utf8Error::Overlong2 | Utf8Error::TwoConts
+               | Utf8Error::Surrogate | Utf8Error::TooLarge,
+            Utf8Error::TooLong | Utf8Error::Overlong2 | Utf8Error::TwoConts
+               | Utf8Error::Surrogate | Utf8Error::TooLarge,
+            // ________ 11______ - lead                                 
+            Utf8Error::TooShort, Utf8Error::TooShort, Utf8Error::TooShort, Utf8Error::TooShort
+         };
+
+         /// Find UTF-8 errors in a block of 16 bytes                         
+         ///   @param input - the block                                       
+         ///   @param prev - the previous block                               
+         ///   @return nonzero bytes where errors were detected               
+         NOD() LANGULUS(INLINED)
+         simde__m128i Utf8BlockErrors(const simde__m128i& input, const simde__m128i& prev) noexcept {
+            const auto nibble = simde_mm_set1_epi8(0x0F);
+            const auto lookup = [&](const ::std::uint8_t* table, const simde__m128i& index) noexcept {
+               return simde_mm_shuffle_epi8(simde_mm_loadu_si128(table), simde_mm_and_si128(index, nibble));
+            };
+
+            // Check each byte against its predecessor                  
+            const auto prev1 = simde_mm_alignr_epi8(input, prev, 15);
+            const auto special = simde_mm_and_si128(simde_mm_and_si128(
+               lookup(Utf8Byte1High, simde_mm_srli_epi16(prev1, 4)),
+               lookup(Utf8Byte1Low,  prev1)),
+               lookup(Utf8Byte2High, simde_mm_srli_epi16(input, 4))
+            );
+
+            // Third and fourth bytes must be continuations, and the    
+            // two continuations that the lookup flags are fine there   
+            const auto prev2 = simde_mm_alignr_epi8(input, prev, 14);
+            const auto prev3 = simde_mm_alignr_epi8(input, prev, 13);
+            const auto third  = simde_mm_subs_epu8(prev2, simde_mm_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+            const auto fourth = simde_mm_subs_epu8(prev3, simde_mm_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+            const auto must23 = simde_mm_and_si128(simde_mm_or_si128(third, fourth),
+               simde_mm_set1_epi8(static_cast<char>(0x80)));
+            return simde_mm_xor_si128(must23, special);
+         }
+      #endif
+
+      /// Validate UTF-8                                                      
+      ///   @return the offset of the first invalid byte, or 'count'          
+      NOD() inline Offset ValidateUtf8(const ::std::uint8_t* p, const Count count) noexcept {
+         Offset i = 0;
+         #if LANGULUS_SIMD(128BIT)
+            // Blocks ending with an incomplete sequence can't be       
+            // followed by ASCII                                        
+            const auto incomplete = simde_mm_setr_epi8(
+               -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+               static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1)
+            );
+
+            auto prev = simde_mm_setzero_si128();
+            for (; i + 16 <= count; i += 16) {
+               const auto input = simde_mm_loadu_si128(p + i);
+               const auto error = simde_mm_movemask_epi8(input)
+                  ? Utf8BlockErrors(input, prev)
+                  : simde_mm_subs_epu8(prev, incomplete);
+               if (not simde_mm_testz_si128(error, error))
+                  break;
+               prev = input;
+            }
+
+            // Find the exact position of the error (if any) by         
+            // decoding the rest, starting from a character boundary    
+            i = Utf8Boundary(p, i);
+         #endif
+
+         while (i < count) {
+            const auto decoded = DecodeUtf8(p + i, count - i);
+            if (not decoded.mSize)
+               return i;
+            i += decoded.mSize;
+         }
+         return count;
+      }
+
+      /// Count the code units needed to transcode valid UTF-8                
+      ///   @tparam TO - the output code unit                                 
+      template<class TO> NOD() LANGULUS(INLINED)
+      Count Utf8TranscodedSize(const ::std::uint8_t* p, const Count count) noexcept {
+         if constexpr (sizeof(TO) == 1)
+            return count;
+         else {
+            // Each lead (or ASCII) byte makes a code unit, and four    
+            // byte leads make an additional surrogate in UTF-16        
+            Offset i = 0;
+            Count result = 0;
+            #if LANGULUS_SIMD(128BIT)
+               const auto lastContinuation = simde_mm_set1_epi8(static_cast<char>(0xBF));
+               const auto fourByteLead = simde_mm_set1_epi8(static_cast<char>(0xF0));
+               for (; i + 16 <= count; i += 16) {
+                  const auto input = simde_mm_loadu_si128(p + i);
+                  result += ::std::popcount(static_cast<::std::uint32_t>(simde_mm_movemask_epi8(
+                     simde_mm_cmpgt_epi8(input, lastContinuation))));
+                  if constexpr (sizeof(TO) == 2) {
+                     result += ::std::popcount(static_cast<::std::uint32_t>(simde_mm_movemask_epi8(
+                        simde_mm_cmpeq_epi8(simde_mm_max_epu8(input, fourByteLead), input))));
+                  }
+               }
+            #endif
+
+            // Remaining bytes                                          
+            for (; i < count; ++i) {
+               result += (p[i] & 0xC0) != 0x80;
+               if constexpr (sizeof(TO) == 2)
+                  result += p[i] >= 0xF0;
+            }
+            return result;
+         }
+      }
+
+      #if LANGULUS_SIMD(128BIT)
+         /// Transcode a block of code units, if all of them are ASCII (or    
+         /// BMP characters, between UTF-16 and UTF-32)                       
+         ///   @return true if the block was transcoded                       
+         template<class FROM, class TO> LANGULUS(INLINED)
+         bool TranscodeBlock(const FROM* in, TO* out) noexcept {
+            const auto zero = simde_mm_setzero_si128();
+            const auto x = simde_mm_loadu_si128(in);
+
+            if constexpr (sizeof(FROM) == 1) {
+               if (simde_mm_movemask_epi8(x))
+                  return false;
+
+               const auto lo = simde_mm_unpacklo_epi8(x, zero);
+               const auto hi = simde_mm_unpackhi_epi8(x, zero);
+               if constexpr (sizeof(TO) == 2) {
+                  simde_mm_storeu_si128(out,     lo);
+                  simde_mm_storeu_si128(out + 8, hi);
+               }
+               else {
+                  simde_mm_storeu_si128(out,      simde_mm_unpacklo_epi16(lo, zero));
+                  simde_mm_storeu_si128(out + 4,  simde_mm_unpackhi_epi16(lo, zero));
+                  simde_mm_storeu_si128(out + 8,  simde_mm_unpacklo_epi16(hi, zero));
+                  simde_mm_storeu_si128(out + 12, simde_mm_unpackhi_epi16(hi, zero));
+               }
+            }
+            else if constexpr (sizeof(FROM) == 2) {
+               if constexpr (sizeof(TO) == 1) {
+                  if (not simde_mm_testz_si128(x, simde_mm_set1_epi16(static_cast<short>(0xFF80))))
+                     return false;
+                  simde_mm_storel_epi64(reinterpret_cast<simde__m128i*>(out), simde_mm_packus_epi16(x, x));
+               }
+               else {
+                  const auto surrogates = simde_mm_cmpeq_epi16(
+                     simde_mm_and_si128(x, simde_mm_set1_epi16(static_cast<short>(0xF800))),
+                     simde_mm_set1_epi16(static_cast<short>(0xD800)));
+                  if (simde_mm_movemask_epi8(surrogates))
+                     return false;
+                  simde_mm_storeu_si128(out,     simde_mm_unpacklo_epi16(x, zero));
+                  simde_mm_storeu_si128(out + 4, simde_mm_unpackhi_epi16(x, zero));
+               }
+            }
+            else {
+               if constexpr (sizeof(TO) == 1) {
+                  if (not simde_mm_testz_si128(x, simde_mm_set1_epi32(~0x7F)))
+                     return false;
+                  const auto bytes = simde_mm_packus_epi16(simde_mm_packus_epi32(x, x), zero);
+                  const auto packed = simde_mm_cvtsi128_si32(bytes);
+                  ::std::memcpy(out, &packed, 4);
+               }
+               else {
+                  const auto surrogates = simde_mm_cmpeq_epi32(
+                     simde_mm_and_si128(x, simde_mm_set1_epi32(0xF800)),
+                     simde_mm_set1_epi32(0xD800));
+                  const auto wide = simde_mm_and_si128(x, simde_mm_set1_epi32(static_cast<int>(0xFFFF0000)));
+                  if (not simde_mm_testz_si128(simde_mm_or_si128(surrogates, wide), simde_mm_set1_epi32(-1)))
+                     return false;
+                  simde_mm_storel_epi64(reinterpret_cast<simde__m128i*>(out), simde_mm_packus_epi32(x, x));
+               }
+            }
+            return true;
+         }
+      #endif
+
+      /// Transcode, validating the input                                     
+      ///   @param in - the input code units                                  
+      ///   @param count - number of input code units                         
+      ///   @param out - the output code units                                
+      ///   @param capacity - number of output code units                     
+      ///   @return the result                                                
+      template<class FROM, class TO>
+      TextResult TranscodeBulk(const FROM* in, const Count count, TO* out, const Count capacity) noexcept {
+         if constexpr (sizeof(FROM) == sizeof(TO)) {
+            // Same encoding, just validate and copy the valid part     
+            Offset valid = count;
+            if constexpr (sizeof(FROM) == 1)
+               valid = ValidateUtf8(in, count);
+            else {
+               Count ignored = 0;
+               valid = 0;
+               TranscodeScalar<false>(in, count, out, capacity, valid, ignored, count);
+            }
+
+            LANGULUS_ASSUME(UserAssumes, valid <= capacity, "Output span is too short");
+            if (valid and static_cast<const void*>(in) != static_cast<const void*>(out))
+               ::std::memmove(out, in, valid * sizeof(FROM));
+            return {valid, valid, valid == count};
+         }
+         else {
+            Offset i = 0;
+            Count written = 0;
+
+            #if LANGULUS_SIMD(128BIT)
+               constexpr Count B = 16 / sizeof(FROM);
+               while (i + B <= count) {
+                  if (written + B <= capacity and TranscodeBlock(in + i, out + written)) {
+                     i += B;
+                     written += B;
+                  }
+                  else if (not TranscodeScalar<true>(in, count, out, capacity, i, written, i + B))
+                     return {i, written, false};
+               }
+            #endif
+
+            if (not TranscodeScalar<true>(in, count, out, capacity, i, written, count))
+               return {i, written, false};
+            return {count, written, true};
+         }
+      }
+
+      /// Get the code units of a mutable span, as unsigned integers          
+      template<class DATA> NOD() LANGULUS(INLINED)
+      auto TextUnits(DATA& data) noexcept {
+         const ::std::span span {data};
+         using V = typename decltype(span)::element_type;
+         static_assert(not ::std::is_const_v<V>, "Output must be mutable");
+         static_assert(::std::is_trivially_copyable_v<V>
+            and (sizeof(V) == 1 or sizeof(V) == 2 or sizeof(V) == 4),
+            "Text must be made of 1, 2 or 4-byte characters");
+         using E = SearchElement<V>;
+         return ::std::pair {reinterpret_cast<E*>(span.data()), span.size()};
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   /// Find the first byte that isn't ASCII                                   
+   ///   @param text - span of bytes, char or char8_t characters              
+   ///   @return the offset of the byte, or the size of 'text' if all ASCII   
+   template<class DATA> NOD() LANGULUS(INLINED)
+   Offset FindNonAscii(const DATA& text) noexcept {
+      const auto [p, count] = Inner::SearchElements(text);
+      static_assert(sizeof(*p) == 1, "Text must be made of bytes");
+
+      Offset i = 0;
+      #if LANGULUS_SIMD(512BIT)
+         for (; i + 64 <= count; i += 64) {
+            if (const ::std::uint64_t mask = simde_mm512_movepi8_mask(simde_mm512_loadu_si512(p + i)))
+               return i + ::std::countr_zero(mask);
+         }
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         for (; i + 32 <= count; i += 32) {
+            if (const auto mask = static_cast<::std::uint32_t>(simde_mm256_movemask_epi8(simde_mm256_loadu_si256(p + i))))
+               return i + ::std::countr_zero(mask);
+         }
+      #endif
+      #if LANGULUS_SIMD(128BIT)
+         for (; i + 16 <= count; i += 16) {
+            if (const auto mask = static_cast<::std::uint32_t>(simde_mm_movemask_epi8(simde_mm_loadu_si128(p + i))))
+               return i + ::std::countr_zero(mask);
+         }
+      #endif
+
+      // Remaining bytes                                                
+      for (; i < count; ++i) {
+         if (p[i] >= 0x80)
+            return i;
+      }
+      return count;
+   }
+
+   /// Check if text is pure ASCII, which is valid in any encoding            
+   ///   @param text - span of bytes, char or char8_t characters              
+   template<class DATA> NOD() LANGULUS(INLINED)
+   bool IsAscii(const DATA& text) noexcept {
+      return FindNonAscii(text) == ::std::span {text}.size();
+   }
+
+   /// Validate UTF-8, UTF-16 or UTF-32 text                                  
+   ///   @param text - span of characters, encoding is picked by their size   
+   ///   @return the result, where mCount is the number of valid code units   
+   template<class DATA> NOD() LANGULUS(INLINED)
+   TextResult Validate(const DATA& text) noexcept {
+      const auto [p, count] = Inner::SearchElements(text);
+      Offset valid = 0;
+      if constexpr (sizeof(*p) == 1)
+         valid = Inner::ValidateUtf8(p, count);
+      else {
+         Count ignored = 0;
+         Inner::TranscodeScalar<false>(p, count, p, 0, valid, ignored, count);
+      }
+      return {valid, valid, valid == count};
+   }
+
+   /// Measure the exact output of a transcoding, validating the input        
+   ///   @tparam TO - the output character, e.g. char16_t                     
+   ///   @param text - span of characters, encoding is picked by their size   
+   ///   @return the result, where mCount is the number of TO characters      
+   ///           needed for the valid part of the input                       
+   template<class TO, class DATA> NOD() LANGULUS(INLINED)
+   TextResult TranscodedSize(const DATA& text) noexcept {
+      static_assert(sizeof(TO) == 1 or sizeof(TO) == 2 or sizeof(TO) == 4,
+         "Output must be made of 1, 2 or 4-byte characters");
+      using E = Inner::SearchElement<TO>;
+      const auto [p, count] = Inner::SearchElements(text);
+
+      TextResult result;
+      if constexpr (sizeof(*p) == 1) {
+         result.mPosition = Inner::ValidateUtf8(p, count);
+         result.mCount = Inner::Utf8TranscodedSize<E>(p, result.mPosition);
+      }
+      else {
+         Inner::TranscodeScalar<false>(p, count, static_cast<E*>(nullptr), 0,
+            result.mPosition, result.mCount, count);
+      }
+      result.mValid = result.mPosition == count;
+      return result;
+   }
+
+   /// Transcode between UTF-8, UTF-16 and UTF-32, validating the input       
+   /// Stops at the first invalid code unit, everything before it is written  
+   ///   @param in - span of characters, encoding is picked by their size     
+   ///   @param out - span of characters, encoding is picked by their size;   
+   ///                use TranscodedSize to get its exact size                
+   ///   @return the result, where mCount is the number of written characters 
+   template<class IN, class OUT> LANGULUS(INLINED)
+   TextResult Transcode(const IN& in, OUT&& out) noexcept {
+      const auto [from, count] = Inner::SearchElements(in);
+      const auto [to, capacity] = Inner::TextUnits(out);
+      return Inner::TranscodeBulk(from, count, to, capacity);
+   }
+
+} // namespace Langulus::SIMD
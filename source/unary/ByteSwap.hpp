@@ -0,0 +1,152 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#pragma once
+#include "../Attempt.hpp"
+#include "../MoreSIMD.hpp"
+#include <bit>
+
+
+namespace Langulus::SIMD
+{
+   namespace Inner
+   {
+
+      /// Reverse the bytes of a single scalar                                
+      ///   @param value - the scalar to swap                                 
+      ///   @return the swapped scalar                                        
+      template<class E> NOD() LANGULUS(INLINED)
+      constexpr E ByteSwapScalar(const E& value) noexcept {
+         if constexpr (sizeof(E) == 1)
+            return value;
+         else {
+            using U = Conditional<sizeof(E) == 2, ::std::uint16_t,
+                      Conditional<sizeof(E) == 4, ::std::uint32_t,
+                                                  ::std::uint64_t>>;
+            static_assert(sizeof(E) == sizeof(U), "Unsupported element size");
+
+            auto bits = ::std::bit_cast<U>(value);
+            U result = 0;
+            for (Offset i = 0; i < sizeof(U); ++i) {
+               result = static_cast<U>((result << 8) | (bits & 0xFF));
+               bits >>= 8;
+            }
+            return ::std::bit_cast<E>(result);
+         }
+      }
+
+      /// Generate a simde_mm*_shuffle_epi8 control, that reverses the bytes  
+      /// of each S-byte element, for a register of B bytes                   
+      template<Count S, Count B>
+      consteval auto ByteSwapControl() {
+         ::std::array<::std::int8_t, B> result {};
+         for (Offset j = 0; j < B; ++j) {
+            // The shuffle never crosses 128bit lanes, so indices are   
+            // relative to the lane                                     
+            const Offset inLane = j % 16;
+            result[j] = static_cast<::std::int8_t>((inLane / S) * S + (S - 1 - inLane % S));
+         }
+         return result;
+      }
+
+      template<Count S, Count B>
+      constexpr auto ByteSwapControlTable = ByteSwapControl<S, B>();
+
+      /// Used to detect missing SIMD routine                                 
+      NOD() LANGULUS(INLINED)
+      constexpr Unsupported ByteSwapSIMD(CT::NotSIMD auto) noexcept {
+         return {};
+      }
+
+      /// Reverse the bytes of each element via SIMD                          
+      /// Uses the _mm_bswap_* helpers for 128bit registers, and vpshufb for  
+      /// the wider ones. Reals are swapped as raw bits                       
+      ///   @param v - the register                                           
+      ///   @return the swapped register                                      
+      NOD() LANGULUS(INLINED)
+      auto ByteSwapSIMD(CT::SIMD auto v) noexcept {
+         using R = decltype(v);
+         using T = TypeOf<R>;
+         constexpr Count S = sizeof(T);
+         (void)v;
+
+         if constexpr (S == 1)
+            return v;
+         else if constexpr (CT::SIMD128<R>) {
+            const auto swap = [](const auto& i) noexcept {
+               if      constexpr (S == 2) return _mm_bswap_epi16(i);
+               else if constexpr (S == 4) return _mm_bswap_epi32(i);
+               else if constexpr (S == 8) return _mm_bswap_epi64(i);
+               else static_assert(false, "Unsupported element size");
+            };
+
+            if      constexpr (CT::Integer<T>) return R {swap(v)};
+            else if constexpr (CT::Float<T>)   return R {simde_mm_castsi128_ps(swap(simde_mm_castps_si128(v)))};
+            else if constexpr (CT::Double<T>)  return R {simde_mm_castsi128_pd(swap(simde_mm_castpd_si128(v)))};
+            else static_assert(false, "Unsupported type for 16-byte package");
+         }
+         else if constexpr (CT::SIMD256<R>) {
+            const auto swap = [](const auto& i) noexcept {
+               return simde_mm256_shuffle_epi8(i, simde_mm256_loadu_si256(
+                  ByteSwapControlTable<S, 32>.data()));
+            };
+
+            if      constexpr (CT::Integer<T>) return R {swap(v)};
+            else if constexpr (CT::Float<T>)   return R {simde_mm256_castsi256_ps(swap(simde_mm256_castps_si256(v)))};
+            else if constexpr (CT::Double<T>)  return R {simde_mm256_castsi256_pd(swap(simde_mm256_castpd_si256(v)))};
+            else static_assert(false, "Unsupported type for 32-byte package");
+         }
+         else if constexpr (CT::SIMD512<R>) {
+            const auto swap = [](const auto& i) noexcept {
+               return simde_mm512_shuffle_epi8(i, simde_mm512_loadu_si512(
+                  ByteSwapControlTable<S, 64>.data()));
+            };
+
+            if      constexpr (CT::Integer<T>) return R {swap(v)};
+            else if constexpr (CT::Float<T>)   return R {simde_mm512_castsi512_ps(swap(simde_mm512_castps_si512(v)))};
+            else if constexpr (CT::Double<T>)  return R {simde_mm512_castsi512_pd(swap(simde_mm512_castpd_si512(v)))};
+            else static_assert(false, "Unsupported type for 64-byte package");
+         }
+         else static_assert(false, "Unsupported type");
+      }
+
+      /// Reverse bytes as constexpr, if possible                             
+      ///   @tparam FORCE_OUT - the desired element type (lossless if void)   
+      ///   @patam value - scalar/vector to operate on                        
+      ///   @return the swapped scalar/vector                                 
+      template<CT::NoIntent FORCE_OUT = void> NOD() LANGULUS(INLINED)
+      constexpr auto ByteSwapConstexpr(const auto& value) noexcept {
+         return AttemptUnary<0, FORCE_OUT>(value, nullptr,
+            []<class E>(const E& f) noexcept -> E {
+               return ByteSwapScalar(f);
+            }
+         );
+      }
+
+      /// Reverse bytes as a register, if possible                            
+      ///   @tparam FORCE_OUT - the desired element type (lossless if void)   
+      ///   @patam value - scalar/vector/register to operate on               
+      ///   @return the swapped scalar/vector/register                        
+      template<CT::NoIntent FORCE_OUT = void> NOD() LANGULUS(INLINED)
+      auto ByteSwap(const auto& value) noexcept {
+         return AttemptUnary<0, FORCE_OUT>(value,
+            []<class R>(const R& v) noexcept {
+               LANGULUS_SIMD_VERBOSE("Swapping bytes (SIMD) as ", NameOf<R>());
+               return ByteSwapSIMD(v);
+            },
+            []<class E>(const E& v) noexcept -> E {
+               LANGULUS_SIMD_VERBOSE("Swapping bytes (Fallback) ", v, " (", NameOf<E>(), ")");
+               return ByteSwapScalar(v);
+            }
+         );
+      }
+
+   } // namespace Langulus::SIMD::Inner
+
+   LANGULUS_SIMD_ARITHMETHIC_UNARY_API(ByteSwap)
+
+} // namespace Langulus::SIMD
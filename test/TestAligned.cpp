@@ -0,0 +1,81 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <cstdint>
+
+
+TEMPLATE_TEST_CASE("Aligned storage", "[aligned]",
+   ::std::int8_t, ::std::uint16_t, ::std::int32_t, float, ::std::int64_t, double
+) {
+   using T = TestType;
+
+   GIVEN("Buffers from the aligned allocator") {
+      SIMD::AlignedAllocator<T> allocator;
+      for (Count count : {1, 3, 16, 17, 1000}) {
+         T* buffer = allocator.allocate(count);
+         REQUIRE(reinterpret_cast<::std::uintptr_t>(buffer) % Alignment == 0);
+         allocator.deallocate(buffer, count);
+      }
+
+      SIMD::AlignedAllocator<T, 128> wide;
+      T* buffer = wide.allocate(5);
+      REQUIRE(reinterpret_cast<::std::uintptr_t>(buffer) % 128 == 0);
+      wide.deallocate(buffer, 5);
+   }
+
+   GIVEN("An aligned vector") {
+      SIMD::AlignedVector<T> data;
+      for (int i = 0; i < 1000; ++i) {
+         data.push_back(static_cast<T>(i % 100));
+         REQUIRE(reinterpret_cast<::std::uintptr_t>(data.data()) % Alignment == 0);
+      }
+
+      // Bulk routines take aligned vectors as any other span           
+      SIMD::AlignedVector<double> converted(data.size());
+      SIMD::Convert(data, converted);
+      for (Offset i = 0; i < data.size(); ++i)
+         REQUIRE(converted[i] == static_cast<double>(data[i]));
+   }
+
+   GIVEN("Aligned arrays") {
+      constexpr Count N = SIMD::WidestRegisterSize / sizeof(T) > 1 ? SIMD::WidestRegisterSize / sizeof(T) : 2;
+      static_assert(alignof(SIMD::AlignedArray<T, N>) == (sizeof(T) * N < Alignment ? sizeof(T) * N : Alignment));
+      static_assert(alignof(SIMD::AlignedArray<T, 3>) >= alignof(T));
+      static_assert(CountOf<SIMD::AlignedArray<T, N>> == N);
+      static_assert(CT::Exact<TypeOf<SIMD::AlignedArray<T, N>>, T>);
+
+      SIMD::AlignedArray<T, N> a, b;
+      for (Offset i = 0; i < N; ++i) {
+         a[i] = static_cast<T>(i + 1);
+         b[i] = static_cast<T>(i * 2);
+      }
+
+      #if LANGULUS_SIMD(128BIT)
+         // Registers are loaded from and stored to them directly       
+         SIMD::AlignedArray<T, N> copy;
+         SIMD::Store(SIMD::Load<0>(a), copy);
+         REQUIRE(copy == a);
+      #endif
+
+      #if LANGULUS_SIMD(128BIT)
+         // Or streamed around the caches                               
+         SIMD::AlignedArray<T, N> streamed;
+         SIMD::StreamStore(SIMD::Load<0>(a), streamed.data());
+         SIMD::StreamFence();
+         REQUIRE(streamed == a);
+
+         if constexpr (sizeof(T) < Alignment)
+            REQUIRE_THROWS(SIMD::StreamStore(SIMD::Load<0>(a), streamed.data() + 1));
+      #endif
+
+      SIMD::AlignedArray<T, N> sum;
+      SIMD::Add(a, b, sum);
+      for (Offset i = 0; i < N; ++i)
+         REQUIRE(sum[i] == static_cast<T>(a[i] + b[i]));
+   }
+}
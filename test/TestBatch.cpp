@@ -0,0 +1,301 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+
+
+/// Fill a batch with small non-zero values, that don't overflow any type     
+template<class T>
+some<T> ControlBatch(Count count, int seed) {
+   using E = TypeOf<T>;
+   constexpr Count N = CountOf<T>;
+   some<T> batch(count);
+   for (Offset i = 0; i < count; ++i) {
+      auto* flat = reinterpret_cast<E*>(&batch[i]);
+      for (Offset c = 0; c < N; ++c)
+         flat[c] = static_cast<E>((i * N + c) * seed % 11 + 1);
+   }
+   return batch;
+}
+
+TEMPLATE_TEST_CASE("Batched operations", "[batch]"
+   , (Vector<float, 4>), (Vector<float, 3>), (Vector<double, 2>)
+   , (Vector<::std::int32_t, 4>), (Vector<::std::int16_t, 3>)
+   , (Vector<::std::uint8_t, 4>), (Vector<::std::int64_t, 2>)
+   , float, ::std::uint16_t
+) {
+   using T = TestType;
+   constexpr Count N = CountOf<T>;
+
+   for (Count count : {0, 1, 5, 16, 33, 100}) {
+      GIVEN("Two batches of " + std::to_string(count)) {
+         const auto lhs = ControlBatch<T>(count, 7);
+         const auto rhs = ControlBatch<T>(count, 3);
+         some<T> out(count, T {TypeOf<T> {0}});
+         some<SIMD::Bitmask<N>> mask(count);
+
+         WHEN("Added") {
+            SIMD::Batch::Add(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i] == SIMD::Add(lhs[i], rhs[i]));
+         }
+
+         WHEN("Subtracted") {
+            SIMD::Batch::Subtract(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i] == SIMD::Subtract(lhs[i], rhs[i]));
+         }
+
+         WHEN("Multiplied") {
+            SIMD::Batch::Multiply(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i] == SIMD::Multiply(lhs[i], rhs[i]));
+         }
+
+         WHEN("Divided") {
+            SIMD::Batch::Divide(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i] == SIMD::Divide(lhs[i], rhs[i]));
+         }
+
+         WHEN("Maxed") {
+            SIMD::Batch::Max(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i] == SIMD::Max(lhs[i], rhs[i]));
+         }
+
+         WHEN("Compared for equality") {
+            SIMD::Batch::Equals(lhs, lhs, mask);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(mask[i].mValue == SIMD::Bitmask<N>::Mask);
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      GIVEN("A million vectors") {
+         const auto lhs = ControlBatch<T>(1000000, 7);
+         const auto rhs = ControlBatch<T>(1000000, 3);
+         some<T> out(lhs.size(), lhs[0]);
+
+         BENCHMARK_ADVANCED("Add per vector (control)") (timer meter) {
+            meter.measure([&] {
+               for (Offset i = 0; i < lhs.size(); ++i)
+                  SIMD::Add(lhs[i], rhs[i], out[i]);
+            });
+         };
+
+         BENCHMARK_ADVANCED("Add batched") (timer meter) {
+            meter.measure([&] {
+               SIMD::Batch::Add(lhs, rhs, out);
+            });
+         };
+      }
+   #endif
+}
+
+TEMPLATE_TEST_CASE("Batched comparisons", "[batch]"
+   , (Vector<float, 4>), (Vector<float, 3>), (Vector<double, 2>)
+   , (Vector<double, 3>), float
+) {
+   using T = TestType;
+   constexpr Count N = CountOf<T>;
+
+   for (Count count : {0, 1, 5, 16, 33, 100}) {
+      GIVEN("Two batches of " + std::to_string(count)) {
+         const auto lhs = ControlBatch<T>(count, 7);
+         const auto rhs = ControlBatch<T>(count, 3);
+         some<SIMD::Bitmask<N>> mask(count);
+
+         WHEN("Compared for lesser") {
+            SIMD::Batch::Lesser(lhs, rhs, mask);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(mask[i] == SIMD::Lesser(lhs[i], rhs[i]));
+         }
+
+         WHEN("Compared for greater") {
+            SIMD::Batch::Greater(lhs, rhs, mask);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(mask[i] == SIMD::Greater(lhs[i], rhs[i]));
+         }
+
+         WHEN("Compared for greater or equal") {
+            SIMD::Batch::EqualsOrGreater(lhs, rhs, mask);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(mask[i] == SIMD::EqualsOrGreater(lhs[i], rhs[i]));
+         }
+      }
+   }
+}
+
+TEMPLATE_TEST_CASE("Batched operations with prefetching", "[batch]"
+   , (Vector<float, 4>), (Vector<float, 3>), (Vector<::std::uint8_t, 4>)
+   , (Vector<double, 2>), float
+) {
+   using T = TestType;
+   constexpr Count N = CountOf<T>;
+   using SIMD::PrefetchPolicy;
+
+   // Distances well beyond the end of the inputs must not be prefetched
+   for (auto prefetch : {
+      PrefetchPolicy {1, false}, PrefetchPolicy {4, true},
+      PrefetchPolicy {32, false}, PrefetchPolicy {1000, true}
+   }) {
+      for (Count count : {0, 1, 5, 33, 100, 1001}) {
+         const auto lhs = ControlBatch<T>(count, 7);
+         const auto rhs = ControlBatch<T>(count, 3);
+         some<T> out(count, T {TypeOf<T> {0}});
+         some<SIMD::Bitmask<N>> mask(count);
+
+         SIMD::Batch::Add(lhs, rhs, out, prefetch);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i] == SIMD::Add(lhs[i], rhs[i]));
+
+         SIMD::Batch::Equals(lhs, lhs, mask, prefetch);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(mask[i].mValue == SIMD::Bitmask<N>::Mask);
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      GIVEN("A prefetch policy tuned for this machine") {
+         const auto defaults = SIMD::BulkPrefetch;
+         const auto tuned = SIMD::TunePrefetch();
+         REQUIRE(SIMD::BulkPrefetch.mDistance == tuned.mDistance);
+         REQUIRE(SIMD::BulkPrefetch.mNonTemporal == tuned.mNonTemporal);
+
+         const auto lhs = ControlBatch<T>(1000000, 7);
+         const auto rhs = ControlBatch<T>(1000000, 3);
+         some<T> out(lhs.size(), lhs[0]);
+
+         BENCHMARK_ADVANCED("Add batched (no prefetching)") (timer meter) {
+            meter.measure([&] {
+               SIMD::Batch::Add(lhs, rhs, out, PrefetchPolicy {});
+            });
+         };
+
+         BENCHMARK_ADVANCED("Add batched (tuned prefetching)") (timer meter) {
+            meter.measure([&] {
+               SIMD::Batch::Add(lhs, rhs, out, tuned);
+            });
+         };
+
+         SIMD::BulkPrefetch = defaults;
+      }
+   #endif
+}
+
+TEMPLATE_TEST_CASE("Batched operations streamed around the caches", "[batch]"
+   , (Vector<float, 4>), (Vector<float, 3>), (Vector<double, 2>)
+   , (Vector<::std::int16_t, 3>), (Vector<::std::uint8_t, 4>), float
+) {
+   using T = TestType;
+   const T fill {TypeOf<T> {42}};
+
+   // Stream everything, and start the output at all kinds of offsets   
+   // from the alignment of registers                                   
+   const auto threshold = SIMD::StreamThreshold;
+   SIMD::StreamThreshold = 0;
+
+   for (Offset offset : {0, 1, 3, 7}) {
+      for (Count count : {0, 1, 5, 33, 100, 1001}) {
+         const auto lhs = ControlBatch<T>(count, 7);
+         const auto rhs = ControlBatch<T>(count, 3);
+         some<T> out(count + offset + 1, fill);
+
+         SIMD::Batch::Add(lhs, rhs, std::span {out.data() + offset, count});
+         for (Offset i = 0; i < offset; ++i)
+            REQUIRE(out[i] == fill);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i + offset] == SIMD::Add(lhs[i], rhs[i]));
+         REQUIRE(out[count + offset] == fill);
+      }
+   }
+
+   SIMD::StreamThreshold = threshold;
+}
+
+TEMPLATE_TEST_CASE("Batched operations at a preferred width", "[batch]"
+   , (Vector<float, 4>), (Vector<float, 3>), (Vector<double, 3>)
+   , (Vector<::std::int16_t, 3>), (Vector<::std::uint8_t, 4>)
+   , (Vector<::std::int64_t, 2>), float
+) {
+   using T = TestType;
+   constexpr Count N = CountOf<T>;
+   const auto preferred = SIMD::PreferredWidth;
+
+   // Narrowing the registers at runtime must not change any result     
+   for (Count width : {128, 256, 512}) {
+      SIMD::PreferredWidth = width;
+      for (Count count : {0, 1, 5, 33, 100, 1001}) {
+         const auto lhs = ControlBatch<T>(count, 7);
+         const auto rhs = ControlBatch<T>(count, 3);
+         some<T> out(count, T {TypeOf<T> {0}});
+         some<SIMD::Bitmask<N>> mask(count);
+
+         SIMD::Batch::Add(lhs, rhs, out);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i] == SIMD::Add(lhs[i], rhs[i]));
+
+         SIMD::Batch::Multiply(lhs, rhs, out);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i] == SIMD::Multiply(lhs[i], rhs[i]));
+
+         SIMD::Batch::Max(lhs, rhs, out);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i] == SIMD::Max(lhs[i], rhs[i]));
+
+         SIMD::Batch::Equals(lhs, lhs, mask);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(mask[i].mValue == SIMD::Bitmask<N>::Mask);
+      }
+   }
+
+   SIMD::PreferredWidth = preferred;
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      GIVEN("A million vectors") {
+         const auto lhs = ControlBatch<T>(1000000, 7);
+         const auto rhs = ControlBatch<T>(1000000, 3);
+         some<T> out(lhs.size(), lhs[0]);
+         some<SIMD::Bitmask<N>> mask(lhs.size());
+
+         // Each operation is measured in each width, because the best  
+         // one depends on both the operation and the rest of the load  
+         for (Count width : {128, 256, 512}) {
+            SIMD::PreferredWidth = width;
+            const auto bits = std::to_string(width) + "bit";
+
+            BENCHMARK_ADVANCED("Add batched in " + bits) (timer meter) {
+               meter.measure([&] {
+                  SIMD::Batch::Add(lhs, rhs, out);
+               });
+            };
+
+            BENCHMARK_ADVANCED("Multiply batched in " + bits) (timer meter) {
+               meter.measure([&] {
+                  SIMD::Batch::Multiply(lhs, rhs, out);
+               });
+            };
+
+            BENCHMARK_ADVANCED("Max batched in " + bits) (timer meter) {
+               meter.measure([&] {
+                  SIMD::Batch::Max(lhs, rhs, out);
+               });
+            };
+
+            BENCHMARK_ADVANCED("Equals batched in " + bits) (timer meter) {
+               meter.measure([&] {
+                  SIMD::Batch::Equals(lhs, rhs, mask);
+               });
+            };
+         }
+
+         SIMD::PreferredWidth = preferred;
+      }
+   #endif
+}
@@ -0,0 +1,128 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <bit>
+#include <cstring>
+
+
+/// Reverse the bytes of each element conventionally, one byte at a time      
+template<class T>
+T ControlByteSwap(const T& value) {
+   T result = value;
+   if constexpr (CT::Vector<T>) {
+      for (auto& e : result.mArray)
+         e = ControlByteSwap(e);
+   }
+   else {
+      auto bytes = reinterpret_cast<std::byte*>(&result);
+      std::reverse(bytes, bytes + sizeof(T));
+   }
+   return result;
+}
+
+/// Compare bitwise, because swapped reals can end up NaN                     
+template<class T>
+bool SameBytes(const T& a, const T& b) {
+   return std::memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+TEMPLATE_TEST_CASE("Byte swapping", "[byteswap]"
+   , ::std::int8_t, ::std::uint16_t, ::std::int32_t, ::std::uint64_t
+   , char16_t, float, double
+   , (Vector<::std::uint16_t, 3>), (Vector<::std::uint16_t, 16>)
+   , (Vector<::std::int32_t, 4>), (Vector<::std::uint32_t, 16>)
+   , (Vector<::std::uint64_t, 2>), (Vector<::std::int64_t, 8>)
+   , (Vector<float, 8>), (Vector<double, 4>), (Vector<double, 9>)
+) {
+   using T = TestType;
+
+   GIVEN("A value") {
+      T x {};
+      if constexpr (not CT::Vector<T>)
+         InitOne(x, 0x2B);
+      else
+         x = T {};
+
+      WHEN("Bytes are swapped") {
+         const T r = SIMD::ByteSwap(x);
+         REQUIRE(SameBytes(r, ControlByteSwap(x)));
+
+         const T back = SIMD::ByteSwap(r);
+         REQUIRE(SameBytes(back, x));
+      }
+   }
+
+   for (Count count : {0, 1, 3, 8, 17, 100}) {
+      GIVEN("A batch of " + std::to_string(count)) {
+         some<T> data(count);
+         for (auto& v : data)
+            v = ControlByteSwap(T {});
+
+         WHEN("Bytes are swapped") {
+            some<T> out(count);
+            SIMD::Batch::ByteSwap(data, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(SameBytes(out[i], ControlByteSwap(data[i])));
+
+            SIMD::Batch::ByteSwap(out, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(SameBytes(out[i], data[i]));
+         }
+
+         WHEN("Bytes are swapped with prefetching") {
+            some<T> out(count);
+            SIMD::Batch::ByteSwap(data, out, SIMD::PrefetchPolicy {1, false});
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(SameBytes(out[i], ControlByteSwap(data[i])));
+         }
+      }
+   }
+}
+
+TEST_CASE("Byte swapping as constexpr", "[byteswap]") {
+   static_assert(SIMD::ByteSwap(::std::uint16_t {0x1122}) == 0x2211);
+   static_assert(SIMD::ByteSwap(::std::uint32_t {0x11223344}) == 0x44332211);
+   static_assert(SIMD::ByteSwap(::std::uint64_t {0x1122334455667788}) == 0x8877665544332211);
+   static_assert(SIMD::ByteSwap(::std::uint8_t {0x12}) == 0x12);
+}
+
+TEST_CASE("Big-endian buffers", "[byteswap]") {
+   some<::std::uint32_t> data(37);
+   for (Offset i = 0; i < data.size(); ++i)
+      data[i] = static_cast<::std::uint32_t>(0x01020304u * (i + 1));
+   const auto original = data;
+
+   SIMD::ToBigEndian(data);
+   for (Offset i = 0; i < data.size(); ++i) {
+      const auto bytes = reinterpret_cast<const ::std::uint8_t*>(&data[i]);
+      REQUIRE(bytes[0] == ((original[i] >> 24) & 0xFF));
+      REQUIRE(bytes[3] == (original[i] & 0xFF));
+   }
+
+   SIMD::FromBigEndian(data);
+   REQUIRE(data == original);
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<::std::uint64_t> big(1000000);
+      for (Offset i = 0; i < big.size(); ++i)
+         big[i] = i * 0x0102030405060708ull;
+
+      BENCHMARK_ADVANCED("Byte swap (control)") (timer meter) {
+         meter.measure([&] {
+            for (auto& v : big)
+               v = ControlByteSwap(v);
+         });
+      };
+
+      BENCHMARK_ADVANCED("Byte swap (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::FromBigEndian(big);
+         });
+      };
+   #endif
+}
@@ -0,0 +1,130 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <memory>
+#include <random>
+
+
+TEMPLATE_TEST_CASE("Compress and expand by mask", "[compress]",
+   ::std::int8_t, ::std::uint16_t, ::std::int32_t, float, ::std::uint64_t, double
+) {
+   using T = TestType;
+   std::mt19937 gen {17};
+
+   for (Count count : {0, 1, 7, 8, 9, 16, 33, 64, 65, 100, 1000}) {
+      for (unsigned density : {0, 10, 50, 90, 100}) {
+         GIVEN(std::to_string(count) + " elements, " + std::to_string(density) + "% selected") {
+            some<T> data(count);
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(i % 120 + 1);
+
+            some<::std::uint8_t> flags(count);
+            auto bools = std::make_unique<bool[]>(count);
+            some<::std::uint64_t> words((count + 63) / 64);
+            some<T> expected;
+            for (Offset i = 0; i < count; ++i) {
+               flags[i] = gen() % 100 < density;
+               bools[i] = flags[i];
+               if (flags[i]) {
+                  words[i / 64] |= ::std::uint64_t {1} << (i % 64);
+                  expected.push_back(data[i]);
+               }
+            }
+
+            // Outputs exactly as long as needed, so that the last groups
+            // don't fit, and as long as the input                      
+            some<T> exact(expected.size());
+            REQUIRE(SIMD::Compress(data, flags, exact) == expected.size());
+            REQUIRE(exact == expected);
+
+            some<T> wide(count);
+            REQUIRE(SIMD::Compress(data, words, wide) == expected.size());
+            REQUIRE(std::equal(expected.begin(), expected.end(), wide.begin()));
+
+            some<T> fromBools(count);
+            REQUIRE(SIMD::Compress(data, std::span<const bool> {bools.get(), count}, fromBools) == expected.size());
+            REQUIRE(std::equal(expected.begin(), expected.end(), fromBools.begin()));
+
+            // Elements are unique up to 120, so they can be mapped back
+            if (count <= 120) {
+               some<T> picked(count);
+               REQUIRE(SIMD::Compress(data, [&](const T& x) {
+                  return flags[static_cast<Offset>(x) - 1] != 0;
+               }, picked) == expected.size());
+               REQUIRE(std::equal(expected.begin(), expected.end(), picked.begin()));
+            }
+
+            // Expanding back restores the selected places, and the others
+            // are left untouched                                       
+            some<T> back(count, T {0});
+            REQUIRE(SIMD::Expand(exact, flags, back) == expected.size());
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(back[i] == (flags[i] ? data[i] : T {0}));
+
+            some<T> backWords(count, T {0});
+            REQUIRE(SIMD::Expand(data, words, backWords) == expected.size());
+            Offset r = 0;
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(backWords[i] == (flags[i] ? data[r++] : T {0}));
+
+            if (not expected.empty()) {
+               some<T> tooShort(expected.size() - 1);
+               REQUIRE_THROWS(SIMD::Compress(data, flags, tooShort));
+               REQUIRE_THROWS(SIMD::Expand(tooShort, flags, back));
+            }
+         }
+      }
+   }
+
+   GIVEN("A comparison bitmask") {
+      const T data[] {5, 1, 9, 2, 7, 3, 8, 4};
+      SIMD::Bitmask<8> mask;
+      for (Offset i = 0; i < 8; ++i)
+         mask[i] = data[i] > T {4};
+
+      T out[8] {};
+      REQUIRE(SIMD::Compress(data, mask, out) == 4);
+      REQUIRE(out[0] == T {5});
+      REQUIRE(out[1] == T {9});
+      REQUIRE(out[2] == T {7});
+      REQUIRE(out[3] == T {8});
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<T> big(1 << 20);
+      some<::std::uint8_t> flags(big.size());
+      for (Offset i = 0; i < big.size(); ++i) {
+         big[i] = static_cast<T>(gen() % 100);
+         flags[i] = big[i] < T {50};
+      }
+      some<T> out(big.size());
+
+      BENCHMARK_ADVANCED("Compress 1M elements (control)") (timer meter) {
+         meter.measure([&] {
+            Offset w = 0;
+            for (Offset i = 0; i < big.size(); ++i) {
+               if (flags[i])
+                  out[w++] = big[i];
+            }
+            return w;
+         });
+      };
+
+      BENCHMARK_ADVANCED("Compress 1M elements (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::Compress(big, flags, out);
+         });
+      };
+
+      BENCHMARK_ADVANCED("Compress 1M elements by predicate (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::Compress(big, [](const T& x) { return x < T {50}; }, out);
+         });
+      };
+   #endif
+}
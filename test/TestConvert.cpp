@@ -0,0 +1,361 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+template<class F, class T>
+struct Conversion {
+   using From = F;
+   using To = T;
+};
+
+TEMPLATE_TEST_CASE("Convert arrays", "[convert]",
+   (Conversion<::std::int8_t, float>),
+   (Conversion<::std::uint8_t, float>),
+   (Conversion<::std::int16_t, double>),
+   (Conversion<::std::uint16_t, ::std::int32_t>),
+   (Conversion<::std::uint32_t, float>),
+   (Conversion<::std::uint32_t, double>),
+   (Conversion<::std::int32_t, ::std::int8_t>),
+   (Conversion<::std::int8_t, ::std::int64_t>),
+   (Conversion<::std::uint32_t, ::std::uint64_t>),
+   (Conversion<::std::int64_t, ::std::int16_t>),
+   (Conversion<::std::uint64_t, ::std::uint8_t>),
+   (Conversion<::std::int16_t, ::std::uint8_t>),
+   (Conversion<float, double>),
+   (Conversion<double, float>),
+   (Conversion<float, ::std::int16_t>),
+   (Conversion<double, ::std::int32_t>),
+   (Conversion<float, ::std::uint32_t>),
+   (Conversion<::std::int64_t, double>)
+) {
+   using FROM = typename TestType::From;
+   using TO = typename TestType::To;
+   std::mt19937_64 gen {23};
+
+   // Reals are kept in the range of integers they're converted to,     
+   // anything else is fair game                                        
+   const auto random = [&] {
+      if constexpr (CT::Real<FROM> and CT::Integer<TO>) {
+         const auto lo = static_cast<double>(std::numeric_limits<TO>::lowest());
+         const auto hi = static_cast<double>(std::numeric_limits<TO>::max());
+         return static_cast<FROM>(lo + (hi - lo) * std::uniform_real_distribution<double> {0.0, 0.999}(gen));
+      }
+      else if constexpr (CT::Real<FROM>)
+         return static_cast<FROM>(std::uniform_real_distribution<double> {-1e6, 1e6}(gen) / 3.0);
+      else
+         return static_cast<FROM>(gen());
+   };
+
+   for (Count count : {0, 1, 3, 4, 8, 15, 16, 17, 33, 64, 100, 1001}) {
+      GIVEN(std::to_string(count) + " elements") {
+         some<FROM> in(count);
+         for (auto& x : in)
+            x = random();
+
+         if constexpr (CT::Integer<FROM>) {
+            if (count > 2) {
+               in[0] = std::numeric_limits<FROM>::max();
+               in[1] = std::numeric_limits<FROM>::lowest();
+            }
+         }
+
+         some<TO> out(count + 1, TO {42});
+         SIMD::Convert(in, out);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i] == static_cast<TO>(in[i]));
+         REQUIRE(out[count] == TO {42});
+
+         if (count) {
+            some<TO> tooShort(count - 1);
+            REQUIRE_THROWS(SIMD::Convert(in, tooShort));
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<FROM> big(1 << 20);
+      for (auto& x : big)
+         x = random();
+      some<TO> out(big.size());
+
+      BENCHMARK_ADVANCED("Convert 1M elements (control)") (timer meter) {
+         meter.measure([&] {
+            for (Offset i = 0; i < big.size(); ++i)
+               out[i] = static_cast<TO>(big[i]);
+            return out[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Convert 1M elements (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Convert(big, out);
+            return out[0];
+         });
+      };
+   #endif
+}
+
+TEMPLATE_TEST_CASE("Convert arrays with streaming stores", "[convert]",
+   (Conversion<::std::int32_t, float>),
+   (Conversion<::std::uint32_t, double>),
+   (Conversion<float, ::std::int8_t>),
+   (Conversion<::std::int16_t, ::std::uint16_t>),
+   (Conversion<double, float>),
+   (Conversion<::std::int8_t, ::std::int64_t>)
+) {
+   using FROM = typename TestType::From;
+   using TO = typename TestType::To;
+
+   // Stream everything, and start the output at all kinds of offsets   
+   // from the alignment of registers                                   
+   const auto threshold = SIMD::StreamThreshold;
+   SIMD::StreamThreshold = 0;
+
+   for (Offset offset : {0, 1, 3, 7}) {
+      for (Count count : {0, 1, 15, 64, 100, 1001}) {
+         some<FROM> in(count);
+         for (Offset i = 0; i < count; ++i)
+            in[i] = static_cast<FROM>(static_cast<int>(i % 200) - 100);
+
+         some<TO> out(count + offset + 1, TO {42});
+         SIMD::Convert(in, std::span {out.data() + offset, count});
+         for (Offset i = 0; i < offset; ++i)
+            REQUIRE(out[i] == TO {42});
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i + offset] == static_cast<TO>(in[i]));
+         REQUIRE(out[count + offset] == TO {42});
+      }
+   }
+
+   SIMD::StreamThreshold = threshold;
+}
+
+/// Convert a number by policy, as a reference                                
+template<SIMD::ConvertPolicy P, class TO, class FROM>
+TO ControlConvert(FROM x) {
+   using SIMD::ConvertPolicy;
+   constexpr auto bits = static_cast<unsigned>(P);
+   long double v = static_cast<long double>(x);
+   if constexpr (CT::Real<FROM>) {
+      if ((bits & 6) == static_cast<unsigned>(ConvertPolicy::RoundNearest))
+         v = std::nearbyint(v);
+      else if ((bits & 6) == static_cast<unsigned>(ConvertPolicy::Floor))
+         v = std::floor(v);
+      else if ((bits & 6) == static_cast<unsigned>(ConvertPolicy::Ceil))
+         v = std::ceil(v);
+      else
+         v = std::trunc(v);
+   }
+
+   if (bits & 1) {
+      if (v != v)
+         return TO {0};
+      v = std::clamp(v,
+         static_cast<long double>(std::numeric_limits<TO>::lowest()),
+         static_cast<long double>(std::numeric_limits<TO>::max()));
+   }
+   return static_cast<TO>(v);
+}
+
+TEMPLATE_TEST_CASE("Convert arrays by policy", "[convert]",
+   (Conversion<float, ::std::int8_t>),
+   (Conversion<float, ::std::uint8_t>),
+   (Conversion<float, ::std::int16_t>),
+   (Conversion<float, ::std::int32_t>),
+   (Conversion<double, ::std::int32_t>),
+   (Conversion<double, ::std::uint16_t>),
+   (Conversion<float, ::std::uint32_t>),
+   (Conversion<::std::int32_t, ::std::int8_t>),
+   (Conversion<::std::uint32_t, ::std::int16_t>),
+   (Conversion<::std::uint32_t, ::std::int32_t>),
+   (Conversion<::std::int16_t, ::std::uint8_t>),
+   (Conversion<::std::uint16_t, ::std::int8_t>),
+   (Conversion<::std::int8_t, ::std::uint32_t>),
+   (Conversion<::std::int32_t, ::std::uint64_t>),
+   (Conversion<::std::int64_t, ::std::int32_t>)
+) {
+   using FROM = typename TestType::From;
+   using TO = typename TestType::To;
+   using SIMD::ConvertPolicy;
+   std::mt19937_64 gen {29};
+
+   // Reals go well beyond the range of the output, but not beyond the  
+   // range of 32bit integers, unless saturated                         
+   const auto random = [&](bool saturated) {
+      if constexpr (CT::Real<FROM>) {
+         const auto r = gen() % 50;
+         if (saturated and r == 0)
+            return std::numeric_limits<FROM>::quiet_NaN();
+         if (saturated and r == 1)
+            return std::numeric_limits<FROM>::infinity();
+         if (saturated and r == 2)
+            return -std::numeric_limits<FROM>::infinity();
+         if (saturated and r == 3)
+            return static_cast<FROM>(1e20);
+         if (r < 10) {
+            // Exactly between two integers                             
+            return static_cast<FROM>(static_cast<int>(gen() % 200) - 100) + FROM {0.5};
+         }
+
+         const double range = saturated
+            ? 3.0 * static_cast<double>(std::numeric_limits<TO>::max())
+            : static_cast<double>(std::numeric_limits<TO>::max());
+         const double lo = std::is_signed_v<TO> or saturated ? -range : 0.0;
+         return static_cast<FROM>(std::uniform_real_distribution<double> {lo, range}(gen));
+      }
+      else return static_cast<FROM>(gen());
+   };
+
+   const auto check = [&]<ConvertPolicy P>() {
+      constexpr bool saturated = static_cast<unsigned>(P) & 1;
+      for (Count count : {0, 1, 7, 16, 17, 33, 100, 1001}) {
+         some<FROM> in(count);
+         for (auto& x : in)
+            x = random(saturated);
+         if constexpr (CT::Real<FROM> and not saturated) {
+            // Without saturation, reals must fit                       
+            for (auto& x : in) {
+               if (x >= static_cast<FROM>(std::numeric_limits<TO>::max()) or x < FROM {0} and not std::is_signed_v<TO>)
+                  x = FROM {1.5};
+               if (x <= static_cast<FROM>(std::numeric_limits<TO>::lowest()))
+                  x = FROM {-1.5} * (std::is_signed_v<TO> ? 1 : -1);
+            }
+         }
+
+         some<TO> out(count);
+         SIMD::Convert<P>(in, out);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(out[i] == ControlConvert<P, TO>(in[i]));
+      }
+   };
+
+   check.template operator()<ConvertPolicy::Saturate>();
+   check.template operator()<ConvertPolicy::Saturate | ConvertPolicy::RoundNearest>();
+   check.template operator()<ConvertPolicy::Saturate | ConvertPolicy::Floor>();
+   check.template operator()<ConvertPolicy::Saturate | ConvertPolicy::Ceil>();
+   if constexpr (CT::Real<FROM>) {
+      check.template operator()<ConvertPolicy::RoundNearest>();
+      check.template operator()<ConvertPolicy::Floor>();
+      check.template operator()<ConvertPolicy::Ceil>();
+   }
+}
+
+#if LANGULUS_SIMD(128BIT)
+TEMPLATE_TEST_CASE("Convert registers by policy", "[convert]",
+   (Conversion<float, ::std::int8_t>),
+   (Conversion<float, ::std::uint16_t>),
+   (Conversion<float, ::std::int32_t>),
+   (Conversion<float, ::std::uint32_t>),
+   (Conversion<double, ::std::uint8_t>),
+   (Conversion<double, ::std::int32_t>),
+   (Conversion<double, ::std::int64_t>),
+   (Conversion<double, ::std::uint64_t>),
+   (Conversion<::std::int32_t, ::std::uint8_t>),
+   (Conversion<::std::uint16_t, ::std::int8_t>),
+   (Conversion<::std::int16_t, ::std::uint32_t>),
+   (Conversion<::std::int64_t, ::std::int16_t>),
+   (Conversion<::std::uint32_t, ::std::int32_t>)
+) {
+   using FROM = typename TestType::From;
+   using TO = typename TestType::To;
+   using SIMD::ConvertPolicy;
+   std::mt19937_64 gen {31};
+
+   // A 128bit register of inputs, of which only as many are converted  
+   // as fit in a 128bit register of the bigger type                    
+   constexpr Count N = 16 / sizeof(FROM);
+   constexpr Count M = 16 / (sizeof(FROM) > sizeof(TO) ? sizeof(FROM) : sizeof(TO));
+
+   const auto random = [&] {
+      if constexpr (CT::Real<FROM>) {
+         const auto r = gen() % 20;
+         if (r == 0)
+            return std::numeric_limits<FROM>::quiet_NaN();
+         if (r == 1)
+            return static_cast<FROM>(1e20);
+         if (r < 5)
+            return static_cast<FROM>(static_cast<int>(gen() % 200) - 100) + FROM {0.5};
+
+         const auto range = 3.0 * static_cast<double>(std::numeric_limits<TO>::max());
+         return static_cast<FROM>(std::uniform_real_distribution<double> {-range, range}(gen));
+      }
+      else return static_cast<FROM>(gen());
+   };
+
+   const auto check = [&]<ConvertPolicy P>() {
+      for (int repeat = 0; repeat < 100; ++repeat) {
+         FROM in[N];
+         for (auto& x : in)
+            x = random();
+
+         TO out[M];
+         SIMD::Convert<P>(SIMD::Load<0>(in), out);
+         for (Offset i = 0; i < M; ++i) {
+            if constexpr (static_cast<unsigned>(P) & 1)
+               REQUIRE(out[i] == ControlConvert<P, TO>(in[i]));
+            else
+               REQUIRE(out[i] == static_cast<TO>(in[i]));
+         }
+      }
+   };
+
+   check.template operator()<ConvertPolicy::Saturate>();
+   check.template operator()<ConvertPolicy::Saturate | ConvertPolicy::RoundNearest>();
+   check.template operator()<ConvertPolicy::Saturate | ConvertPolicy::Floor>();
+   check.template operator()<ConvertPolicy::Saturate | ConvertPolicy::Ceil>();
+   if constexpr (CT::Integer<FROM>)
+      check.template operator()<ConvertPolicy::Wrap>();
+}
+#endif
+
+#if LANGULUS_SIMD(128BIT)
+TEST_CASE("Convert into registers, padded with a default value", "[convert]") {
+   using SIMD::ConvertPolicy;
+   const ::std::int32_t in[2] {-3, 300};
+
+   WHEN("Converted to floats") {
+      auto out = SIMD::V128<float>::Zero();
+      SIMD::Convert<7>(in, out);
+
+      float lanes[4];
+      SIMD::Store(out, lanes);
+      REQUIRE(lanes[0] == -3.0f);
+      REQUIRE(lanes[1] == 300.0f);
+      REQUIRE(lanes[2] == 7.0f);
+      REQUIRE(lanes[3] == 7.0f);
+   }
+
+   WHEN("Converted to saturated 8bit integers") {
+      auto out = SIMD::V128<::std::uint8_t>::Zero();
+      SIMD::Convert<100, ConvertPolicy::Saturate>(in, out);
+
+      ::std::uint8_t lanes[4];
+      SIMD::Store(out, lanes);
+      REQUIRE(lanes[0] == 0);
+      REQUIRE(lanes[1] == 255);
+      REQUIRE(lanes[2] == 100);
+      REQUIRE(lanes[3] == 100);
+   }
+
+   WHEN("Converted by policy, without a default value") {
+      auto out = SIMD::V128<float>::Zero();
+      SIMD::Convert<ConvertPolicy::Saturate>(in, out);
+
+      float lanes[4];
+      SIMD::Store(out, lanes);
+      REQUIRE(lanes[0] == -3.0f);
+      REQUIRE(lanes[1] == 300.0f);
+      REQUIRE(lanes[2] == 0.0f);
+      REQUIRE(lanes[3] == 0.0f);
+   }
+}
+#endif
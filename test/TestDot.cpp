@@ -0,0 +1,126 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <random>
+
+
+/// Dot product one element at a time, wrapping around in 32bit               
+template<class A, class B>
+::std::int32_t ControlDot(const A* a, const B* b, Count n) {
+   ::std::uint32_t sum = 0;
+   for (Offset i = 0; i < n; ++i)
+      sum += static_cast<::std::uint32_t>(static_cast<::std::int32_t>(a[i]) * static_cast<::std::int32_t>(b[i]));
+   return static_cast<::std::int32_t>(sum);
+}
+
+TEST_CASE("Quantized dot products", "[dot]") {
+   std::mt19937 gen {31};
+
+   for (Count count : {0, 1, 7, 8, 15, 16, 31, 32, 63, 64, 65, 100, 1000, 4099}) {
+      GIVEN(std::to_string(count) + " elements") {
+         some<::std::uint8_t> u8(count);
+         some<::std::int8_t> i8(count);
+         some<::std::int16_t> a16(count), b16(count);
+
+         WHEN("Random") {
+            for (Offset i = 0; i < count; ++i) {
+               u8[i] = static_cast<::std::uint8_t>(gen());
+               i8[i] = static_cast<::std::int8_t>(gen());
+               a16[i] = static_cast<::std::int16_t>(gen());
+               b16[i] = static_cast<::std::int16_t>(gen());
+            }
+         }
+
+         WHEN("Extremes, that saturate pmaddubsw and overflow pmaddwd") {
+            for (Offset i = 0; i < count; ++i) {
+               u8[i] = 255;
+               i8[i] = i % 3 ? 127 : -128;
+               a16[i] = -32768;
+               b16[i] = -32768;
+            }
+         }
+
+         REQUIRE(SIMD::DotU8I8(u8, i8) == ControlDot(u8.data(), i8.data(), count));
+         REQUIRE(SIMD::DotI16(a16, b16) == ControlDot(a16.data(), b16.data(), count));
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<::std::uint8_t> u8(1 << 20);
+      some<::std::int8_t> i8(u8.size());
+      for (Offset i = 0; i < u8.size(); ++i) {
+         u8[i] = static_cast<::std::uint8_t>(gen());
+         i8[i] = static_cast<::std::int8_t>(gen());
+      }
+
+      BENCHMARK_ADVANCED("DotU8I8 of 1M bytes (control)") (timer meter) {
+         meter.measure([&] {
+            return ControlDot(u8.data(), i8.data(), u8.size());
+         });
+      };
+
+      BENCHMARK_ADVANCED("DotU8I8 of 1M bytes (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::DotU8I8(u8, i8);
+         });
+      };
+   #endif
+}
+
+TEST_CASE("Quantized matrix-vector product", "[dot]") {
+   std::mt19937 gen {13};
+
+   for (Count rows : {1, 3, 4, 5, 8, 13}) {
+      for (Count cols : {0, 1, 17, 64, 100, 257}) {
+         GIVEN(std::to_string(rows) + "x" + std::to_string(cols) + " matrix") {
+            some<::std::int8_t> matrix(rows * cols);
+            some<::std::uint8_t> x(cols);
+            some<float> scales(rows);
+            for (auto& m : matrix)
+               m = static_cast<::std::int8_t>(gen());
+            for (auto& v : x)
+               v = static_cast<::std::uint8_t>(gen());
+            for (Offset r = 0; r < rows; ++r)
+               scales[r] = 0.5f + static_cast<float>(r) / 8;
+
+            some<float> y(rows);
+            SIMD::GemvU8I8(matrix, x, scales, y);
+            for (Offset r = 0; r < rows; ++r) {
+               const auto dot = ControlDot(x.data(), matrix.data() + r * cols, cols);
+               REQUIRE(y[r] == scales[r] * static_cast<float>(dot));
+            }
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      constexpr Count rows = 1024, cols = 768;
+      some<::std::int8_t> matrix(rows * cols);
+      some<::std::uint8_t> x(cols);
+      some<float> scales(rows, 0.01f), y(rows);
+      for (auto& m : matrix)
+         m = static_cast<::std::int8_t>(gen());
+      for (auto& v : x)
+         v = static_cast<::std::uint8_t>(gen());
+
+      BENCHMARK_ADVANCED("GemvU8I8 1024x768 (control)") (timer meter) {
+         meter.measure([&] {
+            for (Offset r = 0; r < rows; ++r)
+               y[r] = scales[r] * static_cast<float>(ControlDot(x.data(), matrix.data() + r * cols, cols));
+            return y[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("GemvU8I8 1024x768 (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::GemvU8I8(matrix, x, scales, y);
+            return y[0];
+         });
+      };
+   #endif
+}
@@ -0,0 +1,147 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <cmath>
+#include <limits>
+
+
+/// Floats that cover normals, subnormals, ties, overflow and specials        
+some<float> ControlFloats(Count count) {
+   constexpr float specials[] {
+      0.0f, -0.0f, 1.0f, -1.0f, 0.1f, 65504.0f, 65519.0f, 65520.0f, 1e10f,
+      5.9604645e-8f, 2.9802322e-8f, 1e-10f, 1.00048828125f, 1.00146484375f,
+      1.00390625f, 1.01171875f, std::numeric_limits<float>::infinity(),
+      -std::numeric_limits<float>::infinity()
+   };
+
+   some<float> result(count);
+   for (Offset i = 0; i < count; ++i) {
+      if (i < std::size(specials))
+         result[i] = specials[i];
+      else
+         result[i] = static_cast<float>(int(i * 7919 % 2001) - 1000) / 7.0f;
+   }
+   return result;
+}
+
+TEST_CASE("Half-precision scalars", "[half]") {
+   using SIMD::Float16;
+   using SIMD::BFloat16;
+
+   WHEN("Narrowing floats to Float16") {
+      REQUIRE(Float16 {1.0f}.mBits == 0x3C00);
+      REQUIRE(Float16 {-2.0f}.mBits == 0xC000);
+      REQUIRE(Float16 {0.1f}.mBits == 0x2E66);
+      REQUIRE(Float16 {65504.0f}.mBits == 0x7BFF);
+      REQUIRE(Float16 {65520.0f}.mBits == 0x7C00);
+      REQUIRE(Float16 {5.9604645e-8f}.mBits == 0x0001);
+      REQUIRE(Float16 {1e-10f}.mBits == 0x0000);
+      REQUIRE(Float16 {1.00048828125f}.mBits == 0x3C00);
+      REQUIRE(Float16 {1.00146484375f}.mBits == 0x3C02);
+      REQUIRE(Float16 {std::numeric_limits<float>::quiet_NaN()}.mBits == 0x7E00);
+   }
+
+   WHEN("Narrowing floats to BFloat16") {
+      REQUIRE(BFloat16 {1.0f}.mBits == 0x3F80);
+      REQUIRE(BFloat16 {-2.0f}.mBits == 0xC000);
+      REQUIRE(BFloat16 {1.00390625f}.mBits == 0x3F80);
+      REQUIRE(BFloat16 {1.01171875f}.mBits == 0x3F82);
+      REQUIRE(std::isnan(float(BFloat16 {std::numeric_limits<float>::quiet_NaN()})));
+   }
+
+   WHEN("Every Float16 is widened and narrowed back") {
+      for (unsigned bits = 0; bits < 65536; ++bits) {
+         const auto h = Float16::FromBits(static_cast<std::uint16_t>(bits));
+         const float f = h;
+         if (std::isnan(f))
+            REQUIRE(std::isnan(float(Float16 {f})));
+         else
+            REQUIRE(Float16 {f}.mBits == bits);
+      }
+   }
+
+   WHEN("Half-precision scalars are added") {
+      const auto sum = Float16 {1.5f} + BFloat16 {2.25f};
+      static_assert(CT::Exact<decltype(sum), const float>);
+      REQUIRE(sum == 3.75f);
+   }
+}
+
+TEMPLATE_TEST_CASE("Half-precision bulk conversion", "[half]"
+   , SIMD::Float16, SIMD::BFloat16
+) {
+   using T = TestType;
+
+   for (Count count : {0, 1, 3, 4, 7, 8, 9, 17, 100, 1000}) {
+      GIVEN(std::to_string(count) + " floats") {
+         const auto floats = ControlFloats(count);
+
+         WHEN("Narrowed and widened back") {
+            some<T> halves(count);
+            SIMD::FloatToHalf(floats, halves);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(halves[i].mBits == T {floats[i]}.mBits);
+
+            some<float> back(count);
+            SIMD::HalfToFloat(halves, back);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(back[i] == float(halves[i]));
+         }
+
+         WHEN("Half-precision batches are added and multiplied") {
+            some<T> lhs(count), rhs(count), out(count);
+            for (Offset i = 0; i < count; ++i) {
+               lhs[i] = T {floats[i]};
+               rhs[i] = T {floats[count - i - 1]};
+            }
+
+            SIMD::Batch::Add(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i].mBits == T {lhs[i] + rhs[i]}.mBits);
+
+            SIMD::Batch::Multiply(lhs, rhs, out);
+            for (Offset i = 0; i < count; ++i)
+               REQUIRE(out[i].mBits == T {lhs[i] * rhs[i]}.mBits);
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      GIVEN("A million halves") {
+         const auto floats = ControlFloats(1000000);
+         some<T> halves(floats.size());
+         some<float> back(floats.size());
+
+         BENCHMARK_ADVANCED("Narrow (control)") (timer meter) {
+            meter.measure([&] {
+               for (Offset i = 0; i < floats.size(); ++i)
+                  halves[i] = T {floats[i]};
+            });
+         };
+
+         BENCHMARK_ADVANCED("Narrow (SIMD)") (timer meter) {
+            meter.measure([&] {
+               SIMD::FloatToHalf(floats, halves);
+            });
+         };
+
+         BENCHMARK_ADVANCED("Widen (control)") (timer meter) {
+            meter.measure([&] {
+               for (Offset i = 0; i < floats.size(); ++i)
+                  back[i] = halves[i];
+            });
+         };
+
+         BENCHMARK_ADVANCED("Widen (SIMD)") (timer meter) {
+            meter.measure([&] {
+               SIMD::HalfToFloat(halves, back);
+            });
+         };
+      }
+   #endif
+}
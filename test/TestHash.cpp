@@ -0,0 +1,210 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <cstring>
+#include <string>
+#include <string_view>
+
+
+/// Generate some pseudo-random bytes                                         
+some<::std::uint8_t> MakeBytes(Count count, unsigned seed) {
+   some<::std::uint8_t> result(count);
+   for (auto& byte : result) {
+      seed = seed * 1103515245u + 12345u;
+      byte = static_cast<::std::uint8_t>(seed >> 16);
+   }
+   return result;
+}
+
+/// Compute CRC32C a bit at a time, as a reference                            
+::std::uint32_t ControlCrc32c(const ::std::uint8_t* p, Count count, ::std::uint32_t crc = 0) {
+   crc = ~crc;
+   for (Offset i = 0; i < count; ++i) {
+      crc ^= p[i];
+      for (int bit = 0; bit < 8; ++bit)
+         crc = (crc >> 1) ^ (0x82F63B78u & (0u - (crc & 1)));
+   }
+   return ~crc;
+}
+
+/// Compute Hash64 one lane at a time, as a reference                         
+::std::uint64_t ControlHash64(const ::std::uint8_t* p, Count count, ::std::uint64_t seed) {
+   using namespace SIMD::Inner;
+   ::std::uint64_t secret[HashSecretWords];
+   for (Offset i = 0; i < HashSecretWords; ++i)
+      secret[i] = DefaultHashSecret[i] + (i % 2 ? 0 - seed : seed);
+
+   ::std::uint64_t acc[HashLanes] {
+      HashPrime32[2], HashPrime64[0], HashPrime64[1], HashPrime64[2],
+      HashPrime64[3], HashPrime32[1], HashPrime64[4], HashPrime32[0]
+   };
+
+   // Zero-pad the input to a whole number of stripes                   
+   const Count stripes = (count + HashStripe - 1) / HashStripe;
+   some<::std::uint64_t> data(stripes * HashLanes);
+   if (count)
+      std::memcpy(data.data(), p, count);
+
+   for (Offset s = 0; s < stripes; ++s) {
+      const Offset first = s % HashBlockStripes;
+      HashStripeScalar(acc, data.data() + s * HashLanes, secret + first);
+      if (first + 1 == HashBlockStripes)
+         HashScrambleScalar(acc, secret + HashBlockStripes);
+   }
+
+   ::std::uint64_t result = count * HashPrime64[0] ^ seed;
+   for (Offset i = 0; i < HashLanes; i += 2) {
+      result += MultiplyFold64(
+         acc[i]     ^ DefaultHashSecret[HashLanes + i],
+         acc[i + 1] ^ DefaultHashSecret[HashLanes + i + 1]
+      );
+   }
+   result ^= result >> 37;
+   result *= 0x165667919E3779F9ull;
+   return result ^ (result >> 32);
+}
+
+TEST_CASE("CRC32C", "[hash]") {
+   GIVEN("Known check values") {
+      REQUIRE(SIMD::Crc32c(std::string_view {""}) == 0);
+      REQUIRE(SIMD::Crc32c(std::string_view {"123456789"}) == 0xE3069283u);
+
+      some<::std::uint8_t> bytes(32, 0);
+      REQUIRE(SIMD::Crc32c(bytes) == 0x8A9136AAu);
+      std::fill(bytes.begin(), bytes.end(), ::std::uint8_t {0xFF});
+      REQUIRE(SIMD::Crc32c(bytes) == 0x62A8AB43u);
+      for (Offset i = 0; i < bytes.size(); ++i)
+         bytes[i] = static_cast<::std::uint8_t>(i);
+      REQUIRE(SIMD::Crc32c(bytes) == 0x46DD794Eu);
+   }
+
+   for (Count count : {1, 3, 7, 8, 9, 15, 16, 17, 63, 64, 65, 1000}) {
+      GIVEN(std::to_string(count) + " random bytes") {
+         const auto bytes = MakeBytes(count, static_cast<unsigned>(count));
+         const std::span all {bytes};
+
+         REQUIRE(SIMD::Crc32c(all) == ControlCrc32c(bytes.data(), count));
+
+         // Computing in parts must give the same result                
+         for (Offset split : {Offset {0}, count / 3, count - 1}) {
+            const auto first = SIMD::Crc32c(all.first(split));
+            REQUIRE(SIMD::Crc32c(all.subspan(split), first) == SIMD::Crc32c(all));
+         }
+      }
+   }
+}
+
+TEST_CASE("Streaming 64bit hash", "[hash]") {
+   for (Count count : {0, 1, 7, 8, 31, 63, 64, 65, 127, 128, 200, 1023, 1024, 1025, 3000, 5000}) {
+      GIVEN(std::to_string(count) + " random bytes") {
+         const auto bytes = MakeBytes(count, static_cast<unsigned>(count) + 1);
+
+         WHEN("Hashed") {
+            for (::std::uint64_t seed : {0ull, 1ull, 0xDEADBEEFCAFEBABEull}) {
+               const auto h = SIMD::Hash64(bytes, seed);
+               REQUIRE(h == ControlHash64(bytes.data(), count, seed));
+               REQUIRE(h == SIMD::Hash64(bytes, seed));
+            }
+            REQUIRE(SIMD::Hash64(bytes, 0) != SIMD::Hash64(bytes, 1));
+         }
+
+         WHEN("A single bit changes") {
+            if (count) {
+               auto changed = bytes;
+               changed[count / 2] ^= 1;
+               REQUIRE(SIMD::Hash64(changed) != SIMD::Hash64(bytes));
+            }
+         }
+
+         WHEN("A trailing zero is appended") {
+            auto longer = bytes;
+            longer.push_back(0);
+            REQUIRE(SIMD::Hash64(longer) != SIMD::Hash64(bytes));
+         }
+      }
+   }
+
+   REQUIRE(SIMD::Hash64(std::string_view {"hello"}) == SIMD::Hash64(std::u8string_view {u8"hello"}));
+   REQUIRE(SIMD::Hash64(std::string_view {"hello"}) != SIMD::Hash64(std::string_view {"hellp"}));
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      const auto big = MakeBytes(10000000, 1);
+
+      BENCHMARK_ADVANCED("Hash64 of 10MB (control)") (timer meter) {
+         meter.measure([&] {
+            return ControlHash64(big.data(), big.size(), 0);
+         });
+      };
+
+      BENCHMARK_ADVANCED("Hash64 of 10MB (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::Hash64(big);
+         });
+      };
+
+      BENCHMARK_ADVANCED("Crc32c of 10MB (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::Crc32c(big);
+         });
+      };
+   #endif
+}
+
+TEMPLATE_TEST_CASE("Hashing integers", "[hash]", ::std::uint32_t, ::std::int32_t, ::std::uint64_t, ::std::int64_t) {
+   using T = TestType;
+   using U = std::make_unsigned_t<T>;
+
+   for (Count count : {0, 1, 3, 4, 5, 15, 16, 17, 33, 100}) {
+      GIVEN(std::to_string(count) + " integers") {
+         some<T> in(count);
+         for (Offset i = 0; i < count; ++i)
+            in[i] = static_cast<T>((i + 1) * 0x9E3779B97F4A7C15ull);
+
+         for (::std::uint64_t seed : {0ull, 42ull}) {
+            some<T> out(count);
+            SIMD::HashIntegers(in, out, seed);
+            for (Offset i = 0; i < count; ++i) {
+               const auto expected = SIMD::Inner::HashInteger(
+                  static_cast<U>(static_cast<U>(in[i]) ^ static_cast<U>(seed)));
+               REQUIRE(static_cast<U>(out[i]) == expected);
+            }
+
+            // Hashing in place must give the same result               
+            auto inplace = in;
+            SIMD::HashIntegers(inplace, inplace, seed);
+            REQUIRE(inplace == out);
+         }
+      }
+   }
+
+   // The finalizers are bijections, so zero stays zero                 
+   REQUIRE(SIMD::Inner::HashInteger(U {0}) == 0);
+   REQUIRE(SIMD::Inner::HashInteger(U {1}) != 1);
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<T> in(1000000);
+      some<T> out(in.size());
+      for (Offset i = 0; i < in.size(); ++i)
+         in[i] = static_cast<T>(i);
+
+      BENCHMARK_ADVANCED("HashIntegers (control)") (timer meter) {
+         meter.measure([&] {
+            for (Offset i = 0; i < in.size(); ++i)
+               out[i] = static_cast<T>(SIMD::Inner::HashInteger(static_cast<U>(in[i])));
+            return out[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("HashIntegers (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::HashIntegers(in, out);
+            return out[0];
+         });
+      };
+   #endif
+}
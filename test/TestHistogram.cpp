@@ -0,0 +1,175 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+
+/// Count elements between edges one by one, as a reference                   
+template<class T>
+some<Count> ControlHistogram(const some<T>& data, const some<T>& edges) {
+   some<Count> result(edges.size() + 1);
+   for (auto& x : data) {
+      if (x != x)
+         continue;
+      ++result[std::upper_bound(edges.begin(), edges.end(), x) - edges.begin()];
+   }
+   return result;
+}
+
+TEMPLATE_TEST_CASE("Histogram of values", "[histogram]", ::std::uint8_t, ::std::uint16_t) {
+   using T = TestType;
+   std::mt19937 gen {99};
+
+   for (Count count : {0, 1, 3, 64, 100, 1000, 70000, 300000}) {
+      GIVEN(std::to_string(count) + " elements") {
+         some<T> data(count);
+         for (auto& x : data)
+            x = static_cast<T>(gen() % 300);
+
+         for (Count binCount : {Count {1}, Count {17}, Count {256}, Count {300}, Count {70000}}) {
+            some<Count> expected(binCount);
+            for (auto& x : data) {
+               if (x < binCount)
+                  ++expected[x];
+            }
+
+            some<Count> bins(binCount);
+            SIMD::Histogram(data, bins);
+            REQUIRE(bins == expected);
+
+            // Counts are added to what's already in the bins           
+            SIMD::Histogram(data, bins, 4);
+            for (auto& x : expected)
+               x *= 2;
+            REQUIRE(bins == expected);
+         }
+
+         // Runs of the same value                                      
+         some<::std::uint32_t> bins(256);
+         some<T> same(count, T {5});
+         SIMD::Histogram(same, bins, 0);
+         REQUIRE(bins[5] == count);
+         REQUIRE(std::count(bins.begin(), bins.end(), 0) == (count ? 255 : 256));
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<T> big(10000000);
+      for (auto& x : big)
+         x = static_cast<T>(gen() % 256);
+      some<Count> bins(256);
+
+      BENCHMARK_ADVANCED("Histogram of 10M values (control)") (timer meter) {
+         meter.measure([&] {
+            for (auto& x : big)
+               ++bins[x];
+            return bins[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Histogram of 10M values (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Histogram(big, bins);
+            return bins[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Histogram of 10M values (SIMD, all threads)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Histogram(big, bins, 0);
+            return bins[0];
+         });
+      };
+   #endif
+}
+
+TEMPLATE_TEST_CASE("Histogram between edges", "[histogram]",
+   ::std::int8_t, ::std::uint16_t,
+   ::std::int32_t, ::std::uint32_t, float,
+   ::std::int64_t, ::std::uint64_t, double
+) {
+   using T = TestType;
+   std::mt19937 gen {77};
+
+   const auto random = [&] {
+      const auto r = gen() % 100;
+      if (r == 0)
+         return std::numeric_limits<T>::max();
+      if (r == 1)
+         return std::numeric_limits<T>::lowest();
+      if constexpr (CT::Signed<T>)
+         return static_cast<T>(static_cast<int>(gen() % 120) - 60);
+      else
+         return static_cast<T>(gen() % 120);
+   };
+
+   for (Count edgeCount : {0, 1, 5, 8, 9, 31, 32, 100}) {
+      some<T> edges(edgeCount);
+      for (auto& x : edges)
+         x = random();
+      std::sort(edges.begin(), edges.end());
+
+      for (Count count : {0, 1, 7, 33, 1000, 100000}) {
+         GIVEN(std::to_string(count) + " elements and " + std::to_string(edgeCount) + " edges") {
+            some<T> data(count);
+            for (auto& x : data)
+               x = random();
+
+            // Exactly at the edges                                     
+            for (Offset i = 0; i < std::min(count, edgeCount); ++i)
+               data[i] = edges[i];
+
+            if constexpr (CT::Real<T>) {
+               for (Offset i = 3; i < count; i += 17)
+                  data[i] = std::numeric_limits<T>::quiet_NaN();
+               if (count > 10) {
+                  data[4] = std::numeric_limits<T>::infinity();
+                  data[5] = -std::numeric_limits<T>::infinity();
+               }
+            }
+
+            const auto expected = ControlHistogram(data, edges);
+            some<Count> bins(edgeCount + 1);
+            SIMD::Histogram(data, edges, bins);
+            REQUIRE(bins == expected);
+
+            some<::std::uint32_t> split(edgeCount + 1);
+            SIMD::Histogram(data, edges, split, 3);
+            REQUIRE(std::equal(split.begin(), split.end(), expected.begin()));
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<T> big(10000000);
+      for (auto& x : big)
+         x = random();
+      some<T> edges(64);
+      for (auto& x : edges)
+         x = random();
+      std::sort(edges.begin(), edges.end());
+      some<Count> bins(edges.size() + 1);
+
+      BENCHMARK_ADVANCED("Histogram of 10M elements, 64 edges (control)") (timer meter) {
+         meter.measure([&] {
+            for (auto& x : big)
+               ++bins[std::upper_bound(edges.begin(), edges.end(), x) - edges.begin()];
+            return bins[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Histogram of 10M elements, 64 edges (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Histogram(big, edges, bins);
+            return bins[0];
+         });
+      };
+   #endif
+}
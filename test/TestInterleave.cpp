@@ -0,0 +1,116 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+
+
+/// Fill an interleaved array of 'count' structures, each element unique      
+template<Count N, class T>
+some<T> ControlAoS(Count count) {
+   some<T> aos(count * N);
+   for (Offset i = 0; i < aos.size(); ++i)
+      aos[i] = static_cast<T>(i % 97 + 1);
+   return aos;
+}
+
+template<Count N, class T>
+void CheckDeinterleaveAndBack(Count count) {
+   const auto aos = ControlAoS<N, T>(count);
+   some<T> soa[N];
+   for (auto& stream : soa)
+      stream.resize(count);
+
+   [&]<Offset...C>(ExpandedSequence<C...>) {
+      SIMD::Deinterleave<N>(aos, soa[C]...);
+   }(Sequence<N>::Expand);
+
+   for (Offset i = 0; i < count; ++i) {
+      for (Offset c = 0; c < N; ++c)
+         REQUIRE(soa[c][i] == aos[i * N + c]);
+   }
+
+   some<T> back(count * N);
+   [&]<Offset...C>(ExpandedSequence<C...>) {
+      SIMD::Interleave<N>(back, soa[C]...);
+   }(Sequence<N>::Expand);
+
+   REQUIRE(back == aos);
+}
+
+TEMPLATE_TEST_CASE("Interleave and deinterleave", "[interleave]"
+   , NUMBERS_ALL()
+) {
+   using T = TestType;
+
+   for (Count count : {0, 1, 3, 7, 16, 33, 64, 100, 257}) {
+      GIVEN("Two streams of " + std::to_string(count)) {
+         CheckDeinterleaveAndBack<2, T>(count);
+      }
+      GIVEN("Three streams of " + std::to_string(count)) {
+         CheckDeinterleaveAndBack<3, T>(count);
+      }
+      GIVEN("Four streams of " + std::to_string(count)) {
+         CheckDeinterleaveAndBack<4, T>(count);
+      }
+      GIVEN("Eight streams of " + std::to_string(count)) {
+         CheckDeinterleaveAndBack<8, T>(count);
+      }
+   }
+}
+
+TEMPLATE_TEST_CASE("Deinterleave packed vectors", "[interleave]"
+   , (Vector<float, 3>), (Vector<float, 4>), (Vector<double, 3>)
+   , (Vector<::std::int16_t, 2>), (Vector<::std::uint8_t, 4>)
+) {
+   using T = TestType;
+   using E = TypeOf<T>;
+   constexpr Count N = CountOf<T>;
+
+   GIVEN("An array of vectors") {
+      some<T> aos(77);
+      some<E> soa[N];
+      for (auto& stream : soa)
+         stream.resize(aos.size());
+
+      WHEN("Deinterleaved and interleaved back") {
+         [&]<Offset...C>(ExpandedSequence<C...>) {
+            SIMD::Deinterleave<N>(aos, soa[C]...);
+         }(Sequence<N>::Expand);
+
+         for (Offset i = 0; i < aos.size(); ++i) {
+            for (Offset c = 0; c < N; ++c)
+               REQUIRE(soa[c][i] == aos[i][c]);
+         }
+
+         some<T> back(aos.size(), T {E {0}});
+         [&]<Offset...C>(ExpandedSequence<C...>) {
+            SIMD::Interleave<N>(back, soa[C]...);
+         }(Sequence<N>::Expand);
+
+         REQUIRE(back == aos);
+
+         #ifdef LANGULUS_STD_BENCHMARK
+            BENCHMARK_ADVANCED("Deinterleave (control)") (timer meter) {
+               meter.measure([&] {
+                  for (Offset i = 0; i < aos.size(); ++i) {
+                     for (Offset c = 0; c < N; ++c)
+                        soa[c][i] = aos[i][c];
+                  }
+               });
+            };
+
+            BENCHMARK_ADVANCED("Deinterleave (SIMD)") (timer meter) {
+               meter.measure([&] {
+                  [&]<Offset...C>(ExpandedSequence<C...>) {
+                     SIMD::Deinterleave<N>(aos, soa[C]...);
+                  }(Sequence<N>::Expand);
+               });
+            };
+         #endif
+      }
+   }
+}
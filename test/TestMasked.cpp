@@ -0,0 +1,124 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <limits>
+#include <random>
+
+
+/// Fill a vector with random elements from a small range, so that there are  
+/// plenty of equal elements, or from the whole range of unsigned integers    
+template<class V>
+V RandomVector(std::mt19937_64& gen, bool wide = false) {
+   using T = TypeOf<V>;
+   V v;
+   for (Offset i = 0; i < CountOf<V>; ++i) {
+      if (wide and CT::Integer<T> and not CT::Signed<T>)
+         v[i] = static_cast<T>(gen());
+      else
+         v[i] = static_cast<T>(static_cast<int>(gen() % 9) - (CT::Signed<T> ? 4 : 0));
+   }
+   return v;
+}
+
+/// Get a random bitmask for a vector, and the edge cases                     
+template<class V>
+auto RandomMasks(std::mt19937_64& gen) {
+   using B = SIMD::Bitmask<CountOf<V>>;
+   using TYPE = typename B::Type;
+   return std::array {
+      B {TYPE {0}}, B {B::Mask},
+      B {static_cast<TYPE>(0x5555555555555555ull)},
+      B {static_cast<TYPE>(gen())}, B {static_cast<TYPE>(gen())}
+   };
+}
+
+TEMPLATE_TEST_CASE("Compare into native bitmasks", "[masked]",
+   (Vector<float, 16>), (Vector<double, 8>), (Vector<float, 10>), (Vector<double, 3>),
+   (Vector<::std::int32_t, 16>), (Vector<::std::uint16_t, 32>),
+   (Vector<::std::int8_t, 64>), (Vector<::std::uint64_t, 8>)
+) {
+   using T = TestType;
+   constexpr Count N = CountOf<T>;
+   std::mt19937_64 gen {31};
+
+   for (int run = 0; run < 20; ++run) {
+      const auto lhs = RandomVector<T>(gen, run % 2);
+      const auto rhs = RandomVector<T>(gen, run % 2);
+
+      const SIMD::Bitmask<N> eq = SIMD::Equals(lhs, rhs);
+      const SIMD::Bitmask<N> lt = SIMD::Lesser(lhs, rhs);
+      const SIMD::Bitmask<N> gt = SIMD::Greater(lhs, rhs);
+      const SIMD::Bitmask<N> le = SIMD::EqualsOrLesser(lhs, rhs);
+      const SIMD::Bitmask<N> ge = SIMD::EqualsOrGreater(lhs, rhs);
+      for (Offset i = 0; i < N; ++i) {
+         REQUIRE(eq[i] == (lhs[i] == rhs[i]));
+         REQUIRE(lt[i] == (lhs[i] <  rhs[i]));
+         REQUIRE(gt[i] == (lhs[i] >  rhs[i]));
+         REQUIRE(le[i] == (lhs[i] <= rhs[i]));
+         REQUIRE(ge[i] == (lhs[i] >= rhs[i]));
+      }
+   }
+}
+
+TEMPLATE_TEST_CASE("Masked arithmetic", "[masked]",
+   (Vector<float, 4>), (Vector<float, 16>), (Vector<double, 8>), (Vector<double, 3>),
+   (Vector<::std::int32_t, 16>), (Vector<::std::int16_t, 8>),
+   (Vector<::std::uint8_t, 64>), (Vector<::std::int64_t, 2>)
+) {
+   using T = TestType;
+   using E = TypeOf<T>;
+   constexpr Count N = CountOf<T>;
+   std::mt19937_64 gen {37};
+
+   // Check merge-masking and zero-masking against the whole operation  
+   const auto check = [&](const auto& mask, const T& whole, const T& old, const T& merged, const T& zeroed) {
+      for (Offset i = 0; i < N; ++i) {
+         REQUIRE(merged[i] == (mask[i] ? whole[i] : old[i]));
+         REQUIRE(zeroed[i] == (mask[i] ? whole[i] : E {0}));
+      }
+   };
+
+   for (int run = 0; run < 10; ++run) {
+      const auto lhs = RandomVector<T>(gen);
+      const auto rhs = RandomVector<T>(gen);
+      const auto old = RandomVector<T>(gen);
+
+      for (const auto& mask : RandomMasks<T>(gen)) {
+         T out = old;
+         SIMD::Masked::Add(mask, lhs, rhs, out);
+         check(mask, SIMD::Add(lhs, rhs), old, out, SIMD::Masked::Add(mask, lhs, rhs));
+
+         out = old;
+         SIMD::Masked::Subtract(mask, lhs, rhs, out);
+         check(mask, SIMD::Subtract(lhs, rhs), old, out, SIMD::Masked::Subtract(mask, lhs, rhs));
+
+         out = old;
+         SIMD::Masked::Multiply(mask, lhs, rhs, out);
+         check(mask, SIMD::Multiply(lhs, rhs), old, out, SIMD::Masked::Multiply(mask, lhs, rhs));
+
+         out = old;
+         SIMD::Masked::Min(mask, lhs, rhs, out);
+         check(mask, SIMD::Min(lhs, rhs), old, out, SIMD::Masked::Min(mask, lhs, rhs));
+
+         out = old;
+         SIMD::Masked::Max(mask, lhs, rhs, out);
+         check(mask, SIMD::Max(lhs, rhs), old, out, SIMD::Masked::Max(mask, lhs, rhs));
+
+         // Zeroes in unselected elements can't cause division by zero  
+         T divisor = rhs, safe = rhs;
+         for (Offset i = 0; i < N; ++i) {
+            divisor[i] = mask[i] ? (rhs[i] == E {0} ? E {3} : rhs[i]) : E {0};
+            safe[i] = mask[i] ? divisor[i] : E {1};
+         }
+
+         out = old;
+         SIMD::Masked::Divide(mask, lhs, divisor, out);
+         check(mask, SIMD::Divide(lhs, safe), old, out, SIMD::Masked::Divide(mask, lhs, divisor));
+      }
+   }
+}
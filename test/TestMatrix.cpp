@@ -0,0 +1,190 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+
+
+/// A well conditioned, non-symmetric matrix                                  
+template<class T>
+std::array<T, 16> ControlMatrix() {
+   std::array<T, 16> m;
+   for (Offset i = 0; i < 16; ++i)
+      m[i] = static_cast<T>(int(i * 7 % 5) - 2) / T {4};
+   for (Offset i = 0; i < 4; ++i)
+      m[i * 5] += T {3};
+   return m;
+}
+
+/// An affine matrix - rotation, non-uniform scale and translation            
+template<class T>
+std::array<T, 16> ControlAffine() {
+   return {
+       T {0},   T {2},    T {0},  T {0},
+      -T {3},   T {0},    T {0},  T {0},
+       T {0},   T {0},    T {.5}, T {0},
+       T {10}, -T {20},   T {5},  T {1}
+   };
+}
+
+/// Column-major matrix multiplication, done conventionally                   
+template<class T>
+std::array<T, 16> ControlMultiply(const std::array<T, 16>& a, const std::array<T, 16>& b) {
+   std::array<T, 16> r {};
+   for (Offset c = 0; c < 4; ++c) {
+      for (Offset row = 0; row < 4; ++row) {
+         for (Offset k = 0; k < 4; ++k)
+            r[c * 4 + row] += a[k * 4 + row] * b[c * 4 + k];
+      }
+   }
+   return r;
+}
+
+template<class T>
+void RequireClose(const std::array<T, 16>& a, const std::array<T, 16>& b) {
+   for (Offset i = 0; i < 16; ++i)
+      REQUIRE(a[i] == Approx(b[i]).margin(1e-5));
+}
+
+template<class T>
+void RequireIdentity(const std::array<T, 16>& a) {
+   for (Offset i = 0; i < 16; ++i)
+      REQUIRE(a[i] == Approx(i % 5 == 0 ? 1 : 0).margin(1e-5));
+}
+
+TEMPLATE_TEST_CASE("4x4 matrices", "[matrix]", NUMBERS_REAL()) {
+   using T = TestType;
+
+   GIVEN("Two matrices") {
+      const auto a = ControlMatrix<T>();
+      const auto b = ControlAffine<T>();
+
+      WHEN("Multiplied") {
+         std::array<T, 16> r;
+         SIMD::Mat4Multiply(a, b, r);
+         RequireClose(r, ControlMultiply(a, b));
+
+         SIMD::Mat4Multiply(b, a, r);
+         RequireClose(r, ControlMultiply(b, a));
+      }
+
+      WHEN("Multiplied in place") {
+         auto r = a;
+         SIMD::Mat4Multiply(r, b, r);
+         RequireClose(r, ControlMultiply(a, b));
+      }
+
+      WHEN("Transposed") {
+         std::array<T, 16> r;
+         SIMD::Transpose4x4(a, r);
+         for (Offset c = 0; c < 4; ++c) {
+            for (Offset row = 0; row < 4; ++row)
+               REQUIRE(r[row * 4 + c] == a[c * 4 + row]);
+         }
+
+         SIMD::Transpose4x4(r, r);
+         REQUIRE(r == a);
+      }
+
+      WHEN("Inverted") {
+         std::array<T, 16> r;
+         SIMD::Inverse4x4(a, r);
+         RequireIdentity(ControlMultiply(a, r));
+         RequireIdentity(ControlMultiply(r, a));
+      }
+
+      WHEN("Affine matrix is inverted") {
+         std::array<T, 16> r, g;
+         SIMD::InverseAffine4x4(b, r);
+         RequireIdentity(ControlMultiply(b, r));
+
+         SIMD::Inverse4x4(b, g);
+         RequireClose(r, g);
+      }
+
+      WHEN("Singular matrix is inverted") {
+         std::array<T, 16> s {}, r;
+         REQUIRE_THROWS(SIMD::Inverse4x4(s, r));
+         REQUIRE_THROWS(SIMD::InverseAffine4x4(s, r));
+      }
+   }
+}
+
+TEMPLATE_TEST_CASE("8x8 matrix transposition", "[matrix]"
+   , ::std::int16_t, ::std::uint16_t
+) {
+   using T = TestType;
+   std::array<T, 64> m, r;
+   for (Offset i = 0; i < 64; ++i)
+      m[i] = static_cast<T>(i * 3 + 1);
+
+   SIMD::Transpose8x8(m, r);
+   for (Offset c = 0; c < 8; ++c) {
+      for (Offset row = 0; row < 8; ++row)
+         REQUIRE(r[row * 8 + c] == m[c * 8 + row]);
+   }
+
+   SIMD::Transpose8x8(r, r);
+   REQUIRE(r == m);
+}
+
+TEMPLATE_TEST_CASE("Point transformation", "[matrix]"
+   , (Vector<float, 3>), (Vector<float, 4>)
+   , (Vector<double, 3>), (Vector<double, 4>)
+) {
+   using T = TestType;
+   using E = TypeOf<T>;
+   constexpr Count N = CountOf<T>;
+   const auto m = ControlMatrix<E>();
+
+   for (Count count : {0, 1, 3, 5, 64, 100}) {
+      GIVEN("A batch of " + std::to_string(count) + " points") {
+         some<T> points(count);
+         some<T> out(count, T {E {0}});
+
+         WHEN("Transformed") {
+            SIMD::TransformPoints(m, points, out);
+
+            for (Offset i = 0; i < count; ++i) {
+               const E w = N == 4 ? points[i][3] : E {1};
+               for (Offset r = 0; r < N; ++r) {
+                  const E expected = m[r] * points[i][0] + m[4 + r] * points[i][1]
+                                   + m[8 + r] * points[i][2] + m[12 + r] * w;
+                  REQUIRE(out[i][r] == Approx(expected).epsilon(1e-5));
+               }
+            }
+
+            WHEN("Transformed in place") {
+               SIMD::TransformPoints(m, points);
+               REQUIRE(points == out);
+            }
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      GIVEN("A million points") {
+         some<T> points(1000000);
+
+         BENCHMARK_ADVANCED("Transform points (control)") (timer meter) {
+            meter.measure([&] {
+               for (auto& p : points) {
+                  const E w = N == 4 ? p[3] : E {1};
+                  const T c = p;
+                  for (Offset r = 0; r < N; ++r)
+                     p[r] = m[r] * c[0] + m[4 + r] * c[1] + m[8 + r] * c[2] + m[12 + r] * w;
+               }
+            });
+         };
+
+         BENCHMARK_ADVANCED("Transform points (SIMD)") (timer meter) {
+            meter.measure([&] {
+               SIMD::TransformPoints(m, points);
+            });
+         };
+      }
+   #endif
+}
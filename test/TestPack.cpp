@@ -6,6 +6,9 @@
 /// SPDX-License-Identifier: MIT                                              
 ///                                                                           
 #include "Common.hpp"
+#include <algorithm>
+#include <limits>
+#include <random>
 
 
 TEMPLATE_TEST_CASE("Pack 64 bits", "[pack]", ::std::int64_t, ::std::uint64_t) {
@@ -143,4 +146,95 @@ TEMPLATE_TEST_CASE("Pack 64 bits", "[pack]", ::std::int64_t, ::std::uint64_t) {
 #if LANGULUS_SIMD(512BIT)
    TODO();
 #endif
-}
\ No newline at end of file
+}
+
+/// Generate a random number, with plenty of extremes among them              
+template<class T>
+T MakePackable(std::mt19937_64& gen) {
+   const auto r = gen() % 10;
+   if (r == 0)
+      return std::numeric_limits<T>::max();
+   if (r == 1)
+      return std::numeric_limits<T>::lowest();
+   if constexpr (CT::Real<T>)
+      return static_cast<T>(static_cast<int>(gen() % 2000) - 1000) / T {3};
+   else if (r < 5)
+      return static_cast<T>(static_cast<int>(gen() % 512) - 256);
+   else
+      return static_cast<T>(gen());
+}
+
+/// Pack N registers at once, and compare with packing element by element     
+template<class R, Count N, SIMD::ConvertPolicy P>
+void CheckPackN(std::mt19937_64& gen) {
+   using T = TypeOf<R>;
+   constexpr Count L = CountOf<R>;
+   using TO = Conditional<CT::Real<T>, float, Conditional<CT::Signed<T>,
+      Conditional<sizeof(T) / N == 1, ::std::int8_t,
+      Conditional<sizeof(T) / N == 2, ::std::int16_t, ::std::int32_t>>,
+      Conditional<sizeof(T) / N == 1, ::std::uint8_t,
+      Conditional<sizeof(T) / N == 2, ::std::uint16_t, ::std::uint32_t>>
+   >>;
+
+   for (int test = 0; test < 20; ++test) {
+      std::array<T, L * N> in;
+      for (auto& x : in)
+         x = MakePackable<T>(gen);
+
+      const auto packed = [&]<Offset...I>(std::index_sequence<I...>) {
+         return SIMD::PackN<P>(SIMD::Inner::LoadUnaligned<R>(in.data() + I * L)...);
+      }(std::make_index_sequence<N> {});
+      static_assert(CT::Exact<TypeOf<decltype(packed)>, TO>);
+      static_assert(CountOf<decltype(packed)> == L * N);
+
+      std::array<TO, L * N> out;
+      SIMD::Inner::StoreUnaligned(out.data(), packed);
+      for (Offset i = 0; i < L * N; ++i) {
+         if constexpr (P == SIMD::ConvertPolicy::Saturate and CT::Integer<T>) {
+            REQUIRE(out[i] == std::clamp(in[i],
+               static_cast<T>(std::numeric_limits<TO>::lowest()),
+               static_cast<T>(std::numeric_limits<TO>::max())));
+         }
+         else REQUIRE(out[i] == static_cast<TO>(in[i]));
+      }
+   }
+}
+
+/// Pack registers of R by all policies, as many at once as possible          
+template<class R>
+void CheckPack(std::mt19937_64& gen) {
+   using T = TypeOf<R>;
+   CheckPackN<R, 2, SIMD::ConvertPolicy::Wrap>(gen);
+   CheckPackN<R, 2, SIMD::ConvertPolicy::Saturate>(gen);
+   if constexpr (CT::Integer<T> and sizeof(T) >= 4) {
+      CheckPackN<R, 4, SIMD::ConvertPolicy::Wrap>(gen);
+      CheckPackN<R, 4, SIMD::ConvertPolicy::Saturate>(gen);
+   }
+   if constexpr (CT::Integer<T> and sizeof(T) == 8) {
+      CheckPackN<R, 8, SIMD::ConvertPolicy::Wrap>(gen);
+      CheckPackN<R, 8, SIMD::ConvertPolicy::Saturate>(gen);
+   }
+}
+
+TEMPLATE_TEST_CASE("Pack several registers into one", "[pack]",
+   ::std::int16_t, ::std::uint16_t, ::std::int32_t, ::std::uint32_t,
+   ::std::int64_t, ::std::uint64_t, double
+) {
+   std::mt19937_64 gen {31};
+
+   #if LANGULUS_SIMD(128BIT)
+      GIVEN("128bit registers") {
+         CheckPack<SIMD::V128<TestType>>(gen);
+      }
+   #endif
+   #if LANGULUS_SIMD(256BIT)
+      GIVEN("256bit registers") {
+         CheckPack<SIMD::V256<TestType>>(gen);
+      }
+   #endif
+   #if LANGULUS_SIMD(512BIT)
+      GIVEN("512bit registers") {
+         CheckPack<SIMD::V512<TestType>>(gen);
+      }
+   #endif
+}
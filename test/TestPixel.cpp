@@ -0,0 +1,139 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <cmath>
+#include <cstring>
+
+
+using Pixels = some<::std::uint8_t>;
+
+/// Generate a number of pixels with pseudo-random channels                   
+Pixels MakePixels(Count count, unsigned seed) {
+   Pixels result(count * 4);
+   for (auto& c : result) {
+      seed = seed * 1103515245u + 12345u;
+      c = static_cast<::std::uint8_t>(seed >> 16);
+   }
+   return result;
+}
+
+/// x * y / 255, truncated                                                    
+::std::uint8_t ControlScale(unsigned x, unsigned y) {
+   return static_cast<::std::uint8_t>(x * y / 255);
+}
+
+TEST_CASE("RGBA8 pixel kernels", "[pixel]") {
+   for (Count count : {0, 1, 3, 4, 5, 15, 16, 17, 33, 100}) {
+      GIVEN(std::to_string(count) + " pixels") {
+         const auto src = MakePixels(count, 1 + count);
+         const auto dst = MakePixels(count, 1000 + count);
+
+         WHEN("Composited with alpha over") {
+            Pixels out(count * 4);
+            SIMD::Pixel::AlphaOver(src, dst, out);
+            for (Offset i = 0; i < count * 4; ++i) {
+               const unsigned inv = 255u - src[i / 4 * 4 + 3];
+               const unsigned r = src[i] + ControlScale(dst[i], inv);
+               REQUIRE(out[i] == (r > 255 ? 255 : r));
+            }
+         }
+
+         WHEN("Premultiplied") {
+            Pixels out(count * 4);
+            SIMD::Pixel::Premultiply(src, out);
+            for (Offset i = 0; i < count * 4; ++i) {
+               const unsigned a = src[i / 4 * 4 + 3];
+               REQUIRE(out[i] == (i % 4 == 3 ? a : ControlScale(src[i], a)));
+            }
+         }
+
+         WHEN("Premultiplied and then unpremultiplied") {
+            Pixels pre(count * 4);
+            SIMD::Pixel::Premultiply(src, pre);
+            Pixels out(count * 4);
+            SIMD::Pixel::Unpremultiply(pre, out);
+            for (Offset i = 0; i < count * 4; ++i) {
+               const auto a = pre[i / 4 * 4 + 3];
+               if (i % 4 == 3)
+                  REQUIRE(out[i] == a);
+               else if (a == 0)
+                  REQUIRE(out[i] == 0);
+               else {
+                  const float scale = 255.0f / static_cast<float>(a);
+                  const auto expected = std::nearbyint(std::min(pre[i] * scale, 255.0f));
+                  REQUIRE(out[i] == static_cast<::std::uint8_t>(expected));
+
+                  // Must be close to the original, for opaque pixels   
+                  if (a == 255)
+                     REQUIRE(out[i] == src[i]);
+               }
+            }
+         }
+
+         WHEN("Scaled by constant factors") {
+            const ::std::array<::std::uint8_t, 4> factors {255, 128, 3, 0};
+            Pixels out(count * 4);
+            SIMD::Pixel::Scale(src, factors, out);
+            for (Offset i = 0; i < count * 4; ++i)
+               REQUIRE(out[i] == ControlScale(src[i], factors[i % 4]));
+
+            // In place, through packed 32bit pixels                    
+            some<::std::uint32_t> packed(count);
+            std::memcpy(packed.data(), src.data(), count * 4);
+            SIMD::Pixel::Scale(packed, factors, packed);
+            REQUIRE(std::memcmp(packed.data(), out.data(), count * 4) == 0);
+         }
+      }
+   }
+
+   for (auto [w, h] : {std::pair<Count, Count> {2, 2}, {3, 5}, {8, 2}, {16, 4}, {33, 7}, {64, 3}, {70, 6}}) {
+      GIVEN("An image of " + std::to_string(w) + "x" + std::to_string(h)) {
+         const auto image = MakePixels(w * h, w * 31 + h);
+
+         WHEN("Downsampled") {
+            const Count ow = w / 2, oh = h / 2;
+            Pixels out(ow * oh * 4);
+            SIMD::Pixel::Downsample2x(image, w, h, out);
+
+            for (Offset y = 0; y < oh; ++y) {
+               for (Offset x = 0; x < ow; ++x) {
+                  for (Offset c = 0; c < 4; ++c) {
+                     const auto at = [&](Offset xx, Offset yy) -> unsigned {
+                        return image[(yy * w + xx) * 4 + c];
+                     };
+                     const unsigned left  = (at(x * 2,     y * 2) + at(x * 2,     y * 2 + 1) + 1) / 2;
+                     const unsigned right = (at(x * 2 + 1, y * 2) + at(x * 2 + 1, y * 2 + 1) + 1) / 2;
+                     REQUIRE(out[(y * ow + x) * 4 + c] == (left + right + 1) / 2);
+                  }
+               }
+            }
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      const auto fg = MakePixels(1000000, 1);
+      const auto bg = MakePixels(1000000, 2);
+      Pixels out(fg.size());
+
+      BENCHMARK_ADVANCED("Alpha over (control)") (timer meter) {
+         meter.measure([&] {
+            for (Offset i = 0; i < fg.size(); ++i) {
+               const unsigned r = fg[i] + ControlScale(bg[i], 255u - fg[i / 4 * 4 + 3]);
+               out[i] = static_cast<::std::uint8_t>(r > 255 ? 255 : r);
+            }
+         });
+      };
+
+      BENCHMARK_ADVANCED("Alpha over (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Pixel::AlphaOver(fg, bg, out);
+         });
+      };
+   #endif
+}
@@ -0,0 +1,124 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <cmath>
+#include <limits>
+#include <random>
+
+
+/// Quantize a float one at a time, as a reference                            
+template<class T>
+T ControlQuantize(float x, float scale, ::std::int32_t zp) {
+   const float p = x * (1.0f / scale);
+   if (std::isnan(p))
+      return static_cast<T>(zp);
+
+   const double q = std::nearbyint(static_cast<double>(p)) + zp;
+   if (q < std::numeric_limits<T>::min())
+      return std::numeric_limits<T>::min();
+   if (q > std::numeric_limits<T>::max())
+      return std::numeric_limits<T>::max();
+   return static_cast<T>(q);
+}
+
+TEMPLATE_TEST_CASE("Quantize and dequantize", "[quantize]",
+   ::std::int8_t, ::std::uint8_t, ::std::int16_t
+) {
+   using T = TestType;
+   std::mt19937 gen {5};
+   const float scale = sizeof(T) == 1 ? 0.05f : 0.001f;
+   const ::std::int32_t zp = CT::Signed<T> ? -3 : 128;
+
+   for (Count count : {0, 1, 3, 15, 16, 17, 31, 32, 33, 64, 100, 1001}) {
+      GIVEN(std::to_string(count) + " floats") {
+         some<float> in(count);
+         for (auto& x : in)
+            x = static_cast<float>(static_cast<int>(gen() % 20001) - 10000) / 1000.0f;
+
+         // Values exactly between two steps, that must round to even,  
+         // values out of range, and special values                     
+         const float specials[] {
+            0.5f * scale, 1.5f * scale, 2.5f * scale, -0.5f * scale, -2.5f * scale,
+            1e9f, -1e9f, 1e30f, -1e30f,
+            std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN(), 0.0f, -0.0f
+         };
+         for (Offset i = 0; i < count; ++i) {
+            if (i % 3 == 0)
+               in[i] = specials[(i / 3) % std::size(specials)];
+         }
+
+         some<T> q(count);
+         SIMD::Quantize(in, scale, zp, q);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(q[i] == ControlQuantize<T>(in[i], scale, zp));
+
+         some<float> back(count);
+         SIMD::Dequantize(q, scale, zp, back);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(back[i] == static_cast<float>(static_cast<::std::int32_t>(q[i]) - zp) * scale);
+      }
+   }
+
+   GIVEN("A matrix, quantized per channel") {
+      constexpr Count rows = 5, cols = 37;
+      some<float> in(rows * cols);
+      for (auto& x : in)
+         x = static_cast<float>(static_cast<int>(gen() % 2001) - 1000) / 100.0f;
+
+      some<float> scales(rows);
+      some<::std::int32_t> zps(rows);
+      for (Offset r = 0; r < rows; ++r) {
+         scales[r] = 0.02f * static_cast<float>(r + 1);
+         zps[r] = static_cast<::std::int32_t>(r) - 2 + (CT::Signed<T> ? 0 : 128);
+      }
+
+      some<T> q(in.size());
+      SIMD::Quantize(in, scales, zps, q);
+      for (Offset i = 0; i < in.size(); ++i)
+         REQUIRE(q[i] == ControlQuantize<T>(in[i], scales[i / cols], zps[i / cols]));
+
+      some<float> back(in.size());
+      SIMD::Dequantize(q, scales, zps, back);
+      for (Offset i = 0; i < in.size(); ++i) {
+         const auto r = i / cols;
+         REQUIRE(back[i] == static_cast<float>(static_cast<::std::int32_t>(q[i]) - zps[r]) * scales[r]);
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<float> big(1 << 20);
+      for (auto& x : big)
+         x = static_cast<float>(static_cast<int>(gen() % 20001) - 10000) / 1000.0f;
+      some<T> q(big.size());
+      some<float> back(big.size());
+
+      BENCHMARK_ADVANCED("Quantize 1M floats (control)") (timer meter) {
+         meter.measure([&] {
+            for (Offset i = 0; i < big.size(); ++i)
+               q[i] = ControlQuantize<T>(big[i], scale, zp);
+            return q[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Quantize 1M floats (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Quantize(big, scale, zp, q);
+            return q[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Dequantize 1M integers (SIMD)") (timer meter) {
+         meter.measure([&] {
+            SIMD::Dequantize(q, scale, zp, back);
+            return back[0];
+         });
+      };
+   #endif
+}
@@ -0,0 +1,123 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <numeric>
+
+
+/// Fill an array with small values of both signs, so that sums stay exact    
+template<class T>
+some<T> ControlScan(Count count) {
+   some<T> data(count);
+   for (Offset i = 0; i < count; ++i) {
+      if constexpr (CT::Signed<T>)
+         data[i] = static_cast<T>(int(i * 7 % 13) - 6);
+      else
+         data[i] = static_cast<T>(i * 7 % 13);
+   }
+   return data;
+}
+
+/// Scan conventionally, and compare against SIMD::InclusiveScan and          
+/// SIMD::ExclusiveScan, both out of place and in place                       
+template<class OP, class T>
+void CheckScan(Count count, Count threads = 1) {
+   const auto data = ControlScan<T>(count);
+   const auto op = [](const T& a, const T& b) { return OP::Scalar(a, b); };
+
+   some<T> inclusive(count), exclusive(count);
+   std::inclusive_scan(data.begin(), data.end(), inclusive.begin(), op);
+   std::exclusive_scan(data.begin(), data.end(), exclusive.begin(),
+      OP::template Identity<T>(), op);
+
+   some<T> out(count);
+   SIMD::InclusiveScan<OP>(data, out, threads);
+   REQUIRE(out == inclusive);
+
+   SIMD::ExclusiveScan<OP>(data, out, threads);
+   REQUIRE(out == exclusive);
+
+   out = data;
+   SIMD::InclusiveScan<OP>(out, out, threads);
+   REQUIRE(out == inclusive);
+
+   out = data;
+   SIMD::ExclusiveScan<OP>(out, out, threads);
+   REQUIRE(out == exclusive);
+}
+
+TEMPLATE_TEST_CASE("Prefix scans", "[scan]"
+   , ::std::int8_t, ::std::uint8_t, ::std::int16_t, ::std::uint16_t
+   , ::std::int32_t, ::std::uint32_t, ::std::int64_t, ::std::uint64_t
+   , float, double
+) {
+   using T = TestType;
+
+   for (Count count : {0, 1, 3, 15, 16, 17, 100, 1000}) {
+      GIVEN("An array of " + std::to_string(count) + " elements") {
+         WHEN("Summed") {
+            CheckScan<SIMD::ScanOp::Add, T>(count);
+         }
+
+         WHEN("Maxed") {
+            CheckScan<SIMD::ScanOp::Max, T>(count);
+         }
+
+         WHEN("Mined") {
+            CheckScan<SIMD::ScanOp::Min, T>(count);
+         }
+
+         if constexpr (CT::Integer<T>) {
+            WHEN("XOr-ed") {
+               CheckScan<SIMD::ScanOp::XOr, T>(count);
+            }
+         }
+      }
+   }
+}
+
+TEMPLATE_TEST_CASE("Multithreaded prefix scans", "[scan]"
+   , ::std::int32_t, ::std::uint64_t, float
+) {
+   using T = TestType;
+   constexpr Count count = 4 * SIMD::Inner::ScanParallelThreshold + 123;
+
+   GIVEN("An array big enough to be split") {
+      WHEN("Summed with four threads") {
+         CheckScan<SIMD::ScanOp::Add, T>(count, 4);
+      }
+
+      WHEN("Maxed with all hardware threads") {
+         CheckScan<SIMD::ScanOp::Max, T>(count, 0);
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      GIVEN("Sixteen million elements") {
+         const auto data = ControlScan<T>(16 * 1024 * 1024);
+         some<T> out(data.size());
+
+         BENCHMARK_ADVANCED("Inclusive scan (control)") (timer meter) {
+            meter.measure([&] {
+               std::inclusive_scan(data.begin(), data.end(), out.begin());
+            });
+         };
+
+         BENCHMARK_ADVANCED("Inclusive scan (SIMD)") (timer meter) {
+            meter.measure([&] {
+               SIMD::InclusiveScan(data, out);
+            });
+         };
+
+         BENCHMARK_ADVANCED("Inclusive scan (SIMD, all threads)") (timer meter) {
+            meter.measure([&] {
+               SIMD::InclusiveScan(data, out, 0);
+            });
+         };
+      }
+   #endif
+}
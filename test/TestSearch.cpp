@@ -0,0 +1,116 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <algorithm>
+#include <string>
+#include <string_view>
+
+
+/// Generate some text, that has a newline every few characters               
+std::string MakeText(Count count) {
+   std::string result(count, 'a');
+   unsigned seed = static_cast<unsigned>(count) + 7;
+   for (auto& c : result) {
+      seed = seed * 1103515245u + 12345u;
+      const auto r = (seed >> 16) % 40;
+      c = r == 0 ? '\n' : static_cast<char>('a' + r % 26);
+   }
+   return result;
+}
+
+TEST_CASE("Searching for bytes", "[search]") {
+   for (Count count : {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+      GIVEN("A text of " + std::to_string(count) + " characters") {
+         const auto text = MakeText(count);
+         const std::string_view view {text};
+
+         WHEN("Searching for a byte") {
+            REQUIRE(SIMD::FindByte(view, '\n') == std::min(view.find('\n'), view.size()));
+            REQUIRE(SIMD::FindByte(view, 'z') == std::min(view.find('z'), view.size()));
+            REQUIRE(SIMD::FindByte(view, '!') == view.size());
+
+            // The last byte must be found too                          
+            if (count) {
+               auto changed = text;
+               std::replace(changed.begin(), changed.end(), '!', '?');
+               changed.back() = '!';
+               REQUIRE(SIMD::FindByte(std::string_view {changed}, '!') == count - 1);
+            }
+         }
+
+         WHEN("Searching for any of a set of bytes") {
+            for (std::string_view set : {"", "\n", "xyz", ",;\n!", "abcdefghijklmnopqrstuvwxyz"}) {
+               const auto expected = set.empty() ? view.size()
+                  : std::min(view.find_first_of(set), view.size());
+               REQUIRE(SIMD::FindAnyOf(view, set) == expected);
+            }
+         }
+
+         WHEN("Counting bytes") {
+            REQUIRE(SIMD::CountByte(view, '\n') == static_cast<Count>(std::count(view.begin(), view.end(), '\n')));
+            REQUIRE(SIMD::CountByte(view, 'q') == static_cast<Count>(std::count(view.begin(), view.end(), 'q')));
+            REQUIRE(SIMD::CountByte(view, '!') == 0);
+         }
+
+         WHEN("Searching at every offset") {
+            // Shifting the start exercises all alignments and tails    
+            for (Offset skip = 0; skip < std::min<Count>(count, 70); ++skip) {
+               const auto sub = view.substr(skip);
+               REQUIRE(SIMD::FindByte(sub, '\n') == std::min(sub.find('\n'), sub.size()));
+               REQUIRE(SIMD::CountByte(sub, '\n') == static_cast<Count>(std::count(sub.begin(), sub.end(), '\n')));
+            }
+         }
+      }
+   }
+}
+
+TEMPLATE_TEST_CASE("Measuring zero-terminated strings", "[search]", char, char8_t, char16_t, char32_t) {
+   using T = TestType;
+
+   for (Count count : {0, 1, 7, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000}) {
+      GIVEN("A string of " + std::to_string(count) + " characters") {
+         // Place the string at all sorts of offsets in a buffer        
+         some<T> buffer(count + 80, T {'x'});
+         for (Offset skip = 0; skip < 70; ++skip) {
+            std::fill(buffer.begin(), buffer.end(), T {'x'});
+            buffer[skip + count] = T {0};
+            REQUIRE(SIMD::Length(buffer.data() + skip) == count);
+            REQUIRE(SIMD::Length(std::span {buffer.data() + skip, count + 1}) == count);
+            REQUIRE(SIMD::Length(std::span {buffer.data() + skip, count}) == count);
+         }
+      }
+   }
+
+   if constexpr (CT::Exact<T, char>) {
+      REQUIRE(SIMD::Length("hello") == 5);
+      REQUIRE(SIMD::Length(std::string_view {"hello\0world", 11}) == 5);
+   }
+   else if constexpr (CT::Exact<T, char16_t>)
+      REQUIRE(SIMD::Length(u"hello") == 5);
+   else if constexpr (CT::Exact<T, char32_t>)
+      REQUIRE(SIMD::Length(U"hello") == 5);
+}
+
+#ifdef LANGULUS_STD_BENCHMARK
+TEST_CASE("Searching for bytes (benchmark)", "[search]") {
+   const auto text = MakeText(10000000);
+   const std::string_view view {text};
+
+   BENCHMARK_ADVANCED("Counting newlines (control)") (timer meter) {
+      meter.measure([&] {
+         return std::count(view.begin(), view.end(), '\n');
+      });
+   };
+
+   BENCHMARK_ADVANCED("Counting newlines (SIMD)") (timer meter) {
+      meter.measure([&] {
+         return SIMD::CountByte(view, '\n');
+      });
+   };
+}
+#endif
@@ -0,0 +1,191 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+
+
+/// Generate a random number from a narrow range, so that there are plenty    
+/// of ties, with the occasional extreme among them                           
+template<class T>
+T MakeSelectable(std::mt19937& gen) {
+   const auto r = gen() % 1000;
+   if (r == 0)
+      return std::numeric_limits<T>::max();
+   if (r == 1)
+      return std::numeric_limits<T>::lowest();
+   if constexpr (CT::Real<T>)
+      return static_cast<T>(static_cast<int>(gen() % 2000) - 1000) / T {8};
+   else if constexpr (CT::Signed<T>)
+      return static_cast<T>(static_cast<int>(gen() % 100) - 50);
+   else
+      return static_cast<T>(gen() % 100);
+}
+
+/// Compare ArgMin/ArgMax against std::min_element/std::max_element           
+template<class T>
+void CheckArg(const some<T>& data) {
+   const auto min = SIMD::ArgMin(data);
+   const auto max = SIMD::ArgMax(data);
+   if (data.empty()) {
+      REQUIRE(min.mIndex == 0);
+      REQUIRE(max.mIndex == 0);
+      return;
+   }
+
+   // std::max_element picks the first of the biggest, as ArgMax does,  
+   // only with an inverted comparison                                  
+   const auto expectedMin = std::min_element(data.begin(), data.end());
+   const auto expectedMax = std::min_element(data.begin(), data.end(),
+      [](const T& a, const T& b) { return b < a; });
+   REQUIRE(min.mIndex == static_cast<Offset>(expectedMin - data.begin()));
+   REQUIRE(min.mValue == *expectedMin);
+   REQUIRE(max.mIndex == static_cast<Offset>(expectedMax - data.begin()));
+   REQUIRE(max.mValue == *expectedMax);
+}
+
+/// Compare TopK against a stable sort                                        
+template<bool SMALLEST, class T>
+void CheckTop(const some<T>& data, Count k) {
+   some<Offset> expected(data.size());
+   std::iota(expected.begin(), expected.end(), Offset {0});
+   std::stable_sort(expected.begin(), expected.end(), [&](Offset a, Offset b) {
+      return SMALLEST ? data[a] < data[b] : data[b] < data[a];
+   });
+   expected.resize(std::min(k, data.size()));
+
+   some<::std::uint32_t> indices(k, ~::std::uint32_t {0});
+   REQUIRE(SIMD::TopK<SMALLEST>(data, indices) == expected.size());
+   for (Offset i = 0; i < expected.size(); ++i)
+      REQUIRE(indices[i] == expected[i]);
+}
+
+TEMPLATE_TEST_CASE("ArgMin, ArgMax and TopK", "[select]",
+   ::std::int8_t, ::std::uint8_t, ::std::int16_t, ::std::uint16_t,
+   ::std::int32_t, ::std::uint32_t, float,
+   ::std::int64_t, ::std::uint64_t, double
+) {
+   using T = TestType;
+   std::mt19937 gen {2024};
+
+   for (Count count : {0, 1, 2, 7, 16, 33, 100, 1000, 4095, 4097, 10000}) {
+      GIVEN(std::to_string(count) + " elements") {
+         some<T> data(count);
+
+         WHEN("Random") {
+            for (auto& x : data)
+               x = MakeSelectable<T>(gen);
+         }
+
+         WHEN("Ascending") {
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(i % 100);
+         }
+
+         WHEN("Descending") {
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(100 - i % 100);
+         }
+
+         WHEN("All equal") {
+            std::fill(data.begin(), data.end(), T {7});
+         }
+
+         WHEN("Extremes at the very end") {
+            for (auto& x : data)
+               x = MakeSelectable<T>(gen);
+            if (count > 1) {
+               data[count - 2] = std::numeric_limits<T>::lowest();
+               data[count - 1] = std::numeric_limits<T>::max();
+            }
+         }
+
+         CheckArg(data);
+         for (Count k : {1, 3, 16, 100}) {
+            CheckTop<false>(data, k);
+            CheckTop<true>(data, k);
+         }
+      }
+   }
+
+   if constexpr (CT::Real<T>) {
+      const auto nan = std::numeric_limits<T>::quiet_NaN();
+      const auto inf = std::numeric_limits<T>::infinity();
+
+      GIVEN("NaNs among the elements") {
+         some<T> data(100, T {1});
+         for (Offset i = 0; i < data.size(); i += 3)
+            data[i] = nan;
+         data[50] = T {-5};
+         data[70] = T {5};
+
+         REQUIRE(SIMD::ArgMin(data).mIndex == 50);
+         REQUIRE(SIMD::ArgMax(data).mIndex == 70);
+
+         some<::std::uint32_t> indices(3);
+         REQUIRE(SIMD::TopK(data, indices) == 3);
+         REQUIRE(indices[0] == 70);
+         REQUIRE(indices[1] == 1);
+         REQUIRE(indices[2] == 2);
+      }
+
+      GIVEN("Only NaNs") {
+         some<T> data(40, nan);
+         REQUIRE(SIMD::ArgMin(data).mIndex == 40);
+         REQUIRE(SIMD::ArgMax(data).mIndex == 40);
+
+         some<::std::uint32_t> indices(3);
+         REQUIRE(SIMD::TopK(data, indices) == 0);
+      }
+
+      GIVEN("Only infinities") {
+         some<T> data(40, inf);
+         data[20] = nan;
+         data[30] = -inf;
+         REQUIRE(SIMD::ArgMin(data).mIndex == 30);
+         REQUIRE(SIMD::ArgMax(data).mIndex == 0);
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<T> big(1000000);
+      for (auto& x : big)
+         x = MakeSelectable<T>(gen);
+
+      BENCHMARK_ADVANCED("ArgMin of a million elements (control)") (timer meter) {
+         meter.measure([&] {
+            return std::min_element(big.begin(), big.end()) - big.begin();
+         });
+      };
+
+      BENCHMARK_ADVANCED("ArgMin of a million elements (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::ArgMin(big).mIndex;
+         });
+      };
+
+      some<::std::uint32_t> top(16);
+      BENCHMARK_ADVANCED("Top 16 of a million elements (control)") (timer meter) {
+         some<Offset> order(big.size());
+         meter.measure([&] {
+            std::iota(order.begin(), order.end(), Offset {0});
+            std::partial_sort(order.begin(), order.begin() + top.size(), order.end(),
+               [&](Offset a, Offset b) { return big[b] < big[a]; });
+            return order[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Top 16 of a million elements (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::TopK(big, top);
+         });
+      };
+   #endif
+}
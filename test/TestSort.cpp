@@ -0,0 +1,267 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <algorithm>
+#include <limits>
+#include <random>
+
+
+/// Generate a random number, with plenty of duplicates, negatives and        
+/// extremes among them                                                       
+template<class T>
+T MakeSortable(std::mt19937& gen) {
+   const auto r = gen() % 100;
+   if (r == 0)
+      return std::numeric_limits<T>::max();
+   if (r == 1)
+      return std::numeric_limits<T>::lowest();
+   if constexpr (CT::Real<T>) {
+      if (r == 2)
+         return std::numeric_limits<T>::infinity();
+      if (r == 3)
+         return -std::numeric_limits<T>::infinity();
+      return static_cast<T>(static_cast<int>(gen() % 200) - 100) / T {4};
+   }
+   else return static_cast<T>(static_cast<int>(gen() % 40) - 20);
+}
+
+/// Sort random arrays of N elements, and compare with std::sort              
+template<class T, Count N>
+void CheckSort(std::mt19937& gen) {
+   for (int test = 0; test < 20; ++test) {
+      Vector<T, N> keys;
+      for (auto& key : keys.mArray)
+         key = MakeSortable<T>(gen);
+
+      // Sorting only keys                                              
+      auto sorted = keys;
+      SIMD::Sort(sorted);
+      auto expected = keys;
+      std::sort(std::begin(expected.mArray), std::end(expected.mArray));
+      REQUIRE(sorted == expected);
+
+      // Sorting keys, and carrying their indices along                 
+      using I = Conditional<sizeof(T) == 4, ::std::uint32_t, ::std::uint64_t>;
+      std::array<I, N> indices;
+      for (Offset i = 0; i < N; ++i)
+         indices[i] = static_cast<I>(i);
+      sorted = keys;
+      SIMD::Sort(sorted, indices);
+      REQUIRE(sorted == expected);
+      for (Offset i = 0; i < N; ++i)
+         REQUIRE(keys[indices[i]] == sorted[i]);
+      std::sort(indices.begin(), indices.end());
+      for (Offset i = 0; i < N; ++i)
+         REQUIRE(indices[i] == i);
+   }
+}
+
+/// Sort a register and compare with std::sort                                
+template<class R>
+void CheckRegisterSort(std::mt19937& gen) {
+   using T = TypeOf<R>;
+   constexpr Count L = CountOf<R>;
+   for (int test = 0; test < 50; ++test) {
+      std::array<T, L> a, b;
+      for (auto& x : a) x = MakeSortable<T>(gen);
+      for (auto& x : b) x = MakeSortable<T>(gen);
+
+      std::array<T, L> out;
+      SIMD::Inner::StoreUnaligned(out.data(),
+         SIMD::Inner::SortSIMD(SIMD::Inner::LoadUnaligned<R>(a.data())));
+      std::sort(a.begin(), a.end());
+      REQUIRE(out == a);
+
+      // Merge with another sorted register                             
+      std::sort(b.begin(), b.end());
+      R lo = SIMD::Inner::LoadUnaligned<R>(a.data());
+      R hi = SIMD::Inner::LoadUnaligned<R>(b.data());
+      SIMD::Inner::MergeSIMD(lo, hi);
+
+      std::array<T, L * 2> merged, expected;
+      SIMD::Inner::StoreUnaligned(merged.data(), lo);
+      SIMD::Inner::StoreUnaligned(merged.data() + L, hi);
+      std::merge(a.begin(), a.end(), b.begin(), b.end(), expected.begin());
+      REQUIRE(merged == expected);
+   }
+}
+
+TEMPLATE_TEST_CASE("Sorting small arrays", "[sort]",
+   ::std::int32_t, ::std::uint32_t, float, ::std::int64_t, ::std::uint64_t, double
+) {
+   using T = TestType;
+   std::mt19937 gen {1234};
+
+   GIVEN("Arrays of all sizes up to 64 elements") {
+      [&]<Count...N>(std::integer_sequence<Count, N...>) {
+         (CheckSort<T, N + 2>(gen), ...);
+      }(std::make_integer_sequence<Count, 63> {});
+   }
+
+   GIVEN("A C array") {
+      T data[5] {T {3}, T {1}, T {4}, T {1}, T {5}};
+      SIMD::Sort(data);
+      REQUIRE(data[0] == T {1});
+      REQUIRE(data[1] == T {1});
+      REQUIRE(data[2] == T {3});
+      REQUIRE(data[3] == T {4});
+      REQUIRE(data[4] == T {5});
+   }
+
+   GIVEN("Single registers") {
+      #if LANGULUS_SIMD(128BIT)
+         CheckRegisterSort<SIMD::V128<T>>(gen);
+      #endif
+      #if LANGULUS_SIMD(256BIT)
+         CheckRegisterSort<SIMD::V256<T>>(gen);
+      #endif
+      #if LANGULUS_SIMD(512BIT)
+         CheckRegisterSort<SIMD::V512<T>>(gen);
+      #endif
+   }
+
+   if constexpr (CT::Real<T>) {
+      GIVEN("Signed zeroes and NaNs") {
+         const auto nan = std::numeric_limits<T>::quiet_NaN();
+         std::array<T, 6> data {nan, T {1}, T {0}, -nan, T {-0.0}, T {-1}};
+         SIMD::Sort(data);
+         REQUIRE(std::isnan(data[0]));
+         REQUIRE(std::signbit(data[0]));
+         REQUIRE(data[1] == T {-1});
+         REQUIRE(data[2] == T {0});
+         REQUIRE(std::signbit(data[2]));
+         REQUIRE(data[3] == T {0});
+         REQUIRE_FALSE(std::signbit(data[3]));
+         REQUIRE(data[4] == T {1});
+         REQUIRE(std::isnan(data[5]));
+         REQUIRE_FALSE(std::signbit(data[5]));
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<Vector<T, 32>> arrays(10000);
+      for (auto& a : arrays) {
+         for (auto& x : a.mArray)
+            x = MakeSortable<T>(gen);
+      }
+
+      BENCHMARK_ADVANCED("Sorting 32 elements (control)") (timer meter) {
+         auto copy = arrays;
+         meter.measure([&] {
+            for (auto& a : copy)
+               std::sort(std::begin(a.mArray), std::end(a.mArray));
+            return copy.size();
+         });
+      };
+
+      BENCHMARK_ADVANCED("Sorting 32 elements (SIMD)") (timer meter) {
+         auto copy = arrays;
+         meter.measure([&] {
+            for (auto& a : copy)
+               SIMD::Sort(a);
+            return copy.size();
+         });
+      };
+   #endif
+}
+
+TEMPLATE_TEST_CASE("Sorting large arrays", "[sort]",
+   ::std::int32_t, ::std::uint32_t, float, ::std::int64_t, ::std::uint64_t, double
+) {
+   using T = TestType;
+   using I = Conditional<sizeof(T) == 4, ::std::uint32_t, ::std::uint64_t>;
+   using F = Conditional<sizeof(T) == 4, float, double>;
+   std::mt19937 gen {4321};
+
+   for (Count count : {0, 1, 2, 17, 100, 129, 257, 1000, 4099, 100000}) {
+      GIVEN(std::to_string(count) + " elements") {
+         some<T> data(count);
+
+         WHEN("Random") {
+            for (auto& x : data)
+               x = MakeSortable<T>(gen);
+         }
+
+         WHEN("Random, without duplicates") {
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(gen() % 1000000);
+         }
+
+         WHEN("Already sorted") {
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(i);
+         }
+
+         WHEN("Sorted in reverse") {
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(count - i);
+         }
+
+         WHEN("All equal") {
+            std::fill(data.begin(), data.end(), T {7});
+         }
+
+         WHEN("Organ pipe") {
+            for (Offset i = 0; i < count; ++i)
+               data[i] = static_cast<T>(std::min(i, count - i));
+         }
+
+         auto expected = data;
+         std::sort(expected.begin(), expected.end());
+
+         auto sorted = data;
+         SIMD::SortArray(sorted);
+         REQUIRE(sorted == expected);
+
+         // Sort keys, and carry their indices along                    
+         some<I> indices(count);
+         for (Offset i = 0; i < count; ++i)
+            indices[i] = static_cast<I>(i);
+         sorted = data;
+         SIMD::SortArray(sorted, indices);
+         REQUIRE(sorted == expected);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(data[indices[i]] == sorted[i]);
+         std::sort(indices.begin(), indices.end());
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(indices[i] == i);
+
+         // Sort keys, and carry real numbers along                     
+         some<F> reals(count);
+         for (Offset i = 0; i < count; ++i)
+            reals[i] = static_cast<F>(i) + F {0.5};
+         sorted = data;
+         SIMD::SortArray(sorted, reals);
+         REQUIRE(sorted == expected);
+         for (Offset i = 0; i < count; ++i)
+            REQUIRE(data[static_cast<Offset>(reals[i])] == sorted[i]);
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      some<T> data(1000000);
+      for (auto& x : data)
+         x = static_cast<T>(gen());
+
+      BENCHMARK_ADVANCED("Sorting a million elements (control)") (timer meter) {
+         auto copy = data;
+         meter.measure([&] {
+            std::sort(copy.begin(), copy.end());
+            return copy[0];
+         });
+      };
+
+      BENCHMARK_ADVANCED("Sorting a million elements (SIMD)") (timer meter) {
+         auto copy = data;
+         meter.measure([&] {
+            SIMD::SortArray(copy);
+            return copy[0];
+         });
+      };
+   #endif
+}
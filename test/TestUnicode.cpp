@@ -0,0 +1,203 @@
+///                                                                           
+/// Langulus::SIMD                                                            
+/// Copyright (c) 2019 Dimo Markov <team@langulus.com>                        
+/// Part of the Langulus framework, see https://langulus.com                  
+///                                                                           
+/// SPDX-License-Identifier: MIT                                              
+///                                                                           
+#include "Common.hpp"
+#include <string>
+
+
+/// Generate text of the given number of code points, with all kinds of       
+/// characters, from ASCII to the supplementary planes                        
+std::u32string MakeCodePoints(Count count, unsigned seed, unsigned asciiOdds) {
+   std::u32string result;
+   for (Offset i = 0; i < count; ++i) {
+      seed = seed * 1103515245u + 12345u;
+      const auto r = (seed >> 8) % 1000;
+      if (r < asciiOdds)
+         result += static_cast<char32_t>('a' + r % 26);
+      else switch (r % 4) {
+         case 0:  result += static_cast<char32_t>(0x80 + r);        break;
+         case 1:  result += static_cast<char32_t>(0x800 + r * 7);   break;
+         case 2:  result += static_cast<char32_t>(0xE000 + r * 3);  break;
+         default: result += static_cast<char32_t>(0x10000 + r * 997); break;
+      }
+   }
+   return result;
+}
+
+/// Encode code points one at a time, as a reference                          
+template<class T>
+std::basic_string<T> ControlEncode(const std::u32string& code) {
+   std::basic_string<T> result;
+   for (auto c : code) {
+      T units[4];
+      const auto n = SIMD::Inner::EncodeUnicode(c, units);
+      result.append(units, n);
+   }
+   return result;
+}
+
+/// Find the first invalid byte by decoding one code point at a time          
+Offset ControlValidate(const std::u8string& text) {
+   const auto p = reinterpret_cast<const ::std::uint8_t*>(text.data());
+   Offset i = 0;
+   while (i < text.size()) {
+      const auto decoded = SIMD::Inner::DecodeUtf8(p + i, text.size() - i);
+      if (not decoded.mSize)
+         break;
+      i += decoded.mSize;
+   }
+   return i;
+}
+
+/// Transcode and make sure both the size and the result are correct          
+template<class TO, class FROM>
+void CheckTranscode(const std::basic_string<FROM>& from, const std::basic_string<TO>& expected) {
+   const auto size = SIMD::TranscodedSize<TO>(from);
+   REQUIRE(size.mValid);
+   REQUIRE(size.mPosition == from.size());
+   REQUIRE(size.mCount == expected.size());
+
+   std::basic_string<TO> out(size.mCount, TO {});
+   const auto result = SIMD::Transcode(from, out);
+   REQUIRE(result.mValid);
+   REQUIRE(result.mCount == expected.size());
+   REQUIRE(out == expected);
+}
+
+TEST_CASE("Unicode transcoding", "[unicode]") {
+   for (Count count : {0, 1, 5, 15, 16, 17, 40, 100, 1000}) {
+      for (unsigned ascii : {1000u, 950u, 500u, 0u}) {
+         GIVEN(std::to_string(count) + " code points, " + std::to_string(ascii / 10) + "% ASCII") {
+            const auto u32 = MakeCodePoints(count, count * 13 + ascii, ascii);
+            const auto u8  = ControlEncode<char8_t>(u32);
+            const auto u16 = ControlEncode<char16_t>(u32);
+
+            WHEN("Validated") {
+               REQUIRE(SIMD::Validate(u8).mValid);
+               REQUIRE(SIMD::Validate(u16).mValid);
+               REQUIRE(SIMD::Validate(u32).mValid);
+
+               Offset firstNonAscii = 0;
+               while (firstNonAscii < u8.size() and static_cast<unsigned>(u8[firstNonAscii]) < 0x80)
+                  ++firstNonAscii;
+               REQUIRE(SIMD::FindNonAscii(u8) == firstNonAscii);
+               REQUIRE(SIMD::IsAscii(u8) == (firstNonAscii == u8.size()));
+            }
+
+            WHEN("Transcoded") {
+               CheckTranscode<char16_t>(u8,  u16);
+               CheckTranscode<char32_t>(u8,  u32);
+               CheckTranscode<char8_t> (u16, u8);
+               CheckTranscode<char32_t>(u16, u32);
+               CheckTranscode<char8_t> (u32, u8);
+               CheckTranscode<char16_t>(u32, u16);
+               CheckTranscode<char8_t> (u8,  u8);
+               CheckTranscode<wchar_t> (u8,  ControlEncode<wchar_t>(u32));
+            }
+         }
+      }
+   }
+
+   #ifdef LANGULUS_STD_BENCHMARK
+      const auto u8 = ControlEncode<char8_t>(MakeCodePoints(1000000, 1, 950));
+      std::u16string u16(u8.size(), u'\0');
+
+      BENCHMARK_ADVANCED("UTF-8 to UTF-16 (control)") (timer meter) {
+         meter.measure([&] {
+            const auto p = reinterpret_cast<const ::std::uint8_t*>(u8.data());
+            Offset i = 0, w = 0;
+            while (i < u8.size()) {
+               const auto d = SIMD::Inner::DecodeUtf8(p + i, u8.size() - i);
+               w += SIMD::Inner::EncodeUnicode(d.mCode, u16.data() + w);
+               i += d.mSize;
+            }
+            return w;
+         });
+      };
+
+      BENCHMARK_ADVANCED("UTF-8 to UTF-16 (SIMD)") (timer meter) {
+         meter.measure([&] {
+            return SIMD::Transcode(u8, u16).mCount;
+         });
+      };
+   #endif
+}
+
+TEST_CASE("Invalid UTF-8", "[unicode]") {
+   const std::u8string invalid[] {
+      u8"\x80",                  // lone continuation
+      u8"\xC3",                  // truncated two byte sequence
+      u8"\xC3\x28",              // lead, then no continuation
+      u8"\xC0\xAF",              // overlong '/'
+      u8"\xE0\x80\xAF",          // overlong three byte sequence
+      u8"\xF0\x80\x80\xAF",      // overlong four byte sequence
+      u8"\xED\xA0\x80",          // surrogate
+      u8"\xF4\x90\x80\x80",      // above 0x10FFFF
+      u8"\xF5\x80\x80\x80",      // invalid lead
+      u8"\xFF",                  // invalid byte
+      u8"\xE2\x82",              // truncated three byte sequence
+      u8"\xE2\x82\xAC\xAC",      // too many continuations
+   };
+
+   for (const auto& bad : invalid) {
+      for (Offset at : {0, 1, 13, 14, 15, 16, 17, 31, 47, 63, 64, 100}) {
+         // Embed the bad sequence in valid text, at the given offset   
+         std::u8string text(at, u8'x');
+         if (at > 5)
+            text.replace(at - 5, 3, u8"€");
+         text += bad;
+         text += u8"valid text afterwards é€\U0001F600 and more ASCII";
+
+         const auto result = SIMD::Validate(text);
+         REQUIRE_FALSE(result.mValid);
+         REQUIRE(result.mPosition == ControlValidate(text));
+         REQUIRE(result.mPosition >= at);
+
+         // Transcoding must stop at the same place                     
+         std::u16string out(text.size(), u'\0');
+         const auto transcoded = SIMD::Transcode(text, out);
+         REQUIRE_FALSE(transcoded.mValid);
+         REQUIRE(transcoded.mPosition == result.mPosition);
+         REQUIRE(transcoded.mCount == SIMD::TranscodedSize<char16_t>(text).mCount);
+      }
+   }
+
+   GIVEN("Randomly corrupted text") {
+      unsigned seed = 12345;
+      for (unsigned test = 0; test < 2000; ++test) {
+         auto text = ControlEncode<char8_t>(MakeCodePoints(test % 90, test, 500));
+         for (unsigned corrupt = test % 3; corrupt > 0 and not text.empty(); --corrupt) {
+            seed = seed * 1103515245u + 12345u;
+            text[(seed >> 8) % text.size()] = static_cast<char8_t>(seed >> 24);
+         }
+         REQUIRE(SIMD::Validate(text).mPosition == ControlValidate(text));
+      }
+   }
+}
+
+TEST_CASE("Invalid UTF-16 and UTF-32", "[unicode]") {
+   std::u16string u16 = u"abcé\U0001F600";
+   u16 += static_cast<char16_t>(0xD800);
+   u16 += u"def";
+   REQUIRE(SIMD::Validate(u16).mPosition == 6);
+
+   std::u8string out8(20, u8'\0');
+   const auto r16 = SIMD::Transcode(u16, out8);
+   REQUIRE_FALSE(r16.mValid);
+   REQUIRE(r16.mPosition == 6);
+   REQUIRE(out8.substr(0, r16.mCount) == u8"abcé\U0001F600");
+
+   std::u32string u32 = U"abcdefgh";
+   u32[5] = 0x110000;
+   REQUIRE(SIMD::Validate(u32).mPosition == 5);
+
+   std::u16string out16(20, u'\0');
+   const auto r32 = SIMD::Transcode(u32, out16);
+   REQUIRE_FALSE(r32.mValid);
+   REQUIRE(r32.mPosition == 5);
+   REQUIRE(out16.substr(0, r32.mCount) == u"abcde");
+}